@@ -51,6 +51,14 @@ void Context::setUserEnabledMkldnn(bool e) {
   enabled_mkldnn = e;
 }
 
+bool Context::philoxCPURNG() const {
+  return philox_cpu_rng;
+}
+
+void Context::setPhiloxCPURNG(bool e) {
+  philox_cpu_rng = e;
+}
+
 bool Context::deterministicCuDNN() const {
   return deterministic_cudnn;
 }
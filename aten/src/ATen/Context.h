@@ -102,6 +102,12 @@ class CAFFE2_API Context {
   void setUserEnabledCuDNN(bool e);
   bool userEnabledMkldnn() const;
   void setUserEnabledMkldnn(bool e);
+  // Whether the CPU sampling kernels that support it (uniform_, normal_,
+  // bernoulli_) draw from a counter-based Philox stream, split across
+  // threads, instead of the generator's mt19937 stream.
+  // See Note [Philox CPU random number generation]
+  bool philoxCPURNG() const;
+  void setPhiloxCPURNG(bool e);
   bool benchmarkCuDNN() const;
   void setBenchmarkCuDNN(bool);
   bool deterministicCuDNN() const;
@@ -137,6 +143,7 @@ class CAFFE2_API Context {
   bool _deterministic = false;
   bool benchmark_cudnn = false;
   bool enabled_mkldnn = true;
+  bool philox_cpu_rng = false;
   #ifdef C10_MOBILE
   bool release_original_weights = true;
   #else
@@ -0,0 +1,161 @@
+#include <ATen/ExecutionDomain.h>
+
+#include <ATen/Parallel.h>
+#include <c10/util/Exception.h>
+#include <c10/util/thread_name.h>
+
+#include <unordered_map>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace at {
+
+namespace {
+
+// Nice values of the threads of the domains with a non default priority
+constexpr int kLowPriorityNice = 10;
+constexpr int kHighPriorityNice = -5;
+
+thread_local std::shared_ptr<ExecutionDomain> current_domain_;
+
+std::mutex& registry_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+// Leaked, as the threads of the domains may still be running at exit
+std::unordered_map<std::string, std::shared_ptr<ExecutionDomain>>& registry() {
+  static auto* domains =
+      new std::unordered_map<std::string, std::shared_ptr<ExecutionDomain>>();
+  return *domains;
+}
+
+int defaultNumThreads(const ExecutionDomainOptions& options, int num_threads, int global_default) {
+  if (num_threads > 0) {
+    return num_threads;
+  }
+  return options.cpus.empty() ? global_default : options.cpus.size();
+}
+
+} // namespace
+
+ExecutionDomain::ExecutionDomain(std::string name, ExecutionDomainOptions options)
+    : name_(std::move(name)),
+      options_(std::move(options)),
+      num_intraop_threads_(defaultNumThreads(
+          options_, options_.num_intraop_threads, intraop_default_num_threads())),
+      num_interop_threads_(defaultNumThreads(
+          options_, options_.num_interop_threads, c10::TaskThreadPoolBase::defaultNumThreads())) {
+  TORCH_CHECK(
+      options_.num_intraop_threads >= 0 && options_.num_interop_threads >= 0,
+      "Expected non-negative numbers of threads for the execution domain ", name_);
+#ifndef __linux__
+  TORCH_CHECK(
+      options_.cpus.empty(),
+      "Setting the CPU affinity of an execution domain is only supported on Linux");
+#endif
+}
+
+c10::TaskThreadPoolBase& ExecutionDomain::interop_pool() {
+  std::call_once(interop_pool_created_, [this] {
+    interop_pool_ = std::make_unique<c10::ThreadPool>(
+        num_interop_threads_, /*numa_node_id=*/-1, [this] {
+          init_thread("PTDomainInterop");
+        });
+  });
+  return *interop_pool_;
+}
+
+c10::TaskThreadPoolBase& ExecutionDomain::intraop_pool() {
+  std::call_once(intraop_pool_created_, [this] {
+    intraop_pool_ = std::make_unique<c10::ThreadPool>(
+        num_intraop_threads_ - 1, /*numa_node_id=*/-1, [this] {
+          init_thread("PTDomainIntraop");
+        });
+  });
+  return *intraop_pool_;
+}
+
+void ExecutionDomain::init_thread(const char* thread_name) {
+  c10::setThreadName(thread_name);
+#ifdef __linux__
+  if (!options_.cpus.empty()) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (int cpu : options_.cpus) {
+      CPU_SET(cpu, &cpus);
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+      TORCH_WARN_ONCE("Could not set the CPU affinity of the threads of the execution domain ", name_);
+    }
+  }
+  if (options_.priority != ExecutionPriority::Normal) {
+    int nice = options_.priority == ExecutionPriority::Low ? kLowPriorityNice : kHighPriorityNice;
+    // On Linux, the nice value of a thread can be set through its tid
+    if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), nice) != 0) {
+      TORCH_WARN_ONCE(
+          "Could not set the priority of the threads of the execution domain ", name_,
+          " (raising the priority of threads requires the CAP_SYS_NICE capability)");
+    }
+  }
+#endif
+  internal::set_current_execution_domain(shared_from_this());
+  at::init_num_threads();
+}
+
+void register_execution_domain(const std::string& name, ExecutionDomainOptions options) {
+  auto domain = std::make_shared<ExecutionDomain>(name, std::move(options));
+  std::lock_guard<std::mutex> lock(registry_mutex());
+  TORCH_CHECK(
+      registry().emplace(name, std::move(domain)).second,
+      "An execution domain named ", name, " is already registered");
+}
+
+std::shared_ptr<ExecutionDomain> get_execution_domain(const std::string& name) {
+  std::lock_guard<std::mutex> lock(registry_mutex());
+  auto it = registry().find(name);
+  return it != registry().end() ? it->second : nullptr;
+}
+
+const std::shared_ptr<ExecutionDomain>& current_execution_domain() {
+  return current_domain_;
+}
+
+namespace internal {
+
+void set_current_execution_domain(std::shared_ptr<ExecutionDomain> domain) {
+  if (domain == current_domain_) {
+    return;
+  }
+  current_domain_ = std::move(domain);
+#if AT_PARALLEL_OPENMP
+  // Resizes the parallel regions started from this thread
+  at::init_num_threads();
+#endif
+}
+
+} // namespace internal
+
+ExecutionDomainGuard::ExecutionDomainGuard(const std::string& name)
+    : ExecutionDomainGuard([&] {
+        auto domain = get_execution_domain(name);
+        TORCH_CHECK(domain, "No execution domain named ", name, " is registered");
+        return domain;
+      }()) {}
+
+ExecutionDomainGuard::ExecutionDomainGuard(std::shared_ptr<ExecutionDomain> domain)
+    : prev_domain_(current_execution_domain()) {
+  internal::set_current_execution_domain(std::move(domain));
+}
+
+ExecutionDomainGuard::~ExecutionDomainGuard() {
+  internal::set_current_execution_domain(std::move(prev_domain_));
+}
+
+} // namespace at
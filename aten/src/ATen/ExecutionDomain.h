@@ -0,0 +1,117 @@
+#pragma once
+
+#include <c10/core/thread_pool.h>
+#include <c10/macros/Macros.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace at {
+
+// Note [Execution domains]
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// By default the inter-op pool (at::launch, TorchScript fork) and the
+// intra-op threads (at::parallel_for) are shared by the whole process, so
+// models served concurrently from one process compete for the same threads.
+//
+// An execution domain is a named set of threads with its own inter-op pool
+// and intra-op thread count, optionally pinned to a set of CPUs and run with
+// a lower or higher scheduling priority. Work runs in a domain while an
+// ExecutionDomainGuard is alive on its thread. The domain is part of the
+// ThreadLocalState, so the tasks started with at::launch run in the inter-op
+// pool of the domain, as does everything they launch in turn.
+//
+// How the intra-op threads are isolated depends on the parallel backend:
+//   - native: each domain has its own intra-op pool;
+//   - OpenMP: the domain sets the size of the parallel regions started from
+//     its threads, but the OpenMP worker threads are shared by all domains;
+//   - TBB: the intra-op threads are not isolated.
+// The affinity and priority are applied to the threads the domain owns, not
+// to the threads that enter the domain with a guard.
+
+enum class ExecutionPriority { Low, Normal, High };
+
+struct CAFFE2_API ExecutionDomainOptions {
+  // 0 for the number of CPUs of the domain if it has any, or else the
+  // default size of the global pools
+  int num_intraop_threads = 0;
+  int num_interop_threads = 0;
+  // CPUs the threads of the domain run on, all if empty (only Linux)
+  std::vector<int> cpus;
+  ExecutionPriority priority = ExecutionPriority::Normal;
+};
+
+class CAFFE2_API ExecutionDomain
+    : public std::enable_shared_from_this<ExecutionDomain> {
+ public:
+  ExecutionDomain(std::string name, ExecutionDomainOptions options);
+
+  const std::string& name() const {
+    return name_;
+  }
+  const ExecutionDomainOptions& options() const {
+    return options_;
+  }
+  int num_intraop_threads() const {
+    return num_intraop_threads_;
+  }
+  int num_interop_threads() const {
+    return num_interop_threads_;
+  }
+
+  // The pools are created on first use. The intra-op pool doesn't include
+  // the thread that starts the parallel work, so it has
+  // num_intraop_threads() - 1 threads.
+  c10::TaskThreadPoolBase& interop_pool();
+  c10::TaskThreadPoolBase& intraop_pool();
+
+ private:
+  // Runs in each thread of the pools of the domain
+  void init_thread(const char* thread_name);
+
+  const std::string name_;
+  const ExecutionDomainOptions options_;
+  const int num_intraop_threads_;
+  const int num_interop_threads_;
+  std::once_flag interop_pool_created_;
+  std::once_flag intraop_pool_created_;
+  std::unique_ptr<c10::ThreadPool> interop_pool_;
+  std::unique_ptr<c10::ThreadPool> intraop_pool_;
+};
+
+// Registers a domain; the name must not be registered yet. Domains live
+// until the end of the process.
+CAFFE2_API void register_execution_domain(
+    const std::string& name,
+    ExecutionDomainOptions options);
+
+// Returns nullptr if no domain was registered with this name
+CAFFE2_API std::shared_ptr<ExecutionDomain> get_execution_domain(
+    const std::string& name);
+
+// Domain the current thread runs in, nullptr outside of any domain
+CAFFE2_API const std::shared_ptr<ExecutionDomain>& current_execution_domain();
+
+namespace internal {
+// Used by ExecutionDomainGuard and ThreadLocalState
+CAFFE2_API void set_current_execution_domain(
+    std::shared_ptr<ExecutionDomain> domain);
+} // namespace internal
+
+// Runs the current thread in a domain (nullptr for none) until destroyed
+class CAFFE2_API ExecutionDomainGuard {
+ public:
+  explicit ExecutionDomainGuard(const std::string& name);
+  explicit ExecutionDomainGuard(std::shared_ptr<ExecutionDomain> domain);
+  ~ExecutionDomainGuard();
+
+  ExecutionDomainGuard(const ExecutionDomainGuard&) = delete;
+  ExecutionDomainGuard& operator=(const ExecutionDomainGuard&) = delete;
+
+ private:
+  std::shared_ptr<ExecutionDomain> prev_domain_;
+};
+
+} // namespace at
@@ -45,8 +45,12 @@ inline C10_HOST_DEVICE bool _isnan(T val) {
   return at::_isnan(float(val));
 }
 
-
-inline C10_HOST_DEVICE bool _isnan(at::BFloat16 val) {
+// A template like the Half overload, not a plain function: callers such as
+// min_impl/max_impl in zmath.h spell the call _isnan<scalar_t>(x), which only
+// considers templates.
+template <typename T,
+         typename std::enable_if<std::is_same<T, at::BFloat16>::value, int>::type = 0>
+inline C10_HOST_DEVICE bool _isnan(T val) {
   return at::_isnan(float(val));
 }
 
@@ -2,6 +2,7 @@
 #if AT_PARALLEL_NATIVE
 #include <ATen/Parallel.h>
 #include <ATen/PTThreadPool.h>
+#include <ATen/ExecutionDomain.h>
 
 #ifndef C10_MOBILE
 #include <c10/core/thread_pool.h>
@@ -66,7 +67,7 @@ int _num_pool_threads(int nthreads) {
   return nthreads - 1;
 }
 
-TaskThreadPoolBase& _get_intraop_pool() {
+TaskThreadPoolBase& _get_global_intraop_pool() {
   static std::shared_ptr<TaskThreadPoolBase> pool =
       ThreadPoolRegistry()->Create(
           "C10",
@@ -76,6 +77,15 @@ TaskThreadPoolBase& _get_intraop_pool() {
   return *pool;
 }
 
+// Intra-op pool of the execution domain of the current thread if any
+TaskThreadPoolBase& _get_intraop_pool() {
+  const auto& domain = current_execution_domain();
+  if (domain) {
+    return domain->intraop_pool();
+  }
+  return _get_global_intraop_pool();
+}
+
 #endif // C10_MOBILE
 
 // Run lambda function `fn` over `task_id` in [0, `range`) with threadpool.
@@ -198,7 +208,7 @@ void set_num_threads(int nthreads) {
     int stored_nthreads = num_intraop_threads.load();
     if (stored_nthreads <= 0) {
       // plus one because of master thread
-      stored_nthreads = _get_intraop_pool().size() + 1;
+      stored_nthreads = _get_global_intraop_pool().size() + 1;
     }
     if (stored_nthreads != nthreads) {
       TORCH_WARN(
@@ -214,6 +224,10 @@ void set_num_threads(int nthreads) {
 
 int get_num_threads() {
 #ifndef C10_MOBILE
+  const auto& domain = current_execution_domain();
+  if (domain) {
+    return domain->num_intraop_threads();
+  }
   // not initializing pool unnecessarily,
   // because pool cannot be resized after initialization
   int nthreads = num_intraop_threads.load();
@@ -223,7 +237,7 @@ int get_num_threads() {
     return intraop_default_num_threads();
   } else {
     TORCH_INTERNAL_ASSERT(nthreads == CONSUMED);
-    return _get_intraop_pool().size() + 1;
+    return _get_global_intraop_pool().size() + 1;
   }
 #else
   caffe2::ThreadPool* pool = caffe2::mobile_threadpool();
@@ -238,11 +252,17 @@ int get_thread_num() {
 
 bool in_parallel_region() {
 #ifndef C10_MOBILE
-  return in_parallel_region_ || (
-    num_intraop_threads.load() == CONSUMED &&
-    // Needed as intraop_launch() doesn't set in_parallel_region().
-    _get_intraop_pool().inThreadPool()
-  );
+  if (in_parallel_region_) {
+    return true;
+  }
+  // Needed as intraop_launch() doesn't set in_parallel_region().
+  const auto& domain = current_execution_domain();
+  if (domain) {
+    // The threads of the intra-op pool of a domain run in the domain
+    return domain->intraop_pool().inThreadPool();
+  }
+  return num_intraop_threads.load() == CONSUMED &&
+    _get_global_intraop_pool().inThreadPool();
 #else
   return in_parallel_region_;
 #endif // C10_MOBILE
@@ -1,6 +1,7 @@
 #include <ATen/Config.h>
 #if AT_PARALLEL_OPENMP
 #include <ATen/Parallel.h>
+#include <ATen/ExecutionDomain.h>
 
 #include <atomic>
 
@@ -17,6 +18,15 @@ std::atomic<int> num_threads{-1};
 } // namespace
 
 void init_num_threads() {
+#ifdef _OPENMP
+  // The size of the parallel regions is a property of the calling thread,
+  // see Note [Execution domains]
+  const auto& domain = current_execution_domain();
+  if (domain) {
+    omp_set_num_threads(domain->num_intraop_threads());
+    return;
+  }
+#endif
   auto nthreads = num_threads.load();
   if (nthreads > 0) {
     set_num_threads(nthreads);
@@ -2,6 +2,7 @@
 #if AT_PARALLEL_OPENMP || AT_PARALLEL_NATIVE || AT_PARALLEL_NATIVE_TBB
 #include <ATen/Parallel.h>
 #include <ATen/PTThreadPool.h>
+#include <ATen/ExecutionDomain.h>
 #include <ATen/ThreadLocalState.h>
 
 #include <atomic>
@@ -57,6 +58,10 @@ void set_num_interop_threads(int nthreads) {
 }
 
 int get_num_interop_threads() {
+  const auto& domain = current_execution_domain();
+  if (domain) {
+    return domain->num_interop_threads();
+  }
   int nthreads = num_interop_threads.load();
   if (nthreads > 0) {
     return nthreads;
@@ -73,7 +78,12 @@ void launch_no_thread_state(std::function<void()> fn) {
 #if AT_EXPERIMENTAL_SINGLE_THREAD_POOL
   intraop_launch(std::move(fn));
 #else
-  get_pool().run(std::move(fn));
+  const auto& domain = current_execution_domain();
+  if (domain) {
+    domain->interop_pool().run(std::move(fn));
+  } else {
+    get_pool().run(std::move(fn));
+  }
 #endif
 }
 } // namespace internal
@@ -4,6 +4,9 @@
 #include <ATen/core/TensorBody.h>
 #include <ATen/ExpandUtils.h>
 #include <ATen/Functions.h>
+#include <ATen/TracerMode.h>
+#include <ATen/core/grad_mode.h>
+#include <c10/util/SmallVector.h>
 
 namespace at {
 namespace indexing {
@@ -438,6 +441,141 @@ static inline Tensor applySlicing(
   }
   return result;
 }
+
+// Note [Fused basic indexing]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// applySlicing applies the indices one dimension at a time: every integer,
+// slice and None creates an intermediate view through a select, slice or
+// unsqueeze call, each going through dispatch and autograd. These indices
+// only change the geometry of the view, so applySlicingFused computes the
+// sizes, strides and storage offset of the result in one pass and creates it
+// with a single as_strided call. Tensor indices are recorded in outIndices at
+// the same positions as applySlicing does, so a mix of basic and advanced
+// indices also takes one view followed by a single index call.
+//
+// The fused path is only used when canApplySlicingFused(self) holds:
+//   - the backward of as_strided is much more expensive than the ones of
+//     select and slice, so it isn't used for results that require grad;
+//   - a trace must record the individual ops, see
+//     NOTE [ Setting `disable_slice_optimization` when calling C++ tensor indexing functions from Python ];
+//   - named, quantized and non-strided tensors need their specific views.
+// For the same reason, set_item only takes it when the assigned value
+// doesn't require grad either (canSetItemFused): copying it into the view
+// would record the backward of as_strided.
+// It returns nullopt for the indices it doesn't handle (booleans, masks and
+// 0-dim tensors) and for invalid ones, so that applySlicing reports the error.
+static inline bool canApplySlicingFused(const Tensor& self, const at::Device& self_device) {
+  return !(self.requires_grad() && GradMode::is_enabled()) &&
+      !tracer::impl::is_dispatch_enabled() &&
+      (self_device == at::kCPU || self_device == at::kCUDA) &&
+      self.layout() == kStrided && !self.is_quantized() && !self.has_names();
+}
+
+static inline bool canSetItemFused(const Tensor& self, const Tensor& value, const at::Device& self_device) {
+  return canApplySlicingFused(self, self_device) &&
+      !(value.requires_grad() && GradMode::is_enabled());
+}
+
+static inline c10::optional<Tensor> applySlicingFused(
+    const Tensor& self,
+    const ArrayRef<TensorIndex>& indices,
+    std::vector<Tensor>& outIndices,
+    const IntArrayRef& self_sizes) {
+  const int64_t self_dim = self_sizes.size();
+  int64_t specified_dims = 0;
+  bool has_ellipsis = false;
+  for (const auto& index : indices) {
+    if (index.is_integer() || index.is_slice()) {
+      specified_dims++;
+    } else if (index.is_tensor()) {
+      const Tensor& tensor = index.tensor();
+      if (tensor.dim() == 0 || tensor.scalar_type() != kLong) {
+        return c10::nullopt;
+      }
+      specified_dims++;
+    } else if (index.is_ellipsis() && !has_ellipsis) {
+      has_ellipsis = true;
+    } else if (!index.is_none()) {
+      return c10::nullopt;
+    }
+  }
+  if (specified_dims > self_dim) {
+    return c10::nullopt;
+  }
+
+  IntArrayRef self_strides = self.strides();
+  c10::SmallVector<int64_t, 5> sizes;
+  c10::SmallVector<int64_t, 5> strides;
+  std::vector<Tensor> tensorIndices;
+  int64_t storage_offset = self.storage_offset();
+  int64_t dim = 0;
+  for (const auto& index : indices) {
+    if (index.is_integer()) {
+      // Same as at::native::select
+      const int64_t size = self_sizes[dim];
+      int64_t i = index.integer();
+      if (i < -size || i >= size) {
+        return c10::nullopt;
+      }
+      if (i < 0) {
+        i += size;
+      }
+      storage_offset += i * self_strides[dim];
+      dim++;
+    } else if (index.is_slice()) {
+      // Same as at::native::slice
+      const int64_t size = self_sizes[dim];
+      int64_t start = index.slice().start();
+      int64_t stop = index.slice().stop();
+      const int64_t step = index.slice().step();
+      if (step <= 0) {
+        return c10::nullopt;
+      }
+      if (start < 0) {
+        start += size;
+      }
+      if (stop < 0) {
+        stop += size;
+      }
+      if (start < 0) {
+        start = 0;
+      } else if (start >= size) {
+        start = size;
+      }
+      if (stop < start) {
+        stop = start;
+      } else if (stop >= size) {
+        stop = size;
+      }
+      storage_offset += start * self_strides[dim];
+      sizes.push_back((stop - start + step - 1) / step);
+      strides.push_back(self_strides[dim] * step);
+      dim++;
+    } else if (index.is_none()) {
+      // Same as at::native::unsqueeze
+      sizes.push_back(1);
+      strides.push_back(dim < self_dim ? self_sizes[dim] * self_strides[dim] : 1);
+    } else if (index.is_ellipsis()) {
+      for (int64_t end = dim + self_dim - specified_dims; dim < end; dim++) {
+        sizes.push_back(self_sizes[dim]);
+        strides.push_back(self_strides[dim]);
+      }
+    } else {
+      // The dimension is kept and indexed by the tensor
+      int64_t out_dim = sizes.size();
+      recordTensorIndex(index.tensor(), tensorIndices, &out_dim);
+      sizes.push_back(self_sizes[dim]);
+      strides.push_back(self_strides[dim]);
+      dim++;
+    }
+  }
+  for (; dim < self_dim; dim++) {
+    sizes.push_back(self_sizes[dim]);
+    strides.push_back(self_strides[dim]);
+  }
+  outIndices = std::move(tensorIndices);
+  return self.as_strided(sizes, strides, storage_offset);
+}
 } // namespace impl
 
 static inline Tensor dispatch_index(const Tensor& self, std::vector<Tensor>&& indices) {
@@ -508,7 +646,14 @@ static inline Tensor get_item(const Tensor& self, const ArrayRef<TensorIndex>& i
   }
 
   std::vector<Tensor> tensorIndices;
-  Tensor sliced = impl::applySlicing(self, indices, tensorIndices, disable_slice_optimization, self_device, self_sizes);
+  // See Note [Fused basic indexing]
+  c10::optional<Tensor> fused;
+  if (!disable_slice_optimization && impl::canApplySlicingFused(self, self_device)) {
+    fused = impl::applySlicingFused(self, indices, tensorIndices, self_sizes);
+  }
+  Tensor sliced = fused
+      ? std::move(*fused)
+      : impl::applySlicing(self, indices, tensorIndices, disable_slice_optimization, self_device, self_sizes);
   if (tensorIndices.empty()) {
     if (sliced.is_same(self)) {
       // ensure we return a shallow copy for things like x[...]
@@ -559,7 +704,14 @@ static inline void set_item(Tensor& self, const ArrayRef<TensorIndex>& indices,
   }
 
   std::vector<Tensor> tensorIndices;
-  Tensor sliced = impl::applySlicing(self, indices, tensorIndices, disable_slice_optimization, self_device, self_sizes);
+  // See Note [Fused basic indexing]
+  c10::optional<Tensor> fused;
+  if (!disable_slice_optimization && impl::canSetItemFused(self, value, self_device)) {
+    fused = impl::applySlicingFused(self, indices, tensorIndices, self_sizes);
+  }
+  Tensor sliced = fused
+      ? std::move(*fused)
+      : impl::applySlicing(self, indices, tensorIndices, disable_slice_optimization, self_device, self_sizes);
   if (tensorIndices.empty()) {
     copy_to(sliced, value);
     return;
@@ -8,7 +8,8 @@ namespace at {
 
 ThreadLocalState::ThreadLocalState(bool keep_grad_mode)
     : dispatch_key_(c10::impl::tls_local_dispatch_key_set()),
-      debug_info_(c10::ThreadLocalDebugInfo::current()) {
+      debug_info_(c10::ThreadLocalDebugInfo::current()),
+      execution_domain_(current_execution_domain()) {
   callbacks_ = _getTLSCallbacks();
 #if !defined(CAFFE2_IS_XPLAT_BUILD) && !defined(C10_MOBILE)
   keep_grad_mode_ = keep_grad_mode;
@@ -31,6 +32,8 @@ void ThreadLocalState::setThreadLocalState(
 
   c10::ThreadLocalDebugInfo::_forceCurrentDebugInfo(state.debug_info_);
 
+  internal::set_current_execution_domain(state.execution_domain_);
+
   c10::impl::_force_tls_local_dispatch_key_set(state.dispatch_key_);
 }
 
@@ -4,6 +4,7 @@
 #include <c10/util/Exception.h>
 #include <c10/util/ThreadLocalDebugInfo.h>
 
+#include <ATen/ExecutionDomain.h>
 #include <ATen/record_function.h>
 
 namespace at {
@@ -33,6 +34,9 @@ class TORCH_API ThreadLocalState {
   // RecordFunction TLS callbacks
   RecordFunctionCallbacks callbacks_;
 
+  // Execution domain the work runs in, see Note [Execution domains]
+  std::shared_ptr<ExecutionDomain> execution_domain_;
+
 #if !defined(CAFFE2_IS_XPLAT_BUILD) && !defined(C10_MOBILE)
   bool keep_grad_mode_ = true;
   bool grad_mode_enabled_;
@@ -0,0 +1,61 @@
+#pragma once
+
+// DO NOT DEFINE STATIC DATA IN THIS HEADER!
+// See Note [Do not compile initializers with AVX]
+
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <ATen/cpu/vec512/vec512_base.h>
+#include <ATen/cpu/vec512/vec512_float.h>
+#include <ATen/cpu/vec512/vec512_bfloat16.h>
+#include <ATen/cpu/vec512/vec512_double.h>
+#include <ATen/cpu/vec512/vec512_int.h>
+
+#include <iostream>
+
+namespace at {
+namespace vec512 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+// Note [Choosing the vector width]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Kernels that want to use 512-bit registers in the AVX512 build should spell
+// their vector type as Vectorized<scalar_t> rather than Vec512<scalar_t>.
+// It resolves to Vec512<scalar_t> only when this compilation unit has an
+// AVX-512 specialization for scalar_t; otherwise (other CPU capabilities, or
+// element types such as complex, Half and the quantized types that only have
+// Vec256 implementations) it is Vec256<scalar_t>, so porting a kernel never
+// makes a type slower than it was. Both types expose the same interface, and
+// cpu_kernel_vec takes the vector width from the vectorized lambda.
+template <typename T>
+using Vectorized = typename std::conditional<
+    is_vec512_native<T>::value,
+    Vec512<T>,
+    vec256::Vec256<T>>::type;
+
+// Bring the Vec256 overloads of the free functions into vec512 so that
+// vec512::maximum(a, b) and friends work whichever width Vectorized<T> is.
+using vec256::maximum;
+using vec256::minimum;
+using vec256::clamp;
+using vec256::clamp_max;
+using vec256::clamp_min;
+using vec256::fmadd;
+
+template <typename T>
+std::ostream& operator<<(std::ostream& stream, const Vec512<T>& vec) {
+  T buf[Vec512<T>::size()];
+  vec.store(buf);
+  stream << "vec[";
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    if (i != 0) {
+      stream << ", ";
+    }
+    stream << buf[i];
+  }
+  stream << "]";
+  return stream;
+}
+
+}}}
@@ -0,0 +1,419 @@
+#pragma once
+
+// DO NOT DEFINE STATIC DATA IN THIS HEADER!
+// See Note [Do not compile initializers with AVX]
+//
+// Vec512 mirrors the Vec256 interface for 512-bit registers. Only the
+// AVX512 build of the kernels (CPU_CAPABILITY_AVX512) provides intrinsic
+// specializations; everywhere else Vec512<T> is the scalar emulation below,
+// and kernels should normally go through vec512::Vectorized<T> (see vec512.h)
+// which falls back to Vec256<T> instead.
+
+#include <ATen/cpu/vec256/vec256.h>
+
+#if defined(__GNUC__)
+#define __at_align64__ __attribute__((aligned(64)))
+#elif defined(_WIN32)
+#define __at_align64__ __declspec(align(64))
+#else
+#define __at_align64__
+#endif
+
+namespace at {
+namespace vec512 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+using vec256::is_floating_point;
+using vec256::int_same_size_t;
+
+// True for the element types that have an AVX512 specialization of Vec512 in
+// this compilation unit. Specializations set this next to their definition.
+template <typename T>
+struct is_vec512_native : std::false_type {};
+
+// NOTE: If you specialize on a type, you must define all operations!
+
+// emulates vectorized types
+template <class T>
+struct Vec512 {
+private:
+  __at_align64__ T values[64 / sizeof(T)];
+public:
+  using value_type = T;
+  // See Note [constexpr static function to avoid odr-usage compiler bug]
+  static constexpr int size() {
+    return 64 / sizeof(T);
+  }
+  Vec512() : values{0} {}
+  Vec512(T val) {
+    for (int i = 0; i != size(); i++) {
+      values[i] = val;
+    }
+  }
+  // This also implies const T& operator[](int idx) const
+  inline operator const T*() const {
+    return values;
+  }
+  // This also implies T& operator[](int idx)
+  inline operator T*() {
+    return values;
+  }
+  template <int64_t mask_>
+  static Vec512<T> blend(const Vec512<T>& a, const Vec512<T>& b) {
+    uint64_t mask = mask_;
+    Vec512 vec;
+    for (int64_t i = 0; i < size(); i++) {
+      vec[i] = (mask & 0x01) ? b[i] : a[i];
+      mask = mask >> 1;
+    }
+    return vec;
+  }
+  static Vec512<T> blendv(const Vec512<T>& a, const Vec512<T>& b,
+                          const Vec512<T>& mask) {
+    Vec512 vec;
+    int_same_size_t<T> buffer[size()];
+    mask.store(buffer);
+    for (int64_t i = 0; i < size(); i++) {
+      vec[i] = (buffer[i] & 0x01) ? b[i] : a[i];
+    }
+    return vec;
+  }
+  template<typename step_t>  // step sometimes requires a higher precision type (e.g., T=int, step_t=double)
+  static Vec512<T> arange(T base = static_cast<T>(0), step_t step = static_cast<step_t>(1)) {
+    Vec512 vec;
+    for (int64_t i = 0; i < size(); i++) {
+      vec.values[i] = base + i * step;
+    }
+    return vec;
+  }
+  static Vec512<T> set(const Vec512<T>& a, const Vec512<T>& b, int64_t count = size()) {
+    Vec512 vec;
+    for (int64_t i = 0; i < size(); i++) {
+      vec[i] = i < count ? b[i] : a[i];
+    }
+    return vec;
+  }
+  static Vec512<T> loadu(const void* ptr) {
+    Vec512 vec;
+    std::memcpy(vec.values, ptr, 64);
+    return vec;
+  }
+  static Vec512<T> loadu(const void* ptr, int64_t count) {
+    Vec512 vec;
+    std::memcpy(vec.values, ptr, count * sizeof(T));
+    return vec;
+  }
+  void store(void* ptr, int count = size()) const {
+    std::memcpy(ptr, values, count * sizeof(T));
+  }
+  int64_t zero_mask() const {
+    // returns an integer mask where all zero elements are translated to 1-bit and others are translated to 0-bit
+    int64_t mask = 0;
+    for (int i = 0; i < size(); ++ i) {
+      if (values[i] == static_cast<T>(0)) {
+        mask |= (int64_t(1) << i);
+      }
+    }
+    return mask;
+  }
+  Vec512<T> map(T (*f)(T)) const {
+    Vec512<T> ret;
+    for (int64_t i = 0; i != size(); i++) {
+      ret[i] = f(values[i]);
+    }
+    return ret;
+  }
+  Vec512<T> map(T (*f)(const T &)) const {
+    Vec512<T> ret;
+    for (int64_t i = 0; i != size(); i++) {
+      ret[i] = f(values[i]);
+    }
+    return ret;
+  }
+  template <typename other_t_abs = T,
+            typename std::enable_if<!is_floating_point<other_t_abs>::value, int>::type = 0>
+  Vec512<T> abs() const {
+    static_assert(std::is_same<other_t_abs, T>::value, "other_t_abs must be T");
+    return map([](T x) -> T { return x < static_cast<T>(0) ? -x : x; });
+  }
+  template <typename float_t_abs = T,
+            typename std::enable_if<is_floating_point<float_t_abs>::value, int>::type = 0>
+  Vec512<T> abs() const {
+    static_assert(std::is_same<float_t_abs, T>::value, "float_t_abs must be T");
+    // Handle -0.0 the same way Vec256 does.
+    return map([](T x) -> T { return std::abs(x); });
+  }
+  Vec512<T> neg() const {
+    // NB: the trailing return type is needed because we need to coerce the
+    // return value back to T in the case of unary operator- incuring a
+    // promotion
+    return map([](T x) -> T { return -x; });
+  }
+  Vec512<T> acos() const {
+    return map(std::acos);
+  }
+  Vec512<T> asin() const {
+    return map(std::asin);
+  }
+  Vec512<T> atan() const {
+    return map(std::atan);
+  }
+  Vec512<T> atan2(const Vec512<T> &exp) const {
+    Vec512<T> ret;
+    for (int64_t i = 0; i < size(); i++) {
+      ret[i] = std::atan2(values[i], exp[i]);
+    }
+    return ret;
+  }
+  Vec512<T> erf() const {
+    return map(std::erf);
+  }
+  Vec512<T> erfc() const {
+    return map(std::erfc);
+  }
+  Vec512<T> erfinv() const {
+    return map(calc_erfinv);
+  }
+  Vec512<T> exp() const {
+    return map(std::exp);
+  }
+  Vec512<T> expm1() const {
+    return map(std::expm1);
+  }
+  Vec512<T> frac() const {
+    return *this - this->trunc();
+  }
+  Vec512<T> fmod(const Vec512<T>& q) const {
+    Vec512<T> ret;
+    for (int64_t i = 0; i < size(); i++) {
+      ret[i] = std::fmod(values[i], q[i]);
+    }
+    return ret;
+  }
+  Vec512<T> log() const {
+    return map(std::log);
+  }
+  Vec512<T> log10() const {
+    return map(std::log10);
+  }
+  Vec512<T> log1p() const {
+    return map(std::log1p);
+  }
+  Vec512<T> log2() const {
+    return map(std::log2);
+  }
+  Vec512<T> ceil() const {
+    return map(at::native::ceil_impl);
+  }
+  Vec512<T> cos() const {
+    return map(std::cos);
+  }
+  Vec512<T> cosh() const {
+    return map(std::cosh);
+  }
+  Vec512<T> floor() const {
+    return map(at::native::floor_impl);
+  }
+  Vec512<T> round() const {
+    // We do not use std::round because we would like to round midway numbers to the nearest even integer.
+    return map(at::native::round_impl);
+  }
+  Vec512<T> sin() const {
+    return map(std::sin);
+  }
+  Vec512<T> sinh() const {
+    return map(std::sinh);
+  }
+  Vec512<T> tan() const {
+    return map(std::tan);
+  }
+  Vec512<T> tanh() const {
+    return map(std::tanh);
+  }
+  Vec512<T> trunc() const {
+    return map(at::native::trunc_impl);
+  }
+  Vec512<T> lgamma() const {
+    return map(std::lgamma);
+  }
+  Vec512<T> sqrt() const {
+    return map(std::sqrt);
+  }
+  Vec512<T> reciprocal() const {
+    return map([](T x) { return (T)(1) / x; });
+  }
+  Vec512<T> rsqrt() const {
+    return map([](T x) { return (T)1 / std::sqrt(x); });
+  }
+  Vec512<T> pow(const Vec512<T> &exp) const {
+    Vec512<T> ret;
+    for (int64_t i = 0; i < size(); i++) {
+      ret[i] = std::pow(values[i], exp[i]);
+    }
+    return ret;
+  }
+private:
+  template <typename Op>
+  inline Vec512<T> binary_pred(const Vec512<T>& other, Op op) const {
+    // All bits are set to 1 if the pred is true, otherwise 0.
+    Vec512<T> vec;
+    for (int64_t i = 0; i != size(); i++) {
+      if (op(values[i], other.values[i])) {
+        std::memset(static_cast<void*>(vec.values + i), 0xFF, sizeof(T));
+      } else {
+        std::memset(static_cast<void*>(vec.values + i), 0, sizeof(T));
+      }
+    }
+    return vec;
+  }
+  template <typename Op>
+  inline Vec512<T> binary_pred_bool(const Vec512<T>& other, Op op) const {
+    // 1 if the pred is true, otherwise 0.
+    Vec512<T> vec;
+    for (int i = 0; i != size(); ++ i) {
+      vec[i] = bool(op(values[i], other.values[i]));
+    }
+    return vec;
+  }
+
+public:
+  Vec512<T> operator==(const Vec512<T>& other) const { return binary_pred(other, std::equal_to<T>()); }
+  Vec512<T> operator!=(const Vec512<T>& other) const { return binary_pred(other, std::not_equal_to<T>()); }
+  Vec512<T> operator>=(const Vec512<T>& other) const { return binary_pred(other, std::greater_equal<T>()); }
+  Vec512<T> operator<=(const Vec512<T>& other) const { return binary_pred(other, std::less_equal<T>()); }
+  Vec512<T> operator>(const Vec512<T>& other) const { return binary_pred(other, std::greater<T>()); }
+  Vec512<T> operator<(const Vec512<T>& other) const { return binary_pred(other, std::less<T>()); }
+
+  Vec512<T> eq(const Vec512<T>& other) const { return binary_pred_bool(other, std::equal_to<T>()); }
+  Vec512<T> ne(const Vec512<T>& other) const { return binary_pred_bool(other, std::not_equal_to<T>()); }
+  Vec512<T> gt(const Vec512<T>& other) const { return binary_pred_bool(other, std::greater<T>()); }
+  Vec512<T> ge(const Vec512<T>& other) const { return binary_pred_bool(other, std::greater_equal<T>()); }
+  Vec512<T> lt(const Vec512<T>& other) const { return binary_pred_bool(other, std::less<T>()); }
+  Vec512<T> le(const Vec512<T>& other) const { return binary_pred_bool(other, std::less_equal<T>()); }
+};
+
+template <class T> Vec512<T> inline operator+(const Vec512<T> &a, const Vec512<T> &b) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = a[i] + b[i];
+  }
+  return c;
+}
+
+template <class T> Vec512<T> inline operator-(const Vec512<T> &a, const Vec512<T> &b) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = a[i] - b[i];
+  }
+  return c;
+}
+
+template <class T> Vec512<T> inline operator*(const Vec512<T> &a, const Vec512<T> &b) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = a[i] * b[i];
+  }
+  return c;
+}
+
+template <class T> Vec512<T> inline operator/(const Vec512<T> &a, const Vec512<T> &b) __ubsan_ignore_float_divide_by_zero__ {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = a[i] / b[i];
+  }
+  return c;
+}
+
+template <class T, typename Op>
+static inline Vec512<T> bitwise_binary_op(const Vec512<T> &a, const Vec512<T> &b, Op op) {
+  static constexpr uint32_t element_no = 64 / sizeof(intmax_t);
+  __at_align64__ intmax_t buffer[element_no];
+  const intmax_t *a_ptr = reinterpret_cast<const intmax_t*>((const T*) a);
+  const intmax_t *b_ptr = reinterpret_cast<const intmax_t*>((const T*) b);
+  for (uint32_t i = 0U; i < element_no; ++ i) {
+    buffer[i] = op(a_ptr[i], b_ptr[i]);
+  }
+  return Vec512<T>::loadu(buffer);
+}
+
+struct Vec512i;
+
+template<class T, typename std::enable_if_t<!std::is_base_of<Vec512i, Vec512<T>>::value, int> = 0>
+inline Vec512<T> operator&(const Vec512<T>& a, const Vec512<T>& b) {
+  return bitwise_binary_op(a, b, std::bit_and<intmax_t>());
+}
+template<class T, typename std::enable_if_t<!std::is_base_of<Vec512i, Vec512<T>>::value, int> = 0>
+inline Vec512<T> operator|(const Vec512<T>& a, const Vec512<T>& b) {
+  return bitwise_binary_op(a, b, std::bit_or<intmax_t>());
+}
+template<class T, typename std::enable_if_t<!std::is_base_of<Vec512i, Vec512<T>>::value, int> = 0>
+inline Vec512<T> operator^(const Vec512<T>& a, const Vec512<T>& b) {
+  return bitwise_binary_op(a, b, std::bit_xor<intmax_t>());
+}
+
+// Implements the IEEE 754 201X `maximum` operation, which propagates NaN if
+// either input is a NaN.
+template <class T>
+Vec512<T> inline maximum(const Vec512<T> &a, const Vec512<T> &b) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = (a[i] > b[i]) ? a[i] : b[i];
+    if (_isnan(a[i])) {
+      // If either input is NaN, propagate a NaN.
+      // NOTE: The case where b[i] was NaN is handled correctly by the naive
+      // ternary operator above.
+      c[i] = a[i];
+    }
+  }
+  return c;
+}
+
+// Implements the IEEE 754 201X `minimum` operation, which propagates NaN if
+// either input is a NaN.
+template <class T>
+Vec512<T> inline minimum(const Vec512<T> &a, const Vec512<T> &b) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = (a[i] < b[i]) ? a[i] : b[i];
+    if (_isnan(a[i])) {
+      c[i] = a[i];
+    }
+  }
+  return c;
+}
+
+// To save BC, it will not propagate NaN based on IEEE 754 201X
+template <class T>
+Vec512<T> inline clamp(const Vec512<T> &a, const Vec512<T> &min_vec, const Vec512<T> &max_vec) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = a[i] < min_vec[i] ? min_vec[i] : (a[i] > max_vec[i] ? max_vec[i] : a[i]);
+  }
+  return c;
+}
+
+template <class T>
+Vec512<T> inline clamp_max(const Vec512<T> &a, const Vec512<T> &max_vec) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = a[i] > max_vec[i] ? max_vec[i] : a[i];
+  }
+  return c;
+}
+
+template <class T>
+Vec512<T> inline clamp_min(const Vec512<T> &a, const Vec512<T> &min_vec) {
+  Vec512<T> c = Vec512<T>();
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    c[i] = a[i] < min_vec[i] ? min_vec[i] : a[i];
+  }
+  return c;
+}
+
+template <typename T>
+inline Vec512<T> fmadd(const Vec512<T>& a, const Vec512<T>& b, const Vec512<T>& c) {
+  return a * b + c;
+}
+
+}}}
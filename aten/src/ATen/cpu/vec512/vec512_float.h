@@ -0,0 +1,353 @@
+#pragma once
+
+// DO NOT DEFINE STATIC DATA IN THIS HEADER!
+// See Note [Do not compile initializers with AVX]
+
+#include <ATen/cpu/vec512/vec512_base.h>
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+#include <sleef.h>
+#endif
+
+namespace at {
+namespace vec512 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+
+template <> struct is_vec512_native<float> : std::true_type {};
+
+template <> class Vec512<float> {
+private:
+  __m512 values;
+  // Lane mask selecting the first `count` elements.
+  static __mmask16 first_n(int64_t count) {
+    return static_cast<__mmask16>((1ULL << count) - 1);
+  }
+  // Expands a comparison mask into the all-ones / all-zeros lanes that the
+  // Vec256 comparison operators return.
+  static __m512 mask_to_vec(__mmask16 mask) {
+    return _mm512_castsi512_ps(_mm512_movm_epi32(mask));
+  }
+public:
+  using value_type = float;
+  static constexpr int size() {
+    return 16;
+  }
+  Vec512() {}
+  Vec512(__m512 v) : values(v) {}
+  Vec512(float val) {
+    values = _mm512_set1_ps(val);
+  }
+  Vec512(float val1, float val2, float val3, float val4,
+         float val5, float val6, float val7, float val8,
+         float val9, float val10, float val11, float val12,
+         float val13, float val14, float val15, float val16) {
+    values = _mm512_setr_ps(
+        val1, val2, val3, val4, val5, val6, val7, val8,
+        val9, val10, val11, val12, val13, val14, val15, val16);
+  }
+  operator __m512() const {
+    return values;
+  }
+  template <int64_t mask>
+  static Vec512<float> blend(const Vec512<float>& a, const Vec512<float>& b) {
+    return _mm512_mask_blend_ps(static_cast<__mmask16>(mask), a.values, b.values);
+  }
+  static Vec512<float> blendv(const Vec512<float>& a, const Vec512<float>& b,
+                              const Vec512<float>& mask) {
+    auto m = _mm512_movepi32_mask(_mm512_castps_si512(mask.values));
+    return _mm512_mask_blend_ps(m, a.values, b.values);
+  }
+  template<typename step_t>
+  static Vec512<float> arange(float base = 0, step_t step = static_cast<step_t>(1)) {
+    return Vec512<float>(
+      base, base + step, base + 2 * step, base + 3 * step,
+      base + 4 * step, base + 5 * step, base + 6 * step, base + 7 * step,
+      base + 8 * step, base + 9 * step, base + 10 * step, base + 11 * step,
+      base + 12 * step, base + 13 * step, base + 14 * step, base + 15 * step);
+  }
+  static Vec512<float> set(const Vec512<float>& a, const Vec512<float>& b,
+                           int64_t count = size()) {
+    if (count >= size()) {
+      return b;
+    }
+    return _mm512_mask_blend_ps(first_n(count), a.values, b.values);
+  }
+  static Vec512<float> loadu(const void* ptr, int64_t count = size()) {
+    if (count == size())
+      return _mm512_loadu_ps(reinterpret_cast<const float*>(ptr));
+    // Masked-off lanes are zeroed and never touch memory, so this is safe at
+    // the end of an allocation. See https://github.com/pytorch/pytorch/issues/32502
+    // for why the tail must not contain uninitialized values.
+    return _mm512_maskz_loadu_ps(first_n(count), ptr);
+  }
+  void store(void* ptr, int64_t count = size()) const {
+    if (count == size()) {
+      _mm512_storeu_ps(reinterpret_cast<float*>(ptr), values);
+    } else if (count > 0) {
+      _mm512_mask_storeu_ps(ptr, first_n(count), values);
+    }
+  }
+  const float& operator[](int idx) const  = delete;
+  float& operator[](int idx) = delete;
+  int zero_mask() const {
+    // returns an integer mask where all zero elements are translated to 1-bit and others are translated to 0-bit
+    return _mm512_cmp_ps_mask(values, _mm512_set1_ps(0), _CMP_EQ_OQ);
+  }
+  Vec512<float> map(float (*f)(float)) const {
+    __at_align64__ float tmp[size()];
+    store(tmp);
+    for (int64_t i = 0; i < size(); i++) {
+      tmp[i] = f(tmp[i]);
+    }
+    return loadu(tmp);
+  }
+  Vec512<float> abs() const {
+    return _mm512_abs_ps(values);
+  }
+  Vec512<float> angle() const {
+    return _mm512_set1_ps(0);
+  }
+  Vec512<float> real() const {
+    return *this;
+  }
+  Vec512<float> imag() const {
+    return _mm512_set1_ps(0);
+  }
+  Vec512<float> conj() const {
+    return *this;
+  }
+  Vec512<float> acos() const {
+    return Vec512<float>(Sleef_acosf16_u10(values));
+  }
+  Vec512<float> asin() const {
+    return Vec512<float>(Sleef_asinf16_u10(values));
+  }
+  Vec512<float> atan() const {
+    return Vec512<float>(Sleef_atanf16_u10(values));
+  }
+  Vec512<float> atan2(const Vec512<float> &b) const {
+    return Vec512<float>(Sleef_atan2f16_u10(values, b));
+  }
+  Vec512<float> erf() const {
+    return Vec512<float>(Sleef_erff16_u10(values));
+  }
+  Vec512<float> erfc() const {
+    return Vec512<float>(Sleef_erfcf16_u15(values));
+  }
+  Vec512<float> erfinv() const {
+    return map(calc_erfinv);
+  }
+  Vec512<float> exp() const {
+    return Vec512<float>(Sleef_expf16_u10(values));
+  }
+  Vec512<float> expm1() const {
+    return Vec512<float>(Sleef_expm1f16_u10(values));
+  }
+  Vec512<float> fmod(const Vec512<float>& q) const {
+    return Vec512<float>(Sleef_fmodf16(values, q));
+  }
+  Vec512<float> log() const {
+    return Vec512<float>(Sleef_logf16_u10(values));
+  }
+  Vec512<float> log2() const {
+    return Vec512<float>(Sleef_log2f16_u10(values));
+  }
+  Vec512<float> log10() const {
+    return Vec512<float>(Sleef_log10f16_u10(values));
+  }
+  Vec512<float> log1p() const {
+    return Vec512<float>(Sleef_log1pf16_u10(values));
+  }
+  Vec512<float> frac() const;
+  Vec512<float> sin() const {
+    return Vec512<float>(Sleef_sinf16_u10(values));
+  }
+  Vec512<float> sinh() const {
+    return Vec512<float>(Sleef_sinhf16_u10(values));
+  }
+  Vec512<float> cos() const {
+    return Vec512<float>(Sleef_cosf16_u10(values));
+  }
+  Vec512<float> cosh() const {
+    return Vec512<float>(Sleef_coshf16_u10(values));
+  }
+  Vec512<float> ceil() const {
+    return _mm512_roundscale_ps(values, (_MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+  }
+  Vec512<float> floor() const {
+    return _mm512_roundscale_ps(values, (_MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+  }
+  Vec512<float> neg() const {
+    return _mm512_xor_ps(_mm512_set1_ps(-0.f), values);
+  }
+  Vec512<float> round() const {
+    return _mm512_roundscale_ps(values, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+  }
+  Vec512<float> tan() const {
+    return Vec512<float>(Sleef_tanf16_u10(values));
+  }
+  Vec512<float> tanh() const {
+    return Vec512<float>(Sleef_tanhf16_u10(values));
+  }
+  Vec512<float> trunc() const {
+    return _mm512_roundscale_ps(values, (_MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+  }
+  Vec512<float> lgamma() const {
+    return Vec512<float>(Sleef_lgammaf16_u10(values));
+  }
+  Vec512<float> sqrt() const {
+    return _mm512_sqrt_ps(values);
+  }
+  Vec512<float> reciprocal() const {
+    return _mm512_div_ps(_mm512_set1_ps(1), values);
+  }
+  Vec512<float> rsqrt() const {
+    return _mm512_div_ps(_mm512_set1_ps(1), _mm512_sqrt_ps(values));
+  }
+  Vec512<float> pow(const Vec512<float> &b) const {
+    return Vec512<float>(Sleef_powf16_u10(values, b));
+  }
+  // Comparison using the _CMP_**_OQ predicate.
+  //   `O`: get false if an operand is NaN
+  //   `Q`: do not raise if an operand is NaN
+  Vec512<float> operator==(const Vec512<float>& other) const {
+    return mask_to_vec(_mm512_cmp_ps_mask(values, other.values, _CMP_EQ_OQ));
+  }
+
+  Vec512<float> operator!=(const Vec512<float>& other) const {
+    return mask_to_vec(_mm512_cmp_ps_mask(values, other.values, _CMP_NEQ_OQ));
+  }
+
+  Vec512<float> operator<(const Vec512<float>& other) const {
+    return mask_to_vec(_mm512_cmp_ps_mask(values, other.values, _CMP_LT_OQ));
+  }
+
+  Vec512<float> operator<=(const Vec512<float>& other) const {
+    return mask_to_vec(_mm512_cmp_ps_mask(values, other.values, _CMP_LE_OQ));
+  }
+
+  Vec512<float> operator>(const Vec512<float>& other) const {
+    return mask_to_vec(_mm512_cmp_ps_mask(values, other.values, _CMP_GT_OQ));
+  }
+
+  Vec512<float> operator>=(const Vec512<float>& other) const {
+    return mask_to_vec(_mm512_cmp_ps_mask(values, other.values, _CMP_GE_OQ));
+  }
+
+  Vec512<float> eq(const Vec512<float>& other) const;
+  Vec512<float> ne(const Vec512<float>& other) const;
+  Vec512<float> gt(const Vec512<float>& other) const;
+  Vec512<float> ge(const Vec512<float>& other) const;
+  Vec512<float> lt(const Vec512<float>& other) const;
+  Vec512<float> le(const Vec512<float>& other) const;
+};
+
+template <>
+Vec512<float> inline operator+(const Vec512<float>& a, const Vec512<float>& b) {
+  return _mm512_add_ps(a, b);
+}
+
+template <>
+Vec512<float> inline operator-(const Vec512<float>& a, const Vec512<float>& b) {
+  return _mm512_sub_ps(a, b);
+}
+
+template <>
+Vec512<float> inline operator*(const Vec512<float>& a, const Vec512<float>& b) {
+  return _mm512_mul_ps(a, b);
+}
+
+template <>
+Vec512<float> inline operator/(const Vec512<float>& a, const Vec512<float>& b) {
+  return _mm512_div_ps(a, b);
+}
+
+// frac. Implement this here so we can use subtraction
+Vec512<float> Vec512<float>::frac() const {
+  return *this - this->trunc();
+}
+
+// Implements the IEEE 754 201X `maximum` operation, which propagates NaN if
+// either input is a NaN.
+template <>
+Vec512<float> inline maximum(const Vec512<float>& a, const Vec512<float>& b) {
+  auto max = _mm512_max_ps(a, b);
+  auto isnan = _mm512_cmp_ps_mask(a, b, _CMP_UNORD_Q);
+  // Exploit the fact that all-ones is a NaN.
+  return _mm512_or_ps(max, _mm512_castsi512_ps(_mm512_movm_epi32(isnan)));
+}
+
+// Implements the IEEE 754 201X `minimum` operation, which propagates NaN if
+// either input is a NaN.
+template <>
+Vec512<float> inline minimum(const Vec512<float>& a, const Vec512<float>& b) {
+  auto min = _mm512_min_ps(a, b);
+  auto isnan = _mm512_cmp_ps_mask(a, b, _CMP_UNORD_Q);
+  // Exploit the fact that all-ones is a NaN.
+  return _mm512_or_ps(min, _mm512_castsi512_ps(_mm512_movm_epi32(isnan)));
+}
+
+template <>
+Vec512<float> inline clamp(const Vec512<float>& a, const Vec512<float>& min, const Vec512<float>& max) {
+  return _mm512_min_ps(max, _mm512_max_ps(min, a));
+}
+
+template <>
+Vec512<float> inline clamp_max(const Vec512<float>& a, const Vec512<float>& max) {
+  return _mm512_min_ps(max, a);
+}
+
+template <>
+Vec512<float> inline clamp_min(const Vec512<float>& a, const Vec512<float>& min) {
+  return _mm512_max_ps(min, a);
+}
+
+template <>
+Vec512<float> inline operator&(const Vec512<float>& a, const Vec512<float>& b) {
+  return _mm512_and_ps(a, b);
+}
+
+template <>
+Vec512<float> inline operator|(const Vec512<float>& a, const Vec512<float>& b) {
+  return _mm512_or_ps(a, b);
+}
+
+template <>
+Vec512<float> inline operator^(const Vec512<float>& a, const Vec512<float>& b) {
+  return _mm512_xor_ps(a, b);
+}
+
+Vec512<float> Vec512<float>::eq(const Vec512<float>& other) const {
+  return (*this == other) & Vec512<float>(1.0f);
+}
+
+Vec512<float> Vec512<float>::ne(const Vec512<float>& other) const {
+  return (*this != other) & Vec512<float>(1.0f);
+}
+
+Vec512<float> Vec512<float>::gt(const Vec512<float>& other) const {
+  return (*this > other) & Vec512<float>(1.0f);
+}
+
+Vec512<float> Vec512<float>::ge(const Vec512<float>& other) const {
+  return (*this >= other) & Vec512<float>(1.0f);
+}
+
+Vec512<float> Vec512<float>::lt(const Vec512<float>& other) const {
+  return (*this < other) & Vec512<float>(1.0f);
+}
+
+Vec512<float> Vec512<float>::le(const Vec512<float>& other) const {
+  return (*this <= other) & Vec512<float>(1.0f);
+}
+
+template <>
+Vec512<float> inline fmadd(const Vec512<float>& a, const Vec512<float>& b, const Vec512<float>& c) {
+  return _mm512_fmadd_ps(a, b, c);
+}
+
+#endif
+
+}}}
@@ -0,0 +1,429 @@
+#pragma once
+
+// DO NOT DEFINE STATIC DATA IN THIS HEADER!
+// See Note [Do not compile initializers with AVX]
+
+#include <ATen/cpu/vec512/vec512_base.h>
+#include <c10/macros/Macros.h>
+
+namespace at {
+namespace vec512 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+
+struct Vec512i {
+protected:
+  __m512i values;
+public:
+  Vec512i() {}
+  Vec512i(__m512i v) : values(v) {}
+  operator __m512i() const {
+    return values;
+  }
+};
+
+#else
+
+struct Vec512i {};  // dummy definition to make Vec512i always defined
+
+#endif // defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+
+#if defined(CPU_CAPABILITY_AVX512) && !defined(_MSC_VER)
+
+template <> struct is_vec512_native<int64_t> : std::true_type {};
+
+template <>
+class Vec512<int64_t> : public Vec512i {
+private:
+  static __mmask8 first_n(int64_t count) {
+    return static_cast<__mmask8>((1ULL << count) - 1);
+  }
+  static __m512i mask_to_vec(__mmask8 mask) {
+    return _mm512_movm_epi64(mask);
+  }
+public:
+  using value_type = int64_t;
+  static constexpr int size() {
+    return 8;
+  }
+  using Vec512i::Vec512i;
+  Vec512() {}
+  Vec512(int64_t v) { values = _mm512_set1_epi64(v); }
+  Vec512(int64_t val1, int64_t val2, int64_t val3, int64_t val4,
+         int64_t val5, int64_t val6, int64_t val7, int64_t val8) {
+    values = _mm512_setr_epi64(
+        val1, val2, val3, val4, val5, val6, val7, val8);
+  }
+  template <int64_t mask>
+  static Vec512<int64_t> blend(Vec512<int64_t> a, Vec512<int64_t> b) {
+    return _mm512_mask_blend_epi64(static_cast<__mmask8>(mask), a.values, b.values);
+  }
+  static Vec512<int64_t> blendv(const Vec512<int64_t>& a, const Vec512<int64_t>& b,
+                                const Vec512<int64_t>& mask) {
+    return _mm512_mask_blend_epi64(_mm512_movepi64_mask(mask.values), a.values, b.values);
+  }
+  template <typename step_t>
+  static Vec512<int64_t> arange(int64_t base = 0, step_t step = static_cast<step_t>(1)) {
+    return Vec512<int64_t>(
+      base, base + step, base + 2 * step, base + 3 * step,
+      base + 4 * step, base + 5 * step, base + 6 * step, base + 7 * step);
+  }
+  static Vec512<int64_t>
+  set(Vec512<int64_t> a, Vec512<int64_t> b, int64_t count = size()) {
+    if (count >= size()) {
+      return b;
+    }
+    return _mm512_mask_blend_epi64(first_n(count), a.values, b.values);
+  }
+  static Vec512<int64_t> loadu(const void* ptr) {
+    return _mm512_loadu_si512(ptr);
+  }
+  static Vec512<int64_t> loadu(const void* ptr, int64_t count) {
+    return _mm512_maskz_loadu_epi64(first_n(count), ptr);
+  }
+  void store(void* ptr, int count = size()) const {
+    if (count == size()) {
+      _mm512_storeu_si512(ptr, values);
+    } else if (count > 0) {
+      _mm512_mask_storeu_epi64(ptr, first_n(count), values);
+    }
+  }
+  const int64_t& operator[](int idx) const  = delete;
+  int64_t& operator[](int idx) = delete;
+  int zero_mask() const {
+    // returns an integer mask where all zero elements are translated to 1-bit and others are translated to 0-bit
+    return _mm512_cmpeq_epi64_mask(values, _mm512_setzero_si512());
+  }
+  Vec512<int64_t> abs() const {
+    return _mm512_abs_epi64(values);
+  }
+  Vec512<int64_t> angle() const {
+    return _mm512_setzero_si512();
+  }
+  Vec512<int64_t> real() const {
+    return *this;
+  }
+  Vec512<int64_t> imag() const {
+    return _mm512_setzero_si512();
+  }
+  Vec512<int64_t> conj() const {
+    return *this;
+  }
+  Vec512<int64_t> neg() const;
+  Vec512<int64_t> operator==(const Vec512<int64_t>& other) const {
+    return mask_to_vec(_mm512_cmpeq_epi64_mask(values, other.values));
+  }
+  Vec512<int64_t> operator!=(const Vec512<int64_t>& other) const {
+    return mask_to_vec(_mm512_cmpneq_epi64_mask(values, other.values));
+  }
+  Vec512<int64_t> operator<(const Vec512<int64_t>& other) const {
+    return mask_to_vec(_mm512_cmplt_epi64_mask(values, other.values));
+  }
+  Vec512<int64_t> operator<=(const Vec512<int64_t>& other) const {
+    return mask_to_vec(_mm512_cmple_epi64_mask(values, other.values));
+  }
+  Vec512<int64_t> operator>(const Vec512<int64_t>& other) const {
+    return mask_to_vec(_mm512_cmpgt_epi64_mask(values, other.values));
+  }
+  Vec512<int64_t> operator>=(const Vec512<int64_t>& other) const {
+    return mask_to_vec(_mm512_cmpge_epi64_mask(values, other.values));
+  }
+
+  Vec512<int64_t> eq(const Vec512<int64_t>& other) const;
+  Vec512<int64_t> ne(const Vec512<int64_t>& other) const;
+  Vec512<int64_t> gt(const Vec512<int64_t>& other) const;
+  Vec512<int64_t> ge(const Vec512<int64_t>& other) const;
+  Vec512<int64_t> lt(const Vec512<int64_t>& other) const;
+  Vec512<int64_t> le(const Vec512<int64_t>& other) const;
+};
+
+template <> struct is_vec512_native<int32_t> : std::true_type {};
+
+template <>
+class Vec512<int32_t> : public Vec512i {
+private:
+  static __mmask16 first_n(int64_t count) {
+    return static_cast<__mmask16>((1ULL << count) - 1);
+  }
+  static __m512i mask_to_vec(__mmask16 mask) {
+    return _mm512_movm_epi32(mask);
+  }
+public:
+  using value_type = int32_t;
+  static constexpr int size() {
+    return 16;
+  }
+  using Vec512i::Vec512i;
+  Vec512() {}
+  Vec512(int32_t v) { values = _mm512_set1_epi32(v); }
+  Vec512(int32_t val1, int32_t val2, int32_t val3, int32_t val4,
+         int32_t val5, int32_t val6, int32_t val7, int32_t val8,
+         int32_t val9, int32_t val10, int32_t val11, int32_t val12,
+         int32_t val13, int32_t val14, int32_t val15, int32_t val16) {
+    values = _mm512_setr_epi32(
+        val1, val2, val3, val4, val5, val6, val7, val8,
+        val9, val10, val11, val12, val13, val14, val15, val16);
+  }
+  template <int64_t mask>
+  static Vec512<int32_t> blend(Vec512<int32_t> a, Vec512<int32_t> b) {
+    return _mm512_mask_blend_epi32(static_cast<__mmask16>(mask), a.values, b.values);
+  }
+  static Vec512<int32_t> blendv(const Vec512<int32_t>& a, const Vec512<int32_t>& b,
+                                const Vec512<int32_t>& mask) {
+    return _mm512_mask_blend_epi32(_mm512_movepi32_mask(mask.values), a.values, b.values);
+  }
+  template <typename step_t>
+  static Vec512<int32_t> arange(int32_t base = 0, step_t step = static_cast<step_t>(1)) {
+    return Vec512<int32_t>(
+      base, base + step, base + 2 * step, base + 3 * step,
+      base + 4 * step, base + 5 * step, base + 6 * step, base + 7 * step,
+      base + 8 * step, base + 9 * step, base + 10 * step, base + 11 * step,
+      base + 12 * step, base + 13 * step, base + 14 * step, base + 15 * step);
+  }
+  static Vec512<int32_t>
+  set(Vec512<int32_t> a, Vec512<int32_t> b, int64_t count = size()) {
+    if (count >= size()) {
+      return b;
+    }
+    return _mm512_mask_blend_epi32(first_n(count), a.values, b.values);
+  }
+  static Vec512<int32_t> loadu(const void* ptr) {
+    return _mm512_loadu_si512(ptr);
+  }
+  static Vec512<int32_t> loadu(const void* ptr, int64_t count) {
+    return _mm512_maskz_loadu_epi32(first_n(count), ptr);
+  }
+  void store(void* ptr, int count = size()) const {
+    if (count == size()) {
+      _mm512_storeu_si512(ptr, values);
+    } else if (count > 0) {
+      _mm512_mask_storeu_epi32(ptr, first_n(count), values);
+    }
+  }
+  const int32_t& operator[](int idx) const  = delete;
+  int32_t& operator[](int idx) = delete;
+  int zero_mask() const {
+    // returns an integer mask where all zero elements are translated to 1-bit and others are translated to 0-bit
+    return _mm512_cmpeq_epi32_mask(values, _mm512_setzero_si512());
+  }
+  Vec512<int32_t> abs() const {
+    return _mm512_abs_epi32(values);
+  }
+  Vec512<int32_t> angle() const {
+    return _mm512_setzero_si512();
+  }
+  Vec512<int32_t> real() const {
+    return *this;
+  }
+  Vec512<int32_t> imag() const {
+    return _mm512_setzero_si512();
+  }
+  Vec512<int32_t> conj() const {
+    return *this;
+  }
+  Vec512<int32_t> neg() const;
+  Vec512<int32_t> operator==(const Vec512<int32_t>& other) const {
+    return mask_to_vec(_mm512_cmpeq_epi32_mask(values, other.values));
+  }
+  Vec512<int32_t> operator!=(const Vec512<int32_t>& other) const {
+    return mask_to_vec(_mm512_cmpneq_epi32_mask(values, other.values));
+  }
+  Vec512<int32_t> operator<(const Vec512<int32_t>& other) const {
+    return mask_to_vec(_mm512_cmplt_epi32_mask(values, other.values));
+  }
+  Vec512<int32_t> operator<=(const Vec512<int32_t>& other) const {
+    return mask_to_vec(_mm512_cmple_epi32_mask(values, other.values));
+  }
+  Vec512<int32_t> operator>(const Vec512<int32_t>& other) const {
+    return mask_to_vec(_mm512_cmpgt_epi32_mask(values, other.values));
+  }
+  Vec512<int32_t> operator>=(const Vec512<int32_t>& other) const {
+    return mask_to_vec(_mm512_cmpge_epi32_mask(values, other.values));
+  }
+
+  Vec512<int32_t> eq(const Vec512<int32_t>& other) const;
+  Vec512<int32_t> ne(const Vec512<int32_t>& other) const;
+  Vec512<int32_t> gt(const Vec512<int32_t>& other) const;
+  Vec512<int32_t> ge(const Vec512<int32_t>& other) const;
+  Vec512<int32_t> lt(const Vec512<int32_t>& other) const;
+  Vec512<int32_t> le(const Vec512<int32_t>& other) const;
+};
+
+template <typename T, typename Op>
+Vec512<T> inline int_elementwise_binary_512(const Vec512<T>& a, const Vec512<T>& b, Op op) {
+  __at_align64__ T values_a[Vec512<T>::size()];
+  __at_align64__ T values_b[Vec512<T>::size()];
+  a.store(values_a);
+  b.store(values_b);
+  for (int i = 0; i != Vec512<T>::size(); i++) {
+    values_a[i] = op(values_a[i], values_b[i]);
+  }
+  return Vec512<T>::loadu(values_a);
+}
+
+template<class T, typename std::enable_if_t<std::is_base_of<Vec512i, Vec512<T>>::value, int> = 0>
+Vec512<T> inline operator&(const Vec512<T>& a, const Vec512<T>& b) {
+  return _mm512_and_si512(a, b);
+}
+template<class T, typename std::enable_if_t<std::is_base_of<Vec512i, Vec512<T>>::value, int> = 0>
+Vec512<T> inline operator|(const Vec512<T>& a, const Vec512<T>& b) {
+  return _mm512_or_si512(a, b);
+}
+template<class T, typename std::enable_if_t<std::is_base_of<Vec512i, Vec512<T>>::value, int> = 0>
+Vec512<T> inline operator^(const Vec512<T>& a, const Vec512<T>& b) {
+  return _mm512_xor_si512(a, b);
+}
+
+template <>
+Vec512<int64_t> inline operator+(const Vec512<int64_t>& a, const Vec512<int64_t>& b) {
+  return _mm512_add_epi64(a, b);
+}
+
+template <>
+Vec512<int64_t> inline operator-(const Vec512<int64_t>& a, const Vec512<int64_t>& b) {
+  return _mm512_sub_epi64(a, b);
+}
+
+template <>
+Vec512<int64_t> inline operator*(const Vec512<int64_t>& a, const Vec512<int64_t>& b) {
+  return _mm512_mullo_epi64(a, b);
+}
+
+template <>
+Vec512<int64_t> inline operator/(const Vec512<int64_t>& a, const Vec512<int64_t>& b) {
+  return int_elementwise_binary_512(a, b, std::divides<int64_t>());
+}
+
+// Negation. Defined here so we can utilize operator-
+Vec512<int64_t> Vec512<int64_t>::neg() const {
+  return Vec512<int64_t>(0) - *this;
+}
+
+template <>
+Vec512<int64_t> inline minimum(const Vec512<int64_t>& a, const Vec512<int64_t>& b) {
+  return _mm512_min_epi64(a, b);
+}
+
+template <>
+Vec512<int64_t> inline maximum(const Vec512<int64_t>& a, const Vec512<int64_t>& b) {
+  return _mm512_max_epi64(a, b);
+}
+
+template <>
+Vec512<int64_t> inline clamp(const Vec512<int64_t>& a, const Vec512<int64_t>& min_val, const Vec512<int64_t>& max_val) {
+  return _mm512_min_epi64(max_val, _mm512_max_epi64(a, min_val));
+}
+
+template <>
+Vec512<int64_t> inline clamp_max(const Vec512<int64_t>& a, const Vec512<int64_t>& max_val) {
+  return _mm512_min_epi64(max_val, a);
+}
+
+template <>
+Vec512<int64_t> inline clamp_min(const Vec512<int64_t>& a, const Vec512<int64_t>& min_val) {
+  return _mm512_max_epi64(min_val, a);
+}
+
+Vec512<int64_t> Vec512<int64_t>::eq(const Vec512<int64_t>& other) const {
+  return (*this == other) & Vec512<int64_t>(1);
+}
+
+Vec512<int64_t> Vec512<int64_t>::ne(const Vec512<int64_t>& other) const {
+  return (*this != other) & Vec512<int64_t>(1);
+}
+
+Vec512<int64_t> Vec512<int64_t>::gt(const Vec512<int64_t>& other) const {
+  return (*this > other) & Vec512<int64_t>(1);
+}
+
+Vec512<int64_t> Vec512<int64_t>::ge(const Vec512<int64_t>& other) const {
+  return (*this >= other) & Vec512<int64_t>(1);
+}
+
+Vec512<int64_t> Vec512<int64_t>::lt(const Vec512<int64_t>& other) const {
+  return (*this < other) & Vec512<int64_t>(1);
+}
+
+Vec512<int64_t> Vec512<int64_t>::le(const Vec512<int64_t>& other) const {
+  return (*this <= other) & Vec512<int64_t>(1);
+}
+
+template <>
+Vec512<int32_t> inline operator+(const Vec512<int32_t>& a, const Vec512<int32_t>& b) {
+  return _mm512_add_epi32(a, b);
+}
+
+template <>
+Vec512<int32_t> inline operator-(const Vec512<int32_t>& a, const Vec512<int32_t>& b) {
+  return _mm512_sub_epi32(a, b);
+}
+
+template <>
+Vec512<int32_t> inline operator*(const Vec512<int32_t>& a, const Vec512<int32_t>& b) {
+  return _mm512_mullo_epi32(a, b);
+}
+
+template <>
+Vec512<int32_t> inline operator/(const Vec512<int32_t>& a, const Vec512<int32_t>& b) {
+  return int_elementwise_binary_512(a, b, std::divides<int32_t>());
+}
+
+// Negation. Defined here so we can utilize operator-
+Vec512<int32_t> Vec512<int32_t>::neg() const {
+  return Vec512<int32_t>(0) - *this;
+}
+
+template <>
+Vec512<int32_t> inline minimum(const Vec512<int32_t>& a, const Vec512<int32_t>& b) {
+  return _mm512_min_epi32(a, b);
+}
+
+template <>
+Vec512<int32_t> inline maximum(const Vec512<int32_t>& a, const Vec512<int32_t>& b) {
+  return _mm512_max_epi32(a, b);
+}
+
+template <>
+Vec512<int32_t> inline clamp(const Vec512<int32_t>& a, const Vec512<int32_t>& min_val, const Vec512<int32_t>& max_val) {
+  return _mm512_min_epi32(max_val, _mm512_max_epi32(a, min_val));
+}
+
+template <>
+Vec512<int32_t> inline clamp_max(const Vec512<int32_t>& a, const Vec512<int32_t>& max_val) {
+  return _mm512_min_epi32(max_val, a);
+}
+
+template <>
+Vec512<int32_t> inline clamp_min(const Vec512<int32_t>& a, const Vec512<int32_t>& min_val) {
+  return _mm512_max_epi32(min_val, a);
+}
+
+Vec512<int32_t> Vec512<int32_t>::eq(const Vec512<int32_t>& other) const {
+  return (*this == other) & Vec512<int32_t>(1);
+}
+
+Vec512<int32_t> Vec512<int32_t>::ne(const Vec512<int32_t>& other) const {
+  return (*this != other) & Vec512<int32_t>(1);
+}
+
+Vec512<int32_t> Vec512<int32_t>::gt(const Vec512<int32_t>& other) const {
+  return (*this > other) & Vec512<int32_t>(1);
+}
+
+Vec512<int32_t> Vec512<int32_t>::ge(const Vec512<int32_t>& other) const {
+  return (*this >= other) & Vec512<int32_t>(1);
+}
+
+Vec512<int32_t> Vec512<int32_t>::lt(const Vec512<int32_t>& other) const {
+  return (*this < other) & Vec512<int32_t>(1);
+}
+
+Vec512<int32_t> Vec512<int32_t>::le(const Vec512<int32_t>& other) const {
+  return (*this <= other) & Vec512<int32_t>(1);
+}
+
+#endif
+
+}}}
@@ -0,0 +1,118 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/native/Attention.h>
+
+#include <limits>
+#include <vector>
+
+namespace at { namespace native {
+
+DEFINE_DISPATCH(fused_attention_stub);
+DEFINE_DISPATCH(fused_attention_backward_stub);
+
+namespace {
+
+// The kernels hand blocks of rows of these tensors to gemm, which needs the
+// elements of a row to be contiguous and the rows not to overlap.
+Tensor rows_contiguous(const Tensor& t) {
+  const bool rows_ok = t.stride(-1) == 1 && (t.size(-2) <= 1 || t.stride(-2) >= t.size(-1));
+  return rows_ok ? t : t.contiguous();
+}
+
+void check_attention_inputs(const Tensor& query, const Tensor& key, const Tensor& value) {
+  TORCH_CHECK(query.dim() >= 3 && key.dim() == query.dim() && value.dim() == query.dim(),
+      "_fused_attention: expected query, key and value to have the same number of dimensions, "
+      "at least 3, but got ", query.dim(), ", ", key.dim(), " and ", value.dim());
+  TORCH_CHECK(query.sizes().slice(0, query.dim() - 2) == key.sizes().slice(0, key.dim() - 2) &&
+      query.sizes().slice(0, query.dim() - 2) == value.sizes().slice(0, value.dim() - 2),
+      "_fused_attention: expected query, key and value to have the same batch dimensions, but got ",
+      query.sizes(), ", ", key.sizes(), " and ", value.sizes());
+  TORCH_CHECK(query.size(-1) == key.size(-1),
+      "_fused_attention: expected query and key to have the same embedding size, but got ",
+      query.size(-1), " and ", key.size(-1));
+  TORCH_CHECK(key.size(-2) == value.size(-2),
+      "_fused_attention: expected key and value to have the same sequence length, but got ",
+      key.size(-2), " and ", value.size(-2));
+  TORCH_CHECK(query.scalar_type() == kFloat || query.scalar_type() == kDouble,
+      "_fused_attention: expected float or double inputs but got ", query.scalar_type());
+  TORCH_CHECK(key.scalar_type() == query.scalar_type() && value.scalar_type() == query.scalar_type(),
+      "_fused_attention: expected query, key and value to have the same dtype, but got ",
+      query.scalar_type(), ", ", key.scalar_type(), " and ", value.scalar_type());
+}
+
+// Returns attn_mask as an additive mask of the dtype of query, expanded to
+// [*, L, S]. See Note [Fused attention]
+Tensor expand_attention_mask(const Tensor& attn_mask, const Tensor& query, const Tensor& key) {
+  if (!attn_mask.defined()) {
+    return attn_mask;
+  }
+  Tensor mask = attn_mask;
+  if (mask.scalar_type() == kBool) {
+    mask = at::zeros(mask.sizes(), query.options()).masked_fill_(
+        mask, -std::numeric_limits<double>::infinity());
+  } else {
+    mask = mask.to(query.scalar_type());
+  }
+  std::vector<int64_t> sizes(query.sizes().begin(), query.sizes().end());
+  sizes.back() = key.size(-2);
+  return mask.expand(sizes);
+}
+
+} // namespace
+
+std::tuple<Tensor, Tensor> fused_attention_cpu(
+    const Tensor& query_, const Tensor& key_, const Tensor& value_, const Tensor& attn_mask,
+    double scale) {
+  check_attention_inputs(query_, key_, value_);
+  auto query = rows_contiguous(query_);
+  auto key = rows_contiguous(key_);
+  auto value = rows_contiguous(value_);
+  auto mask = expand_attention_mask(attn_mask, query, key);
+
+  // The output has the layout of query when it has the same shape, so that
+  // callers who permuted the heads out of a [L, *, E] tensor can permute them
+  // back without a copy.
+  std::vector<int64_t> output_sizes(query.sizes().begin(), query.sizes().end());
+  output_sizes.back() = value.size(-1);
+  Tensor output = query.sizes().equals(output_sizes)
+      ? at::empty_like(query, MemoryFormat::Preserve)
+      : at::empty(output_sizes, query.options());
+  Tensor logsumexp = at::empty(query.sizes().slice(0, query.dim() - 1), query.options());
+  if (output.numel() == 0) {
+    logsumexp.fill_(-std::numeric_limits<double>::infinity());
+    return std::make_tuple(output, logsumexp);
+  }
+  if (key.size(-2) == 0) {
+    output.zero_();
+    logsumexp.fill_(-std::numeric_limits<double>::infinity());
+    return std::make_tuple(output, logsumexp);
+  }
+  fused_attention_stub(kCPU, output, logsumexp, query, key, value, mask, scale);
+  return std::make_tuple(output, logsumexp);
+}
+
+std::tuple<Tensor, Tensor, Tensor> fused_attention_backward_cpu(
+    const Tensor& grad_out_, const Tensor& query_, const Tensor& key_, const Tensor& value_,
+    const Tensor& attn_mask, const Tensor& output_, const Tensor& logsumexp_, double scale) {
+  check_attention_inputs(query_, key_, value_);
+  auto grad_out = rows_contiguous(grad_out_);
+  auto query = rows_contiguous(query_);
+  auto key = rows_contiguous(key_);
+  auto value = rows_contiguous(value_);
+  auto output = rows_contiguous(output_);
+  auto logsumexp = logsumexp_.contiguous();
+  auto mask = expand_attention_mask(attn_mask, query, key);
+
+  // The kernel accumulates into the gradients.
+  Tensor grad_query = at::zeros(query.sizes(), query.options());
+  Tensor grad_key = at::zeros(key.sizes(), key.options());
+  Tensor grad_value = at::zeros(value.sizes(), value.options());
+  if (logsumexp.numel() == 0 || key.size(-2) == 0 || value.size(-1) == 0) {
+    return std::make_tuple(grad_query, grad_key, grad_value);
+  }
+  fused_attention_backward_stub(kCPU, grad_query, grad_key, grad_value, grad_out, query, key,
+      value, mask, output, logsumexp, scale);
+  return std::make_tuple(grad_query, grad_key, grad_value);
+}
+
+}} // namespace at::native
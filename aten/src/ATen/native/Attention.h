@@ -0,0 +1,39 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// Note [Fused attention]
+// ~~~~~~~~~~~~~~~~~~~~~~
+// _fused_attention computes softmax(query @ key^T * scale + attn_mask) @ value
+// for query [*, L, E], key [*, S, E] and value [*, S, Ev] without
+// materializing the [*, L, S] matrix of scores. The queries are split into
+// blocks of rows, and each block streams over blocks of keys keeping a running
+// maximum and sum of the exponentials of its rows (an "online" softmax): when
+// the maximum of a row grows, its sum and the partial output are rescaled.
+// The products of the blocks are gemms, and the (batch, query block) pairs are
+// computed in parallel.
+//
+// attn_mask is added to the scores and is broadcast to [*, L, S]; a bool mask
+// is converted to an additive one that is -inf where it is true. A row whose
+// scores are all -inf produces NaN, as softmax does.
+//
+// Besides the output, the forward returns the logsumexp of each row of
+// scores, so that the backward can recompute the softmax one block at a time
+// instead of saving it. The backward runs in parallel over the batch, since
+// the gradients of key and value sum over all the query blocks.
+
+using fused_attention_fn = void(*)(const Tensor& output, const Tensor& logsumexp,
+    const Tensor& query, const Tensor& key, const Tensor& value, const Tensor& attn_mask,
+    double scale);
+using fused_attention_backward_fn = void(*)(const Tensor& grad_query, const Tensor& grad_key,
+    const Tensor& grad_value, const Tensor& grad_out, const Tensor& query, const Tensor& key,
+    const Tensor& value, const Tensor& attn_mask, const Tensor& output,
+    const Tensor& logsumexp, double scale);
+
+DECLARE_DISPATCH(fused_attention_fn, fused_attention_stub);
+DECLARE_DISPATCH(fused_attention_backward_fn, fused_attention_backward_stub);
+
+}} // namespace at::native
@@ -1,13 +1,33 @@
 #include <limits>
 #include <algorithm>
+#include <type_traits>
 #include <ATen/ATen.h>
 #include <ATen/Config.h>
+#include <TH/THGeneral.h>
+
+#ifdef USE_FBGEMM
+#include <fbgemm/FbgemmI64.h>
+#endif // USE_FBGEMM
 
 #if AT_BUILD_WITH_BLAS()
+#ifdef BLAS_F2C
+# define ffloat double
+#else
+# define ffloat float
+#endif
+
 extern "C" void dscal_(int *n, double *a, double *x, int *incx);
 extern "C" void sscal_(int *n, float *a, float *x, int *incx);
 extern "C" void dgemv_(char *trans, int *m, int *n, double *alpha, double *a, int *lda, double *x, int *incx, double *beta, double *y, int *incy);
 extern "C" void sgemv_(char *trans, int *m, int *n, float *alpha, float *a, int *lda, float *x, int *incx, float *beta, float *y, int *incy);
+extern "C" void dgemm_(char *transa, char *transb, int *m, int *n, int *k, double *alpha, double *a, int *lda, double *b, int *ldb, double *beta, double *c, int *ldc);
+extern "C" void sgemm_(char *transa, char *transb, int *m, int *n, int *k, float *alpha, float *a, int *lda, float *b, int *ldb, float *beta, float *c, int *ldc);
+extern "C" double ddot_(int *n, double *x, int *incx, double *y, int *incy);
+#ifdef BLAS_USE_CBLAS_DOT
+extern "C" float cblas_sdot(const int n, const float *x, const int incx, const float *y, const int incy);
+#else
+extern "C" ffloat sdot_(int *n, float *x, int *incx, float *y, int *incy);
+#endif // BLAS_USE_CBLAS_DOT
 #endif // AT_BUILD_WITH_BLAS
 
 namespace at { namespace native {
@@ -24,6 +44,16 @@ bool gemv_use_fast_path(int64_t m, int64_t n, int64_t lda, int64_t incx, int64_t
   return false;
 }
 
+template <typename scalar_t>
+bool gemm_use_fast_path(bool transa, bool transb, int64_t m, int64_t n, int64_t k, int64_t lda, int64_t ldb, int64_t ldc) {
+  return false;
+}
+
+template <typename scalar_t>
+bool dot_use_fast_path(int64_t n, int64_t incx, int64_t incy) {
+  return false;
+}
+
 template <typename scalar_t>
 void scal_fast_path(int *n, scalar_t *a, scalar_t *x, int *incx) {
   TORCH_INTERNAL_ASSERT(false, "scal_fast_path shouldn't be called for this configuration");
@@ -34,10 +64,25 @@ void gemv_fast_path(char *trans, int *m, int *n, scalar_t *alpha, scalar_t *a, i
   TORCH_INTERNAL_ASSERT(false, "gemv_fast_path shouldn't be called for this configuration");
 }
 
+template <typename scalar_t>
+void gemm_fast_path(char *transa, char *transb, int *m, int *n, int *k, scalar_t *alpha, scalar_t *a, int *lda, scalar_t *b, int *ldb, scalar_t *beta, scalar_t *c, int *ldc) {
+  TORCH_INTERNAL_ASSERT(false, "gemm_fast_path shouldn't be called for this configuration");
+}
+
+template <typename scalar_t>
+scalar_t dot_fast_path(int *n, scalar_t *x, int *incx, scalar_t *y, int *incy) {
+  TORCH_INTERNAL_ASSERT(false, "dot_fast_path shouldn't be called for this configuration");
+  return scalar_t(0);
+}
+
 #define INSTANTIATE(scalar_t)                                                                                                                                                     \
 template bool scal_use_fast_path<scalar_t>(int64_t n, int64_t incx);                                                                                                              \
 template bool gemv_use_fast_path<scalar_t>(int64_t m, int64_t n, int64_t lda, int64_t incx, int64_t incy);                                                                        \
+template bool gemm_use_fast_path<scalar_t>(bool transa, bool transb, int64_t m, int64_t n, int64_t k, int64_t lda, int64_t ldb, int64_t ldc);                                     \
+template bool dot_use_fast_path<scalar_t>(int64_t n, int64_t incx, int64_t incy);                                                                                                 \
 template void gemv_fast_path<scalar_t>(char *trans, int *m, int *n, scalar_t *alpha, scalar_t *a, int *lda, scalar_t *x, int *incx, scalar_t *beta, scalar_t *y, int *incy);      \
+template void gemm_fast_path<scalar_t>(char *transa, char *transb, int *m, int *n, int *k, scalar_t *alpha, scalar_t *a, int *lda, scalar_t *b, int *ldb, scalar_t *beta, scalar_t *c, int *ldc); \
+template scalar_t dot_fast_path<scalar_t>(int *n, scalar_t *x, int *incx, scalar_t *y, int *incy);                                                                               \
 template void scal_fast_path<scalar_t>(int *n, scalar_t *a, scalar_t *x, int *incx);
 
 #if AT_BUILD_WITH_BLAS()
@@ -83,11 +128,70 @@ template <>
 void gemv_fast_path<float>(char *trans, int *m, int *n, float *alpha, float *a, int *lda, float *x, int *incx, float *beta, float *y, int *incy) {
   sgemv_(trans, m, n, alpha, a, lda, x, incx, beta, y, incy);
 }
+
+// Products with fewer multiply-adds than this are cheaper to compute with the
+// loops in gemm() below than to hand to the BLAS library, whose argument
+// checking, packing and threading setup would dominate. This is the typical
+// size of the matmuls in the cell of a small RNN run one token at a time.
+constexpr int64_t gemm_small_size = 4096;
+
+template <>
+bool gemm_use_fast_path<float>(bool transa, bool transb, int64_t m, int64_t n, int64_t k, int64_t lda, int64_t ldb, int64_t ldc) {
+  auto intmax = std::numeric_limits<int>::max();
+  const bool is_small = (m * n <= gemm_small_size) && (m * n * k <= gemm_small_size);
+  return !is_small &&
+         (m <= intmax) && (n <= intmax) && (k <= intmax) &&
+         (lda <= intmax) && (ldb <= intmax) && (ldc <= intmax) &&
+         (lda >= std::max<int64_t>(1L, transa ? k : m)) &&
+         (ldb >= std::max<int64_t>(1L, transb ? n : k)) &&
+         (ldc >= std::max<int64_t>(1L, m));
+}
+
+template <>
+bool gemm_use_fast_path<double>(bool transa, bool transb, int64_t m, int64_t n, int64_t k, int64_t lda, int64_t ldb, int64_t ldc) {
+  return gemm_use_fast_path<float>(transa, transb, m, n, k, lda, ldb, ldc);
+}
+
+template <>
+void gemm_fast_path<double>(char *transa, char *transb, int *m, int *n, int *k, double *alpha, double *a, int *lda, double *b, int *ldb, double *beta, double *c, int *ldc) {
+  dgemm_(transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+template <>
+void gemm_fast_path<float>(char *transa, char *transb, int *m, int *n, int *k, float *alpha, float *a, int *lda, float *b, int *ldb, float *beta, float *c, int *ldc) {
+  sgemm_(transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+template <>
+bool dot_use_fast_path<float>(int64_t n, int64_t incx, int64_t incy) {
+  auto intmax = std::numeric_limits<int>::max();
+  return (n <= intmax) && (incx <= intmax) && (incy <= intmax);
+}
+
+template <>
+bool dot_use_fast_path<double>(int64_t n, int64_t incx, int64_t incy) {
+  return dot_use_fast_path<float>(n, incx, incy);
+}
+
+template <>
+double dot_fast_path<double>(int *n, double *x, int *incx, double *y, int *incy) {
+  return ddot_(n, x, incx, y, incy);
+}
+
+template <>
+float dot_fast_path<float>(int *n, float *x, int *incx, float *y, int *incy) {
+#ifdef BLAS_USE_CBLAS_DOT
+  return cblas_sdot(*n, x, *incx, y, *incy);
+#else
+  return static_cast<float>(sdot_(n, x, incx, y, incy));
+#endif // BLAS_USE_CBLAS_DOT
+}
 #else
 INSTANTIATE(float);
 INSTANTIATE(double);
 #endif // AT_BUILD_WITH_BLAS
 
+INSTANTIATE(c10::Half);
 INSTANTIATE(uint8_t);
 INSTANTIATE(int8_t);
 INSTANTIATE(int16_t);
@@ -166,4 +270,144 @@ AT_FORALL_SCALAR_TYPES_AND(BFloat16, INSTANTIATE);
 AT_FORALL_COMPLEX_TYPES(INSTANTIATE);
 #undef INSTANTIATE
 
+// Column-major C = alpha * op(A) * op(B) + beta * C, where op(A) is m x k and
+// op(B) is k x n, with the same conventions as the reference BLAS. As there,
+// C is not read when beta is zero, so it may hold uninitialized values.
+//
+// The loops below are used for the types BLAS doesn't cover and for products
+// small enough that calling into BLAS costs more than the arithmetic. Each
+// case is ordered so that the innermost loop walks contiguous memory and can
+// be vectorized by the compiler.
+template <typename scalar_t>
+void gemm(char transa, char transb, int64_t m, int64_t n, int64_t k, scalar_t alpha, scalar_t *a, int64_t lda, scalar_t *b, int64_t ldb, scalar_t beta, scalar_t *c, int64_t ldc) {
+  const bool transa_ = (transa == 't') || (transa == 'T');
+  const bool transb_ = (transb == 't') || (transb == 'T');
+
+  if (n == 1) ldc = m;
+  if (transa_) {
+    if (m == 1) lda = k;
+  } else {
+    if (k == 1) lda = m;
+  }
+  if (transb_) {
+    if (k == 1) ldb = n;
+  } else {
+    if (n == 1) ldb = k;
+  }
+
+  if (blas_impl::gemm_use_fast_path<scalar_t>(transa_, transb_, m, n, k, lda, ldb, ldc)) {
+    int i_m = (int)m;
+    int i_n = (int)n;
+    int i_k = (int)k;
+    int i_lda = (int)lda;
+    int i_ldb = (int)ldb;
+    int i_ldc = (int)ldc;
+    blas_impl::gemm_fast_path<scalar_t>(&transa, &transb, &i_m, &i_n, &i_k, &alpha, a, &i_lda, b, &i_ldb, &beta, c, &i_ldc);
+    return;
+  }
+
+#ifdef USE_FBGEMM
+  if (std::is_same<scalar_t, int64_t>::value && alpha == scalar_t(1) &&
+      (beta == scalar_t(0) || beta == scalar_t(1))) {
+    // FBGEMM assumes row-major matrices, so compute C^T = op(B)^T * op(A)^T,
+    // which is C viewed as a row-major n x m matrix.
+    fbgemm::cblas_gemm_i64_i64acc(
+        transb_ ? fbgemm::matrix_op_t::Transpose : fbgemm::matrix_op_t::NoTranspose,
+        transa_ ? fbgemm::matrix_op_t::Transpose : fbgemm::matrix_op_t::NoTranspose,
+        n, m, k,
+        reinterpret_cast<const int64_t*>(b), ldb,
+        reinterpret_cast<const int64_t*>(a), lda,
+        beta == scalar_t(1),
+        reinterpret_cast<int64_t*>(c), ldc);
+    return;
+  }
+#endif // USE_FBGEMM
+
+  auto scale_c = [&]() {
+    for (int64_t j = 0; j < n; j++) {
+      scalar_t *c_col = c + j * ldc;
+      if (beta == scalar_t(0)) {
+        std::fill(c_col, c_col + m, scalar_t(0));
+      } else if (beta != scalar_t(1)) {
+        for (int64_t i = 0; i < m; i++) {
+          c_col[i] *= beta;
+        }
+      }
+    }
+  };
+
+  if (!transa_) {
+    // Column j of C accumulates the columns of A scaled by op(B)[:, j].
+    scale_c();
+    for (int64_t j = 0; j < n; j++) {
+      scalar_t *c_col = c + j * ldc;
+      for (int64_t l = 0; l < k; l++) {
+        const scalar_t val = alpha * (transb_ ? b[j + l * ldb] : b[l + j * ldb]);
+        const scalar_t *a_col = a + l * lda;
+        for (int64_t i = 0; i < m; i++) {
+          c_col[i] += a_col[i] * val;
+        }
+      }
+    }
+  } else if (!transb_) {
+    // Every entry of C is a dot product of two contiguous columns.
+    for (int64_t j = 0; j < n; j++) {
+      const scalar_t *b_col = b + j * ldb;
+      for (int64_t i = 0; i < m; i++) {
+        const scalar_t *a_row = a + i * lda;
+        scalar_t sum = 0;
+        for (int64_t l = 0; l < k; l++) {
+          sum += a_row[l] * b_col[l];
+        }
+        scalar_t &dst = c[j * ldc + i];
+        dst = beta == scalar_t(0) ? alpha * sum : beta * dst + alpha * sum;
+      }
+    }
+  } else {
+    // Row i of op(A) is contiguous; walk the rows of B^T along with it.
+    scale_c();
+    for (int64_t i = 0; i < m; i++) {
+      const scalar_t *a_row = a + i * lda;
+      for (int64_t l = 0; l < k; l++) {
+        const scalar_t val = alpha * a_row[l];
+        const scalar_t *b_row = b + l * ldb;
+        for (int64_t j = 0; j < n; j++) {
+          c[j * ldc + i] += val * b_row[j];
+        }
+      }
+    }
+  }
+}
+
+#define INSTANTIATE(scalar_t, _) \
+template void gemm<scalar_t>(char transa, char transb, int64_t m, int64_t n, int64_t k, scalar_t alpha, scalar_t *a, int64_t lda, scalar_t *b, int64_t ldb, scalar_t beta, scalar_t *c, int64_t ldc);
+AT_FORALL_SCALAR_TYPES_AND(BFloat16, INSTANTIATE);
+#undef INSTANTIATE
+
+template <typename scalar_t>
+scalar_t dot_impl(int64_t n, scalar_t *x, int64_t incx, scalar_t *y, int64_t incy) {
+  if (n == 1) {
+    incx = 1;
+    incy = 1;
+  }
+
+  if (blas_impl::dot_use_fast_path<scalar_t>(n, incx, incy)) {
+    int i_n = (int)n;
+    int i_incx = (int)incx;
+    int i_incy = (int)incy;
+    return blas_impl::dot_fast_path<scalar_t>(&i_n, x, &i_incx, y, &i_incy);
+  }
+
+  scalar_t sum = 0;
+  for (int64_t i = 0; i < n; i++) {
+    sum += x[i * incx] * y[i * incy];
+  }
+  return sum;
+}
+
+#define INSTANTIATE(scalar_t, _) \
+template scalar_t dot_impl<scalar_t>(int64_t n, scalar_t *x, int64_t incx, scalar_t *y, int64_t incy);
+AT_FORALL_SCALAR_TYPES_AND(Half, INSTANTIATE);
+#undef INSTANTIATE
+
 }} // namespace at::native
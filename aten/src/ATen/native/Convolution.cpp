@@ -1,6 +1,7 @@
 #include <limits>
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/native/ConvolutionCPU.h>
 #include <ATen/native/cpu/DepthwiseConvKernel.h>
 #include <ATen/native/utils/ParamUtils.h>
 #include <ATen/native/ConvUtils.h>
@@ -51,6 +52,8 @@ struct ConvParams {
   bool use_nnpack(const at::Tensor& input) const;
   bool use_xnnpack(const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) const;
   bool use_vulkan(const at::Tensor& input, const at::Tensor& weight) const;
+  bool use_cpu_winograd(const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) const;
+  bool use_cpu_direct(const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) const;
   bool is_depthwise(const at::Tensor& input, const at::Tensor& weight) const;
 };
 
@@ -292,6 +295,103 @@ auto ConvParams::use_vulkan(
 #endif
 }
 
+// Estimated costs, in multiply-adds, of the CPU algorithms for a 2d
+// convolution. See Note [CPU convolution algorithms]
+struct CPUConvolutionCosts {
+  double im2col;
+  double winograd;
+  double direct;
+};
+
+// Each element written to or read from memory costs about as much as this
+// many multiply-adds.
+constexpr double kMemoryCost = 8;
+// The direct loops against a tuned gemm.
+constexpr double kDirectConvolutionSlowdown = 2;
+// Operations of the Winograd transforms of a tile of one channel, and of a
+// filter.
+constexpr double kWinogradInputTransformCost = 144;
+constexpr double kWinogradOutputTransformCost = 96;
+constexpr double kWinogradFilterTransformCost = 72;
+
+static CPUConvolutionCosts cpu_convolution_costs(
+    const ConvParams& params, const at::Tensor& input, const at::Tensor& weight) {
+  const auto output_size = conv_output_size(input.sizes(), weight.sizes(), params.padding, params.stride);
+  const double batch_size = input.size(0);
+  const double in_channels = input.size(1);
+  const double out_channels = weight.size(0);
+  const double pixels = batch_size * output_size[2] * output_size[3];
+  const double kernel = weight.size(2) * weight.size(3);
+  const double macs = pixels * in_channels * out_channels * kernel;
+  // Both im2col and Winograd want a contiguous input.
+  const double relayout = input.is_contiguous() ? 0 : 2 * kMemoryCost * input.numel();
+
+  CPUConvolutionCosts costs;
+  // The unfolded input has kernel elements per output pixel and input
+  // channel, and is written and read back.
+  costs.im2col = macs + 2 * kMemoryCost * pixels * in_channels * kernel + relayout;
+  const double tiles = batch_size * ((output_size[2] + 3) / 4) * ((output_size[3] + 3) / 4);
+  costs.winograd = 36 * tiles * in_channels * out_channels +
+      tiles * (in_channels * kWinogradInputTransformCost + out_channels * kWinogradOutputTransformCost) +
+      2 * kMemoryCost * 36 * tiles * (in_channels + out_channels) +
+      in_channels * out_channels * kWinogradFilterTransformCost + relayout;
+  // The direct convolution only runs on channels-last inputs.
+  costs.direct = kDirectConvolutionSlowdown * macs;
+  return costs;
+}
+
+// Whether the algorithms of Note [CPU convolution algorithms] can compute
+// the convolution; _convolution only considers them where it would
+// otherwise use thnn_conv2d.
+static bool cpu_convolution2d_applies(
+    const ConvParams& params, const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) {
+  return input.device().is_cpu() && input.layout() == at::kStrided &&
+         weight.device().is_cpu() && weight.layout() == at::kStrided &&
+         input.ndimension() == 4 &&
+         weight.scalar_type() == input.scalar_type() &&
+         (!bias.defined() || bias.scalar_type() == input.scalar_type()) &&
+         !params.transposed &&
+         params.groups == 1 &&
+         !params.is_dilated() &&
+         !params.use_nnpack(input);
+}
+
+static bool cpu_winograd_applies(
+    const ConvParams& params, const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) {
+  // F(4x4, 3x3) loses a few bits of precision, which is not worth it in double.
+  return cpu_convolution2d_applies(params, input, weight, bias) &&
+         input.scalar_type() == at::kFloat &&
+         weight.size(2) == 3 && weight.size(3) == 3 &&
+         !params.is_strided();
+}
+
+static bool cpu_direct_applies(
+    const ConvParams& params, const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) {
+  return cpu_convolution2d_applies(params, input, weight, bias) &&
+         (input.scalar_type() == at::kFloat || input.scalar_type() == at::kDouble) &&
+         input.suggest_memory_format() == at::MemoryFormat::ChannelsLast;
+}
+
+auto ConvParams::use_cpu_winograd(
+    const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) const -> bool {
+  if (!cpu_winograd_applies(*this, input, weight, bias)) {
+    return false;
+  }
+  const auto costs = cpu_convolution_costs(*this, input, weight);
+  return costs.winograd < costs.im2col &&
+         (!cpu_direct_applies(*this, input, weight, bias) || costs.winograd <= costs.direct);
+}
+
+auto ConvParams::use_cpu_direct(
+    const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) const -> bool {
+  if (!cpu_direct_applies(*this, input, weight, bias)) {
+    return false;
+  }
+  const auto costs = cpu_convolution_costs(*this, input, weight);
+  return costs.direct < costs.im2col &&
+         (!cpu_winograd_applies(*this, input, weight, bias) || costs.direct < costs.winograd);
+}
+
 // We currently only have depthwise support for the case where groups ==
 // nInputPlane and nInputPlane == nOutputPlane (the latter due to the lack of
 // a depthwise multiplier)
@@ -773,6 +873,10 @@ at::Tensor _convolution(
         params.stride,
         params.padding,
         params.groups);
+  } else if (params.use_cpu_winograd(input, weight, bias)) {
+    output = at::_winograd_convolution2d(input, weight, bias, params.padding);
+  } else if (params.use_cpu_direct(input, weight, bias)) {
+    output = at::_direct_convolution2d(input, weight, bias, params.padding, params.stride);
   } else if (
         !params.transposed && (input.ndimension() == 5) &&
         (input.device().type() == c10::DeviceType::CPU) &&
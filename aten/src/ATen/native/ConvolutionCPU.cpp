@@ -0,0 +1,76 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/native/ConvUtils.h>
+#include <ATen/native/ConvolutionCPU.h>
+
+namespace at { namespace native {
+
+DEFINE_DISPATCH(winograd_convolution2d_stub);
+DEFINE_DISPATCH(direct_convolution2d_stub);
+
+namespace {
+
+void check_convolution2d_inputs(const char* name, const Tensor& input, const Tensor& weight,
+    const Tensor& bias, IntArrayRef padding, IntArrayRef stride) {
+  TORCH_CHECK(input.dim() == 4 && weight.dim() == 4,
+      name, ": expected a 4-d input and a 4-d weight, but got ", input.dim(), "-d and ",
+      weight.dim(), "-d");
+  TORCH_CHECK(input.size(1) == weight.size(1),
+      name, ": expected input with ", weight.size(1), " channels, but got ", input.size(1));
+  TORCH_CHECK(input.scalar_type() == kFloat || input.scalar_type() == kDouble,
+      name, ": expected a float or double input, but got ", input.scalar_type());
+  TORCH_CHECK(weight.scalar_type() == input.scalar_type(),
+      name, ": expected input and weight to have the same dtype, but got ",
+      input.scalar_type(), " and ", weight.scalar_type());
+  TORCH_CHECK(!bias.defined() || (bias.dim() == 1 && bias.numel() == weight.size(0) &&
+      bias.scalar_type() == input.scalar_type()),
+      name, ": expected a bias of ", weight.size(0), " elements of dtype ", input.scalar_type());
+  TORCH_CHECK(padding.size() == 2 && padding[0] >= 0 && padding[1] >= 0,
+      name, ": expected a non-negative padding of 2 elements, but got ", padding);
+  TORCH_CHECK(stride.size() == 2 && stride[0] > 0 && stride[1] > 0,
+      name, ": expected a positive stride of 2 elements, but got ", stride);
+  const auto output_size = conv_output_size(input.sizes(), weight.sizes(), padding, stride);
+  TORCH_CHECK(output_size[2] > 0 && output_size[3] > 0,
+      name, ": the input of size ", input.sizes(), " with padding ", padding,
+      " is smaller than the kernel of size ", weight.sizes().slice(2));
+}
+
+} // namespace
+
+Tensor winograd_convolution2d_cpu(
+    const Tensor& input_, const Tensor& weight_, const Tensor& bias_, IntArrayRef padding) {
+  check_convolution2d_inputs("_winograd_convolution2d", input_, weight_, bias_, padding, {1, 1});
+  TORCH_CHECK(weight_.size(2) == 3 && weight_.size(3) == 3,
+      "_winograd_convolution2d: expected a 3x3 kernel, but got ", weight_.sizes().slice(2));
+  auto input = input_.contiguous();
+  auto weight = weight_.contiguous();
+  auto bias = bias_.defined() ? bias_.contiguous() : bias_;
+
+  Tensor output = at::empty(
+      conv_output_size(input.sizes(), weight.sizes(), padding, {1, 1}), input.options());
+  if (output.numel() == 0) {
+    return output;
+  }
+  winograd_convolution2d_stub(kCPU, output, input, weight, bias, padding);
+  return output;
+}
+
+Tensor direct_convolution2d_cpu(
+    const Tensor& input_, const Tensor& weight_, const Tensor& bias_, IntArrayRef padding,
+    IntArrayRef stride) {
+  check_convolution2d_inputs("_direct_convolution2d", input_, weight_, bias_, padding, stride);
+  auto input = input_.contiguous(MemoryFormat::ChannelsLast);
+  auto weight = weight_.contiguous();
+  auto bias = bias_.defined() ? bias_.contiguous() : bias_;
+
+  Tensor output = at::empty(
+      conv_output_size(input.sizes(), weight.sizes(), padding, stride),
+      input.options().memory_format(MemoryFormat::ChannelsLast));
+  if (output.numel() == 0) {
+    return output;
+  }
+  direct_convolution2d_stub(kCPU, output, input, weight, bias, padding, stride);
+  return output;
+}
+
+}} // namespace at::native
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// Note [CPU convolution algorithms]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Without MKL-DNN or NNPACK, a 2d convolution on CPU is lowered to im2col and
+// a gemm (thnn_conv2d). The unfolded input is KH * KW times the size of the
+// input, and when there are few channels the gemm is too small to hide the
+// cost of writing and reading it. Two algorithms avoid the unfolded input:
+//
+//  - _winograd_convolution2d computes 3x3 convolutions of stride 1 with
+//    Winograd's F(4x4, 3x3). Each 6x6 tile of the input and each filter are
+//    transformed, the transformed tiles are multiplied with the transformed
+//    filters (36 small gemms, one per element of a tile), and the products
+//    are transformed back into 4x4 tiles of the output: 36 multiplications
+//    per tile and pair of channels instead of 144. The tiles are processed
+//    in blocks, so the transformed tiles stay in cache.
+//
+//  - _direct_convolution2d computes channels-last convolutions directly.
+//    A block of output pixels accumulates in registers over the filter,
+//    vectorized over the output channels, and nothing is materialized.
+//
+// _convolution estimates the cost of each algorithm, in multiply-adds, with
+// the elements moved through memory weighted by a fixed factor, and picks
+// the cheapest one. Both only have a forward; their gradients use
+// slow_conv_dilated2d_backward, as NNPACK's do.
+
+using winograd_convolution2d_fn = void(*)(const Tensor& output, const Tensor& input,
+    const Tensor& weight, const Tensor& bias, IntArrayRef padding);
+using direct_convolution2d_fn = void(*)(const Tensor& output, const Tensor& input,
+    const Tensor& weight, const Tensor& bias, IntArrayRef padding, IntArrayRef stride);
+
+DECLARE_DISPATCH(winograd_convolution2d_fn, winograd_convolution2d_stub);
+DECLARE_DISPATCH(direct_convolution2d_fn, direct_convolution2d_stub);
+
+}} // namespace at::native
@@ -11,6 +11,9 @@ namespace at { namespace native {
 static CPUCapability compute_cpu_capability() {
   auto envar = std::getenv("ATEN_CPU_CAPABILITY");
   if (envar) {
+    if (strcmp(envar, "avx512") == 0) {
+      return CPUCapability::AVX512;
+    }
     if (strcmp(envar, "avx2") == 0) {
       return CPUCapability::AVX2;
     }
@@ -25,6 +28,13 @@ static CPUCapability compute_cpu_capability() {
 
 #if !defined(__powerpc__) && !defined(__s390x__)
   if (cpuinfo_initialize()) {
+    // The AVX512 kernels use the F, BW, VL and DQ subsets; Xeon Phi parts
+    // that only implement F/CD/ER/PF fall through to AVX2.
+    if (cpuinfo_has_x86_avx512f() && cpuinfo_has_x86_avx512bw() &&
+        cpuinfo_has_x86_avx512vl() && cpuinfo_has_x86_avx512dq() &&
+        cpuinfo_has_x86_fma3()) {
+      return CPUCapability::AVX512;
+    }
     if (cpuinfo_has_x86_avx2() && cpuinfo_has_x86_fma3()) {
       return CPUCapability::AVX2;
     }
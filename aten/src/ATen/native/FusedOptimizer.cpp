@@ -0,0 +1,139 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/native/FusedOptimizer.h>
+
+#include <cmath>
+#include <vector>
+
+namespace at { namespace native {
+
+DEFINE_DISPATCH(fused_sgd_stub);
+DEFINE_DISPATCH(fused_adam_stub);
+DEFINE_DISPATCH(fused_adagrad_stub);
+DEFINE_DISPATCH(fused_rmsprop_stub);
+
+namespace {
+
+// Checks that tensors[i] can be updated together with self[i].
+// See Note [Fused optimizer kernels]
+void check_fused_list(const char* fn, TensorList self, TensorList tensors, const char* name) {
+  TORCH_CHECK(tensors.size() == self.size(),
+      fn, ": expected ", self.size(), " ", name, " but got ", tensors.size());
+  for (size_t i = 0; i < self.size(); i++) {
+    const Tensor& t = tensors[i];
+    TORCH_CHECK(t.device().is_cpu() && t.layout() == kStrided,
+        fn, ": expected ", name, "[", i, "] to be a dense CPU tensor");
+    TORCH_CHECK(t.scalar_type() == self[i].scalar_type(),
+        fn, ": expected ", name, "[", i, "] to have dtype ", self[i].scalar_type(),
+        " but got ", t.scalar_type());
+    TORCH_CHECK(t.is_contiguous(), fn, ": expected ", name, "[", i, "] to be contiguous");
+    TORCH_CHECK(t.numel() == self[i].numel(),
+        fn, ": expected ", name, "[", i, "] to have ", self[i].numel(),
+        " elements but got ", t.numel());
+  }
+}
+
+void check_fused_params(const char* fn, TensorList self, TensorList grads) {
+  for (size_t i = 0; i < self.size(); i++) {
+    TORCH_CHECK(at::isFloatingType(self[i].scalar_type()) &&
+        self[i].scalar_type() != kHalf && self[i].scalar_type() != kBFloat16,
+        fn, ": expected float or double parameters but got ", self[i].scalar_type());
+  }
+  check_fused_list(fn, self, self, "self");
+  check_fused_list(fn, self, grads, "grads");
+}
+
+void check_fused_steps(const char* fn, TensorList self, IntArrayRef steps) {
+  TORCH_CHECK(steps.size() == self.size(),
+      fn, ": expected ", self.size(), " steps but got ", steps.size());
+  for (size_t i = 0; i < steps.size(); i++) {
+    TORCH_CHECK(steps[i] > 0, fn, ": expected steps to be positive but got ", steps[i]);
+  }
+}
+
+// The kernels write through data pointers, so the version counters are
+// bumped here as the in-place ops they replace would.
+void bump_versions(TensorList tensors) {
+  for (const Tensor& t : tensors) {
+    t.unsafeGetTensorImpl()->bump_version();
+  }
+}
+
+} // namespace
+
+void _fused_sgd_cpu_(TensorList self, TensorList grads, TensorList momentum_buffers,
+    double lr, double momentum, double dampening, double weight_decay, bool nesterov, bool is_first_step) {
+  const char* fn = "_fused_sgd_";
+  check_fused_params(fn, self, grads);
+  if (momentum != 0) {
+    check_fused_list(fn, self, momentum_buffers, "momentum_buffers");
+  }
+  fused_sgd_stub(kCPU, self, grads, momentum_buffers, lr, momentum, dampening, weight_decay,
+      nesterov, is_first_step);
+  bump_versions(self);
+  bump_versions(momentum_buffers);
+}
+
+void _fused_adam_cpu_(TensorList self, TensorList grads, TensorList exp_avgs,
+    TensorList exp_avg_sqs, TensorList max_exp_avg_sqs, IntArrayRef steps, double lr,
+    double beta1, double beta2, double weight_decay, double eps, bool amsgrad) {
+  const char* fn = "_fused_adam_";
+  check_fused_params(fn, self, grads);
+  check_fused_list(fn, self, exp_avgs, "exp_avgs");
+  check_fused_list(fn, self, exp_avg_sqs, "exp_avg_sqs");
+  if (amsgrad) {
+    check_fused_list(fn, self, max_exp_avg_sqs, "max_exp_avg_sqs");
+  }
+  check_fused_steps(fn, self, steps);
+
+  std::vector<double> step_sizes(steps.size());
+  std::vector<double> bias_correction2_sqrts(steps.size());
+  for (size_t i = 0; i < steps.size(); i++) {
+    step_sizes[i] = lr / (1 - std::pow(beta1, steps[i]));
+    bias_correction2_sqrts[i] = std::sqrt(1 - std::pow(beta2, steps[i]));
+  }
+  fused_adam_stub(kCPU, self, grads, exp_avgs, exp_avg_sqs, max_exp_avg_sqs, step_sizes,
+      bias_correction2_sqrts, beta1, beta2, weight_decay, eps, amsgrad);
+  bump_versions(self);
+  bump_versions(exp_avgs);
+  bump_versions(exp_avg_sqs);
+  bump_versions(max_exp_avg_sqs);
+}
+
+void _fused_adagrad_cpu_(TensorList self, TensorList grads, TensorList state_sums,
+    IntArrayRef steps, double lr, double lr_decay, double weight_decay, double eps) {
+  const char* fn = "_fused_adagrad_";
+  check_fused_params(fn, self, grads);
+  check_fused_list(fn, self, state_sums, "state_sums");
+  check_fused_steps(fn, self, steps);
+
+  std::vector<double> clrs(steps.size());
+  for (size_t i = 0; i < steps.size(); i++) {
+    clrs[i] = lr / (1 + static_cast<double>(steps[i] - 1) * lr_decay);
+  }
+  fused_adagrad_stub(kCPU, self, grads, state_sums, clrs, weight_decay, eps);
+  bump_versions(self);
+  bump_versions(state_sums);
+}
+
+void _fused_rmsprop_cpu_(TensorList self, TensorList grads, TensorList square_avgs,
+    TensorList grad_avgs, TensorList momentum_buffers, double lr, double alpha, double eps,
+    double weight_decay, double momentum, bool centered) {
+  const char* fn = "_fused_rmsprop_";
+  check_fused_params(fn, self, grads);
+  check_fused_list(fn, self, square_avgs, "square_avgs");
+  if (centered) {
+    check_fused_list(fn, self, grad_avgs, "grad_avgs");
+  }
+  if (momentum > 0) {
+    check_fused_list(fn, self, momentum_buffers, "momentum_buffers");
+  }
+  fused_rmsprop_stub(kCPU, self, grads, square_avgs, grad_avgs, momentum_buffers, lr, alpha,
+      eps, weight_decay, momentum, centered);
+  bump_versions(self);
+  bump_versions(square_avgs);
+  bump_versions(grad_avgs);
+  bump_versions(momentum_buffers);
+}
+
+}} // namespace at::native
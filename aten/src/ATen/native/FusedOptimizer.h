@@ -0,0 +1,45 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// Note [Fused optimizer kernels]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The _fused_*_ functions apply one step of an optimizer to a list of
+// parameters, reading and writing each element of the parameter, its gradient
+// and its state once, instead of running a chain of pointwise ops per
+// parameter. They implement the same formulas as torch::optim, in the same
+// order, but the vectorized arithmetic can round differently from the
+// unfused ops.
+//
+// The elements of all the parameters are split into chunks that are updated
+// in parallel, so many small parameters are handled as well as a few large
+// ones. All the tensors of one parameter must be contiguous, with the same
+// number of elements and the same floating point dtype; the lists of optional
+// state (max_exp_avg_sqs, grad_avgs, momentum_buffers) are empty when the
+// option that needs them is off.
+//
+// Per-parameter scalars (bias corrections, learning rate decay) are computed
+// from the steps by the functions in FusedOptimizer.cpp and passed to the
+// kernels already evaluated.
+
+using fused_sgd_fn = void(*)(TensorList self, TensorList grads, TensorList momentum_buffers,
+    double lr, double momentum, double dampening, double weight_decay, bool nesterov, bool is_first_step);
+using fused_adam_fn = void(*)(TensorList self, TensorList grads, TensorList exp_avgs,
+    TensorList exp_avg_sqs, TensorList max_exp_avg_sqs, ArrayRef<double> step_sizes,
+    ArrayRef<double> bias_correction2_sqrts, double beta1, double beta2, double weight_decay,
+    double eps, bool amsgrad);
+using fused_adagrad_fn = void(*)(TensorList self, TensorList grads, TensorList state_sums,
+    ArrayRef<double> clrs, double weight_decay, double eps);
+using fused_rmsprop_fn = void(*)(TensorList self, TensorList grads, TensorList square_avgs,
+    TensorList grad_avgs, TensorList momentum_buffers, double lr, double alpha, double eps,
+    double weight_decay, double momentum, bool centered);
+
+DECLARE_DISPATCH(fused_sgd_fn, fused_sgd_stub);
+DECLARE_DISPATCH(fused_adam_fn, fused_adam_stub);
+DECLARE_DISPATCH(fused_adagrad_fn, fused_adagrad_stub);
+DECLARE_DISPATCH(fused_rmsprop_fn, fused_rmsprop_stub);
+
+}} // namespace at::native
@@ -5,7 +5,6 @@
 #include <ATen/native/LinearAlgebraUtils.h>
 #include <ATen/TensorUtils.h>
 #include <ATen/Parallel.h>
-#include <ATen/LegacyTHFunctionsCPU.h>
 #include <ATen/core/grad_mode.h>
 #include <functional>
 #include <numeric>
@@ -171,28 +170,183 @@ Tensor ger(const Tensor& self, const Tensor& vec2) {
   return result;
 }
 
+template<typename scalar_t>
+void gemm(char transa, char transb, int64_t m, int64_t n, int64_t k, scalar_t alpha, scalar_t *a, int64_t lda, scalar_t *b, int64_t ldb, scalar_t beta, scalar_t *c, int64_t ldc);
+
+// result = beta * self + alpha * (m1 @ m2), computed with a column-major gemm.
+// self must already have the shape of the product; it is not broadcast here.
+// When beta is zero self is ignored, so NaN and inf in it don't propagate.
+static void addmm_impl_cpu_(
+    Tensor &result, const Tensor &self, Tensor m1, Tensor m2, Scalar beta, Scalar alpha) {
+  TORCH_CHECK(m1.dim() == 2 && m2.dim() == 2,
+      "matrices expected, got ", m1.dim(), "D, ", m2.dim(), "D tensors");
+  TORCH_CHECK(m1.size(1) == m2.size(0),
+      "size mismatch, m1: ", m1.sizes(), ", m2: ", m2.sizes());
+  TORCH_CHECK(self.dim() == 2,
+      "matrix expected, got ", self.dim(), "D tensor for self");
+  TORCH_CHECK(self.size(0) == m1.size(0) && self.size(1) == m2.size(1),
+      "size mismatch, self: ", self.sizes(), ", m1: ", m1.sizes(), ", m2: ", m2.sizes());
+
+  if (!result.is_same(self)) {
+    result.resize_as_(self);
+    if (beta.to<double>() != 0.0) {
+      result.copy_(self);
+    }
+  }
+
+  if (result.numel() == 0) {
+    return;
+  }
+
+  // A matrix can be handed to gemm as is if it is column-major or, as the
+  // transpose of a column-major matrix, row-major, with a leading dimension
+  // large enough for BLAS (ld >= max(1, rows), unless there is one column).
+  auto ld_cond = [](int64_t rows, int64_t cols, int64_t ld) {
+    return cols == 1 || ld >= std::max<int64_t>(1, rows);
+  };
+
+  // A row-major result is computed as result^T = m2^T @ m1^T.
+  bool transpose_c = false;
+  Tensor c;
+  if (result.stride(0) == 1 && ld_cond(result.size(0), result.size(1), result.stride(1))) {
+    c = result;
+  } else if (result.stride(1) == 1 && ld_cond(result.size(1), result.size(0), result.stride(0))) {
+    std::swap(m1, m2);
+    transpose_c = true;
+    c = result;
+  } else {
+    // make c column-major
+    c = result.transpose(0, 1).contiguous().transpose_(0, 1);
+  }
+
+  const int64_t row_dim = transpose_c ? 1 : 0;
+  const int64_t col_dim = transpose_c ? 0 : 1;
+  const int64_t m = c.size(row_dim);
+  const int64_t n = c.size(col_dim);
+  const int64_t k = m1.size(col_dim);
+  const int64_t ldc = c.stride(col_dim);
+
+  // Returns the matrix to pass for op (m1 or m2), whether it is transposed,
+  // and its leading dimension, copying it if neither layout fits.
+  auto prepare = [&](const Tensor& op, int64_t rows, int64_t cols) {
+    if (op.stride(row_dim) == 1 && op.stride(col_dim) >= std::max<int64_t>(1, rows)) {
+      return std::make_tuple(op, false, op.stride(col_dim));
+    } else if (op.stride(col_dim) == 1 && op.stride(row_dim) >= std::max<int64_t>(1, cols)) {
+      return std::make_tuple(op, true, op.stride(row_dim));
+    }
+    Tensor op_c = op.contiguous();
+    return std::make_tuple(op_c, !transpose_c, op_c.stride(transpose_c ? col_dim : row_dim));
+  };
+
+  Tensor a, b;
+  bool transpose_a, transpose_b;
+  int64_t lda, ldb;
+  std::tie(a, transpose_a, lda) = prepare(m1, m, k);
+  std::tie(b, transpose_b, ldb) = prepare(m2, k, n);
+
+  AT_DISPATCH_ALL_TYPES_AND(kBFloat16, result.scalar_type(), "addmm_impl_cpu_", [&] {
+    gemm<scalar_t>(
+        transpose_a ? 't' : 'n',
+        transpose_b ? 't' : 'n',
+        m, n, k,
+        alpha.to<scalar_t>(),
+        a.data_ptr<scalar_t>(), lda,
+        b.data_ptr<scalar_t>(), ldb,
+        beta.to<scalar_t>(),
+        c.data_ptr<scalar_t>(), ldc);
+  });
+
+  if (!c.is_same(result)) {
+    result.copy_(c);
+  }
+}
+
+static void addbmm_impl_cpu_(
+    Tensor &result, const Tensor &self, const Tensor &batch1, const Tensor &batch2, Scalar beta, Scalar alpha) {
+  TORCH_CHECK(batch1.dim() == 3, "batch1 must be a 3D tensor");
+  TORCH_CHECK(batch2.dim() == 3, "batch2 must be a 3D tensor");
+  TORCH_CHECK(batch1.size(0) == batch2.size(0),
+      "batch1 and batch2 must have same number of batches, got ",
+      batch1.size(0), " and ", batch2.size(0));
+  TORCH_CHECK(batch1.size(2) == batch2.size(1),
+      "Incompatible matrix sizes for bmm (",
+      batch1.size(1), "x", batch1.size(2), " and ",
+      batch2.size(1), "x", batch2.size(2), ")");
+  TORCH_CHECK(self.dim() == 2 && self.size(0) == batch1.size(1) && self.size(1) == batch2.size(2),
+      "self tensor does not match matmul output shape");
+
+  const int64_t num_batches = batch1.size(0);
+  if (num_batches == 0) {
+    if (!result.is_same(self)) {
+      result.resize_as_(self);
+      result.copy_(self);
+    }
+    if (beta.to<double>() == 0.0) {
+      result.zero_();
+    } else if (beta.to<double>() != 1.0) {
+      result.mul_(beta);
+    }
+    return;
+  }
+
+  for (int64_t batch = 0; batch < num_batches; ++batch) {
+    addmm_impl_cpu_(result, batch == 0 ? self : result, batch1[batch], batch2[batch], beta, alpha);
+    beta = 1; // accumulate output once
+  }
+}
+
 Tensor addbmm_cpu(const Tensor& self, const Tensor& batch1, const Tensor& batch2, Scalar beta, Scalar alpha) {
-  Tensor b_self;
-  std::tie(b_self) = expand_size(self, {batch1.size(1), batch2.size(2)}, "addbmm");
-  return legacy::cpu::_th_addbmm(b_self, batch1, batch2, beta, alpha);
+  Tensor result = at::empty({0}, self.options());
+  return addbmm_cpu_out(result, self, batch1, batch2, beta, alpha);
 }
 
 Tensor& addbmm_cpu_out(Tensor& result, const Tensor& self, const Tensor& batch1, const Tensor& batch2, Scalar beta, Scalar alpha) {
   Tensor b_self;
   std::tie(b_self) = expand_size(self, {batch1.size(1), batch2.size(2)}, "addbmm_out");
-  return legacy::cpu::_th_addbmm_out(result, b_self, batch1, batch2, beta, alpha);
+  {
+    at::NoNamesGuard guard;
+    addbmm_impl_cpu_(result, b_self, batch1, batch2, beta, alpha);
+  }
+  return result;
+}
+
+Tensor& addbmm__cpu(Tensor& self, const Tensor& batch1, const Tensor& batch2, Scalar beta, Scalar alpha) {
+  {
+    at::NoNamesGuard guard;
+    addbmm_impl_cpu_(self, self, batch1, batch2, beta, alpha);
+  }
+  return self;
 }
 
 Tensor addmm_cpu(const Tensor& self, const Tensor& mat1, const Tensor& mat2, Scalar beta, Scalar alpha) {
-  Tensor b_self;
-  std::tie(b_self) = expand_size(self, {mat1.size(0), mat2.size(1)}, "addmm");
-  return legacy::cpu::_th_addmm(b_self, mat1, mat2, beta, alpha);
+  Tensor result = at::empty({0}, self.options());
+  return addmm_cpu_out(result, self, mat1, mat2, beta, alpha);
 }
 
 Tensor& addmm_cpu_out(Tensor &result, const Tensor& self, const Tensor& mat1, const Tensor& mat2, Scalar beta, Scalar alpha) {
+  TORCH_CHECK(mat1.dim() == 2 && mat2.dim() == 2,
+      "matrices expected, got ", mat1.dim(), "D, ", mat2.dim(), "D tensors");
   Tensor b_self;
   std::tie(b_self) = expand_size(self, {mat1.size(0), mat2.size(1)}, "addmm_out");
-  return legacy::cpu::_th_addmm_out(result, b_self, mat1, mat2, beta, alpha);
+  {
+    at::NoNamesGuard guard;
+    addmm_impl_cpu_(result, b_self, mat1, mat2, beta, alpha);
+  }
+  at::namedinference::propagate_names_for_addmm(
+      result.unsafeGetTensorImpl(), mat1.unsafeGetTensorImpl(),
+      mat2.unsafeGetTensorImpl(), b_self.unsafeGetTensorImpl());
+  return result;
+}
+
+Tensor& addmm__cpu(Tensor& self, const Tensor& mat1, const Tensor& mat2, Scalar beta, Scalar alpha) {
+  {
+    at::NoNamesGuard guard;
+    addmm_impl_cpu_(self, self, mat1, mat2, beta, alpha);
+  }
+  at::namedinference::propagate_names_for_addmm(
+      self.unsafeGetTensorImpl(), mat1.unsafeGetTensorImpl(),
+      mat2.unsafeGetTensorImpl(), self.unsafeGetTensorImpl());
+  return self;
 }
 
 Tensor mm_cpu(const Tensor & self, const Tensor & mat2) {
@@ -201,8 +355,41 @@ Tensor mm_cpu(const Tensor & self, const Tensor & mat2) {
 }
 
 Tensor& mm_cpu_out(Tensor & result, const Tensor & self, const Tensor & mat2) {
+  TORCH_CHECK(self.dim() == 2 && mat2.dim() == 2,
+      "matrices expected, got ", self.dim(), "D, ", mat2.dim(), "D tensors");
   result.resize_({ self.size(0), mat2.size(1) });
-  return legacy::cpu::_th_addmm_out(result, result, self, mat2, 0, 1);
+  {
+    at::NoNamesGuard guard;
+    addmm_impl_cpu_(result, result, self, mat2, 0, 1);
+  }
+  at::namedinference::propagate_names_for_addmm(
+      result.unsafeGetTensorImpl(), self.unsafeGetTensorImpl(),
+      mat2.unsafeGetTensorImpl(), result.unsafeGetTensorImpl());
+  return result;
+}
+
+static void addr_impl_cpu_(
+    Tensor &result, const Tensor &self, const Tensor& vec1, const Tensor& vec2, Scalar beta, Scalar alpha) {
+  TORCH_CHECK(vec1.dim() == 1 && vec2.dim() == 1,
+      "vector and vector expected, got ", vec1.dim(), "D, ", vec2.dim(), "D tensors");
+  // The outer product is a matrix product with an inner dimension of 1.
+  addmm_impl_cpu_(result, self, vec1.unsqueeze(1), vec2.unsqueeze(0), beta, alpha);
+}
+
+Tensor _addr_cpu(const Tensor& self, const Tensor& vec1, const Tensor& vec2, Scalar beta, Scalar alpha) {
+  Tensor result = at::empty({0}, self.options());
+  addr_impl_cpu_(result, self, vec1, vec2, beta, alpha);
+  return result;
+}
+
+Tensor& _addr__cpu(Tensor& self, const Tensor& vec1, const Tensor& vec2, Scalar beta, Scalar alpha) {
+  addr_impl_cpu_(self, self, vec1, vec2, beta, alpha);
+  return self;
+}
+
+Tensor& _addr_out_cpu(Tensor& result, const Tensor& self, const Tensor& vec1, const Tensor& vec2, Scalar beta, Scalar alpha) {
+  addr_impl_cpu_(result, self, vec1, vec2, beta, alpha);
+  return result;
 }
 
 template <typename scalar_t, bool is_bmm>
@@ -669,6 +669,16 @@ struct Cell {
       bool pre_compute_input = false) const = 0;
 };
 
+// The fused CPU pointwise kernels skip autograd, so only use them when
+// nothing needs a gradient, e.g. for the dynamically quantized RNNs.
+bool use_fused_cpu_cell(const Tensor& gates, const Tensor& hidden) {
+  return gates.device().is_cpu() && hidden.device().is_cpu() &&
+      gates.dim() == 2 && hidden.dim() == 2 &&
+      (gates.scalar_type() == kFloat || gates.scalar_type() == kDouble) &&
+      gates.scalar_type() == hidden.scalar_type() &&
+      !gates.requires_grad() && !hidden.requires_grad();
+}
+
 template<typename nonlinearity, typename cell_params>
 struct SimpleCell : Cell<Tensor, cell_params> {
   using hidden_type = Tensor;
@@ -707,6 +717,14 @@ struct LSTMCell : Cell<std::tuple<Tensor, Tensor>, cell_params> {
 
     const auto gates = params.linear_hh(hx).add_(
         pre_compute_input ? input : params.linear_ih(input));
+    if (use_fused_cpu_cell(gates, cx)) {
+      auto gates_contig = gates.contiguous();
+      auto cx_contig = cx.contiguous();
+      auto hy = at::empty_like(cx_contig);
+      auto cy = at::empty_like(cx_contig);
+      lstm_cell_pointwise_stub(kCPU, hy, cy, gates_contig, cx_contig);
+      return std::make_tuple(std::move(hy), std::move(cy));
+    }
     auto chunked_gates = gates.chunk(4, 1);
     auto ingate = chunked_gates[0].sigmoid_();
     auto forgetgate = chunked_gates[1].sigmoid_();
@@ -737,10 +755,19 @@ struct GRUCell : Cell<Tensor, cell_params> {
       // Slice off the workspace argument (it's needed only for AD).
       return std::move(std::get<0>(result));
     }
-    const auto chunked_igates = pre_compute_input
-        ? input.chunk(3, 1)
-        : params.linear_ih(input).chunk(3, 1);
-    auto chunked_hgates = params.linear_hh(hidden).chunk(3, 1);
+    const auto igates = pre_compute_input ? input : params.linear_ih(input);
+    const auto hgates = params.linear_hh(hidden);
+    if (use_fused_cpu_cell(igates, hidden) && !hgates.requires_grad()) {
+      auto igates_contig = igates.contiguous();
+      auto hgates_contig = hgates.contiguous();
+      auto hidden_contig = hidden.contiguous();
+      auto hy = at::empty_like(hidden_contig);
+      gru_cell_pointwise_stub(
+          kCPU, hy, igates_contig, hgates_contig, hidden_contig);
+      return hy;
+    }
+    const auto chunked_igates = igates.chunk(3, 1);
+    auto chunked_hgates = hgates.chunk(3, 1);
     const auto reset_gate =
         chunked_hgates[0].add_(chunked_igates[0]).sigmoid_();
     const auto input_gate =
@@ -1383,6 +1410,8 @@ ONE_HIDDEN_RNN(rnn_tanh, tanf_cell_type)
 using relu_cell_type = SimpleCell<relu_f, CellParams>;
 ONE_HIDDEN_RNN(rnn_relu, relu_cell_type);
 
+DEFINE_DISPATCH(lstm_cell_pointwise_stub);
+DEFINE_DISPATCH(gru_cell_pointwise_stub);
 DEFINE_DISPATCH(lstm_cudnn_stub);
 DEFINE_DISPATCH(lstm_packed_cudnn_stub);
 DEFINE_DISPATCH(lstm_miopen_stub);
@@ -9,6 +9,9 @@ using lstm_fn = void(*)(Tensor&, Tensor&, Tensor&, const Tensor&, TensorList, Te
 using rnn_fn = void(*)(Tensor&, Tensor&, const Tensor&, const Tensor&, TensorList, bool, int64_t, double, bool, bool, bool);
 using lstm_packed_fn = void(*)(Tensor&, Tensor&, Tensor&, const Tensor&, const Tensor&, TensorList, TensorList, bool, int64_t, double, bool, bool);
 using rnn_packed_fn = void(*)(Tensor&, Tensor&, const Tensor&, const Tensor&, const Tensor&, TensorList, bool, int64_t, double, bool, bool);
+// Fused, non-differentiable CPU cell pointwise math: (hy, cy, gates, cx) and (hy, igates, hgates, hx)
+using lstm_cell_pointwise_fn = void(*)(Tensor&, Tensor&, const Tensor&, const Tensor&);
+using gru_cell_pointwise_fn = void(*)(Tensor&, const Tensor&, const Tensor&, const Tensor&);
 
 DECLARE_DISPATCH(lstm_fn, lstm_cudnn_stub);
 DECLARE_DISPATCH(lstm_fn, lstm_miopen_stub);
@@ -26,6 +29,8 @@ DECLARE_DISPATCH(rnn_packed_fn, rnn_tanh_packed_cudnn_stub);
 DECLARE_DISPATCH(rnn_packed_fn, rnn_tanh_packed_miopen_stub);
 DECLARE_DISPATCH(rnn_packed_fn, rnn_relu_packed_cudnn_stub);
 DECLARE_DISPATCH(rnn_packed_fn, rnn_relu_packed_miopen_stub);
+DECLARE_DISPATCH(lstm_cell_pointwise_fn, lstm_cell_pointwise_stub);
+DECLARE_DISPATCH(gru_cell_pointwise_fn, gru_cell_pointwise_stub);
 
 inline void check_device(const Tensor& input, const TensorList& params, const TensorList& hiddens) {
   auto input_device = input.device();
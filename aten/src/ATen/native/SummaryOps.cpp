@@ -2,11 +2,15 @@
 
 #include <ATen/ATen.h>
 #include <ATen/Dispatch.h>
+#include <ATen/native/SummaryOps.h>
 
+#include <cmath>
 #include <tuple>
 
 namespace at { namespace native {
 
+DEFINE_DISPATCH(histc_stub);
+
 ///////////////// bincount /////////////////
 namespace {
 
@@ -65,4 +69,34 @@ _bincount_cpu(const Tensor& self, const Tensor& weights, int64_t minlength) {
   });
 }
 
+///////////////// histc /////////////////
+Tensor& _histc_out_cpu(Tensor& hist, const Tensor& self, int64_t nbins, Scalar min, Scalar max) {
+  TORCH_CHECK(nbins > 0, "bins must be > 0");
+  TORCH_CHECK(hist.scalar_type() == self.scalar_type(),
+              "histc(): expected out to have dtype ", self.scalar_type(), ", but got ", hist.scalar_type());
+  hist.resize_({nbins});
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "histc_cpu", [&] {
+    scalar_t minval = min.to<scalar_t>();
+    scalar_t maxval = max.to<scalar_t>();
+    if (minval == maxval) {
+      minval = self.min().item<scalar_t>();
+      maxval = self.max().item<scalar_t>();
+    }
+    if (minval == maxval) {
+      minval = minval - 1;
+      maxval = maxval + 1;
+    }
+    TORCH_CHECK(!(std::isinf(minval) || std::isinf(maxval) || std::isnan(minval) || std::isnan(maxval)),
+                "range of [", minval, ", ", maxval, "] is not finite");
+    TORCH_CHECK(minval < maxval, "max must be larger than min");
+    histc_stub(kCPU, hist, self.contiguous(), minval, maxval);
+  });
+  return hist;
+}
+
+Tensor _histc_cpu(const Tensor& self, int64_t nbins, Scalar min, Scalar max) {
+  Tensor hist = at::empty({0}, self.options());
+  return _histc_out_cpu(hist, self, nbins, min, max);
+}
+
 }} // namespace at::native
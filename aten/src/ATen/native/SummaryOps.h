@@ -0,0 +1,12 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+using histc_fn = void(*)(Tensor& hist, const Tensor& self, Scalar min, Scalar max);
+
+DECLARE_DISPATCH(histc_fn, histc_stub);
+
+}} // namespace at::native
@@ -57,6 +57,7 @@
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/BinaryOps.h>
 #include <ATen/native/Copy.h>
+#include <ATen/native/cpu/IndexAccumulate.h>
 #include <ATen/Parallel.h>
 
 #include <algorithm>
@@ -73,6 +74,7 @@ DEFINE_DISPATCH(masked_fill_stub);
 REGISTER_NO_CPU_DISPATCH(index_put_accum_stub, index_put_accum_fn);
 DEFINE_DISPATCH(masked_select_serial_stub);
 DEFINE_DISPATCH(masked_select_stub);
+DEFINE_DISPATCH(nonzero_stub);
 
 DEFINE_DISPATCH(gather_stub);
 DEFINE_DISPATCH(scatter_stub);
@@ -354,6 +356,11 @@ Tensor& index_add_cpu_(Tensor & self, int64_t dim, const Tensor & index, const T
   auto index_contig = index.contiguous();
   auto index_data = index_contig.data_ptr<int64_t>();
 
+  // Different indices may name the same slice of self, so the additions are
+  // only run on several threads after grouping them by destination (see
+  // IndexAccumulate.h), which keeps the result identical to the serial loop.
+  const bool use_parallel_for = numel > 1 && at::get_num_threads() > 1 && !at::in_parallel_region();
+
   if (self.dim() > 1) {
     // Equivalent to:
     //   for (auto i = 0; i < numel; i++) {
@@ -372,15 +379,38 @@ Tensor& index_add_cpu_(Tensor & self, int64_t dim, const Tensor & index, const T
     auto self_dim_size = self.size(dim);
     auto iter = TensorIterator::binary_op(selfSlice, selfSlice, sourceSlice);
 
-    for (auto i = 0; i < numel; i++) {
-      auto self_i = index_data[i];
-      TORCH_CHECK_INDEX((self_i >= 0) && (self_i < self_dim_size), "index out of range in self");
-      auto self_data = static_cast<char*>(selfSlice.data_ptr()) + self_i * self_stride_bytes;
-      auto source_data = static_cast<char*>(sourceSlice.data_ptr()) + i * source_stride_bytes;
-      iter.unsafe_replace_operand(0, self_data);
-      iter.unsafe_replace_operand(1, self_data);
-      iter.unsafe_replace_operand(2, source_data);
-      add_stub(iter.device_type(), iter, 1);
+    auto add_slices = [&](TensorIterator& iter, const int64_t* items, int64_t count) {
+      for (int64_t k = 0; k < count; k++) {
+        auto i = items ? items[k] : k;
+        auto self_i = index_data[i];
+        TORCH_CHECK_INDEX((self_i >= 0) && (self_i < self_dim_size), "index out of range in self");
+        auto self_data = static_cast<char*>(selfSlice.data_ptr()) + self_i * self_stride_bytes;
+        auto source_data = static_cast<char*>(sourceSlice.data_ptr()) + i * source_stride_bytes;
+        iter.unsafe_replace_operand(0, self_data);
+        iter.unsafe_replace_operand(1, self_data);
+        iter.unsafe_replace_operand(2, source_data);
+        add_stub(iter.device_type(), iter, 1);
+      }
+    };
+
+    // Slices of GRAIN_SIZE elements or more are already split across threads
+    // by add_stub.
+    if (use_parallel_for && selfSlice.numel() < internal::GRAIN_SIZE &&
+        numel * selfSlice.numel() >= internal::GRAIN_SIZE) {
+      std::vector<int64_t> offsets;
+      std::vector<int64_t> perm;
+      const int64_t num_buckets = index_accumulate_num_buckets(self_dim_size);
+      index_accumulate_sort(numel, num_buckets, [&](int64_t i) {
+        auto self_i = index_data[i];
+        TORCH_CHECK_INDEX((self_i >= 0) && (self_i < self_dim_size), "index out of range in self");
+        return self_i * num_buckets / self_dim_size;
+      }, offsets, perm);
+      index_accumulate_for_each_bucket(offsets, perm, [&](int64_t /*bucket*/, const int64_t* items, int64_t count) {
+        auto bucket_iter = iter;
+        add_slices(bucket_iter, items, count);
+      });
+    } else {
+      add_slices(iter, nullptr, numel);
     }
   }
   else {
@@ -389,11 +419,32 @@ Tensor& index_add_cpu_(Tensor & self, int64_t dim, const Tensor & index, const T
     AT_DISPATCH_ALL_TYPES(self.scalar_type(), "index_add_", [&] {
       auto self_stride = self.dim() == 0 ? 1 : self.stride(dim);
       auto source_stride = source.dim() == 0 ? 1 : source.stride(dim);
-      for (auto i = 0; i < numel; i++) {
-        auto self_i = index_data[i];
-        TORCH_CHECK_INDEX((self_i >= 0) && (self_i < self.numel()), "index out of range in self");
-        scalar_t *self_ip = self.data<scalar_t>() + self_i * self_stride;
-        *self_ip += *(source.data<scalar_t>() + i * source_stride);
+      auto self_numel = self.numel();
+      scalar_t* self_data = self.data_ptr<scalar_t>();
+      scalar_t* source_data = source.data_ptr<scalar_t>();
+      auto add_elements = [&](const int64_t* items, int64_t count) {
+        for (int64_t k = 0; k < count; k++) {
+          auto i = items ? items[k] : k;
+          auto self_i = index_data[i];
+          TORCH_CHECK_INDEX((self_i >= 0) && (self_i < self_numel), "index out of range in self");
+          self_data[self_i * self_stride] += source_data[i * source_stride];
+        }
+      };
+
+      if (use_parallel_for && numel >= internal::GRAIN_SIZE) {
+        std::vector<int64_t> offsets;
+        std::vector<int64_t> perm;
+        const int64_t num_buckets = index_accumulate_num_buckets(self_numel);
+        index_accumulate_sort(numel, num_buckets, [&](int64_t i) {
+          auto self_i = index_data[i];
+          TORCH_CHECK_INDEX((self_i >= 0) && (self_i < self_numel), "index out of range in self");
+          return self_i * num_buckets / self_numel;
+        }, offsets, perm);
+        index_accumulate_for_each_bucket(offsets, perm, [&](int64_t /*bucket*/, const int64_t* items, int64_t count) {
+          add_elements(items, count);
+        });
+      } else {
+        add_elements(nullptr, numel);
       }
     });
   }
@@ -629,6 +680,45 @@ Tensor masked_fill(const Tensor & self, const Tensor & mask, const Tensor & sour
   return result;
 }
 
+// Computes the inclusive prefix sum of the contiguous mask into the contiguous
+// long tensor prefix_sum and returns the number of masked elements. The mask
+// is split into one chunk per thread: each chunk is counted, the counts are
+// scanned, and then each chunk writes its part of the sum from its offset.
+template <typename mask_t>
+static int64_t mask_prefix_sum_cpu(Tensor& prefix_sum, const Tensor& mask) {
+  const int64_t numel = mask.numel();
+  const mask_t* mask_data = mask.data_ptr<mask_t>();
+  int64_t* prefix_sum_data = prefix_sum.data_ptr<int64_t>();
+  const int64_t num_chunks = std::max<int64_t>(1, std::min<int64_t>(
+      at::get_num_threads(), divup(numel, internal::GRAIN_SIZE)));
+  const int64_t chunk_size = std::max<int64_t>(1, divup(numel, num_chunks));
+  std::vector<int64_t> chunk_offsets(num_chunks + 1, 0);
+
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; c++) {
+      const int64_t chunk_end = std::min(numel, (c + 1) * chunk_size);
+      int64_t count = 0;
+      for (int64_t i = c * chunk_size; i < chunk_end; i++) {
+        count += mask_data[i] != 0;
+      }
+      chunk_offsets[c + 1] = count;
+    }
+  });
+  std::partial_sum(chunk_offsets.begin(), chunk_offsets.end(), chunk_offsets.begin());
+
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; c++) {
+      const int64_t chunk_end = std::min(numel, (c + 1) * chunk_size);
+      int64_t sum = chunk_offsets[c];
+      for (int64_t i = c * chunk_size; i < chunk_end; i++) {
+        sum += mask_data[i] != 0;
+        prefix_sum_data[i] = sum;
+      }
+    }
+  });
+  return chunk_offsets[num_chunks];
+}
+
 static Tensor & masked_select_out_impl_cpu(Tensor & result, const Tensor & self, const Tensor & mask) {
   NoNamesGuard guard;
 
@@ -646,7 +736,22 @@ static Tensor & masked_select_out_impl_cpu(Tensor & result, const Tensor & self,
   std::tie(_mask, _self) = expand_outplace(mask, self);
 
   auto shape = _self.sizes();
-  int64_t numel = _mask.sum().item().toLong();
+  bool use_serial_kernel = self.numel() < at::internal::GRAIN_SIZE || at::get_num_threads() == 1;
+  int64_t numel;
+  Tensor mask_prefix_sum;
+  if (use_serial_kernel) {
+    numel = _mask.sum().item().toLong();
+  } else {
+    // Use a prefix sum to record the output locations of the masked elements,
+    // so as to parallel with TensorIterator.
+    mask_prefix_sum = at::empty(shape, self.options().dtype(at::kLong));
+    auto mask_contig = _mask.contiguous();
+    if (mask_contig.scalar_type() == ScalarType::Bool) {
+      numel = mask_prefix_sum_cpu<bool>(mask_prefix_sum, mask_contig);
+    } else {
+      numel = mask_prefix_sum_cpu<uint8_t>(mask_prefix_sum, mask_contig);
+    }
+  }
   result.resize_({numel});
   if (numel == 0) {
     return result;
@@ -657,7 +762,6 @@ static Tensor & masked_select_out_impl_cpu(Tensor & result, const Tensor & self,
   auto result_strided = result.as_strided(shape, strides);
 
   // serial kernel
-  bool use_serial_kernel = self.numel() < at::internal::GRAIN_SIZE || at::get_num_threads() == 1;
   if (use_serial_kernel) {
     auto iter = TensorIteratorConfig()
       .check_all_same_dtype(false)
@@ -671,17 +775,6 @@ static Tensor & masked_select_out_impl_cpu(Tensor & result, const Tensor & self,
     return result;
   }
 
-  // Use a prefix sum to record the output locations of the masked elements,
-  // so as to parallel with TensorIterator.
-  auto mask_long = at::empty(shape, self.options().dtype(at::kLong)).copy_(_mask);
-  auto mask_prefix_sum = at::empty(shape, self.options().dtype(at::kLong));
-  auto mask_long_data = mask_long.data_ptr<int64_t>();
-  auto mask_prefix_sum_data = mask_prefix_sum.data_ptr<int64_t>();
-  // TODO: Here can only use std::partial_sum for C++14,
-  // use std::exclusive_scan when PyTorch upgrades to C++17, which have better peformance.
-  // std::exclusive_scan(mask_long_data, mask_long_data + mask_long.numel(), mask_prefix_sum_data, 0);
-  std::partial_sum(mask_long_data, mask_long_data + mask_long.numel(), mask_prefix_sum_data);
-
   auto iter = TensorIteratorConfig()
     .check_all_same_dtype(false)
     .dont_resize_outputs()
@@ -705,6 +798,18 @@ Tensor masked_select_cpu(const Tensor & self, const Tensor & mask) {
   return masked_select_out_cpu(result, self, mask);
 }
 
+Tensor & nonzero_out_cpu(Tensor & result, const Tensor & self) {
+  TORCH_CHECK(result.scalar_type() == ScalarType::Long,
+              "nonzero(): expected out to have dtype Long, but got ", result.scalar_type());
+  nonzero_stub(kCPU, result, self.contiguous());
+  return result;
+}
+
+Tensor nonzero_cpu(const Tensor & self) {
+  Tensor result = at::empty({0}, self.options().dtype(kLong));
+  return nonzero_out_cpu(result, self);
+}
+
 Tensor _gather_sparse_backward(const Tensor& self, int64_t dim, const Tensor& index, const Tensor& grad){
 // special case scalar input and/or index
     if (self.ndimension() == 0) return at::_sparse_coo_tensor_unsafe(at::empty({0,grad.numel()}, index.options()), grad, self.sizes());
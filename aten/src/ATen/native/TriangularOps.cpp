@@ -1,4 +1,5 @@
 #include <ATen/ATen.h>
+#include <ATen/AccumulateType.h>
 #include <ATen/CPUApplyUtils.h>
 #include <ATen/Dispatch.h>
 #include <ATen/NativeFunctions.h>
@@ -154,5 +155,24 @@ Tensor& triu_cpu_out(Tensor &result, const Tensor& self, int64_t k) {
   return result;
 }
 
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ trace ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+Tensor trace_cpu(const Tensor& self) {
+  TORCH_CHECK(self.dim() == 2, "expected a matrix");
+  Tensor result = at::empty({}, self.options());
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), "trace", [&] {
+    using accscalar_t = at::acc_type<scalar_t, false>;
+    const scalar_t* t_data = self.data_ptr<scalar_t>();
+    const int64_t t_diag_stride = self.stride(0) + self.stride(1);
+    const int64_t t_diag_size = std::min(self.size(0), self.size(1));
+    accscalar_t sum = 0;
+    for (int64_t i = 0; i < t_diag_size; i++) {
+      sum += t_data[i * t_diag_stride];
+    }
+    *result.data_ptr<scalar_t>() = static_cast<scalar_t>(sum);
+  });
+  return result;
+}
+
 }  // namespace native
 }  // namespace at
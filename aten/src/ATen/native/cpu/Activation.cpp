@@ -5,6 +5,8 @@
 #include <ATen/native/Activation.h>
 
 #include <math.h>
+#include <tuple>
+#include <type_traits>
 
 #include <ATen/ATen.h>
 #include <ATen/Config.h>
@@ -22,6 +24,55 @@ namespace native {
 
 namespace {
 
+// BFloat16 activations are computed in float. The kernels below write their
+// scalar and vector ops for opmath_t<scalar_t>, and activation_kernel_vec
+// widens each Vec256<BFloat16> to two Vec256<float>, applies the ops and
+// rounds the result back to BFloat16 once.
+template <typename scalar_t>
+using opmath_t = typename std::conditional<
+    std::is_same<scalar_t, BFloat16>::value, float, scalar_t>::type;
+
+template <typename scalar_t, typename func_t, typename vec_func_t,
+    typename std::enable_if<!std::is_same<scalar_t, BFloat16>::value, int>::type = 0>
+void activation_kernel_vec(TensorIterator& iter, const func_t& op, const vec_func_t& vop) {
+  cpu_kernel_vec(iter, op, vop);
+}
+
+template <typename scalar_t, typename func_t, typename vec_func_t,
+    typename std::enable_if<std::is_same<scalar_t, BFloat16>::value &&
+        function_traits<func_t>::arity == 1, int>::type = 0>
+void activation_kernel_vec(TensorIterator& iter, const func_t& op, const vec_func_t& vop) {
+  using bVec = Vec256<BFloat16>;
+  using fVec = Vec256<float>;
+  cpu_kernel_vec(
+      iter,
+      [&](BFloat16 a) -> BFloat16 { return op(static_cast<float>(a)); },
+      [&](bVec a) -> bVec {
+        fVec a0, a1;
+        std::tie(a0, a1) = convert_bfloat16_float(a);
+        return convert_float_bfloat16(vop(a0), vop(a1));
+      });
+}
+
+template <typename scalar_t, typename func_t, typename vec_func_t,
+    typename std::enable_if<std::is_same<scalar_t, BFloat16>::value &&
+        function_traits<func_t>::arity == 2, int>::type = 0>
+void activation_kernel_vec(TensorIterator& iter, const func_t& op, const vec_func_t& vop) {
+  using bVec = Vec256<BFloat16>;
+  using fVec = Vec256<float>;
+  cpu_kernel_vec(
+      iter,
+      [&](BFloat16 a, BFloat16 b) -> BFloat16 {
+        return op(static_cast<float>(a), static_cast<float>(b));
+      },
+      [&](bVec a, bVec b) -> bVec {
+        fVec a0, a1, b0, b1;
+        std::tie(a0, a1) = convert_bfloat16_float(a);
+        std::tie(b0, b1) = convert_bfloat16_float(b);
+        return convert_float_bfloat16(vop(a0, b0), vop(a1, b1));
+      });
+}
+
 template <typename scalar_t>
 inline void _vec_log_sigmoid(Tensor& output, Tensor& buffer, const Tensor& input) {
   using Vec = Vec256<scalar_t>;
@@ -256,21 +307,22 @@ void elu_backward_kernel(TensorIterator& it, Scalar alpha, Scalar scale, Scalar
 // y = 0.5x * (1 + tanh(sqrt(2/Pi) * (x + 0.044715x^3)))
 // and the fast tanh impl from Eigen.
 void GeluKernelImpl(TensorIterator& it) {
-  if (at::hasMKL() && it.is_contiguous()) {
+  if (at::hasMKL() && it.is_contiguous() && it.dtype() != kBFloat16) {
     AT_DISPATCH_FLOATING_TYPES(it.dtype(), "GeluKernelImpl", [&]() {
       GeluMKLKernelImpl<scalar_t>(&it);
     });
   } else {
-    AT_DISPATCH_FLOATING_TYPES(it.dtype(), "GeluKernelImpl", [&]() {
-      using Vec = vec256::Vec256<scalar_t>;
+    AT_DISPATCH_FLOATING_TYPES_AND(kBFloat16, it.dtype(), "GeluKernelImpl", [&]() {
+      using T = opmath_t<scalar_t>;
+      using Vec = vec256::Vec256<T>;
       const Vec kAlphaVec(M_SQRT1_2);
       const Vec kOneVec(1);
       const Vec kPointFiveVec(0.5);
-      cpu_kernel_vec(
+      activation_kernel_vec<scalar_t>(
           it,
-          [](scalar_t x) {
-            constexpr scalar_t kAlpha = M_SQRT1_2;
-            return x * scalar_t(0.5) * (scalar_t(1) + std::erf(x * kAlpha));
+          [](T x) {
+            constexpr T kAlpha = M_SQRT1_2;
+            return x * T(0.5) * (T(1) + std::erf(x * kAlpha));
           },
           [&](Vec x_vec) {
             return x_vec * kPointFiveVec *
@@ -281,26 +333,26 @@ void GeluKernelImpl(TensorIterator& it) {
 }
 
 void GeluBackwardKernelImpl(TensorIterator& it) {
-  if (hasMKL() && it.is_contiguous()) {
+  if (hasMKL() && it.is_contiguous() && it.dtype() != kBFloat16) {
     AT_DISPATCH_FLOATING_TYPES(it.dtype(), "GeluBackwardKernelImpl", [&]() {
       GeluBackwardMKLKernelImpl<scalar_t>(&it);
     });
   } else {
-    AT_DISPATCH_FLOATING_TYPES(it.dtype(), "GeluBackwardKernelImpl", [&]() {
-      using Vec = vec256::Vec256<scalar_t>;
+    AT_DISPATCH_FLOATING_TYPES_AND(kBFloat16, it.dtype(), "GeluBackwardKernelImpl", [&]() {
+      using T = opmath_t<scalar_t>;
+      using Vec = vec256::Vec256<T>;
       const Vec kAlphaVec(M_SQRT1_2);
       const Vec kBetaVec(M_2_SQRTPI * M_SQRT1_2 * 0.5);
       const Vec kOneVec(1);
       const Vec kPointFiveVec(0.5);
       const Vec kMinusPointFiveVec(-0.5);
-      cpu_kernel_vec(
+      activation_kernel_vec<scalar_t>(
           it,
-          [](scalar_t dy, scalar_t x) {
-            constexpr scalar_t kAlpha = M_SQRT1_2;
-            constexpr scalar_t kBeta = M_2_SQRTPI * M_SQRT1_2 * 0.5;
-            const scalar_t cdf =
-                scalar_t(0.5) * (scalar_t(1) + std::erf(x * kAlpha));
-            const scalar_t pdf = kBeta * std::exp(x * x * scalar_t(-0.5));
+          [](T dy, T x) {
+            constexpr T kAlpha = M_SQRT1_2;
+            constexpr T kBeta = M_2_SQRTPI * M_SQRT1_2 * 0.5;
+            const T cdf = T(0.5) * (T(1) + std::erf(x * kAlpha));
+            const T pdf = kBeta * std::exp(x * x * T(-0.5));
             return dy * (cdf + x * pdf);
           },
           [&](Vec dy_vec, Vec x_vec) {
@@ -415,17 +467,18 @@ void hardtanh_backward_kernel(TensorIterator& iter, Scalar min, Scalar max) {
 }
 
 void hardswish_kernel(TensorIterator& iter) {
-  AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "hardswish_cpu", [&]() {
-    const scalar_t zero(0.0f);
-    const scalar_t three(3.0f);
-    const scalar_t six(6.0f);
-    using Vec = vec256::Vec256<scalar_t>;
+  AT_DISPATCH_FLOATING_TYPES_AND(kBFloat16, iter.dtype(), "hardswish_cpu", [&]() {
+    using T = opmath_t<scalar_t>;
+    const T zero(0.0f);
+    const T three(3.0f);
+    const T six(6.0f);
+    using Vec = vec256::Vec256<T>;
     const Vec kZeroVec(zero);
     const Vec kThreeVec(three);
     const Vec kSixVec(six);
-    cpu_kernel_vec(
+    activation_kernel_vec<scalar_t>(
       iter,
-      [&](scalar_t x) {
+      [&](T x) {
         return x * std::min(std::max(x + three, zero), six) / six;
       },
       [&](Vec x_vec) {
@@ -439,19 +492,20 @@ void hardswish_kernel(TensorIterator& iter) {
 }
 
 void hardswish_backward_kernel(TensorIterator& iter) {
-  AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "hardswish_backward_cpu", [&]() {
-    const scalar_t zero(0.0f);
-    const scalar_t three(3.0f);
-    const scalar_t neg_three(-3.0f);
-    const scalar_t one_half(0.5f);
-    using Vec = vec256::Vec256<scalar_t>;
+  AT_DISPATCH_FLOATING_TYPES_AND(kBFloat16, iter.dtype(), "hardswish_backward_cpu", [&]() {
+    using T = opmath_t<scalar_t>;
+    const T zero(0.0f);
+    const T three(3.0f);
+    const T neg_three(-3.0f);
+    const T one_half(0.5f);
+    using Vec = vec256::Vec256<T>;
     const Vec kZeroVec(zero);
     const Vec kThreeVec(three);
     const Vec kNegThreeVec(neg_three);
     const Vec kOneHalfVec(one_half);
-    cpu_kernel_vec(
+    activation_kernel_vec<scalar_t>(
       iter,
-      [&](scalar_t grad_val, scalar_t self_val) {
+      [&](T grad_val, T self_val) -> T {
         if (self_val < neg_three) {
           return zero;
         } else if (self_val <= three) {
@@ -476,16 +530,17 @@ void hardswish_backward_kernel(TensorIterator& iter) {
 }
 
 static void leaky_relu_kernel(TensorIterator& iter, Scalar negval_) {
-  AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "leaky_relu_cpu", [&] {
-    using Vec = Vec256<scalar_t>;
-    auto zero_vec = Vec((scalar_t)(0));
-    auto one_vec = Vec((scalar_t)(1));
-    scalar_t negval = negval_.to<scalar_t>();
+  AT_DISPATCH_FLOATING_TYPES_AND(kBFloat16, iter.dtype(), "leaky_relu_cpu", [&] {
+    using T = opmath_t<scalar_t>;
+    using Vec = Vec256<T>;
+    auto zero_vec = Vec((T)(0));
+    auto one_vec = Vec((T)(1));
+    T negval = negval_.to<T>();
     Vec negval_v = Vec(negval);
-    cpu_kernel_vec(
+    activation_kernel_vec<scalar_t>(
         iter,
-        [&](scalar_t a) -> scalar_t {
-          return a > scalar_t(0) ? a : a * negval;
+        [&](T a) -> T {
+          return a > T(0) ? a : a * negval;
         },
         [&](Vec a) -> Vec {
           auto r = Vec::blendv(negval_v, one_vec, a > zero_vec);
@@ -495,16 +550,17 @@ static void leaky_relu_kernel(TensorIterator& iter, Scalar negval_) {
 }
 
 static void leaky_relu_backward_kernel(TensorIterator& iter, Scalar negval_) {
-  AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "leaky_relu_backward_cpu", [&] {
-    using Vec = Vec256<scalar_t>;
-    auto zero_vec = Vec((scalar_t)(0));
-    auto one_vec = Vec((scalar_t)(1));
-    scalar_t negval = negval_.to<scalar_t>();
+  AT_DISPATCH_FLOATING_TYPES_AND(kBFloat16, iter.dtype(), "leaky_relu_backward_cpu", [&] {
+    using T = opmath_t<scalar_t>;
+    using Vec = Vec256<T>;
+    auto zero_vec = Vec((T)(0));
+    auto one_vec = Vec((T)(1));
+    T negval = negval_.to<T>();
     Vec negval_v = Vec(negval);
-    cpu_kernel_vec(
+    activation_kernel_vec<scalar_t>(
         iter,
-        [&](scalar_t a, scalar_t b) -> scalar_t {
-          return a > scalar_t(0) ? b : b * negval;
+        [&](T a, T b) -> T {
+          return a > T(0) ? b : b * negval;
         },
         [&](Vec a, Vec b) -> Vec {
           auto r = Vec::blendv(negval_v, one_vec, a > zero_vec);
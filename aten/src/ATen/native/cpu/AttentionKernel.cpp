@@ -0,0 +1,298 @@
+#include <ATen/native/Attention.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/functional.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+namespace at { namespace native {
+
+template<typename scalar_t>
+void gemm(char transa, char transb, int64_t m, int64_t n, int64_t k, scalar_t alpha, scalar_t *a, int64_t lda, scalar_t *b, int64_t ldb, scalar_t beta, scalar_t *c, int64_t ldc);
+
+namespace {
+
+using namespace vec256;
+
+// Rows of queries and keys per block. A block of scores is
+// kQueryBlock x kKeyBlock and stays in the L2 cache.
+constexpr int64_t kQueryBlock = 64;
+constexpr int64_t kKeyBlock = 256;
+
+// Strided view of the [L, E] matrices of a tensor of shape [*, L, E], with
+// the batch dimensions flattened. All the offsets are in elements.
+template <typename scalar_t>
+struct MatrixBatch {
+  explicit MatrixBatch(const Tensor& t)
+      : data(t.data_ptr<scalar_t>()),
+        // The stride of a single row is arbitrary; gemm wants it to be at
+        // least the length of the row.
+        row_stride(t.size(-2) > 1 ? t.stride(-2) : std::max<int64_t>(t.size(-1), 1)),
+        col_stride(t.stride(-1)) {
+    const int64_t batch_dims = t.dim() - 2;
+    int64_t batch_size = 1;
+    for (int64_t d = 0; d < batch_dims; d++) {
+      batch_size *= t.size(d);
+    }
+    offsets.resize(batch_size);
+    for (int64_t i = 0; i < batch_size; i++) {
+      int64_t remainder = i;
+      int64_t offset = 0;
+      for (int64_t d = batch_dims - 1; d >= 0; d--) {
+        offset += (remainder % t.size(d)) * t.stride(d);
+        remainder /= t.size(d);
+      }
+      offsets[i] = offset;
+    }
+  }
+
+  scalar_t* row(int64_t batch, int64_t i) const {
+    return data + offsets[batch] + i * row_stride;
+  }
+
+  scalar_t* data;
+  int64_t row_stride;
+  int64_t col_stride;
+  std::vector<int64_t> offsets;
+};
+
+// scores[i][j] += mask[q_begin + i][kv_begin + j]
+template <typename scalar_t>
+void add_mask_row(scalar_t* scores, const MatrixBatch<scalar_t>& mask,
+    int64_t batch, int64_t i, int64_t kv_begin, int64_t kv_len) {
+  using Vec = Vec256<scalar_t>;
+  scalar_t* mask_row = mask.row(batch, i);
+  if (mask.col_stride == 1) {
+    map2([](Vec x, Vec y) { return x + y; }, scores, scores, mask_row + kv_begin, kv_len);
+  } else {
+    for (int64_t j = 0; j < kv_len; j++) {
+      scores[j] += mask_row[(kv_begin + j) * mask.col_stride];
+    }
+  }
+}
+
+template <typename scalar_t>
+void fused_attention_kernel_impl(const Tensor& output_, const Tensor& logsumexp_,
+    const Tensor& query_, const Tensor& key_, const Tensor& value_, const Tensor& attn_mask,
+    double scale_) {
+  using Vec = Vec256<scalar_t>;
+  const MatrixBatch<scalar_t> query(query_);
+  const MatrixBatch<scalar_t> key(key_);
+  const MatrixBatch<scalar_t> value(value_);
+  const MatrixBatch<scalar_t> output(output_);
+  const bool has_mask = attn_mask.defined();
+  const MatrixBatch<scalar_t> mask(has_mask ? attn_mask : query_);
+  scalar_t* logsumexp = logsumexp_.data_ptr<scalar_t>();
+  const scalar_t scale = static_cast<scalar_t>(scale_);
+  const int64_t batch_size = query.offsets.size();
+  const int64_t L = query_.size(-2);
+  const int64_t S = key_.size(-2);
+  const int64_t E = query_.size(-1);
+  const int64_t Ev = value_.size(-1);
+  const int64_t num_query_blocks = divup(L, kQueryBlock);
+  const scalar_t neg_inf = -std::numeric_limits<scalar_t>::infinity();
+
+  at::parallel_for(0, batch_size * num_query_blocks, 1, [&](int64_t begin, int64_t end) {
+    std::vector<scalar_t> scores_buffer(kQueryBlock * kKeyBlock, scalar_t(0));
+    std::vector<scalar_t> row_max(kQueryBlock);
+    std::vector<scalar_t> row_sum(kQueryBlock);
+    std::vector<scalar_t> correction(kQueryBlock);
+    scalar_t* scores = scores_buffer.data();
+
+    for (int64_t index = begin; index < end; index++) {
+      const int64_t n = index / num_query_blocks;
+      const int64_t q_begin = (index % num_query_blocks) * kQueryBlock;
+      const int64_t q_len = std::min(kQueryBlock, L - q_begin);
+      scalar_t* out = output.row(n, q_begin);
+      // The rows of the output accumulate the unnormalized sums.
+      for (int64_t i = 0; i < q_len; i++) {
+        std::fill(out + i * output.row_stride, out + i * output.row_stride + Ev, scalar_t(0));
+      }
+      std::fill(row_max.begin(), row_max.end(), neg_inf);
+      std::fill(row_sum.begin(), row_sum.end(), scalar_t(0));
+
+      for (int64_t kv_begin = 0; kv_begin < S; kv_begin += kKeyBlock) {
+        const int64_t kv_len = std::min(kKeyBlock, S - kv_begin);
+        // scores = scale * query_block @ key_block^T, row-major with rows of
+        // kKeyBlock elements.
+        gemm<scalar_t>('t', 'n', kv_len, q_len, E, scale,
+            key.row(n, kv_begin), key.row_stride,
+            query.row(n, q_begin), query.row_stride,
+            scalar_t(0), scores, kKeyBlock);
+
+        for (int64_t i = 0; i < q_len; i++) {
+          scalar_t* s = scores + i * kKeyBlock;
+          if (has_mask) {
+            add_mask_row(s, mask, n, q_begin + i, kv_begin, kv_len);
+          }
+          const scalar_t block_max = reduce_all<scalar_t>(
+              [](Vec& x, Vec& y) { return maximum(x, y); }, s, kv_len);
+          const scalar_t new_max = std::max(row_max[i], block_max);
+          // While all the scores of a row are -inf there is nothing to
+          // rescale; keep its maximum at -inf and its sums at 0.
+          correction[i] = new_max == neg_inf ? scalar_t(0) : row_max[i] - new_max;
+          row_max[i] = new_max;
+        }
+        // See [Note AVX-SSE transitions] in SoftMaxKernel.cpp
+        map([](Vec x) { return x.exp(); }, correction.data(), correction.data(), q_len);
+
+        for (int64_t i = 0; i < q_len; i++) {
+          scalar_t* s = scores + i * kKeyBlock;
+          const scalar_t max_i = row_max[i];
+          if (max_i == neg_inf) {
+            std::fill(s, s + kv_len, scalar_t(0));
+            continue;
+          }
+          map([max_i](Vec x) { return (x - Vec(max_i)).exp(); }, s, s, kv_len);
+          const scalar_t block_sum = reduce_all<scalar_t>(
+              [](Vec& x, Vec& y) { return x + y; }, s, kv_len);
+          const scalar_t c = correction[i];
+          row_sum[i] = row_sum[i] * c + block_sum;
+          if (c != scalar_t(1)) {
+            scalar_t* out_row = out + i * output.row_stride;
+            map([c](Vec x) { return x * Vec(c); }, out_row, out_row, Ev);
+          }
+        }
+
+        // out_block += exp(scores) @ value_block
+        gemm<scalar_t>('n', 'n', Ev, q_len, kv_len, scalar_t(1),
+            value.row(n, kv_begin), value.row_stride,
+            scores, kKeyBlock,
+            scalar_t(1), out, output.row_stride);
+      }
+
+      scalar_t* lse = logsumexp + n * L + q_begin;
+      for (int64_t i = 0; i < q_len; i++) {
+        // A row without any finite score has a sum of 0 and becomes NaN.
+        const scalar_t inv_sum = scalar_t(1) / row_sum[i];
+        scalar_t* out_row = out + i * output.row_stride;
+        map([inv_sum](Vec x) { return x * Vec(inv_sum); }, out_row, out_row, Ev);
+        lse[i] = row_sum[i];
+      }
+      map([](Vec x) { return x.log(); }, lse, lse, q_len);
+      map2([](Vec x, Vec y) { return x + y; }, lse, lse, row_max.data(), q_len);
+    }
+  });
+}
+
+// Recomputes each block of the softmax from the saved logsumexp:
+//   P = exp(scale * Q K^T + mask - logsumexp)
+//   dV += P^T dO
+//   dS = P * (dO V^T - rowsum(dO * O))
+//   dQ += scale * dS K
+//   dK += scale * dS^T Q
+template <typename scalar_t>
+void fused_attention_backward_kernel_impl(const Tensor& grad_query_, const Tensor& grad_key_,
+    const Tensor& grad_value_, const Tensor& grad_out_, const Tensor& query_, const Tensor& key_,
+    const Tensor& value_, const Tensor& attn_mask, const Tensor& output_,
+    const Tensor& logsumexp_, double scale_) {
+  using Vec = Vec256<scalar_t>;
+  const MatrixBatch<scalar_t> grad_query(grad_query_);
+  const MatrixBatch<scalar_t> grad_key(grad_key_);
+  const MatrixBatch<scalar_t> grad_value(grad_value_);
+  const MatrixBatch<scalar_t> grad_out(grad_out_);
+  const MatrixBatch<scalar_t> query(query_);
+  const MatrixBatch<scalar_t> key(key_);
+  const MatrixBatch<scalar_t> value(value_);
+  const MatrixBatch<scalar_t> output(output_);
+  const bool has_mask = attn_mask.defined();
+  const MatrixBatch<scalar_t> mask(has_mask ? attn_mask : query_);
+  const scalar_t* logsumexp = logsumexp_.data_ptr<scalar_t>();
+  const scalar_t scale = static_cast<scalar_t>(scale_);
+  const int64_t batch_size = query.offsets.size();
+  const int64_t L = query_.size(-2);
+  const int64_t S = key_.size(-2);
+  const int64_t E = query_.size(-1);
+  const int64_t Ev = value_.size(-1);
+
+  at::parallel_for(0, batch_size, 1, [&](int64_t begin, int64_t end) {
+    std::vector<scalar_t> p_buffer(kQueryBlock * kKeyBlock, scalar_t(0));
+    std::vector<scalar_t> dp_buffer(kQueryBlock * kKeyBlock, scalar_t(0));
+    std::vector<scalar_t> delta(L);
+    scalar_t* p = p_buffer.data();
+    scalar_t* dp = dp_buffer.data();
+
+    for (int64_t n = begin; n < end; n++) {
+      for (int64_t i = 0; i < L; i++) {
+        delta[i] = map2_reduce_all<scalar_t>(
+            [](Vec x, Vec y) { return x * y; },
+            [](Vec x, Vec y) { return x + y; },
+            grad_out.row(n, i), output.row(n, i), Ev);
+      }
+
+      for (int64_t kv_begin = 0; kv_begin < S; kv_begin += kKeyBlock) {
+        const int64_t kv_len = std::min(kKeyBlock, S - kv_begin);
+        for (int64_t q_begin = 0; q_begin < L; q_begin += kQueryBlock) {
+          const int64_t q_len = std::min(kQueryBlock, L - q_begin);
+          gemm<scalar_t>('t', 'n', kv_len, q_len, E, scale,
+              key.row(n, kv_begin), key.row_stride,
+              query.row(n, q_begin), query.row_stride,
+              scalar_t(0), p, kKeyBlock);
+          for (int64_t i = 0; i < q_len; i++) {
+            scalar_t* p_row = p + i * kKeyBlock;
+            if (has_mask) {
+              add_mask_row(p_row, mask, n, q_begin + i, kv_begin, kv_len);
+            }
+            const scalar_t lse = logsumexp[n * L + q_begin + i];
+            map([lse](Vec x) { return (x - Vec(lse)).exp(); }, p_row, p_row, kv_len);
+          }
+
+          // dV_block += P^T @ dO_block
+          gemm<scalar_t>('n', 't', Ev, kv_len, q_len, scalar_t(1),
+              grad_out.row(n, q_begin), grad_out.row_stride,
+              p, kKeyBlock,
+              scalar_t(1), grad_value.row(n, kv_begin), grad_value.row_stride);
+          // dP = dO_block @ V_block^T
+          gemm<scalar_t>('t', 'n', kv_len, q_len, Ev, scalar_t(1),
+              value.row(n, kv_begin), value.row_stride,
+              grad_out.row(n, q_begin), grad_out.row_stride,
+              scalar_t(0), dp, kKeyBlock);
+          for (int64_t i = 0; i < q_len; i++) {
+            const scalar_t delta_i = delta[q_begin + i];
+            map2([delta_i](Vec x, Vec y) { return x * (y - Vec(delta_i)); },
+                dp + i * kKeyBlock, p + i * kKeyBlock, dp + i * kKeyBlock, kv_len);
+          }
+          // dQ_block += scale * dS @ K_block
+          gemm<scalar_t>('n', 'n', E, q_len, kv_len, scale,
+              key.row(n, kv_begin), key.row_stride,
+              dp, kKeyBlock,
+              scalar_t(1), grad_query.row(n, q_begin), grad_query.row_stride);
+          // dK_block += scale * dS^T @ Q_block
+          gemm<scalar_t>('n', 't', E, kv_len, q_len, scale,
+              query.row(n, q_begin), query.row_stride,
+              dp, kKeyBlock,
+              scalar_t(1), grad_key.row(n, kv_begin), grad_key.row_stride);
+        }
+      }
+    }
+  });
+}
+
+void fused_attention_kernel(const Tensor& output, const Tensor& logsumexp,
+    const Tensor& query, const Tensor& key, const Tensor& value, const Tensor& attn_mask,
+    double scale) {
+  AT_DISPATCH_FLOATING_TYPES(query.scalar_type(), "fused_attention_cpu", [&] {
+    fused_attention_kernel_impl<scalar_t>(output, logsumexp, query, key, value, attn_mask, scale);
+  });
+}
+
+void fused_attention_backward_kernel(const Tensor& grad_query, const Tensor& grad_key,
+    const Tensor& grad_value, const Tensor& grad_out, const Tensor& query, const Tensor& key,
+    const Tensor& value, const Tensor& attn_mask, const Tensor& output,
+    const Tensor& logsumexp, double scale) {
+  AT_DISPATCH_FLOATING_TYPES(query.scalar_type(), "fused_attention_backward_cpu", [&] {
+    fused_attention_backward_kernel_impl<scalar_t>(grad_query, grad_key, grad_value, grad_out,
+        query, key, value, attn_mask, output, logsumexp, scale);
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(fused_attention_stub, &fused_attention_kernel);
+REGISTER_DISPATCH(fused_attention_backward_stub, &fused_attention_backward_kernel);
+
+}} // namespace at::native
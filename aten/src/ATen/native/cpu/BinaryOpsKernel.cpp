@@ -4,6 +4,7 @@
 #include <ATen/Parallel.h>
 #include <ATen/cpu/vec256/vec256.h>
 #include <ATen/cpu/vec256/functional.h>
+#include <ATen/cpu/vec512/vec512.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/BinaryOps.h>
 #include <ATen/native/cpu/Loops.h>
@@ -25,11 +26,12 @@ void add_kernel(TensorIterator& iter, Scalar alpha_scalar) {
   } else {
     AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND2(kBFloat16, kHalf, iter.dtype(), "add_cpu/sub_cpu", [&]() {
       auto alpha = alpha_scalar.to<scalar_t>();
-      auto alpha_vec = Vec256<scalar_t>(alpha);
+      using Vec = vec512::Vectorized<scalar_t>;
+      auto alpha_vec = Vec(alpha);
       cpu_kernel_vec(iter,
         [=](scalar_t a, scalar_t b) __ubsan_ignore_undefined__ -> scalar_t { return a + alpha * b; },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) __ubsan_ignore_undefined__ {
-          return vec256::fmadd(b, alpha_vec, a);
+        [=](Vec a, Vec b) __ubsan_ignore_undefined__ {
+          return vec512::fmadd(b, alpha_vec, a);
         });
       });
   }
@@ -57,9 +59,10 @@ void mul_kernel(TensorIterator& iter) {
     cpu_kernel(iter, [=](bool a, bool b) -> bool { return a && b; });
   } else {
     AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND2(kBFloat16, kHalf, iter.dtype(), "mul_cpu", [&]() {
+      using Vec = vec512::Vectorized<scalar_t>;
       cpu_kernel_vec(iter,
         [=](scalar_t a, scalar_t b) -> scalar_t { return a * b; },
-        [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+        [=](Vec a, Vec b) {
           return a * b;
         });
     });
@@ -88,11 +91,12 @@ void div_kernel(TensorIterator& iter) {
       });
     } else {
       AT_DISPATCH_FLOATING_TYPES_AND2(kBFloat16, kHalf, iter.dtype(), "div_cpu", [&]() {
+        using Vec = vec512::Vectorized<scalar_t>;
         cpu_kernel_vec(iter,
           [=](scalar_t a, scalar_t b) __ubsan_ignore_float_divide_by_zero__ -> scalar_t {
             return a / b;
           },
-          [=](Vec256<scalar_t> a, Vec256<scalar_t> b) {
+          [=](Vec a, Vec b) {
             return a / b;
           });
       });
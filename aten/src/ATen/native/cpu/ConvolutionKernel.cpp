@@ -0,0 +1,305 @@
+#include <ATen/native/ConvolutionCPU.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+namespace at { namespace native {
+
+template<typename scalar_t>
+void gemm(char transa, char transb, int64_t m, int64_t n, int64_t k, scalar_t alpha, scalar_t *a, int64_t lda, scalar_t *b, int64_t ldb, scalar_t beta, scalar_t *c, int64_t ldc);
+
+namespace {
+
+using namespace vec256;
+
+// Winograd F(4x4, 3x3), with the interpolation points 0, 1, -1, 2, -2 and
+// infinity. The 4x4 tile of output Y of a 6x6 tile of input d and a 3x3
+// filter g is
+//   Y = A^T [(G g G^T) * (B^T d B)] A
+// where * is the elementwise product. The 1-d transforms apply G, B^T and
+// A^T to strided columns; the 2-d ones apply them to the columns and then to
+// the rows of the result.
+constexpr int64_t kTileSize = 6;
+constexpr int64_t kOutputTileSize = 4;
+constexpr int64_t kTileElements = kTileSize * kTileSize;
+// Tiles transformed and multiplied at a time. The transformed tiles of a
+// block are kTileElements * (in_channels + out_channels) * kTileBlock
+// elements.
+constexpr int64_t kTileBlock = 32;
+
+// u = G g, for g of 3 elements and u of 6
+template <typename scalar_t>
+inline void winograd_filter_transform(const scalar_t* g, int64_t g_stride, scalar_t* u, int64_t u_stride) {
+  const scalar_t g0 = g[0], g1 = g[g_stride], g2 = g[2 * g_stride];
+  u[0] = g0 / 4;
+  u[u_stride] = -(g0 + g1 + g2) / 6;
+  u[2 * u_stride] = -(g0 - g1 + g2) / 6;
+  u[3 * u_stride] = g0 / 24 + g1 / 12 + g2 / 6;
+  u[4 * u_stride] = g0 / 24 - g1 / 12 + g2 / 6;
+  u[5 * u_stride] = g2;
+}
+
+// v = B^T d, for d and v of 6 elements
+template <typename scalar_t>
+inline void winograd_input_transform(const scalar_t* d, int64_t d_stride, scalar_t* v, int64_t v_stride) {
+  const scalar_t d0 = d[0], d1 = d[d_stride], d2 = d[2 * d_stride];
+  const scalar_t d3 = d[3 * d_stride], d4 = d[4 * d_stride], d5 = d[5 * d_stride];
+  v[0] = 4 * d0 - 5 * d2 + d4;
+  v[v_stride] = d3 + d4 - 4 * (d1 + d2);
+  v[2 * v_stride] = d4 - d3 + 4 * (d1 - d2);
+  v[3 * v_stride] = d4 - d2 + 2 * (d3 - d1);
+  v[4 * v_stride] = d4 - d2 + 2 * (d1 - d3);
+  v[5 * v_stride] = 4 * d1 - 5 * d3 + d5;
+}
+
+// y = A^T m, for m of 6 elements and y of 4
+template <typename scalar_t>
+inline void winograd_output_transform(const scalar_t* m, int64_t m_stride, scalar_t* y, int64_t y_stride) {
+  const scalar_t m0 = m[0], m1 = m[m_stride], m2 = m[2 * m_stride];
+  const scalar_t m3 = m[3 * m_stride], m4 = m[4 * m_stride], m5 = m[5 * m_stride];
+  y[0] = m0 + m1 + m2 + m3 + m4;
+  y[y_stride] = m1 - m2 + 2 * (m3 - m4);
+  y[2 * y_stride] = m1 + m2 + 4 * (m3 + m4);
+  y[3 * y_stride] = m1 - m2 + 8 * (m3 - m4) + m5;
+}
+
+template <typename scalar_t>
+void winograd_convolution2d_kernel_impl(const Tensor& output_, const Tensor& input_,
+    const Tensor& weight_, const Tensor& bias_, IntArrayRef padding) {
+  const int64_t batch_size = input_.size(0);
+  const int64_t in_channels = input_.size(1);
+  const int64_t in_height = input_.size(2);
+  const int64_t in_width = input_.size(3);
+  const int64_t out_channels = output_.size(1);
+  const int64_t out_height = output_.size(2);
+  const int64_t out_width = output_.size(3);
+  const int64_t pad_h = padding[0];
+  const int64_t pad_w = padding[1];
+  const scalar_t* input = input_.data_ptr<scalar_t>();
+  const scalar_t* weight = weight_.data_ptr<scalar_t>();
+  const scalar_t* bias = bias_.defined() ? bias_.data_ptr<scalar_t>() : nullptr;
+  scalar_t* output = output_.data_ptr<scalar_t>();
+
+  // The transformed filters, [kTileElements, out_channels, in_channels].
+  const int64_t filter_count = out_channels * in_channels;
+  std::vector<scalar_t> filters(kTileElements * filter_count);
+  at::parallel_for(0, filter_count, 64, [&](int64_t begin, int64_t end) {
+    scalar_t tmp[kTileSize * 3];
+    scalar_t u[kTileElements];
+    for (int64_t index = begin; index < end; index++) {
+      const scalar_t* g = weight + index * 9;
+      for (int64_t j = 0; j < 3; j++) {
+        winograd_filter_transform(g + j, 3, tmp + j, 3);
+      }
+      for (int64_t i = 0; i < kTileSize; i++) {
+        winograd_filter_transform(tmp + i * 3, 1, u + i * kTileSize, 1);
+      }
+      for (int64_t xi = 0; xi < kTileElements; xi++) {
+        filters[xi * filter_count + index] = u[xi];
+      }
+    }
+  });
+
+  const int64_t tiles_w = divup(out_width, kOutputTileSize);
+  const int64_t num_tiles = divup(out_height, kOutputTileSize) * tiles_w;
+  const int64_t num_blocks = divup(num_tiles, kTileBlock);
+
+  at::parallel_for(0, batch_size * num_blocks, 1, [&](int64_t begin, int64_t end) {
+    // The transformed tiles of the input, [kTileElements, in_channels,
+    // kTileBlock], and their products with the filters, [kTileElements,
+    // out_channels, kTileBlock].
+    std::vector<scalar_t> tiles(kTileElements * in_channels * kTileBlock);
+    std::vector<scalar_t> products(kTileElements * out_channels * kTileBlock);
+    scalar_t d[kTileElements];
+    scalar_t tmp[kTileElements];
+    scalar_t v[kTileElements];
+
+    for (int64_t index = begin; index < end; index++) {
+      const int64_t n = index / num_blocks;
+      const int64_t tile_begin = (index % num_blocks) * kTileBlock;
+      const int64_t tile_len = std::min(kTileBlock, num_tiles - tile_begin);
+
+      for (int64_t ic = 0; ic < in_channels; ic++) {
+        const scalar_t* in = input + (n * in_channels + ic) * in_height * in_width;
+        for (int64_t t = 0; t < tile_len; t++) {
+          const int64_t tile = tile_begin + t;
+          const int64_t h0 = (tile / tiles_w) * kOutputTileSize - pad_h;
+          const int64_t w0 = (tile % tiles_w) * kOutputTileSize - pad_w;
+          for (int64_t i = 0; i < kTileSize; i++) {
+            const int64_t h = h0 + i;
+            for (int64_t j = 0; j < kTileSize; j++) {
+              const int64_t w = w0 + j;
+              const bool inside = h >= 0 && h < in_height && w >= 0 && w < in_width;
+              d[i * kTileSize + j] = inside ? in[h * in_width + w] : scalar_t(0);
+            }
+          }
+          for (int64_t j = 0; j < kTileSize; j++) {
+            winograd_input_transform(d + j, kTileSize, tmp + j, kTileSize);
+          }
+          for (int64_t i = 0; i < kTileSize; i++) {
+            winograd_input_transform(tmp + i * kTileSize, 1, v + i * kTileSize, 1);
+          }
+          for (int64_t xi = 0; xi < kTileElements; xi++) {
+            tiles[(xi * in_channels + ic) * kTileBlock + t] = v[xi];
+          }
+        }
+      }
+
+      // products[xi] = filters[xi] @ tiles[xi], row-major
+      for (int64_t xi = 0; xi < kTileElements; xi++) {
+        gemm<scalar_t>('n', 'n', tile_len, out_channels, in_channels, scalar_t(1),
+            tiles.data() + xi * in_channels * kTileBlock, kTileBlock,
+            filters.data() + xi * filter_count, in_channels,
+            scalar_t(0), products.data() + xi * out_channels * kTileBlock, kTileBlock);
+      }
+
+      for (int64_t oc = 0; oc < out_channels; oc++) {
+        scalar_t* out = output + (n * out_channels + oc) * out_height * out_width;
+        const scalar_t b = bias ? bias[oc] : scalar_t(0);
+        for (int64_t t = 0; t < tile_len; t++) {
+          for (int64_t xi = 0; xi < kTileElements; xi++) {
+            v[xi] = products[(xi * out_channels + oc) * kTileBlock + t];
+          }
+          for (int64_t j = 0; j < kTileSize; j++) {
+            winograd_output_transform(v + j, kTileSize, tmp + j, kTileSize);
+          }
+          for (int64_t i = 0; i < kOutputTileSize; i++) {
+            winograd_output_transform(tmp + i * kTileSize, 1, d + i * kOutputTileSize, 1);
+          }
+          // The tiles on the bottom and right edges may be partial.
+          const int64_t tile = tile_begin + t;
+          const int64_t h0 = (tile / tiles_w) * kOutputTileSize;
+          const int64_t w0 = (tile % tiles_w) * kOutputTileSize;
+          const int64_t h_len = std::min(kOutputTileSize, out_height - h0);
+          const int64_t w_len = std::min(kOutputTileSize, out_width - w0);
+          for (int64_t i = 0; i < h_len; i++) {
+            for (int64_t j = 0; j < w_len; j++) {
+              out[(h0 + i) * out_width + w0 + j] = d[i * kOutputTileSize + j] + b;
+            }
+          }
+        }
+      }
+    }
+  });
+}
+
+// Output pixels of a row computed together by the direct convolution; each
+// accumulates a vector of output channels in a register.
+constexpr int64_t kPixelBlock = 8;
+
+template <typename scalar_t>
+void direct_convolution2d_kernel_impl(const Tensor& output_, const Tensor& input_,
+    const Tensor& weight_, const Tensor& bias_, IntArrayRef padding, IntArrayRef stride) {
+  using Vec = Vec256<scalar_t>;
+  const int64_t batch_size = input_.size(0);
+  const int64_t in_channels = input_.size(1);
+  const int64_t in_height = input_.size(2);
+  const int64_t in_width = input_.size(3);
+  const int64_t out_channels = output_.size(1);
+  const int64_t out_height = output_.size(2);
+  const int64_t out_width = output_.size(3);
+  const int64_t kernel_h = weight_.size(2);
+  const int64_t kernel_w = weight_.size(3);
+  const int64_t pad_h = padding[0];
+  const int64_t pad_w = padding[1];
+  const int64_t stride_h = stride[0];
+  const int64_t stride_w = stride[1];
+  // Both are channels last.
+  const scalar_t* input = input_.data_ptr<scalar_t>();
+  scalar_t* output = output_.data_ptr<scalar_t>();
+
+  // The filters as [kernel_h, kernel_w, in_channels, padded_channels], with
+  // the output channels padded with zeros to a multiple of the vector size
+  // so that all their loads are whole vectors.
+  const int64_t padded_channels = divup(out_channels, Vec::size()) * Vec::size();
+  std::vector<scalar_t> filters(kernel_h * kernel_w * in_channels * padded_channels, scalar_t(0));
+  const scalar_t* weight = weight_.data_ptr<scalar_t>();
+  for (int64_t oc = 0; oc < out_channels; oc++) {
+    for (int64_t ic = 0; ic < in_channels; ic++) {
+      for (int64_t kh = 0; kh < kernel_h; kh++) {
+        for (int64_t kw = 0; kw < kernel_w; kw++) {
+          filters[((kh * kernel_w + kw) * in_channels + ic) * padded_channels + oc] =
+              weight[((oc * in_channels + ic) * kernel_h + kh) * kernel_w + kw];
+        }
+      }
+    }
+  }
+  std::vector<scalar_t> bias(padded_channels, scalar_t(0));
+  if (bias_.defined()) {
+    std::copy_n(bias_.data_ptr<scalar_t>(), out_channels, bias.begin());
+  }
+
+  const int64_t row_cost = out_width * padded_channels * kernel_h * kernel_w * in_channels;
+  const int64_t grain_size = std::max<int64_t>(1, internal::GRAIN_SIZE / std::max<int64_t>(row_cost, 1));
+  at::parallel_for(0, batch_size * out_height, grain_size, [&](int64_t begin, int64_t end) {
+    // Stands in for the pixels of the padding and past the end of the row.
+    const std::vector<scalar_t> zeros(in_channels, scalar_t(0));
+    const scalar_t* pixels[kPixelBlock];
+    Vec acc[kPixelBlock];
+
+    for (int64_t index = begin; index < end; index++) {
+      const int64_t n = index / out_height;
+      const int64_t oh = index % out_height;
+      scalar_t* out_row = output + index * out_width * out_channels;
+
+      for (int64_t ow_begin = 0; ow_begin < out_width; ow_begin += kPixelBlock) {
+        const int64_t block_len = std::min(kPixelBlock, out_width - ow_begin);
+        for (int64_t oc = 0; oc < out_channels; oc += Vec::size()) {
+          for (int64_t p = 0; p < kPixelBlock; p++) {
+            acc[p] = Vec::loadu(bias.data() + oc);
+          }
+          for (int64_t kh = 0; kh < kernel_h; kh++) {
+            const int64_t ih = oh * stride_h - pad_h + kh;
+            if (ih < 0 || ih >= in_height) {
+              continue;
+            }
+            const scalar_t* in_row = input + (n * in_height + ih) * in_width * in_channels;
+            for (int64_t kw = 0; kw < kernel_w; kw++) {
+              for (int64_t p = 0; p < kPixelBlock; p++) {
+                const int64_t iw = (ow_begin + p) * stride_w - pad_w + kw;
+                const bool inside = p < block_len && iw >= 0 && iw < in_width;
+                pixels[p] = inside ? in_row + iw * in_channels : zeros.data();
+              }
+              const scalar_t* f = filters.data() + (kh * kernel_w + kw) * in_channels * padded_channels + oc;
+              for (int64_t ic = 0; ic < in_channels; ic++) {
+                const Vec w = Vec::loadu(f + ic * padded_channels);
+                for (int64_t p = 0; p < kPixelBlock; p++) {
+                  acc[p] = fmadd(Vec(pixels[p][ic]), w, acc[p]);
+                }
+              }
+            }
+          }
+          const int64_t count = std::min<int64_t>(Vec::size(), out_channels - oc);
+          for (int64_t p = 0; p < block_len; p++) {
+            acc[p].store(out_row + (ow_begin + p) * out_channels + oc, count);
+          }
+        }
+      }
+    }
+  });
+}
+
+void winograd_convolution2d_kernel(const Tensor& output, const Tensor& input,
+    const Tensor& weight, const Tensor& bias, IntArrayRef padding) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "winograd_convolution2d_cpu", [&] {
+    winograd_convolution2d_kernel_impl<scalar_t>(output, input, weight, bias, padding);
+  });
+}
+
+void direct_convolution2d_kernel(const Tensor& output, const Tensor& input,
+    const Tensor& weight, const Tensor& bias, IntArrayRef padding, IntArrayRef stride) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "direct_convolution2d_cpu", [&] {
+    direct_convolution2d_kernel_impl<scalar_t>(output, input, weight, bias, padding, stride);
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(winograd_convolution2d_stub, &winograd_convolution2d_kernel);
+REGISTER_DISPATCH(direct_convolution2d_stub, &direct_convolution2d_kernel);
+
+}} // namespace at::native
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <ATen/Context.h>
 #include <ATen/Dispatch.h>
 #include <ATen/CPUApplyUtils.h>
+#include <ATen/Parallel.h>
 #include <ATen/core/DistributionsHelper.h>
+#include <ATen/core/PhiloxRNGEngine.h>
+#include <ATen/cpu/vec256/vec256.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cpu/Loops.h>
 #include <limits>
@@ -81,6 +85,117 @@ struct RandomKernel {
   }
 };
 
+// ==================================================== Philox ========================================================
+
+// Note [Philox CPU random number generation]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// By default the kernels in this file draw every value from the generator's
+// mt19937 stream, one after the other, while holding the generator's mutex.
+// When at::globalContext().philoxCPURNG() is set, uniform_, normal_ and
+// bernoulli_ instead take a single 64-bit seed from the generator and treat
+// the output as a counter-based Philox4_32_10 stream with that key: value i
+// of the (contiguous) output is built from the 32-bit words
+// [i * words_per_value, (i + 1) * words_per_value) of the stream. Any range of
+// the output can then be generated on its own, by skipping the engine ahead to
+// its first word, so the output is filled with parallel_for and is bitwise
+// identical whatever the number of threads. It is not the same sequence as
+// the default mode, which is why this is opt-in.
+
+// Number of 32-bit Philox words used per value; double needs 53 random bits.
+template <typename scalar_t>
+constexpr int64_t philox_words_per_value() {
+  return std::is_same<scalar_t, double>::value ? 2 : 1;
+}
+
+template<typename RNG>
+uint64_t philox_seed(RNG generator) {
+  // See Note [Acquire lock when using random generators]
+  std::lock_guard<std::mutex> lock(generator->mutex_);
+  return generator->random64();
+}
+
+// Returns an engine whose next output is word `word` of the stream for seed.
+inline at::Philox4_32_10 philox_engine_at(uint64_t seed, uint64_t word) {
+  at::Philox4_32_10 engine(seed, /*subsequence=*/0, /*offset=*/word / 4);
+  for (uint64_t i = 0; i < word % 4; i++) {
+    engine();
+  }
+  return engine;
+}
+
+template <typename scalar_t>
+dist_acctype<scalar_t> philox_uniform(at::Philox4_32_10& engine, scalar_t from, scalar_t to) {
+  if (philox_words_per_value<scalar_t>() == 2) {
+    const uint64_t hi = engine();
+    const uint64_t lo = engine();
+    return transformation::uniform_real<scalar_t>((hi << 32) | lo, from, to);
+  }
+  return transformation::uniform_real<scalar_t>(engine(), from, to);
+}
+
+// Sets self[i] = f(i, engine) for every i, in parallel. f must draw exactly
+// words_per_value words from engine. Non-contiguous outputs are filled through
+// a contiguous buffer so that the values do not depend on the strides.
+template <typename scalar_t, typename func_t>
+void philox_fill(Tensor& self, uint64_t seed, int64_t words_per_value, const func_t& f) {
+  Tensor out = self.is_contiguous() ? self : at::empty(self.sizes(), self.options());
+  scalar_t* data = out.data_ptr<scalar_t>();
+  at::parallel_for(0, out.numel(), internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    auto engine = philox_engine_at(seed, begin * words_per_value);
+    for (int64_t i = begin; i < end; i++) {
+      data[i] = f(i, engine);
+    }
+  });
+  if (!self.is_same(out)) {
+    self.copy_(out);
+  }
+}
+
+// Box-Muller on groups of 16 values, as normal_fill does, with the uniforms
+// for group g taken from words [16 * g * words, 16 * (g + 1) * words). The
+// last group is always computed in full and truncated.
+template <typename scalar_t>
+void normal_fill_philox(Tensor& self, double mean, double std, uint64_t seed) {
+  using acc_t = dist_acctype<scalar_t>;
+  using Vec = vec256::Vec256<acc_t>;
+  constexpr int64_t words = philox_words_per_value<scalar_t>();
+  Tensor out = self.is_contiguous() ? self : at::empty(self.sizes(), self.options());
+  scalar_t* data = out.data_ptr<scalar_t>();
+  const int64_t size = out.numel();
+  const int64_t num_groups = divup(size, 16);
+
+  at::parallel_for(0, num_groups, internal::GRAIN_SIZE / 16, [&](int64_t begin, int64_t end) {
+    auto engine = philox_engine_at(seed, begin * 16 * words);
+    const Vec one(static_cast<acc_t>(1));
+    const Vec minus_two(static_cast<acc_t>(-2));
+    const Vec two_pi(static_cast<acc_t>(2.0 * M_PI));
+    const Vec mean_v(static_cast<acc_t>(mean));
+    const Vec std_v(static_cast<acc_t>(std));
+    __at_align32__ acc_t buf[16];
+
+    for (int64_t g = begin; g < end; g++) {
+      for (int64_t j = 0; j < 16; j++) {
+        buf[j] = philox_uniform<scalar_t>(engine, static_cast<scalar_t>(0), static_cast<scalar_t>(1));
+      }
+      for (int64_t j = 0; j < 8; j += Vec::size()) {
+        const Vec u1 = one - Vec::loadu(buf + j); // [0, 1) -> (0, 1] for log.
+        const Vec u2 = Vec::loadu(buf + j + 8);
+        const Vec radius = (minus_two * u1.log()).sqrt();
+        const Vec theta = two_pi * u2;
+        (radius * theta.cos() * std_v + mean_v).store(buf + j);
+        (radius * theta.sin() * std_v + mean_v).store(buf + j + 8);
+      }
+      const int64_t count = std::min<int64_t>(16, size - g * 16);
+      for (int64_t j = 0; j < count; j++) {
+        data[g * 16 + j] = static_cast<scalar_t>(buf[j]);
+      }
+    }
+  });
+  if (!self.is_same(out)) {
+    self.copy_(out);
+  }
+}
+
 // ==================================================== Normal ========================================================
 
 #ifdef CPU_CAPABILITY_AVX2
@@ -172,6 +287,13 @@ void normal_fill(Tensor& self, const scalar_t mean, const scalar_t std, RNG gene
 
 template<typename RNG>
 void normal_kernel(Tensor& self, double mean, double std, RNG generator) {
+  if (at::globalContext().philoxCPURNG()) {
+    const uint64_t seed = philox_seed(generator);
+    AT_DISPATCH_FLOATING_TYPES_AND_HALF(self.scalar_type(), "normal_kernel_cpu", [&] {
+      normal_fill_philox<scalar_t>(self, mean, std, seed);
+    });
+    return;
+  }
   auto size = self.numel();
   if (self.scalar_type() == ScalarType::Float && size >= 16 && self.is_contiguous()) {
 #ifdef CPU_CAPABILITY_AVX2
@@ -208,6 +330,19 @@ struct NormalKernel {
 
 template<typename RNG>
 void uniform_kernel(TensorIterator& iter, double from_, double to_, RNG generator) {
+  if (at::globalContext().philoxCPURNG()) {
+    const uint64_t seed = philox_seed(generator);
+    Tensor self = iter.tensor(0);
+    AT_DISPATCH_FLOATING_TYPES_AND2(at::ScalarType::Half, at::ScalarType::BFloat16, iter.dtype(), "uniform_kernel_cpu", [&]() {
+      auto from = static_cast<scalar_t>(from_);
+      auto to = static_cast<scalar_t>(to_);
+      philox_fill<scalar_t>(self, seed, philox_words_per_value<scalar_t>(),
+          [from, to](int64_t /*i*/, at::Philox4_32_10& engine) -> scalar_t {
+        return static_cast<scalar_t>(philox_uniform<scalar_t>(engine, from, to));
+      });
+    });
+    return;
+  }
   AT_DISPATCH_FLOATING_TYPES_AND2(at::ScalarType::Half, at::ScalarType::BFloat16, iter.dtype(), "uniform_kernel_cpu", [&]() {
     std::lock_guard<std::mutex> lock(generator->mutex_);
     auto from = static_cast<scalar_t>(from_);
@@ -310,6 +445,21 @@ struct ExponentialKernel {
 
 template<typename RNG>
 void bernoulli_kernel(Tensor& self, const Tensor& p_, RNG generator) {
+  if (at::globalContext().philoxCPURNG()) {
+    const uint64_t seed = philox_seed(generator);
+    auto p = std::get<0>(expand_inplace(self, p_.to(kCPU))).contiguous();
+    AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Bool, self.scalar_type(), "bernoulli_tensor_cpu_self_", [&] {
+      using self_t = scalar_t;
+      AT_DISPATCH_FLOATING_TYPES(p.scalar_type(), "bernoulli_tensor_cpu_p_", [&] {
+        const scalar_t* p_data = p.data_ptr<scalar_t>();
+        philox_fill<self_t>(self, seed, 1, [p_data](int64_t i, at::Philox4_32_10& engine) -> self_t {
+          const float u = philox_uniform<float>(engine, 0.f, 1.f);
+          return static_cast<self_t>(u < p_data[i]);
+        });
+      });
+    });
+    return;
+  }
   AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Bool, self.scalar_type(), "bernoulli_tensor_cpu_self_", [&] {
     // See Note [Acquire lock when using random generators]
     std::lock_guard<std::mutex> lock(generator->mutex_);
@@ -339,6 +489,16 @@ void bernoulli_kernel(Tensor& self, const Tensor& p_, RNG generator) {
 
 template<typename RNG>
 void bernoulli_kernel(Tensor& self, double p, RNG generator) {
+  if (at::globalContext().philoxCPURNG()) {
+    const uint64_t seed = philox_seed(generator);
+    AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Bool, self.scalar_type(), "bernoulli_scalar_cpu_", [&] {
+      philox_fill<scalar_t>(self, seed, 1, [p](int64_t /*i*/, at::Philox4_32_10& engine) -> scalar_t {
+        const float u = philox_uniform<float>(engine, 0.f, 1.f);
+        return static_cast<scalar_t>(u < p);
+      });
+    });
+    return;
+  }
   AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Bool, self.scalar_type(), "bernoulli_scalar_cpu_", [&] {
     // See Note [Acquire lock when using random generators]
     std::lock_guard<std::mutex> lock(generator->mutex_);
@@ -0,0 +1,215 @@
+#include <ATen/native/FusedOptimizer.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+namespace at { namespace native { namespace {
+
+using namespace vec256;
+
+// Runs f(i, begin, end) over the elements [begin, end) of self[i], for all the
+// elements of all the tensors of self. The tensors are laid end to end and
+// the combined range is split with parallel_for, so one task can cover many
+// small tensors or part of a large one.
+template <typename func_t>
+void fused_parallel_for(TensorList self, const func_t& f) {
+  std::vector<int64_t> offsets(self.size() + 1, 0);
+  for (size_t i = 0; i < self.size(); i++) {
+    offsets[i + 1] = offsets[i] + self[i].numel();
+  }
+  at::parallel_for(0, offsets.back(), internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    // The last tensor that starts at or before begin.
+    int64_t i = std::upper_bound(offsets.begin(), offsets.end(), begin) - offsets.begin() - 1;
+    for (; begin < end; i++) {
+      const int64_t tensor_end = std::min(end, offsets[i + 1]);
+      if (tensor_end > begin) {
+        f(i, begin - offsets[i], tensor_end - offsets[i]);
+      }
+      begin = tensor_end;
+    }
+  });
+}
+
+// Calls f(j, n) for j = begin, begin + Vec::size(), ... where n is the number
+// of elements left in the vector, so that the tail of the range goes through
+// the same arithmetic as the rest of it.
+template <typename scalar_t, typename func_t>
+inline void vectorized_range(int64_t begin, int64_t end, const func_t& f) {
+  constexpr int64_t size = Vec256<scalar_t>::size();
+  for (int64_t j = begin; j < end; j += size) {
+    f(j, std::min(size, end - j));
+  }
+}
+
+template <typename scalar_t>
+inline Vec256<scalar_t> load(const scalar_t* data, int64_t n) {
+  using Vec = Vec256<scalar_t>;
+  return n == Vec::size() ? Vec::loadu(data) : Vec::loadu(data, n);
+}
+
+template <typename scalar_t>
+inline void store(const Vec256<scalar_t>& v, scalar_t* data, int64_t n) {
+  if (n == Vec256<scalar_t>::size()) {
+    v.store(data);
+  } else {
+    v.store(data, n);
+  }
+}
+
+void fused_sgd_kernel(TensorList self, TensorList grads, TensorList momentum_buffers,
+    double lr, double momentum, double dampening, double weight_decay, bool nesterov, bool is_first_step) {
+  fused_parallel_for(self, [&](int64_t i, int64_t begin, int64_t end) {
+    AT_DISPATCH_FLOATING_TYPES(self[i].scalar_type(), "fused_sgd_cpu", [&] {
+      using Vec = Vec256<scalar_t>;
+      scalar_t* param = self[i].data_ptr<scalar_t>();
+      const scalar_t* grad = grads[i].data_ptr<scalar_t>();
+      scalar_t* buf = momentum != 0 ? momentum_buffers[i].data_ptr<scalar_t>() : nullptr;
+      const Vec weight_decay_v(static_cast<scalar_t>(weight_decay));
+      const Vec momentum_v(static_cast<scalar_t>(momentum));
+      const Vec one_minus_dampening_v(static_cast<scalar_t>(1 - dampening));
+      const Vec neg_lr_v(static_cast<scalar_t>(-lr));
+
+      vectorized_range<scalar_t>(begin, end, [&](int64_t j, int64_t n) {
+        const Vec p = load(param + j, n);
+        Vec d_p = load(grad + j, n);
+        if (weight_decay != 0) {
+          d_p = d_p + p * weight_decay_v;
+        }
+        if (momentum != 0) {
+          const Vec b = is_first_step ? d_p : load(buf + j, n) * momentum_v + d_p * one_minus_dampening_v;
+          store(b, buf + j, n);
+          d_p = nesterov ? d_p + b * momentum_v : b;
+        }
+        store(p + d_p * neg_lr_v, param + j, n);
+      });
+    });
+  });
+}
+
+void fused_adam_kernel(TensorList self, TensorList grads, TensorList exp_avgs,
+    TensorList exp_avg_sqs, TensorList max_exp_avg_sqs, ArrayRef<double> step_sizes,
+    ArrayRef<double> bias_correction2_sqrts, double beta1, double beta2, double weight_decay,
+    double eps, bool amsgrad) {
+  fused_parallel_for(self, [&](int64_t i, int64_t begin, int64_t end) {
+    AT_DISPATCH_FLOATING_TYPES(self[i].scalar_type(), "fused_adam_cpu", [&] {
+      using Vec = Vec256<scalar_t>;
+      scalar_t* param = self[i].data_ptr<scalar_t>();
+      const scalar_t* grad = grads[i].data_ptr<scalar_t>();
+      scalar_t* exp_avg = exp_avgs[i].data_ptr<scalar_t>();
+      scalar_t* exp_avg_sq = exp_avg_sqs[i].data_ptr<scalar_t>();
+      scalar_t* max_exp_avg_sq = amsgrad ? max_exp_avg_sqs[i].data_ptr<scalar_t>() : nullptr;
+      const Vec weight_decay_v(static_cast<scalar_t>(weight_decay));
+      const Vec beta1_v(static_cast<scalar_t>(beta1));
+      const Vec one_minus_beta1_v(static_cast<scalar_t>(1 - beta1));
+      const Vec beta2_v(static_cast<scalar_t>(beta2));
+      const Vec one_minus_beta2_v(static_cast<scalar_t>(1 - beta2));
+      const Vec bias_correction2_sqrt_v(static_cast<scalar_t>(bias_correction2_sqrts[i]));
+      const Vec eps_v(static_cast<scalar_t>(eps));
+      const Vec neg_step_size_v(static_cast<scalar_t>(-step_sizes[i]));
+
+      vectorized_range<scalar_t>(begin, end, [&](int64_t j, int64_t n) {
+        const Vec p = load(param + j, n);
+        Vec g = load(grad + j, n);
+        if (weight_decay != 0) {
+          g = g + p * weight_decay_v;
+        }
+        const Vec m = load(exp_avg + j, n) * beta1_v + g * one_minus_beta1_v;
+        Vec v = load(exp_avg_sq + j, n) * beta2_v + g * g * one_minus_beta2_v;
+        store(m, exp_avg + j, n);
+        store(v, exp_avg_sq + j, n);
+        if (amsgrad) {
+          // Normalize by the maximum of all 2nd moment running averages so far
+          v = maximum(load(max_exp_avg_sq + j, n), v);
+          store(v, max_exp_avg_sq + j, n);
+        }
+        const Vec denom = v.sqrt() / bias_correction2_sqrt_v + eps_v;
+        store(p + neg_step_size_v * (m / denom), param + j, n);
+      });
+    });
+  });
+}
+
+void fused_adagrad_kernel(TensorList self, TensorList grads, TensorList state_sums,
+    ArrayRef<double> clrs, double weight_decay, double eps) {
+  fused_parallel_for(self, [&](int64_t i, int64_t begin, int64_t end) {
+    AT_DISPATCH_FLOATING_TYPES(self[i].scalar_type(), "fused_adagrad_cpu", [&] {
+      using Vec = Vec256<scalar_t>;
+      scalar_t* param = self[i].data_ptr<scalar_t>();
+      const scalar_t* grad = grads[i].data_ptr<scalar_t>();
+      scalar_t* state_sum = state_sums[i].data_ptr<scalar_t>();
+      const Vec weight_decay_v(static_cast<scalar_t>(weight_decay));
+      const Vec eps_v(static_cast<scalar_t>(eps));
+      const Vec neg_clr_v(static_cast<scalar_t>(-clrs[i]));
+
+      vectorized_range<scalar_t>(begin, end, [&](int64_t j, int64_t n) {
+        const Vec p = load(param + j, n);
+        Vec g = load(grad + j, n);
+        if (weight_decay != 0) {
+          g = g + p * weight_decay_v;
+        }
+        const Vec sum = load(state_sum + j, n) + g * g;
+        store(sum, state_sum + j, n);
+        const Vec std = sum.sqrt() + eps_v;
+        store(p + neg_clr_v * (g / std), param + j, n);
+      });
+    });
+  });
+}
+
+void fused_rmsprop_kernel(TensorList self, TensorList grads, TensorList square_avgs,
+    TensorList grad_avgs, TensorList momentum_buffers, double lr, double alpha, double eps,
+    double weight_decay, double momentum, bool centered) {
+  fused_parallel_for(self, [&](int64_t i, int64_t begin, int64_t end) {
+    AT_DISPATCH_FLOATING_TYPES(self[i].scalar_type(), "fused_rmsprop_cpu", [&] {
+      using Vec = Vec256<scalar_t>;
+      scalar_t* param = self[i].data_ptr<scalar_t>();
+      const scalar_t* grad = grads[i].data_ptr<scalar_t>();
+      scalar_t* square_avg = square_avgs[i].data_ptr<scalar_t>();
+      scalar_t* grad_avg = centered ? grad_avgs[i].data_ptr<scalar_t>() : nullptr;
+      scalar_t* buf = momentum > 0 ? momentum_buffers[i].data_ptr<scalar_t>() : nullptr;
+      const Vec weight_decay_v(static_cast<scalar_t>(weight_decay));
+      const Vec alpha_v(static_cast<scalar_t>(alpha));
+      const Vec one_minus_alpha_v(static_cast<scalar_t>(1 - alpha));
+      const Vec eps_v(static_cast<scalar_t>(eps));
+      const Vec momentum_v(static_cast<scalar_t>(momentum));
+      const Vec neg_lr_v(static_cast<scalar_t>(-lr));
+
+      vectorized_range<scalar_t>(begin, end, [&](int64_t j, int64_t n) {
+        const Vec p = load(param + j, n);
+        Vec g = load(grad + j, n);
+        if (weight_decay != 0) {
+          g = g + p * weight_decay_v;
+        }
+        const Vec sq = load(square_avg + j, n) * alpha_v + g * g * one_minus_alpha_v;
+        store(sq, square_avg + j, n);
+        Vec avg;
+        if (centered) {
+          const Vec ga = load(grad_avg + j, n) * alpha_v + g * one_minus_alpha_v;
+          store(ga, grad_avg + j, n);
+          avg = (sq - ga * ga).sqrt() + eps_v;
+        } else {
+          avg = sq.sqrt() + eps_v;
+        }
+        Vec update = g / avg;
+        if (momentum > 0) {
+          update = load(buf + j, n) * momentum_v + update;
+          store(update, buf + j, n);
+        }
+        store(p + update * neg_lr_v, param + j, n);
+      });
+    });
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(fused_sgd_stub, &fused_sgd_kernel);
+REGISTER_DISPATCH(fused_adam_stub, &fused_adam_kernel);
+REGISTER_DISPATCH(fused_adagrad_stub, &fused_adagrad_kernel);
+REGISTER_DISPATCH(fused_rmsprop_stub, &fused_rmsprop_kernel);
+
+}} // namespace at::native
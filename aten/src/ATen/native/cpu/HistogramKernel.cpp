@@ -0,0 +1,82 @@
+#include <ATen/native/SummaryOps.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+namespace at { namespace native { namespace {
+
+using namespace vec256;
+
+// Each chunk of the input is counted into its own histogram of int64 counts,
+// and the histograms are summed bin by bin at the end. Bin positions are
+// computed Vec::size() elements at a time, with the same arithmetic as the
+// scalar tail so that both agree on elements that fall on a bin edge.
+template <typename scalar_t>
+void cpu_histc(Tensor& hist, const Tensor& self, scalar_t minval, scalar_t maxval) {
+  using Vec = Vec256<scalar_t>;
+  const int64_t nbins = hist.size(0);
+  const int64_t numel = self.numel();
+  const scalar_t* self_data = self.data_ptr<scalar_t>();
+  const scalar_t range = maxval - minval;
+
+  const int64_t num_chunks = std::max<int64_t>(1, std::min<int64_t>(
+      at::get_num_threads(), divup(numel, internal::GRAIN_SIZE)));
+  const int64_t chunk_size = std::max<int64_t>(1, divup(numel, num_chunks));
+  std::vector<int64_t> chunk_hists(num_chunks * nbins, 0);
+
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    const Vec min_vec(minval);
+    const Vec range_vec(range);
+    const Vec nbins_vec(static_cast<scalar_t>(nbins));
+    __at_align32__ scalar_t pos[Vec::size()];
+
+    for (int64_t c = begin; c < end; c++) {
+      int64_t* chunk_hist = chunk_hists.data() + c * nbins;
+      auto count = [&](scalar_t value, scalar_t bin_pos) {
+        if (value >= minval && value <= maxval) {
+          chunk_hist[std::min(static_cast<int64_t>(bin_pos), nbins - 1)] += 1;
+        }
+      };
+
+      const int64_t chunk_end = std::min(numel, (c + 1) * chunk_size);
+      int64_t i = c * chunk_size;
+      for (; i + Vec::size() <= chunk_end; i += Vec::size()) {
+        const Vec values = Vec::loadu(self_data + i);
+        ((values - min_vec) / range_vec * nbins_vec).store(pos);
+        for (int64_t j = 0; j < Vec::size(); j++) {
+          count(self_data[i + j], pos[j]);
+        }
+      }
+      for (; i < chunk_end; i++) {
+        count(self_data[i], (self_data[i] - minval) / range * static_cast<scalar_t>(nbins));
+      }
+    }
+  });
+
+  scalar_t* hist_data = hist.data_ptr<scalar_t>();
+  at::parallel_for(0, nbins, internal::GRAIN_SIZE / num_chunks, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; b++) {
+      int64_t total = 0;
+      for (int64_t c = 0; c < num_chunks; c++) {
+        total += chunk_hists[c * nbins + b];
+      }
+      hist_data[b] = static_cast<scalar_t>(total);
+    }
+  });
+}
+
+static void histc_kernel(Tensor& hist, const Tensor& self, Scalar min, Scalar max) {
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "histc_cpu", [&] {
+    cpu_histc<scalar_t>(hist, self, min.to<scalar_t>(), max.to<scalar_t>());
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(histc_stub, &histc_kernel);
+
+}} // namespace at::native
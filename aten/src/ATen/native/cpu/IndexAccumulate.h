@@ -0,0 +1,102 @@
+#pragma once
+
+// Helpers for running scatter-style accumulations (index_put_ with
+// accumulate=True, index_add_) on several threads without atomics.
+//
+// The updates are grouped by destination into buckets with a parallel,
+// stable counting sort. Every destination falls into exactly one bucket, so
+// buckets can be applied concurrently, and within a bucket the updates are
+// applied in their original order. The result is therefore bitwise identical
+// to the serial loop, whatever the number of threads.
+
+#include <ATen/Parallel.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace at { namespace native {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+// Number of buckets to split the destinations into. A few buckets per
+// thread keeps the threads busy when some destinations get more updates
+// than others.
+inline int64_t index_accumulate_num_buckets(int64_t max_buckets) {
+  return std::max<int64_t>(1, std::min<int64_t>(max_buckets, at::get_num_threads() * 4));
+}
+
+// Stable parallel counting sort of the items [0, n) by bucket(i), which must
+// return a value in [0, num_buckets). On return the items of bucket b are
+// perm[offsets[b]], ..., perm[offsets[b + 1] - 1], in increasing order.
+//
+// The input is split into a fixed number of chunks instead of relying on
+// parallel_for's chunking, so that the per-chunk counts can be combined in
+// order.
+template <typename bucket_fn_t>
+void index_accumulate_sort(
+    int64_t n,
+    int64_t num_buckets,
+    const bucket_fn_t& bucket,
+    std::vector<int64_t>& offsets,
+    std::vector<int64_t>& perm) {
+  const int64_t num_chunks = std::max<int64_t>(1, std::min<int64_t>(
+      at::get_num_threads(), divup(n, internal::GRAIN_SIZE)));
+  const int64_t chunk_size = divup(n, num_chunks);
+
+  // counts[c * num_buckets + b] is the number of items of chunk c in bucket
+  // b; after the scan it is where chunk c writes its first item of bucket b.
+  std::vector<int64_t> counts(num_chunks * num_buckets, 0);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; c++) {
+      int64_t* chunk_counts = counts.data() + c * num_buckets;
+      const int64_t item_end = std::min(n, (c + 1) * chunk_size);
+      for (int64_t i = c * chunk_size; i < item_end; i++) {
+        chunk_counts[bucket(i)]++;
+      }
+    }
+  });
+
+  offsets.resize(num_buckets + 1);
+  int64_t total = 0;
+  for (int64_t b = 0; b < num_buckets; b++) {
+    offsets[b] = total;
+    for (int64_t c = 0; c < num_chunks; c++) {
+      const int64_t count = counts[c * num_buckets + b];
+      counts[c * num_buckets + b] = total;
+      total += count;
+    }
+  }
+  offsets[num_buckets] = total;
+
+  perm.resize(n);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; c++) {
+      int64_t* chunk_pos = counts.data() + c * num_buckets;
+      const int64_t item_end = std::min(n, (c + 1) * chunk_size);
+      for (int64_t i = c * chunk_size; i < item_end; i++) {
+        perm[chunk_pos[bucket(i)]++] = i;
+      }
+    }
+  });
+}
+
+// Calls f(b, items, count) once per non-empty bucket, running different
+// buckets on different threads. items points at count indices in increasing
+// order.
+template <typename func_t>
+void index_accumulate_for_each_bucket(
+    const std::vector<int64_t>& offsets,
+    const std::vector<int64_t>& perm,
+    const func_t& f) {
+  const int64_t num_buckets = offsets.size() - 1;
+  at::parallel_for(0, num_buckets, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; b++) {
+      const int64_t count = offsets[b + 1] - offsets[b];
+      if (count > 0) {
+        f(b, perm.data() + offsets[b], count);
+      }
+    }
+  });
+}
+
+}}} // namespace at::native::<anonymous>
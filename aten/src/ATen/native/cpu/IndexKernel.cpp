@@ -2,11 +2,14 @@
 
 #include <cmath>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <numeric>
 #include <ATen/Dispatch.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/Parallel.h>
 #include <ATen/cpu/vec256/vec256.h>
-#include <ATen/native/cpu/AtomicAddFloat.h>
+#include <ATen/native/cpu/IndexAccumulate.h>
 
 namespace at { namespace native {
 namespace {
@@ -106,19 +109,69 @@ void index_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef inde
   });
 }
 
+// index_put_ with accumulate=True on several threads. Duplicate indices make
+// the updates race with each other, so instead of splitting the iteration
+// space we collect the (dst, src) pointers of a block of elements, group them
+// by destination address (see IndexAccumulate.h) and let each thread add up
+// whole groups in iteration order. Blocks are applied one after another to
+// bound the extra memory, so the result is the same as the serial kernel's.
+template <typename scalar_t>
+void cpu_index_put_accumulate_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef index_stride) {
+  int ntensor = iter.ntensors();
+  const int64_t numel = iter.numel();
+  // 16 bytes of pointers plus 8 bytes of permutation per element
+  const int64_t block_size = std::min<int64_t>(numel, int64_t(1) << 20);
+  std::vector<std::pair<char*, char*>> entries(block_size);
+  std::vector<int64_t> offsets;
+  std::vector<int64_t> perm;
+
+  for (int64_t block_begin = 0; block_begin < numel; block_begin += block_size) {
+    const int64_t block_end = std::min(numel, block_begin + block_size);
+    uintptr_t dst_lo = std::numeric_limits<uintptr_t>::max();
+    uintptr_t dst_hi = 0;
+    std::mutex dst_range_mutex;
+    at::parallel_for(block_begin, block_end, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+      auto entry = entries.begin() + (begin - block_begin);
+      uintptr_t lo = std::numeric_limits<uintptr_t>::max();
+      uintptr_t hi = 0;
+      iter.serial_for_each([&](char** data, const int64_t* strides, int64_t n) {
+        auto indexer = Indexer(ntensor - 2, &data[2], &strides[2], index_size, index_stride);
+        for (int64_t i = 0; i < n; i++) {
+          char* dst = data[0] + strides[0] * i + indexer.get(i);
+          lo = std::min(lo, reinterpret_cast<uintptr_t>(dst));
+          hi = std::max(hi, reinterpret_cast<uintptr_t>(dst));
+          *entry++ = {dst, data[1] + strides[1] * i};
+        }
+      }, {begin, end});
+      std::lock_guard<std::mutex> guard(dst_range_mutex);
+      dst_lo = std::min(dst_lo, lo);
+      dst_hi = std::max(dst_hi, hi);
+    });
+
+    const int64_t num_buckets = index_accumulate_num_buckets((dst_hi - dst_lo) / sizeof(scalar_t) + 1);
+    const uintptr_t bucket_width = (dst_hi - dst_lo) / num_buckets + 1;
+    index_accumulate_sort(block_end - block_begin, num_buckets, [&](int64_t i) {
+      return static_cast<int64_t>((reinterpret_cast<uintptr_t>(entries[i].first) - dst_lo) / bucket_width);
+    }, offsets, perm);
+    index_accumulate_for_each_bucket(offsets, perm, [&](int64_t /*bucket*/, const int64_t* items, int64_t count) {
+      for (int64_t k = 0; k < count; k++) {
+        const auto& entry = entries[items[k]];
+        *(scalar_t*)entry.first += *(scalar_t*)entry.second;
+      }
+    });
+  }
+}
+
 void index_put_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef index_stride, bool accumulate) {
   // NOTE: duplicate indices are only supported if accumulate is true.
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(at::ScalarType::Half, at::ScalarType::Bool, at::ScalarType::BFloat16,
     iter.dtype(), "index_put", [&] {
     if (accumulate) {
-      bool use_parallel_for = ((iter.numel() >= internal::GRAIN_SIZE) && (at::get_num_threads() > 1));
-      if (iter.dtype() == at::ScalarType::Float && use_parallel_for) {
-        cpu_index_kernel<float>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
-          cpu_atomic_add_float((float*)(dst + offset), *(float*)src);
-        });
+      bool use_parallel_for = ((iter.numel() >= internal::GRAIN_SIZE) && (at::get_num_threads() > 1) &&
+                               !at::in_parallel_region());
+      if (use_parallel_for) {
+        cpu_index_put_accumulate_kernel<scalar_t>(iter, index_size, index_stride);
       } else {
-        // TODO: investigate parallelization of the accumulate kernel. Unlike the non-accumulate case,
-        // this needs to be thread-safe.
         cpu_index_kernel<scalar_t>(iter, index_size, index_stride, [](char* dst, char* src, int64_t offset) {
           *(scalar_t*)(dst + offset) += *(scalar_t*)src;
         }, /*serial_execution=*/true);
@@ -241,6 +294,73 @@ void masked_select_kernel(TensorIterator& iter) {
     });
 }
 
+// Writes the indices of the nonzero elements of the contiguous tensor self
+// into result, in row-major order. Both passes split self into the same
+// chunks: the first counts the nonzero elements of each chunk, and after a
+// scan over the counts the second writes each chunk's indices at its offset.
+void nonzero_kernel(Tensor& result, const Tensor& self) {
+  const int64_t numel = self.numel();
+  const int64_t ndim = self.dim();
+  const int64_t num_chunks = std::max<int64_t>(1, std::min<int64_t>(
+      at::get_num_threads(), divup(numel, internal::GRAIN_SIZE)));
+  const int64_t chunk_size = std::max<int64_t>(1, divup(numel, num_chunks));
+  std::vector<int64_t> chunk_offsets(num_chunks + 1, 0);
+
+  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(at::ScalarType::Half, at::ScalarType::Bool, at::ScalarType::BFloat16,
+    self.scalar_type(), "nonzero_cpu", [&] {
+    const scalar_t* self_data = self.data_ptr<scalar_t>();
+
+    at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t c = begin; c < end; c++) {
+        const int64_t chunk_end = std::min(numel, (c + 1) * chunk_size);
+        int64_t count = 0;
+        for (int64_t i = c * chunk_size; i < chunk_end; i++) {
+          count += self_data[i] != scalar_t(0);
+        }
+        chunk_offsets[c + 1] = count;
+      }
+    });
+    std::partial_sum(chunk_offsets.begin(), chunk_offsets.end(), chunk_offsets.begin());
+
+    result.resize_({chunk_offsets[num_chunks], ndim});
+    if (result.numel() == 0) {
+      return;
+    }
+    int64_t* result_data = result.data_ptr<int64_t>();
+    const int64_t result_stride0 = result.stride(0);
+    const int64_t result_stride1 = result.stride(1);
+    const auto sizes = self.sizes();
+
+    at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+      DimVector index(static_cast<size_t>(ndim));
+      for (int64_t c = begin; c < end; c++) {
+        const int64_t chunk_begin = c * chunk_size;
+        const int64_t chunk_end = std::min(numel, chunk_begin + chunk_size);
+        int64_t linear_index = chunk_begin;
+        for (int64_t d = ndim - 1; d >= 0; d--) {
+          index[d] = linear_index % sizes[d];
+          linear_index /= sizes[d];
+        }
+        int64_t* out = result_data + chunk_offsets[c] * result_stride0;
+        for (int64_t i = chunk_begin; i < chunk_end; i++) {
+          if (self_data[i] != scalar_t(0)) {
+            for (int64_t d = 0; d < ndim; d++) {
+              out[d * result_stride1] = index[d];
+            }
+            out += result_stride0;
+          }
+          for (int64_t d = ndim - 1; d >= 0; d--) {
+            if (++index[d] < sizes[d]) {
+              break;
+            }
+            index[d] = 0;
+          }
+        }
+      }
+    });
+  });
+}
+
 } // anonymous namespace
 
 REGISTER_DISPATCH(index_stub, &index_kernel);
@@ -248,5 +368,6 @@ REGISTER_DISPATCH(index_put_stub, &index_put_kernel);
 REGISTER_DISPATCH(masked_fill_stub, &masked_fill_kernel);
 REGISTER_DISPATCH(masked_select_serial_stub, &masked_select_serial_kernel);
 REGISTER_DISPATCH(masked_select_stub, &masked_select_kernel);
+REGISTER_DISPATCH(nonzero_stub, &nonzero_kernel);
 
 }} // namespace at::native
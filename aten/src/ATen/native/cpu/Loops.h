@@ -22,6 +22,9 @@
 //     [](float a, float b) { return a * b; },
 //     [](Vec256<float> a, Vec256<float> b) { return a * b; });
 //
+// The vector lambda may also take vec512::Vectorized<float>, which is
+// Vec512<float> in the AVX512 build of the kernel and Vec256<float> otherwise.
+//
 // See BinaryOpsKernel.cpp for the complete implementation
 //
 //
@@ -136,7 +139,7 @@ static inline void
 vectorized_loop(char** C10_RESTRICT data_, int64_t n, int64_t S, func_t&& op, vec_func_t&& vop) {
   using traits = function_traits<vec_func_t>;
   using scalar_t = typename function_traits<func_t>::result_type;
-  using Vec = Vec256<scalar_t>;
+  using Vec = typename traits::result_type;
   constexpr int ntensors = traits::arity + 1;
 
   char* C10_RESTRICT data[ntensors];
@@ -0,0 +1,129 @@
+#include <ATen/native/RNN.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <cmath>
+
+namespace at { namespace native {
+namespace {
+
+using namespace vec256;
+
+template <typename scalar_t>
+inline scalar_t sigmoid_scalar(scalar_t a) {
+  return static_cast<scalar_t>(1) / (static_cast<scalar_t>(1) + std::exp(-a));
+}
+
+template <typename scalar_t>
+inline Vec256<scalar_t> sigmoid_vec(Vec256<scalar_t> a) {
+  const Vec256<scalar_t> one(static_cast<scalar_t>(1));
+  return (one + a.neg().exp()).reciprocal();
+}
+
+// LSTM cell pointwise math in a single pass over each batch row.
+// gates is [batch, 4 * hidden] holding the (ingate, forgetgate, cellgate,
+// outgate) pre-activations with both biases already applied.
+void lstm_cell_pointwise_kernel(
+    Tensor& hy,
+    Tensor& cy,
+    const Tensor& gates,
+    const Tensor& cx) {
+  const int64_t batch_size = cx.size(0);
+  const int64_t hidden_size = cx.size(1);
+  AT_DISPATCH_FLOATING_TYPES(gates.scalar_type(), "lstm_cell_pointwise_cpu", [&] {
+    using Vec = Vec256<scalar_t>;
+    const scalar_t* gates_data = gates.data_ptr<scalar_t>();
+    const scalar_t* cx_data = cx.data_ptr<scalar_t>();
+    scalar_t* hy_data = hy.data_ptr<scalar_t>();
+    scalar_t* cy_data = cy.data_ptr<scalar_t>();
+    // roughly 3 exp, 2 tanh and a handful of FMAs per element
+    const int64_t grain_size =
+        std::max<int64_t>(1, internal::GRAIN_SIZE / (16 * hidden_size));
+    parallel_for(0, batch_size, grain_size, [&](int64_t begin, int64_t end) {
+      for (int64_t b = begin; b < end; b++) {
+        const scalar_t* i_ptr = gates_data + b * 4 * hidden_size;
+        const scalar_t* f_ptr = i_ptr + hidden_size;
+        const scalar_t* g_ptr = f_ptr + hidden_size;
+        const scalar_t* o_ptr = g_ptr + hidden_size;
+        const scalar_t* cx_ptr = cx_data + b * hidden_size;
+        scalar_t* hy_ptr = hy_data + b * hidden_size;
+        scalar_t* cy_ptr = cy_data + b * hidden_size;
+        int64_t d = 0;
+        for (; d < hidden_size - (hidden_size % Vec::size()); d += Vec::size()) {
+          const Vec ingate = sigmoid_vec(Vec::loadu(i_ptr + d));
+          const Vec forgetgate = sigmoid_vec(Vec::loadu(f_ptr + d));
+          const Vec cellgate = Vec::loadu(g_ptr + d).tanh();
+          const Vec outgate = sigmoid_vec(Vec::loadu(o_ptr + d));
+          const Vec c = forgetgate * Vec::loadu(cx_ptr + d) + ingate * cellgate;
+          c.store(cy_ptr + d);
+          (outgate * c.tanh()).store(hy_ptr + d);
+        }
+        for (; d < hidden_size; d++) {
+          const scalar_t c = sigmoid_scalar(f_ptr[d]) * cx_ptr[d] +
+              sigmoid_scalar(i_ptr[d]) * std::tanh(g_ptr[d]);
+          cy_ptr[d] = c;
+          hy_ptr[d] = sigmoid_scalar(o_ptr[d]) * std::tanh(c);
+        }
+      }
+    });
+  });
+}
+
+// GRU cell pointwise math in a single pass over each batch row.
+// igates and hgates are [batch, 3 * hidden] holding the (reset, input, new)
+// pre-activations of the input and hidden projections, biases applied.
+void gru_cell_pointwise_kernel(
+    Tensor& hy,
+    const Tensor& igates,
+    const Tensor& hgates,
+    const Tensor& hx) {
+  const int64_t batch_size = hx.size(0);
+  const int64_t hidden_size = hx.size(1);
+  AT_DISPATCH_FLOATING_TYPES(igates.scalar_type(), "gru_cell_pointwise_cpu", [&] {
+    using Vec = Vec256<scalar_t>;
+    const scalar_t* igates_data = igates.data_ptr<scalar_t>();
+    const scalar_t* hgates_data = hgates.data_ptr<scalar_t>();
+    const scalar_t* hx_data = hx.data_ptr<scalar_t>();
+    scalar_t* hy_data = hy.data_ptr<scalar_t>();
+    const int64_t grain_size =
+        std::max<int64_t>(1, internal::GRAIN_SIZE / (16 * hidden_size));
+    parallel_for(0, batch_size, grain_size, [&](int64_t begin, int64_t end) {
+      for (int64_t b = begin; b < end; b++) {
+        const scalar_t* ir_ptr = igates_data + b * 3 * hidden_size;
+        const scalar_t* ii_ptr = ir_ptr + hidden_size;
+        const scalar_t* in_ptr = ii_ptr + hidden_size;
+        const scalar_t* hr_ptr = hgates_data + b * 3 * hidden_size;
+        const scalar_t* hi_ptr = hr_ptr + hidden_size;
+        const scalar_t* hn_ptr = hi_ptr + hidden_size;
+        const scalar_t* hx_ptr = hx_data + b * hidden_size;
+        scalar_t* hy_ptr = hy_data + b * hidden_size;
+        int64_t d = 0;
+        for (; d < hidden_size - (hidden_size % Vec::size()); d += Vec::size()) {
+          const Vec reset_gate =
+              sigmoid_vec(Vec::loadu(ir_ptr + d) + Vec::loadu(hr_ptr + d));
+          const Vec input_gate =
+              sigmoid_vec(Vec::loadu(ii_ptr + d) + Vec::loadu(hi_ptr + d));
+          const Vec new_gate =
+              (Vec::loadu(in_ptr + d) + reset_gate * Vec::loadu(hn_ptr + d)).tanh();
+          ((Vec::loadu(hx_ptr + d) - new_gate) * input_gate + new_gate)
+              .store(hy_ptr + d);
+        }
+        for (; d < hidden_size; d++) {
+          const scalar_t reset_gate = sigmoid_scalar(ir_ptr[d] + hr_ptr[d]);
+          const scalar_t input_gate = sigmoid_scalar(ii_ptr[d] + hi_ptr[d]);
+          const scalar_t new_gate = std::tanh(in_ptr[d] + reset_gate * hn_ptr[d]);
+          hy_ptr[d] = (hx_ptr[d] - new_gate) * input_gate + new_gate;
+        }
+      }
+    });
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(lstm_cell_pointwise_stub, &lstm_cell_pointwise_kernel);
+REGISTER_DISPATCH(gru_cell_pointwise_stub, &gru_cell_pointwise_kernel);
+
+}} // namespace at::native
@@ -1,8 +1,10 @@
 #include <numeric>
 #include <iterator>
 #include <algorithm>
+#include <tuple>
 
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 #include <ATen/cpu/vec256/vec256.h>
 #include <ATen/native/ReduceOps.h>
 #include <ATen/native/ReduceOpsUtils.h>
@@ -18,12 +20,60 @@ namespace at { namespace native { namespace {
 
 using namespace vec256;
 
-template <typename scalar_t, typename func_t>
+// Blocked parallel scan of one slice along the scanned dimension, for when
+// the slices alone cannot keep the threads busy. The slice is cut into
+// blocks of a fixed size, so the result does not depend on the number of
+// threads:
+//   1) the blocks are reduced in parallel,
+//   2) the block totals are scanned serially into per-block carries,
+//   3) the blocks are scanned in parallel, each starting from its carry.
+template <typename scalar_t, typename acc_t, typename op_t>
+static void cpu_cum_parallel_scan(
+    scalar_t* result_data, int64_t result_dim_stride,
+    const scalar_t* self_data, int64_t self_dim_stride,
+    int64_t self_dim_size, const op_t& op, acc_t init_val) {
+  const int64_t block_size = internal::GRAIN_SIZE;
+  const int64_t num_blocks = divup(self_dim_size, block_size);
+
+  // carries[b] is the scan of everything before block b. The last block's
+  // total is not needed.
+  std::vector<acc_t> carries(num_blocks, init_val);
+  at::parallel_for(0, num_blocks - 1, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; b++) {
+      acc_t total = init_val;
+      for (int64_t i = b * block_size; i < (b + 1) * block_size; ++i) {
+        op(total, self_data[i * self_dim_stride]);
+      }
+      carries[b + 1] = total;
+    }
+  });
+  for (int64_t b = 1; b < num_blocks; b++) {
+    acc_t carry = carries[b - 1];
+    op(carry, carries[b]);
+    carries[b] = carry;
+  }
+
+  at::parallel_for(0, num_blocks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; b++) {
+      acc_t cum_number = carries[b];
+      const int64_t block_end = std::min(self_dim_size, (b + 1) * block_size);
+      for (int64_t i = b * block_size; i < block_end; ++i) {
+        op(cum_number, self_data[i * self_dim_stride]);
+        result_data[i * result_dim_stride] = (scalar_t)cum_number;
+      }
+    }
+  });
+}
+
+// op(acc, x) folds x into the running value acc, where x is either an input
+// element or another running value; it must be associative for the parallel
+// scan to be correct.
+template <typename scalar_t, typename acc_t, typename op_t>
 static inline void cpu_cum_base_kernel(Tensor& result,
     const Tensor& self,
     int64_t dim,
-    const func_t& f,
-    scalar_t init_val) {
+    const op_t& op,
+    acc_t init_val) {
   if (result.sizes() != self.sizes()) {
     result.resize_as_(self);
   }
@@ -46,85 +96,187 @@ static inline void cpu_cum_base_kernel(Tensor& result,
 
   auto result_dim_stride = ensure_nonempty_stride(result, dim);
   auto self_dim_stride = ensure_nonempty_stride(self, dim);
+  auto self_dim_size = ensure_nonempty_size(self, dim);
+
+  // Parallelizing over the other dimensions leaves threads idle when there
+  // are only a few slices; scan each long slice in parallel instead. The
+  // choice only depends on the shape, as the two scans add up the elements in
+  // a different order: the result must not change with the number of threads.
+  constexpr int64_t max_parallel_scan_slices = 16;
+  const bool use_parallel_scan = self_dim_size >= 2 * internal::GRAIN_SIZE &&
+      iter.numel() <= max_parallel_scan_slices;
 
   auto loop = [&](char** data, const int64_t* strides, int64_t n) {
     auto* result_data_bytes = data[0];
     const auto* self_data_bytes = data[1];
 
     for (int64_t i = 0; i < n; ++i) {
-      f(
-        (scalar_t*)result_data_bytes, result_dim_stride,
-        (scalar_t*)self_data_bytes, self_dim_stride, init_val
-      );
+      auto* result_data = (scalar_t*)result_data_bytes;
+      const auto* self_data = (scalar_t*)self_data_bytes;
+      if (use_parallel_scan) {
+        cpu_cum_parallel_scan(
+          result_data, result_dim_stride, self_data, self_dim_stride,
+          self_dim_size, op, init_val);
+      } else {
+        acc_t cum_number = init_val;
+        for (int64_t j = 0; j < self_dim_size; ++j) {
+          op(cum_number, self_data[j * self_dim_stride]);
+          result_data[j * result_dim_stride] = (scalar_t)cum_number;
+        }
+      }
       result_data_bytes += strides[0];
       self_data_bytes += strides[1];
     }
   };
 
-  iter.for_each(loop);
+  if (use_parallel_scan) {
+    iter.serial_for_each(loop, {0, iter.numel()});
+  } else {
+    iter.for_each(loop);
+  }
 }
 
 static void cumsum_cpu_kernel(Tensor& result, const Tensor& self, int64_t dim) {
   auto wrap_dim = maybe_wrap_dim(dim, self.dim());
-  int64_t self_dim_size = ensure_nonempty_size(self, wrap_dim);
 
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX(self.scalar_type(), "cumsum_out_cpu", [&] {
-    cpu_cum_base_kernel<scalar_t>(result, self, wrap_dim, [&] (
-      scalar_t* result_data, auto result_dim_stride,
-      const scalar_t* self_data, auto self_dim_stride, scalar_t init_val) {
-        auto cum_number = (at::acc_type<scalar_t, false>)init_val;
-        for (int64_t i = 0; i < self_dim_size; ++i) {
-          cum_number += self_data[i * self_dim_stride];
-          result_data[i * result_dim_stride] = (scalar_t)cum_number;
-        }
-      }, /*init_val=*/ 0
+    using acc_t = at::acc_type<scalar_t, false>;
+    cpu_cum_base_kernel<scalar_t>(result, self, wrap_dim, [] (acc_t& cum_number, auto x) {
+        cum_number += x;
+      }, /*init_val=*/ acc_t(0)
     );
   });
 }
 
 static void cumprod_cpu_kernel(Tensor& result, const Tensor& self, int64_t dim) {
   auto wrap_dim = maybe_wrap_dim(dim, self.dim());
-  int64_t self_dim_size = ensure_nonempty_size(self, wrap_dim);
 
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX(self.scalar_type(), "cumprod_out_cpu", [&] {
-    cpu_cum_base_kernel<scalar_t>(result, self, wrap_dim, [&] (
-      scalar_t* result_data, auto result_dim_stride,
-      const scalar_t* self_data, auto self_dim_stride, scalar_t init_val) {
-        auto cum_number = (at::acc_type<scalar_t, false>)init_val;
-        for (int64_t i = 0; i < self_dim_size; ++i) {
-          cum_number *= self_data[i * self_dim_stride];
-          result_data[i * result_dim_stride] = (scalar_t)cum_number;
-        }
-      }, /*init_val=*/ 1
+    using acc_t = at::acc_type<scalar_t, false>;
+    cpu_cum_base_kernel<scalar_t>(result, self, wrap_dim, [] (acc_t& cum_number, auto x) {
+        cum_number *= x;
+      }, /*init_val=*/ acc_t(1)
     );
   });
 }
 
 static void logcumsumexp_cpu_kernel(Tensor& result, const Tensor& self, int64_t dim) {
   auto wrap_dim = maybe_wrap_dim(dim, self.dim());
-  int64_t self_dim_size = ensure_nonempty_size(self, wrap_dim);
 
   AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "logcumsumexp_out_cpu", [&] {
-    cpu_cum_base_kernel<scalar_t>(result, self, wrap_dim, [&] (
-      scalar_t* result_data, auto result_dim_stride,
-      const scalar_t* self_data, auto self_dim_stride, scalar_t init_val) {
-        scalar_t cum_number = (at::acc_type<scalar_t, false>)init_val;
-        for (int64_t i = 0; i < self_dim_size; ++i) {
-          scalar_t x = self_data[i * self_dim_stride];
-
-          // Reference : https://www.tensorflow.org/api_docs/python/tf/math/cumulative_logsumexp
-          auto log_add_exp = [](scalar_t x, scalar_t y) -> scalar_t {
-            return std::log1p(std::exp(std::min(x, y) - std::max(x, y))) + std::max(x, y);
-          };
-          cum_number = log_add_exp(x, cum_number);
-          result_data[i * result_dim_stride] = static_cast<scalar_t>(cum_number);
-        }
+    cpu_cum_base_kernel<scalar_t>(result, self, wrap_dim, [] (scalar_t& cum_number, scalar_t x) {
+        // Reference : https://www.tensorflow.org/api_docs/python/tf/math/cumulative_logsumexp
+        auto log_add_exp = [](scalar_t x, scalar_t y) -> scalar_t {
+          scalar_t min = std::min(x, y);
+          scalar_t max = std::max(x, y);
+          // Adding two equal infinities gives that infinity, not the NaN of
+          // (-inf) - (-inf); a block of the parallel scan may start with -inf
+          if (min != max || std::isfinite(min)) {
+            return std::log1p(std::exp(min - max)) + max;
+          }
+          return x;
+        };
+        cum_number = log_add_exp(x, cum_number);
       }, /*init_val=*/ -std::numeric_limits<scalar_t>::infinity()
     );
   });
 }
 
+// BFloat16 sums are accumulated in float and rounded to BFloat16 once per
+// output element per loop. Adding to a BFloat16 accumulator stops changing it
+// once the partial sum is about 2^8 times larger than the elements. This also
+// covers mean, which is computed as sum + div_ on CPU.
+static void sum_kernel_bfloat16(TensorIterator& iter) {
+  using bVec = Vec256<BFloat16>;
+  using fVec = Vec256<float>;
+  iter.output().fill_(0);
+  iter.parallel_reduce([&](char** data, const int64_t* strides, int64_t size0, int64_t size1) {
+    char* out_data = data[0];
+    char* in_data = data[1];
+    if (strides[0] == 0 && strides[1] == sizeof(BFloat16)) {
+      // input is contiguous in dim 0, output is reduced in dim 0
+      for (int64_t j = 0; j < size1; j++) {
+        const BFloat16* in = reinterpret_cast<const BFloat16*>(in_data + j * strides[3]);
+        BFloat16* out = reinterpret_cast<BFloat16*>(out_data + j * strides[2]);
+        fVec acc0(0), acc1(0);
+        int64_t i = 0;
+        for (; i <= size0 - bVec::size(); i += bVec::size()) {
+          fVec a0, a1;
+          std::tie(a0, a1) = convert_bfloat16_float(bVec::loadu(in + i));
+          acc0 = acc0 + a0;
+          acc1 = acc1 + a1;
+        }
+        float buffer[fVec::size()];
+        (acc0 + acc1).store(buffer);
+        float acc = std::accumulate(buffer, buffer + fVec::size(), 0.0f);
+        for (; i < size0; i++) {
+          acc += static_cast<float>(in[i]);
+        }
+        *out = static_cast<float>(*out) + acc;
+      }
+    } else if (strides[0] == 0 && strides[2] == sizeof(BFloat16) && strides[3] == sizeof(BFloat16)) {
+      // input and output are contiguous in dim 1
+      BFloat16* out = reinterpret_cast<BFloat16*>(out_data);
+      int64_t j = 0;
+      for (; j <= size1 - bVec::size(); j += bVec::size()) {
+        fVec acc0, acc1;
+        std::tie(acc0, acc1) = convert_bfloat16_float(bVec::loadu(out + j));
+        for (int64_t i = 0; i < size0; i++) {
+          const BFloat16* in = reinterpret_cast<const BFloat16*>(in_data + i * strides[1]);
+          fVec a0, a1;
+          std::tie(a0, a1) = convert_bfloat16_float(bVec::loadu(in + j));
+          acc0 = acc0 + a0;
+          acc1 = acc1 + a1;
+        }
+        convert_float_bfloat16(acc0, acc1).store(out + j);
+      }
+      for (; j < size1; j++) {
+        float acc = static_cast<float>(out[j]);
+        for (int64_t i = 0; i < size0; i++) {
+          acc += static_cast<float>(
+              reinterpret_cast<const BFloat16*>(in_data + i * strides[1])[j]);
+        }
+        out[j] = acc;
+      }
+    } else if (strides[0] == 0) {
+      // output is reduced in dim 0
+      for (int64_t j = 0; j < size1; j++) {
+        BFloat16* out = reinterpret_cast<BFloat16*>(out_data + j * strides[2]);
+        const char* in = in_data + j * strides[3];
+        float acc = static_cast<float>(*out);
+        for (int64_t i = 0; i < size0; i++) {
+          acc += static_cast<float>(*reinterpret_cast<const BFloat16*>(in + i * strides[1]));
+        }
+        *out = acc;
+      }
+    } else {
+      // output is reduced in dim 1, or not reduced at all
+      for (int64_t i = 0; i < size0; i++) {
+        char* out = out_data + i * strides[0];
+        const char* in = in_data + i * strides[1];
+        if (strides[2] == 0) {
+          BFloat16* out_ptr = reinterpret_cast<BFloat16*>(out);
+          float acc = static_cast<float>(*out_ptr);
+          for (int64_t j = 0; j < size1; j++) {
+            acc += static_cast<float>(*reinterpret_cast<const BFloat16*>(in + j * strides[3]));
+          }
+          *out_ptr = acc;
+        } else {
+          for (int64_t j = 0; j < size1; j++) {
+            BFloat16* out_ptr = reinterpret_cast<BFloat16*>(out + j * strides[2]);
+            const BFloat16 in_val = *reinterpret_cast<const BFloat16*>(in + j * strides[3]);
+            *out_ptr = static_cast<float>(*out_ptr) + static_cast<float>(in_val);
+          }
+        }
+      }
+    }
+  });
+}
+
 static void sum_kernel_impl(TensorIterator& iter) {
+  if (iter.dtype() == ScalarType::BFloat16) {
+    return sum_kernel_bfloat16(iter);
+  }
   AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(
       ScalarType::BFloat16, ScalarType::Half, ScalarType::Bool, iter.dtype(), "sum_cpu", [&] {
         binary_kernel_reduce_vec(
@@ -267,7 +419,7 @@ static void or_kernel_impl(TensorIterator& iter) {
 }
 
 static void min_values_kernel_impl(TensorIterator& iter) {
-  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND(kHalf, iter.dtype(), "min_values_cpu", [&iter] {
+  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND2(kHalf, kBFloat16, iter.dtype(), "min_values_cpu", [&iter] {
     binary_kernel_reduce_vec(
       iter,
       [](scalar_t a, scalar_t b) -> scalar_t { return min_impl(a, b); },
@@ -276,7 +428,7 @@ static void min_values_kernel_impl(TensorIterator& iter) {
 }
 
 static void max_values_kernel_impl(TensorIterator& iter) {
-  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND(kHalf, iter.dtype(), "max_values_cpu", [&iter] {
+  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND2(kHalf, kBFloat16, iter.dtype(), "max_values_cpu", [&iter] {
     binary_kernel_reduce_vec(
       iter,
       [](scalar_t a, scalar_t b) -> scalar_t { return max_impl(a, b); },
@@ -3,11 +3,14 @@
 #include <algorithm>
 #include <iterator>
 #include <numeric>
+#include <vector>
 
 #include <ATen/Dispatch.h>
 #include <ATen/Parallel.h>
 #include <ATen/cpu/vec256/functional.h>
 #include <ATen/cpu/vec256/vec256.h>
+#include <ATen/cpu/vec512/functional.h>
+#include <ATen/cpu/vec512/vec512.h>
 #include <c10/util/Optional.h>
 
 // [Note AVX-SSE transitions] In general we avoid calls into cmath for code
@@ -28,7 +31,7 @@ inline void _vec_log_softmax_lastdim(
     scalar_t* output_data_base,
     int64_t outer_size,
     int64_t dim_size) {
-  using Vec = vec256::Vec256<scalar_t>;
+  using Vec = vec512::Vectorized<scalar_t>;
   static constexpr int64_t CHUNK_SIZE = (128 / sizeof(scalar_t)) * Vec::size();
   int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size * CHUNK_SIZE);
   if (grain_size < CHUNK_SIZE)
@@ -48,8 +51,8 @@ inline void _vec_log_softmax_lastdim(
           for (int64_t j = 0; j < loop_end; j++) {
             int64_t i = ii + j;
             scalar_t* input_data = input_data_base + i * dim_size;
-            max_input_arr[j] = vec256::reduce_all<scalar_t>(
-                [](Vec& x, Vec& y) { return vec256::maximum(x, y); },
+            max_input_arr[j] = vec512::reduce_all<scalar_t>(
+                [](Vec& x, Vec& y) { return vec512::maximum(x, y); },
                 input_data,
                 dim_size);
           }
@@ -57,7 +60,7 @@ inline void _vec_log_softmax_lastdim(
             int64_t i = ii + j;
             scalar_t* input_data = input_data_base + i * dim_size;
             scalar_t max_input = max_input_arr[j];
-            tmp_sum_scalar[j] = vec256::map_reduce_all<scalar_t>(
+            tmp_sum_scalar[j] = vec512::map_reduce_all<scalar_t>(
                 [max_input](Vec x) { return (x - Vec(max_input)).exp(); },
                 [](Vec x, Vec y) { return x + y; },
                 input_data,
@@ -65,7 +68,7 @@ inline void _vec_log_softmax_lastdim(
           }
           // See [Note AVX-SSE transitions] for why this should call the
           // vectorized version (aside from perf improvements).
-          vec256::map(
+          vec512::map(
               [](Vec x) { return x.log(); },
               tmp_sum_scalar,
               tmp_sum_scalar,
@@ -82,7 +85,7 @@ inline void _vec_log_softmax_lastdim(
             // is small, if we compute `max_input` plus `tmp_sum` before,
             // there would be a numerical problem. See an example in
             // https://github.com/pytorch/pytorch/issues/11752#issuecomment-422883379
-            vec256::map(
+            vec512::map(
                 [tmp_sum, max_input](Vec x) { return x - Vec(max_input) - Vec(tmp_sum); },
                 output_data,
                 input_data,
@@ -98,7 +101,7 @@ inline void _vec_softmax_lastdim(
     scalar_t* output_data_base,
     int64_t outer_size,
     int64_t dim_size) {
-  using Vec = vec256::Vec256<scalar_t>;
+  using Vec = vec512::Vectorized<scalar_t>;
   int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size);
   if (grain_size < 1)
     grain_size = 1;
@@ -111,19 +114,19 @@ inline void _vec_softmax_lastdim(
         for (int64_t i = begin; i < end; i++) {
           scalar_t* input_data = input_data_base + i * dim_size;
           scalar_t* output_data = output_data_base + i * dim_size;
-          scalar_t max_input = vec256::reduce_all<scalar_t>(
-              [](Vec& x, Vec& y) { return vec256::maximum(x, y); },
+          scalar_t max_input = vec512::reduce_all<scalar_t>(
+              [](Vec& x, Vec& y) { return vec512::maximum(x, y); },
               input_data,
               dim_size);
-          vec256::map(
+          vec512::map(
               [max_input](Vec x) { return (x - Vec(max_input)).exp(); },
               output_data,
               input_data,
               dim_size);
-          scalar_t tmp_sum = vec256::reduce_all<scalar_t>(
+          scalar_t tmp_sum = vec512::reduce_all<scalar_t>(
               [](Vec x, Vec y) { return x + y; }, output_data, dim_size);
           tmp_sum = 1 / tmp_sum;
-          vec256::map(
+          vec512::map(
               [tmp_sum](Vec x) { return x * Vec(tmp_sum); },
               output_data,
               output_data,
@@ -139,7 +142,7 @@ inline void _vec_host_softmax_backward_lastdim(
     scalar_t* output_data_base,
     int64_t outer_size,
     int64_t dim_size) {
-  using Vec = vec256::Vec256<scalar_t>;
+  using Vec = vec512::Vectorized<scalar_t>;
   int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size);
   if (grain_size < 1)
     grain_size = 1;
@@ -155,10 +158,10 @@ inline void _vec_host_softmax_backward_lastdim(
           scalar_t* output_data = output_data_base + i * dim_size;
           scalar_t sum;
           if (log_softmax) {
-            sum = vec256::reduce_all<scalar_t>(
+            sum = vec512::reduce_all<scalar_t>(
                 [](Vec& x, Vec& y) { return x + y; }, grad_data, dim_size);
           } else {
-            sum = vec256::map2_reduce_all<scalar_t>(
+            sum = vec512::map2_reduce_all<scalar_t>(
                 [](Vec x, Vec y) { return x * y; },
                 [](Vec x, Vec y) { return x + y; },
                 grad_data,
@@ -166,14 +169,14 @@ inline void _vec_host_softmax_backward_lastdim(
                 dim_size);
           }
           if (log_softmax) {
-            vec256::map2(
+            vec512::map2(
                 [sum](Vec x, Vec y) { return x - ((y.exp()) * Vec(sum)); },
                 grad_input_data,
                 grad_data,
                 output_data,
                 dim_size);
           } else {
-            vec256::map2(
+            vec512::map2(
                 [sum](Vec x, Vec y) { return (x - Vec(sum)) * y; },
                 grad_input_data,
                 grad_data,
@@ -184,6 +187,162 @@ inline void _vec_host_softmax_backward_lastdim(
       });
 }
 
+// BFloat16 rows are widened to float, reduced and normalized in float, and
+// rounded back to BFloat16 once per element. Accumulating the sums in
+// BFloat16 loses most of their precision on long rows.
+template <bool LogSoftMax>
+inline void _vec_softmax_lastdim_bfloat16(
+    BFloat16* input_data_base,
+    BFloat16* output_data_base,
+    int64_t outer_size,
+    int64_t dim_size) {
+  using fVec = vec256::Vec256<float>;
+  int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size);
+  if (grain_size < 1)
+    grain_size = 1;
+
+  parallel_for(
+      0,
+      outer_size,
+      grain_size,
+      [&](int64_t begin, int64_t end) {
+        std::vector<float> buffer(dim_size);
+        float* buffer_data = buffer.data();
+        for (int64_t i = begin; i < end; i++) {
+          vec256::convert(input_data_base + i * dim_size, buffer_data, dim_size);
+          float max_input = vec256::reduce_all<float>(
+              [](fVec& x, fVec& y) { return vec256::maximum(x, y); },
+              buffer_data,
+              dim_size);
+          if (LogSoftMax) {
+            float tmp_sum = vec256::map_reduce_all<float>(
+                [max_input](fVec x) { return (x - fVec(max_input)).exp(); },
+                [](fVec x, fVec y) { return x + y; },
+                buffer_data,
+                dim_size);
+            // See [Note AVX-SSE transitions]
+            vec256::map(
+                [](fVec x) { return x.log(); }, &tmp_sum, &tmp_sum, 1);
+            vec256::map(
+                [tmp_sum, max_input](fVec x) {
+                  return x - fVec(max_input) - fVec(tmp_sum);
+                },
+                buffer_data,
+                buffer_data,
+                dim_size);
+          } else {
+            vec256::map(
+                [max_input](fVec x) { return (x - fVec(max_input)).exp(); },
+                buffer_data,
+                buffer_data,
+                dim_size);
+            float tmp_sum = vec256::reduce_all<float>(
+                [](fVec x, fVec y) { return x + y; }, buffer_data, dim_size);
+            tmp_sum = 1 / tmp_sum;
+            vec256::map(
+                [tmp_sum](fVec x) { return x * fVec(tmp_sum); },
+                buffer_data,
+                buffer_data,
+                dim_size);
+          }
+          vec256::convert(buffer_data, output_data_base + i * dim_size, dim_size);
+        }
+      });
+}
+
+inline void _vec_log_softmax_lastdim(
+    BFloat16* input_data_base,
+    BFloat16* output_data_base,
+    int64_t outer_size,
+    int64_t dim_size) {
+  _vec_softmax_lastdim_bfloat16<true>(
+      input_data_base, output_data_base, outer_size, dim_size);
+}
+
+inline void _vec_softmax_lastdim(
+    BFloat16* input_data_base,
+    BFloat16* output_data_base,
+    int64_t outer_size,
+    int64_t dim_size) {
+  _vec_softmax_lastdim_bfloat16<false>(
+      input_data_base, output_data_base, outer_size, dim_size);
+}
+
+template <bool log_softmax>
+inline void _vec_host_softmax_backward_lastdim_bfloat16(
+    BFloat16* grad_input_data_base,
+    BFloat16* grad_data_base,
+    BFloat16* output_data_base,
+    int64_t outer_size,
+    int64_t dim_size) {
+  using fVec = vec256::Vec256<float>;
+  int64_t grain_size = internal::GRAIN_SIZE / (16 * dim_size);
+  if (grain_size < 1)
+    grain_size = 1;
+
+  parallel_for(
+      0,
+      outer_size,
+      grain_size,
+      [&](int64_t begin, int64_t end) {
+        std::vector<float> grad_buffer(dim_size);
+        std::vector<float> output_buffer(dim_size);
+        float* grad_data = grad_buffer.data();
+        float* output_data = output_buffer.data();
+        for (int64_t i = begin; i < end; i++) {
+          vec256::convert(grad_data_base + i * dim_size, grad_data, dim_size);
+          vec256::convert(output_data_base + i * dim_size, output_data, dim_size);
+          float sum;
+          if (log_softmax) {
+            sum = vec256::reduce_all<float>(
+                [](fVec& x, fVec& y) { return x + y; }, grad_data, dim_size);
+            vec256::map2(
+                [sum](fVec x, fVec y) { return x - ((y.exp()) * fVec(sum)); },
+                grad_data,
+                grad_data,
+                output_data,
+                dim_size);
+          } else {
+            sum = vec256::map2_reduce_all<float>(
+                [](fVec x, fVec y) { return x * y; },
+                [](fVec x, fVec y) { return x + y; },
+                grad_data,
+                output_data,
+                dim_size);
+            vec256::map2(
+                [sum](fVec x, fVec y) { return (x - fVec(sum)) * y; },
+                grad_data,
+                grad_data,
+                output_data,
+                dim_size);
+          }
+          vec256::convert(grad_data, grad_input_data_base + i * dim_size, dim_size);
+        }
+      });
+}
+
+template <>
+inline void _vec_host_softmax_backward_lastdim<BFloat16, false>(
+    BFloat16* grad_input_data_base,
+    BFloat16* grad_data_base,
+    BFloat16* output_data_base,
+    int64_t outer_size,
+    int64_t dim_size) {
+  _vec_host_softmax_backward_lastdim_bfloat16<false>(
+      grad_input_data_base, grad_data_base, output_data_base, outer_size, dim_size);
+}
+
+template <>
+inline void _vec_host_softmax_backward_lastdim<BFloat16, true>(
+    BFloat16* grad_input_data_base,
+    BFloat16* grad_data_base,
+    BFloat16* output_data_base,
+    int64_t outer_size,
+    int64_t dim_size) {
+  _vec_host_softmax_backward_lastdim_bfloat16<true>(
+      grad_input_data_base, grad_data_base, output_data_base, outer_size, dim_size);
+}
+
 template <typename scalar_t, bool LogSoftMax>
 struct vec_host_softmax_lastdim {
   static void apply(Tensor& output, const Tensor& input) {
@@ -224,9 +383,10 @@ struct vec_host_softmax_backward_lastdim {
 };
 
 static void softmax_lastdim_kernel_impl(Tensor& result, const Tensor& self) {
-  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "softmax_lastdim_kernel_impl", [&] {
-    vec_host_softmax_lastdim<scalar_t, false>::apply(result, self);
-  });
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, self.scalar_type(),
+      "softmax_lastdim_kernel_impl",
+      [&] { vec_host_softmax_lastdim<scalar_t, false>::apply(result, self); });
 }
 
 static void log_softmax_lastdim_kernel_impl(
@@ -242,8 +402,9 @@ static void softmax_backward_lastdim_kernel_impl(
     Tensor& grad_input,
     const Tensor& grad,
     const Tensor& output) {
-  AT_DISPATCH_FLOATING_TYPES(
-      grad.scalar_type(), "softmax_backward_lastdim_kernel_impl", [&] {
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, grad.scalar_type(),
+      "softmax_backward_lastdim_kernel_impl", [&] {
         vec_host_softmax_backward_lastdim<scalar_t, false>::apply(
             grad_input, grad, output);
       });
@@ -302,7 +302,9 @@ void bernoulli_scalar_kernel(Tensor& self, double p, c10::optional<Generator> ge
 }
 #else
 void bernoulli_scalar_kernel(Tensor &self, double p, c10::optional<Generator> gen) {
-  if (cpuinfo_initialize() && cpuinfo_vendor_intel == cpuinfo_get_processor(0)->core->vendor) {
+  // The VSL stream is not the Philox stream, see Note [Philox CPU random number generation]
+  if (!at::globalContext().philoxCPURNG() &&
+      cpuinfo_initialize() && cpuinfo_vendor_intel == cpuinfo_get_processor(0)->core->vendor) {
     CPUGeneratorImpl* generator = get_generator_or_default<CPUGeneratorImpl>(gen, detail::getDefaultCPUGenerator());
     int64_t seed;
     {
@@ -1,10 +1,13 @@
 #include <ATen/native/layer_norm.h>
 
 #include <cmath>
+#include <type_traits>
+#include <vector>
 
 #include <ATen/ATen.h>
 #include <ATen/CPUApplyUtils.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 #include <ATen/cpu/vec256/functional.h>
 #include <ATen/cpu/vec256/vec256.h>
 
@@ -13,6 +16,12 @@ namespace native {
 
 namespace {
 
+// BFloat16 inputs are normalized with float statistics and float
+// accumulation; only the loads and stores are in BFloat16.
+template <typename T>
+using layer_norm_acc_t = typename std::conditional<
+    std::is_same<T, BFloat16>::value, float, T>::type;
+
 template <typename T>
 void LayerNormKernelImplInternal(
     const Tensor& X,
@@ -20,7 +29,7 @@ void LayerNormKernelImplInternal(
     const Tensor& beta,
     int64_t M,
     int64_t N,
-    T eps,
+    layer_norm_acc_t<T> eps,
     Tensor* Y,
     Tensor* mean,
     Tensor* rstd) {
@@ -66,6 +75,68 @@ void LayerNormKernelImplInternal(
   });
 }
 
+template <>
+void LayerNormKernelImplInternal<BFloat16>(
+    const Tensor& X,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t M,
+    int64_t N,
+    float eps,
+    Tensor* Y,
+    Tensor* mean,
+    Tensor* rstd) {
+  using fVec = vec256::Vec256<float>;
+  DCHECK_EQ(X.numel(), M * N);
+  DCHECK(!gamma.defined() || gamma.numel() == N);
+  DCHECK(!beta.defined() || beta.numel() == N);
+  const BFloat16* X_data = X.data_ptr<BFloat16>();
+  BFloat16* Y_data = Y->data_ptr<BFloat16>();
+  BFloat16* mean_data = mean->data_ptr<BFloat16>();
+  BFloat16* rstd_data = rstd->data_ptr<BFloat16>();
+  // gamma and beta are read by every row, so they are widened once.
+  std::vector<float> gamma_f(N, 1.0f);
+  std::vector<float> beta_f(N, 0.0f);
+  if (gamma.defined()) {
+    vec256::convert(gamma.data_ptr<BFloat16>(), gamma_f.data(), N);
+  }
+  if (beta.defined()) {
+    vec256::convert(beta.data_ptr<BFloat16>(), beta_f.data(), N);
+  }
+  const float c = 1.0f / static_cast<float>(N);
+  at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
+    std::vector<float> buffer(N);
+    float* X_ptr = buffer.data();
+    for (int64_t i = start; i < end; ++i) {
+      vec256::convert(X_data + i * N, X_ptr, N);
+      float mean_val = vec256::reduce_all<float>(
+          [](fVec& x, fVec& y) { return x + y; },
+          X_ptr,
+          N);
+      float rstd_val = vec256::map_reduce_all<float>(
+          [](fVec x) { return x * x; },
+          [](fVec x, fVec y) { return x + y; },
+          X_ptr,
+          N);
+      mean_val *= c;
+      rstd_val = std::max(rstd_val * c - mean_val * mean_val, 0.0f);
+      rstd_val = 1.0f / std::sqrt(rstd_val + eps);
+      const fVec scale(rstd_val);
+      const fVec bias(-rstd_val * mean_val);
+      for (int64_t j = 0; j < N; j += fVec::size()) {
+        const int64_t n = std::min(static_cast<int64_t>(fVec::size()), N - j);
+        const fVec x = fVec::loadu(X_ptr + j, n);
+        const fVec gamma_v = fVec::loadu(gamma_f.data() + j, n);
+        const fVec beta_v = fVec::loadu(beta_f.data() + j, n);
+        ((x * scale + bias) * gamma_v + beta_v).store(X_ptr + j, n);
+      }
+      vec256::convert(X_ptr, Y_data + i * N, N);
+      mean_data[i] = mean_val;
+      rstd_data[i] = rstd_val;
+    }
+  });
+}
+
 void LayerNormKernelImpl(
     const Tensor& X,
     const Tensor& gamma,
@@ -76,10 +147,12 @@ void LayerNormKernelImpl(
     Tensor* Y,
     Tensor* mean,
     Tensor* rstd) {
-  AT_DISPATCH_FLOATING_TYPES(X.scalar_type(), "LayerNormKernelImpl", [&]() {
-    LayerNormKernelImplInternal<scalar_t>(
-        X, gamma, beta, M, N, static_cast<scalar_t>(eps), Y, mean, rstd);
-  });
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, X.scalar_type(), "LayerNormKernelImpl", [&]() {
+        LayerNormKernelImplInternal<scalar_t>(
+            X, gamma, beta, M, N, static_cast<layer_norm_acc_t<scalar_t>>(eps),
+            Y, mean, rstd);
+      });
 }
 
 template <typename T>
@@ -94,6 +167,7 @@ void LayerNormBackwardKernelImplInternal(
     Tensor* dX,
     Tensor* dgamma,
     Tensor* dbeta) {
+  using T_ACC = layer_norm_acc_t<T>;
   DCHECK_EQ(dY.numel(), M * N);
   DCHECK_EQ(X.numel(), M * N);
   DCHECK_EQ(mean.numel(), M);
@@ -107,48 +181,55 @@ void LayerNormBackwardKernelImplInternal(
       gamma.defined() ? gamma.template data_ptr<T>() : nullptr;
   T* dX_data = dX->defined() ? dX->template data_ptr<T>() : nullptr;
   T* dgamma_data = dgamma->defined() ? dgamma->template data_ptr<T>() : nullptr;
-  if (dgamma_data != nullptr) {
-    std::memset(dgamma_data, 0, N * sizeof(T));
-  }
   T* dbeta_data = dbeta->defined() ? dbeta->template data_ptr<T>() : nullptr;
-  if (dbeta_data != nullptr) {
-    std::memset(dbeta_data, 0, N * sizeof(T));
-  }
-  const T scale = T(1) / static_cast<T>(N);
+  // dgamma and dbeta are sums over all M rows, so they are accumulated in
+  // T_ACC and written out at the end.
+  std::vector<T_ACC> dgamma_acc(dgamma_data != nullptr ? N : 0, T_ACC(0));
+  std::vector<T_ACC> dbeta_acc(dbeta_data != nullptr ? N : 0, T_ACC(0));
+  const T_ACC scale = T_ACC(1) / static_cast<T_ACC>(N);
   const bool gamma_null = gamma_data == nullptr;
   for (int64_t i = 0; i < M; ++i) {
     const T* dY_ptr = dY_data + i * N;
     const T* X_ptr = X_data + i * N;
+    const T_ACC mean_v = static_cast<T_ACC>(mean_data[i]);
+    const T_ACC rstd_v = static_cast<T_ACC>(rstd_data[i]);
     if (dX_data != nullptr) {
       T* dX_ptr = dX_data + i * N;
-      T ds = 0;
-      T db = 0;
+      T_ACC ds = 0;
+      T_ACC db = 0;
       for (int64_t j = 0; j < N; ++j) {
-        const T gamma_v = gamma_null ? T(1) : gamma_data[j];
-        ds += dY_ptr[j] * X_ptr[j] * gamma_v;
-        db += dY_ptr[j] * gamma_v;
+        const T_ACC gamma_v = gamma_null ? T_ACC(1) : static_cast<T_ACC>(gamma_data[j]);
+        ds += static_cast<T_ACC>(dY_ptr[j]) * static_cast<T_ACC>(X_ptr[j]) * gamma_v;
+        db += static_cast<T_ACC>(dY_ptr[j]) * gamma_v;
       }
-      const T a = rstd_data[i];
-      const T b = (db * mean_data[i] - ds) * a * a * a * scale;
-      const T c = -b * mean_data[i] - db * a * scale;
+      const T_ACC a = rstd_v;
+      const T_ACC b = (db * mean_v - ds) * a * a * a * scale;
+      const T_ACC c = -b * mean_v - db * a * scale;
       for (int64_t j = 0; j < N; ++j) {
-        const T gamma_v = gamma_null ? T(1) : gamma_data[j];
-        dX_ptr[j] = a * dY_ptr[j] * gamma_v + b * X_ptr[j] + c;
+        const T_ACC gamma_v = gamma_null ? T_ACC(1) : static_cast<T_ACC>(gamma_data[j]);
+        dX_ptr[j] = static_cast<T>(a * static_cast<T_ACC>(dY_ptr[j]) * gamma_v +
+            b * static_cast<T_ACC>(X_ptr[j]) + c);
       }
     }
     if (dgamma_data != nullptr) {
-      const T a = rstd_data[i];
-      const T b = -a * mean_data[i];
+      const T_ACC a = rstd_v;
+      const T_ACC b = -a * mean_v;
       for (int64_t j = 0; j < N; ++j) {
-        dgamma_data[j] += dY_ptr[j] * (a * X_ptr[j] + b);
+        dgamma_acc[j] += static_cast<T_ACC>(dY_ptr[j]) * (a * static_cast<T_ACC>(X_ptr[j]) + b);
       }
     }
     if (dbeta_data != nullptr) {
       for (int64_t j = 0; j < N; ++j) {
-        dbeta_data[j] += dY_ptr[j];
+        dbeta_acc[j] += static_cast<T_ACC>(dY_ptr[j]);
       }
     }
   }
+  if (dgamma_data != nullptr) {
+    vec256::convert(dgamma_acc.data(), dgamma_data, N);
+  }
+  if (dbeta_data != nullptr) {
+    vec256::convert(dbeta_acc.data(), dbeta_data, N);
+  }
 }
 
 void LayerNormBackwardKernelImpl(
@@ -162,8 +243,8 @@ void LayerNormBackwardKernelImpl(
     Tensor* dX,
     Tensor* dgamma,
     Tensor* dbeta) {
-  AT_DISPATCH_FLOATING_TYPES(
-      X.scalar_type(), "LayerNormBackwardKernelImpl", [&]() {
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, X.scalar_type(), "LayerNormBackwardKernelImpl", [&]() {
         LayerNormBackwardKernelImplInternal<scalar_t>(
             dY, X, mean, rstd, gamma, M, N, dX, dgamma, dbeta);
       });
@@ -9,6 +9,7 @@
 #include <ATen/native/quantized/cpu/quantized_ops.h>
 
 #include <cmath>
+#include <numeric>
 #ifdef USE_FBGEMM
 #include <fbgemm/QuantUtils.h>
 #endif
@@ -1027,6 +1028,152 @@ void qmul_kernel(Tensor& out, const Tensor& self, const Tensor& other) {
   });
 }
 
+// Batched matrix multiplication of two quantized activations.
+// qa is [B, M, K], qb is [B, K, N] and qc is [B, M, N], all contiguous.
+// Products are accumulated in int32 and requantized once per output row.
+template <bool ReLUFused = false>
+void qbmm_kernel(const Tensor& qa, const Tensor& qb, Tensor& qc) {
+  const int64_t B = qa.size(0);
+  const int64_t M = qa.size(1);
+  const int64_t K = qa.size(2);
+  const int64_t N = qb.size(2);
+  const int32_t a_zero_point = qa.q_zero_point();
+  const int32_t b_zero_point = qb.q_zero_point();
+  const int64_t zero_point = qc.q_zero_point();
+  const float multiplier = qa.q_scale() * qb.q_scale() / qc.q_scale();
+
+  AT_DISPATCH_QINT_TYPES(qc.scalar_type(), "qbmm", [&]() {
+    using Vec = Vec256<scalar_t>;
+    using iVec = Vec256<c10::qint32>;
+    constexpr int64_t kIntVLen = iVec::size();
+    constexpr int64_t kVLen = Vec::size();
+    const auto* a_data =
+        reinterpret_cast<const underlying_t*>(qa.data_ptr<scalar_t>());
+    const auto* b_data =
+        reinterpret_cast<const underlying_t*>(qb.data_ptr<scalar_t>());
+    auto* c_data = qc.data_ptr<scalar_t>();
+    const int64_t grain_size =
+        std::max<int64_t>(1, at::internal::GRAIN_SIZE / std::max<int64_t>(1, K * N));
+
+    at::parallel_for(0, B * M, grain_size, [&](int64_t begin, int64_t end) {
+      std::vector<int32_t> acc(N);
+      for (int64_t row = begin; row < end; ++row) {
+        const int64_t b = row / M;
+        const underlying_t* a_row = a_data + row * K;
+        const underlying_t* b_mat = b_data + b * K * N;
+        scalar_t* c_row = c_data + row * N;
+
+        std::fill(acc.begin(), acc.end(), 0);
+        for (int64_t k = 0; k < K; ++k) {
+          const int32_t a_val = static_cast<int32_t>(a_row[k]) - a_zero_point;
+          if (a_val == 0) {
+            continue;
+          }
+          const underlying_t* b_row = b_mat + k * N;
+          // Unit stride over N, auto-vectorized for each CPU capability.
+          for (int64_t n = 0; n < N; ++n) {
+            acc[n] += a_val * (static_cast<int32_t>(b_row[n]) - b_zero_point);
+          }
+        }
+
+        int64_t n = 0;
+        for (; n + kVLen <= N; n += kVLen) {
+          Vec::int_vec_return_type acc_vec;
+          for (int i = 0; i < Vec::int_num_vecs(); ++i) {
+            acc_vec[i] = iVec::loadu(acc.data() + n + i * kIntVLen);
+          }
+          Vec rv = Vec::requantize_from_int(acc_vec, multiplier, zero_point);
+          if (ReLUFused) {
+            rv = rv.maximum(Vec(static_cast<scalar_t>(zero_point)));
+          }
+          rv.store(c_row + n);
+        }
+        for (; n < N; ++n) {
+          scalar_t res = at::native::requantize_from_int<scalar_t>(
+              multiplier, zero_point, acc[n]);
+          if (ReLUFused) {
+            res.val_ = std::max<underlying_t>(res.val_, zero_point);
+          }
+          c_row[n] = res;
+        }
+      }
+    });
+  });
+}
+
+// Softmax over the innermost dimension of a contiguous quantized tensor.
+// The row maximum is found on the integer values, which lets the
+// dequantization fold the max subtraction into the zero point.
+void qsoftmax_kernel(const Tensor& qx, Tensor& qy) {
+  const int64_t N = qx.size(-1);
+  const int64_t outer_size = N == 0 ? 0 : qx.numel() / N;
+  const float i_scale = qx.q_scale();
+  const float o_scale = qy.q_scale();
+  const int64_t o_zero_point = qy.q_zero_point();
+  const float o_inv_scale = 1.0f / o_scale;
+
+  AT_DISPATCH_QINT_TYPES(qx.scalar_type(), "qsoftmax", [&]() {
+    using Vec = Vec256<scalar_t>;
+    using fVec = Vec256<float>;
+    constexpr int64_t kVLen = Vec::size();
+    constexpr int64_t kFloatVLen = fVec::size();
+    const auto* x_data =
+        reinterpret_cast<const underlying_t*>(qx.data_ptr<scalar_t>());
+    auto* y_data = qy.data_ptr<scalar_t>();
+    fVec scale_vec(i_scale);
+    const int64_t grain_size =
+        std::max<int64_t>(1, at::internal::GRAIN_SIZE / std::max<int64_t>(1, N));
+
+    at::parallel_for(0, outer_size, grain_size, [&](int64_t begin, int64_t end) {
+      std::vector<float> exp_buf(N);
+      for (int64_t i = begin; i < end; ++i) {
+        const underlying_t* x_row = x_data + i * N;
+        scalar_t* y_row = y_data + i * N;
+        const int32_t row_max = *std::max_element(x_row, x_row + N);
+
+        // First pass: exp((x - max) * scale) and its sum.
+        fVec max_vec(static_cast<float>(row_max));
+        fVec neg_premul_vec = scale_vec * max_vec.neg();
+        fVec sum_vec(0.0f);
+        int64_t j = 0;
+        for (; j + kVLen <= N; j += kVLen) {
+          auto dx = Vec::loadu(x_row + j)
+                        .dequantize(scale_vec, max_vec, neg_premul_vec);
+          for (int k = 0; k < Vec::float_num_vecs(); ++k) {
+            auto e = dx[k].exp();
+            sum_vec = sum_vec + e;
+            e.store(exp_buf.data() + j + k * kFloatVLen);
+          }
+        }
+        float sum_arr[kFloatVLen];
+        sum_vec.store(sum_arr);
+        float sum = std::accumulate(sum_arr, sum_arr + kFloatVLen, 0.0f);
+        for (; j < N; ++j) {
+          exp_buf[j] = std::exp((static_cast<int32_t>(x_row[j]) - row_max) * i_scale);
+          sum += exp_buf[j];
+        }
+
+        // Second pass: normalize and quantize.
+        const float inv_sum = 1.0f / sum;
+        fVec inv_sum_vec(inv_sum);
+        j = 0;
+        for (; j + kVLen <= N; j += kVLen) {
+          Vec::float_vec_return_type y_vec;
+          for (int k = 0; k < Vec::float_num_vecs(); ++k) {
+            y_vec[k] = fVec::loadu(exp_buf.data() + j + k * kFloatVLen) * inv_sum_vec;
+          }
+          Vec::quantize(y_vec, o_scale, o_zero_point, o_inv_scale)
+              .store(y_row + j);
+        }
+        for (; j < N; ++j) {
+          y_row[j] = at::native::quantize_val<scalar_t>(
+              o_scale, o_zero_point, exp_buf[j] * inv_sum);
+        }
+      }
+    });
+  });
+}
+
 void qmaxpool_2d_nhwc_kernel(
     const Tensor& qx,
     int64_t iC, // input/output channels
@@ -2413,6 +2560,9 @@ REGISTER_DISPATCH(qadd_scalar_relu_stub, &qadd_scalar_kernel<true>);
 REGISTER_DISPATCH(qadd_scalar_stub, &qadd_scalar_kernel<false>);
 REGISTER_DISPATCH(qmul_relu_stub, &qmul_kernel<true>);
 REGISTER_DISPATCH(qmul_stub, &qmul_kernel<false>);
+REGISTER_DISPATCH(qbmm_relu_stub, &qbmm_kernel<true>);
+REGISTER_DISPATCH(qbmm_stub, &qbmm_kernel<false>);
+REGISTER_DISPATCH(qsoftmax_stub, &qsoftmax_kernel);
 REGISTER_DISPATCH(qmaxpool_2d_nhwc_stub, &qmaxpool_2d_nhwc_kernel);
 REGISTER_DISPATCH(
     qadaptive_avg_pool2d_nhwc_stub,
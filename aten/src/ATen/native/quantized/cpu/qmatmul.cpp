@@ -0,0 +1,149 @@
+#include <ATen/ATen.h>
+#include <ATen/Utils.h>
+#include <torch/library.h>
+#include <ATen/native/quantized/cpu/quantized_ops.h>
+#include <ATen/quantized/Quantizer.h>
+
+#include <algorithm>
+
+namespace at {
+namespace native {
+
+DEFINE_DISPATCH(qbmm_relu_stub);
+DEFINE_DISPATCH(qbmm_stub);
+
+namespace {
+
+inline void check_inputs(const Tensor& qa, const Tensor& qb) {
+  TORCH_CHECK(
+      qa.qscheme() == kPerTensorAffine,
+      "Only per tensor quantization is supported in Matmul.");
+  TORCH_CHECK(
+      qa.scalar_type() == qb.scalar_type(),
+      "Matmul operands should have same data type.");
+  TORCH_CHECK(
+      qa.qscheme() == qb.qscheme(),
+      "Both inputs to Matmul must have the same quantization shceme.");
+  TORCH_CHECK(
+      qa.scalar_type() == kQUInt8 || qa.scalar_type() == kQInt8,
+      "Matmul only supports quint8 and qint8 inputs, got ",
+      toString(qa.scalar_type()));
+}
+
+// Computes qa @ qb for 3-D, contiguous inputs of shape [B, M, K] and
+// [B, K, N].
+template <bool ReLUFused = false>
+Tensor _bmm(
+    const Tensor& qa,
+    const Tensor& qb,
+    double scale,
+    int64_t zero_point) {
+  TORCH_CHECK(
+      qa.size(0) == qb.size(0) && qa.size(2) == qb.size(1),
+      "Matmul shapes cannot be multiplied (",
+      qa.sizes(),
+      " and ",
+      qb.sizes(),
+      ")");
+  if (qa.size(2) == 0) {
+    // Empty reduction, the result is exactly zero.
+    return at::quantize_per_tensor(
+        at::zeros({qa.size(0), qa.size(1), qb.size(2)}),
+        scale,
+        zero_point,
+        qa.scalar_type());
+  }
+  auto qc = at::_empty_affine_quantized(
+      {qa.size(0), qa.size(1), qb.size(2)},
+      at::device(kCPU).dtype(qa.scalar_type()),
+      scale,
+      zero_point);
+  if (qc.numel() == 0) {
+    return qc;
+  }
+  auto qa_contig = qa.contiguous();
+  auto qb_contig = qb.contiguous();
+  if (ReLUFused) {
+    qbmm_relu_stub(qa.device().type(), qa_contig, qb_contig, qc);
+  } else {
+    qbmm_stub(qa.device().type(), qa_contig, qb_contig, qc);
+  }
+  return qc;
+}
+
+template <bool ReLUFused = false>
+class QBmm final {
+ public:
+  static Tensor run(Tensor qa, Tensor qb, double scale, int64_t zero_point) {
+    check_inputs(qa, qb);
+    TORCH_CHECK(
+        qa.dim() == 3 && qb.dim() == 3,
+        "quantized::bmm expects 3-D inputs, got ",
+        qa.dim(),
+        "-D and ",
+        qb.dim(),
+        "-D");
+    return _bmm<ReLUFused>(qa, qb, scale, zero_point);
+  }
+};
+
+// Follows aten::matmul for inputs with at least two dimensions. Batch
+// dimensions must match exactly, except that a 2-D right hand side is shared
+// by every matrix of the left hand side.
+template <bool ReLUFused = false>
+class QMatmul final {
+ public:
+  static Tensor run(Tensor qa, Tensor qb, double scale, int64_t zero_point) {
+    check_inputs(qa, qb);
+    TORCH_CHECK(
+        qa.dim() >= 2 && qb.dim() >= 2,
+        "quantized::matmul expects inputs with at least 2 dimensions, got ",
+        qa.dim(),
+        "-D and ",
+        qb.dim(),
+        "-D");
+    const int64_t M = qa.size(-2);
+    const int64_t K = qa.size(-1);
+    const int64_t N = qb.size(-1);
+    std::vector<int64_t> output_size(qa.sizes().begin(), qa.sizes().end() - 1);
+    output_size.push_back(N);
+
+    if (qb.dim() == 2) {
+      // Fold the batch into the rows of a single matrix multiplication. Count
+      // the rows from the sizes, qa.numel() / K says nothing when K == 0; the
+      // empty reduction itself is handled by _bmm.
+      const int64_t rows = at::prod_intlist(qa.sizes().slice(0, qa.dim() - 1));
+      auto qc = _bmm<ReLUFused>(
+          qa.reshape({1, rows, K}),
+          qb.unsqueeze(0),
+          scale,
+          zero_point);
+      return qc.view(output_size);
+    }
+
+    TORCH_CHECK(
+        qa.dim() == qb.dim() &&
+            std::equal(
+                qa.sizes().begin(),
+                qa.sizes().end() - 2,
+                qb.sizes().begin()),
+        "quantized::matmul does not support broadcasting batch dimensions, got ",
+        qa.sizes(),
+        " and ",
+        qb.sizes());
+    const int64_t B = at::prod_intlist(qa.sizes().slice(0, qa.dim() - 2));
+    auto qc = _bmm<ReLUFused>(
+        qa.reshape({B, M, K}), qb.reshape({B, K, N}), scale, zero_point);
+    return qc.view(output_size);
+  }
+};
+
+TORCH_LIBRARY_IMPL(quantized, QuantizedCPU, m) {
+  m.impl("bmm",         TORCH_FN(QBmm</*ReLUFused=*/false>::run));
+  m.impl("bmm_relu",    TORCH_FN(QBmm</*ReLUFused=*/true>::run));
+  m.impl("matmul",      TORCH_FN(QMatmul</*ReLUFused=*/false>::run));
+  m.impl("matmul_relu", TORCH_FN(QMatmul</*ReLUFused=*/true>::run));
+}
+
+}  // namespace
+}}  // namespace at::native
@@ -0,0 +1,51 @@
+#include <ATen/ATen.h>
+#include <ATen/WrapDimUtils.h>
+#include <torch/library.h>
+#include <ATen/native/quantized/cpu/quantized_ops.h>
+#include <ATen/quantized/Quantizer.h>
+
+namespace at {
+namespace native {
+
+DEFINE_DISPATCH(qsoftmax_stub);
+
+namespace {
+
+Tensor quantized_softmax(
+    const Tensor& qx,
+    int64_t dim,
+    double output_scale,
+    int64_t output_zero_point) {
+  TORCH_CHECK(
+      qx.qscheme() == kPerTensorAffine,
+      "Only per tensor quantization is supported in Softmax.");
+  TORCH_CHECK(
+      qx.scalar_type() == kQUInt8 || qx.scalar_type() == kQInt8,
+      "Softmax only supports quint8 and qint8 inputs, got ",
+      toString(qx.scalar_type()));
+  if (qx.dim() == 0) {
+    return quantized_softmax(qx.view({1}), 0, output_scale, output_zero_point)
+        .view({});
+  }
+  dim = maybe_wrap_dim(dim, qx.dim());
+  const int64_t last_dim = qx.dim() - 1;
+  // The kernel reduces over the innermost dimension, move `dim` there.
+  Tensor qx_contig =
+      (dim == last_dim ? qx : qx.transpose(dim, last_dim)).contiguous();
+  Tensor qy = at::_empty_affine_quantized(
+      qx_contig.sizes(),
+      at::device(kCPU).dtype(qx.scalar_type()),
+      output_scale,
+      output_zero_point);
+  if (qy.numel() > 0) {
+    qsoftmax_stub(qx.device().type(), qx_contig, qy);
+  }
+  return dim == last_dim ? qy : qy.transpose(dim, last_dim);
+}
+
+TORCH_LIBRARY_IMPL(quantized, QuantizedCPU, m) {
+  m.impl("softmax", TORCH_FN(quantized_softmax));
+}
+
+}  // namespace
+}}  // namespace at::native
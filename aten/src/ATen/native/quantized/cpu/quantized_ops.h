@@ -27,6 +27,9 @@ using qelu_fn = void(*)(
     at::Tensor& /*qy*/);
 using qbinary_fn =
     void (*)(Tensor& /*out*/, const Tensor& /*self*/, const Tensor& /*other*/);
+using qbmm_fn =
+    void (*)(const Tensor& /*qa*/, const Tensor& /*qb*/, Tensor& /*qc*/);
+using qsoftmax_fn = void (*)(const at::Tensor& /*qx*/, at::Tensor& /*qy*/);
 using qadd_scalar_fn =
     void (*)(Tensor& /*out*/, const Tensor& /*self*/, Scalar other /*other*/);
 using qhardswish_fn = void (*)(const at::Tensor& /*qx*/, at::Tensor& /*qy*/);
@@ -148,6 +151,9 @@ DECLARE_DISPATCH(qbinary_fn, qadd_stub);
 DECLARE_DISPATCH(qbinary_fn, qadd_relu_stub);
 DECLARE_DISPATCH(qbinary_fn, qmul_stub);
 DECLARE_DISPATCH(qbinary_fn, qmul_relu_stub);
+DECLARE_DISPATCH(qbmm_fn, qbmm_stub);
+DECLARE_DISPATCH(qbmm_fn, qbmm_relu_stub);
+DECLARE_DISPATCH(qsoftmax_fn, qsoftmax_stub);
 DECLARE_DISPATCH(qadd_scalar_fn, qadd_scalar_stub);
 DECLARE_DISPATCH(qadd_scalar_fn, qadd_scalar_relu_stub);
 DECLARE_DISPATCH(qhardswish_fn, qhardswish_stub);
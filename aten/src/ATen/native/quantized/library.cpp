@@ -105,6 +105,10 @@ TORCH_LIBRARY(quantized, m) {
       "linear_unpack.legacy(Tensor W_prepack) -> (Tensor W_origin, Tensor? B_origin)");
   m.def(
       "linear_unpack_fp16.legacy(Tensor W_prepack) -> (Tensor W_origin, Tensor? B_origin)");
+  m.def("bmm(Tensor qa, Tensor qb, float scale, int zero_point) -> Tensor qc");
+  m.def("bmm_relu(Tensor qa, Tensor qb, float scale, int zero_point) -> Tensor qc");
+  m.def("matmul(Tensor qa, Tensor qb, float scale, int zero_point) -> Tensor qc");
+  m.def("matmul_relu(Tensor qa, Tensor qb, float scale, int zero_point) -> Tensor qc");
   m.def("mul(Tensor qa, Tensor qb, float scale, int zero_point)-> Tensor qc");
   m.def("mul_relu(Tensor qa, Tensor qb, float scale, int zero_point)-> Tensor qc");
   m.def("mul_out(Tensor qa, Tensor qb, Tensor(a!) out)-> Tensor(a!) out");
@@ -121,6 +125,7 @@ TORCH_LIBRARY(quantized, m) {
   // NB: missing a space after comma here...
   m.def("max_pool2d(Tensor qx, int[] kernel_size, int[] stride, int[] padding, int[] dilation,bool ceil_mode) -> Tensor");
   m.def("relu6(Tensor qx, bool inplace=False) -> Tensor");
+  m.def("softmax(Tensor qx, int dim, float output_scale, int output_zero_point) -> Tensor");
 }
 
 // According to #33294: The "_" prefix registration will be
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+#include <ATen/ExecutionDomain.h>
+#include <ATen/Parallel.h>
+
+#include <atomic>
+#include <future>
+#include <string>
+
+using namespace at;
+
+namespace {
+
+// Domains can't be unregistered, so every run of a test (e.g. with
+// --gtest_repeat) registers its own
+std::string unique_name(const std::string& name) {
+  static std::atomic<int> counter{0};
+  return name + "_" + std::to_string(counter++);
+}
+
+} // namespace
+
+TEST(TestExecutionDomain, Registry) {
+  ExecutionDomainOptions options;
+  options.num_intraop_threads = 2;
+  options.num_interop_threads = 3;
+  const auto name = unique_name("registry");
+  register_execution_domain(name, options);
+  ASSERT_THROW(register_execution_domain(name, options), c10::Error);
+
+  auto domain = get_execution_domain(name);
+  ASSERT_TRUE(domain);
+  ASSERT_EQ(domain->name(), name);
+  ASSERT_EQ(domain->num_intraop_threads(), 2);
+  ASSERT_EQ(domain->num_interop_threads(), 3);
+  ASSERT_FALSE(get_execution_domain("unregistered"));
+  ASSERT_THROW(ExecutionDomainGuard guard("unregistered"), c10::Error);
+}
+
+TEST(TestExecutionDomain, Guard) {
+  ExecutionDomainOptions options;
+  options.num_intraop_threads = 2;
+  options.num_interop_threads = 1;
+  const auto outer_name = unique_name("outer");
+  const auto inner_name = unique_name("inner");
+  register_execution_domain(outer_name, options);
+  register_execution_domain(inner_name, options);
+
+  ASSERT_FALSE(current_execution_domain());
+  {
+    ExecutionDomainGuard outer(outer_name);
+    ASSERT_EQ(current_execution_domain()->name(), outer_name);
+    ASSERT_EQ(get_num_interop_threads(), 1);
+    {
+      ExecutionDomainGuard inner(inner_name);
+      ASSERT_EQ(current_execution_domain()->name(), inner_name);
+    }
+    ASSERT_EQ(current_execution_domain()->name(), outer_name);
+  }
+  ASSERT_FALSE(current_execution_domain());
+}
+
+TEST(TestExecutionDomain, Launch) {
+  ExecutionDomainOptions options;
+  options.num_intraop_threads = 2;
+  options.num_interop_threads = 2;
+  const auto name = unique_name("launch");
+  register_execution_domain(name, options);
+
+  Tensor a = ones({1024, 1024});
+  auto expected = a.sum();
+
+  ExecutionDomainGuard guard(name);
+  std::promise<std::string> domain_name;
+  std::promise<Tensor> sum;
+  at::launch([&]() {
+    // the task runs in the domain it was launched from, as does the
+    // parallel work it starts
+    domain_name.set_value(current_execution_domain()->name());
+    sum.set_value(a.sum());
+  });
+  ASSERT_EQ(domain_name.get_future().get(), name);
+  ASSERT_TRUE(sum.get_future().get().equal(expected));
+
+  // parallel_for runs with the number of threads of the domain
+  at::parallel_for(0, 10, 1, [&](int64_t begin, int64_t end) {
+    ASSERT_LT(at::get_thread_num(), 2);
+  });
+}
@@ -0,0 +1,54 @@
+"""Throughput of a DataLoader with small batches, with the shared memory pool
+of the workers enabled and disabled (see Note [Shared memory pool])."""
+import argparse
+import time
+
+import torch
+from torch.utils.data import DataLoader, Dataset
+from torch.utils.data import _utils
+
+
+class SmallTensorDataset(Dataset):
+    def __init__(self, length, shape):
+        self.length = length
+        self.sample = torch.randn(*shape)
+        self.label = torch.tensor(0)
+
+    def __len__(self):
+        return self.length
+
+    def __getitem__(self, idx):
+        return self.sample, self.label
+
+
+def run(dataset, batch_size, num_workers, pool_size, epochs):
+    _utils.SHARED_MEMORY_POOL_MAX_CACHED_BYTES = pool_size
+    loader = DataLoader(dataset, batch_size=batch_size, num_workers=num_workers)
+    # Warm up
+    for _ in loader:
+        pass
+    num_batches = 0
+    start = time.time()
+    for _ in range(epochs):
+        for _ in loader:
+            num_batches += 1
+    return num_batches / (time.time() - start)
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('--num-samples', type=int, default=20000)
+    parser.add_argument('--num-workers', type=int, default=4)
+    parser.add_argument('--epochs', type=int, default=3)
+    parser.add_argument('--shape', type=int, nargs='+', default=[3, 32, 32])
+    args = parser.parse_args()
+
+    dataset = SmallTensorDataset(args.num_samples, args.shape)
+    print("{} workers, samples of shape {}\n".format(args.num_workers, args.shape))
+    print("{:>10} {:>18} {:>18} {:>8}".format(
+        "batch size", "no pool (batch/s)", "pool (batch/s)", "speedup"))
+    for batch_size in [1, 4, 16, 64]:
+        without_pool = run(dataset, batch_size, args.num_workers, 0, args.epochs)
+        with_pool = run(dataset, batch_size, args.num_workers, 256 * 1024 * 1024, args.epochs)
+        print("{:>10} {:>18.1f} {:>18.1f} {:>7.2f}x".format(
+            batch_size, without_pool, with_pool, with_pool / without_pool))
@@ -0,0 +1,56 @@
+from __future__ import absolute_import, division, print_function, unicode_literals
+import argparse
+import json
+
+import torch
+
+from python_arg_parser_benchmark import benchmark_case
+
+""" Tensor indexing overhead benchmark script.
+Measures the time per call of Python indexing expressions on small tensors,
+with and without requires_grad (indexing a tensor that requires grad applies
+one select / slice per index instead of computing the view directly).
+Example run:
+python indexing_benchmark.py --num_iters 200000 --json results.json
+"""
+
+
+def make_cases(requires_grad):
+    x = torch.ones(8, 16, 32, requires_grad=requires_grad)
+    idx = torch.tensor([0, 3, 5])
+    return [
+        ("x[0]", lambda: x[0]),
+        ("x[1:5]", lambda: x[1:5]),
+        ("x[0, 1:5]", lambda: x[0, 1:5]),
+        ("x[0, 1:5, 2]", lambda: x[0, 1:5, 2]),
+        ("x[:, None, ::2, -1]", lambda: x[:, None, ::2, -1]),
+        ("x[..., 3]", lambda: x[..., 3]),
+        ("x[1:, idx]", lambda: x[1:, idx]),
+        ("x[idx, 2, 1:9]", lambda: x[idx, 2, 1:9]),
+    ]
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--num_warmup_iters", type=int, default=1000)
+    parser.add_argument("--num_iters", type=int, default=100000)
+    parser.add_argument("--repeat", type=int, default=5)
+    parser.add_argument("--json", type=str, default="",
+                        help="also write the results to this file")
+    args = parser.parse_args()
+
+    torch.set_num_threads(1)
+    result = {}
+    for requires_grad in (False, True):
+        for name, fn in make_cases(requires_grad):
+            key = "{} requires_grad={}".format(name, requires_grad)
+            result[key] = benchmark_case(fn, args.num_warmup_iters, args.num_iters, args.repeat)
+            print("{:<42} {:>8.0f} ns/call".format(key, result[key]))
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(result, f, indent=2, sort_keys=True)
+
+
+if __name__ == "__main__":
+    main()
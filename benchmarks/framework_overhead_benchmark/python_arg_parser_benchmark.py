@@ -0,0 +1,78 @@
+from __future__ import absolute_import, division, print_function, unicode_literals
+import argparse
+import json
+import timeit
+
+import torch
+
+""" Python binding overhead benchmark script.
+Measures the time per call of Tensor methods and torch functions on tiny
+tensors, where the cost of a call is dominated by parsing its arguments and
+dispatching it, e.g. to compare builds before and after a change to
+torch/csrc/utils/python_arg_parser.cpp or to the generated bindings.
+Example run:
+python python_arg_parser_benchmark.py --num_iters 200000 --json results.json
+"""
+
+
+def make_cases():
+    t = torch.ones(2, 3)
+    u = torch.ones(2, 3)
+    idx = torch.tensor([0, 1])
+    return [
+        # a call of a Python function, as a lower bound
+        ("python_call", lambda: len(())),
+        ("t.add(u)", lambda: t.add(u)),
+        ("t.add(1)", lambda: t.add(1)),
+        ("t.add(u, alpha=2)", lambda: t.add(u, alpha=2)),
+        ("t + u", lambda: t + u),
+        ("t.mul(u)", lambda: t.mul(u)),
+        ("t.add_(u)", lambda: t.add_(u)),
+        ("t.view(3, 2)", lambda: t.view(3, 2)),
+        ("t.view(-1)", lambda: t.view(-1)),
+        ("t.view((3, 2))", lambda: t.view((3, 2))),
+        ("t.select(0, 1)", lambda: t.select(0, 1)),
+        ("t.transpose(0, 1)", lambda: t.transpose(0, 1)),
+        ("t.index_select(0, idx)", lambda: t.index_select(0, idx)),
+        ("t[0]", lambda: t[0]),
+        ("t[0:1]", lambda: t[0:1]),
+        ("t[:, 1]", lambda: t[:, 1]),
+        ("torch.add(t, u)", lambda: torch.add(t, u)),
+    ]
+
+
+def benchmark_case(fn, num_warmup_iters, num_iters, repeat):
+    for _ in range(num_warmup_iters):
+        fn()
+    timer = timeit.Timer(fn)
+    # the minimum is the least disturbed by the rest of the system
+    return min(timer.repeat(repeat=repeat, number=num_iters)) / num_iters * 1e9
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--num_warmup_iters", type=int, default=1000)
+    parser.add_argument("--num_iters", type=int, default=100000)
+    parser.add_argument("--repeat", type=int, default=5)
+    parser.add_argument("--filter", type=str, default="",
+                        help="only run the cases whose name contains this string")
+    parser.add_argument("--json", type=str, default="",
+                        help="also write the results to this file")
+    args = parser.parse_args()
+
+    torch.set_num_threads(1)
+    result = {}
+    with torch.no_grad():
+        for name, fn in make_cases():
+            if args.filter not in name:
+                continue
+            result[name] = benchmark_case(fn, args.num_warmup_iters, args.num_iters, args.repeat)
+            print("{:<28} {:>8.0f} ns/call".format(name, result[name]))
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(result, f, indent=2, sort_keys=True)
+
+
+if __name__ == "__main__":
+    main()
@@ -5,11 +5,11 @@ from __future__ import unicode_literals
 
 import operator_benchmark as op_bench
 from pt import ( # noqa
-    add_test, as_strided_test, batchnorm_test, binary_test, cat_test,  # noqa
+    add_test, addmm_test, as_strided_test, attention_test, batchnorm_test, bfloat16_test, binary_test, cat_test,  # noqa
     chunk_test, conv_test, diag_test, embeddingbag_test, fill_test,  # noqa
     gather_test, linear_test, matmul_test, pool_test,  # noqa
     softmax_test, hardsigmoid_test, hardswish_test, layernorm_test,  # noqa
-    groupnorm_test, instancenorm_test # noqa
+    groupnorm_test, instancenorm_test, random_sample_test # noqa
 )
 
 if __name__ == "__main__":
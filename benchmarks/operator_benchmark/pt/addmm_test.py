@@ -0,0 +1,81 @@
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+from __future__ import unicode_literals
+
+import operator_benchmark as op_bench
+import torch
+
+"""
+Microbenchmarks for addmm, addbmm and addr.
+
+The small configs are the size of the matmuls in the cell of a small RNN run
+one token at a time, which are computed without calling into BLAS on CPU.
+"""
+
+addmm_short_configs = op_bench.config_list(
+    attr_names=["M", "N", "K"],
+    attrs=[
+        [1, 16, 16],
+        [4, 32, 8],
+        [64, 64, 64],
+        [256, 512, 256],
+    ],
+    cross_product_configs={
+        'device': ['cpu'],
+        'dtype': [torch.float, torch.long],
+    },
+    tags=["short"],
+)
+
+
+addmm_long_configs = op_bench.cross_product_configs(
+    M=[1, 8, 128],
+    N=[16, 1024],
+    K=[16, 512],
+    device=['cpu', 'cuda'],
+    dtype=[torch.float],
+    tags=["long"]
+)
+
+
+class AddmmBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, K, device, dtype):
+        self.input_one = torch.rand(M, K, device=device).to(dtype=dtype)
+        self.mat1 = torch.rand(M, N, device=device).to(dtype=dtype)
+        self.mat2 = torch.rand(N, K, device=device).to(dtype=dtype)
+        self.set_module_name("addmm")
+
+    def forward(self):
+        return torch.addmm(self.input_one, self.mat1, self.mat2)
+
+
+class AddbmmBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, K, device, dtype):
+        self.input_one = torch.rand(M, K, device=device).to(dtype=dtype)
+        self.batch1 = torch.rand(8, M, N, device=device).to(dtype=dtype)
+        self.batch2 = torch.rand(8, N, K, device=device).to(dtype=dtype)
+        self.set_module_name("addbmm")
+
+    def forward(self):
+        return torch.addbmm(self.input_one, self.batch1, self.batch2)
+
+
+class AddrBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, K, device, dtype):
+        self.input_one = torch.rand(M, K, device=device).to(dtype=dtype)
+        self.vec1 = torch.rand(M, device=device).to(dtype=dtype)
+        self.vec2 = torch.rand(K, device=device).to(dtype=dtype)
+        self.set_module_name("addr")
+
+    def forward(self):
+        return torch.addr(self.input_one, self.vec1, self.vec2)
+
+
+op_bench.generate_pt_test(addmm_short_configs + addmm_long_configs, AddmmBenchmark)
+op_bench.generate_pt_test(addmm_short_configs + addmm_long_configs, AddbmmBenchmark)
+op_bench.generate_pt_test(addmm_short_configs + addmm_long_configs, AddrBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
@@ -0,0 +1,73 @@
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+from __future__ import unicode_literals
+
+import operator_benchmark as op_bench
+import torch
+
+
+"""
+Microbenchmarks for the fused CPU attention kernel.
+
+The fused op is compared with the composition of matmul, softmax and matmul
+that it replaces, on inputs of shape [N, H, L, E].
+"""
+
+
+attention_configs_short = op_bench.config_list(
+    attr_names=['N', 'H', 'L', 'E'],
+    attrs=[
+        [8, 8, 128, 64],
+        [2, 12, 512, 64],
+    ],
+    cross_product_configs={
+        'device': ['cpu'],
+    },
+    tags=['short']
+)
+
+
+attention_configs_long = op_bench.cross_product_configs(
+    N=[1, 16],
+    H=[16],
+    L=[256, 2048],
+    E=[64],
+    device=['cpu'],
+    tags=['long']
+)
+
+
+def composed_attention(q, k, v, scale):
+    scores = torch.matmul(q, k.transpose(-2, -1)) * scale
+    return torch.matmul(torch.softmax(scores, dim=-1), v)
+
+
+attention_ops_list = op_bench.op_list(
+    attr_names=['op_name', 'op_func'],
+    attrs=[
+        ['fused_attention', lambda q, k, v, scale: torch._fused_attention(q, k, v, None, scale)[0]],
+        ['composed_attention', composed_attention],
+    ],
+)
+
+
+class AttentionBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, N, H, L, E, device, op_func):
+        self.q = torch.randn(N, H, L, E, device=device)
+        self.k = torch.randn(N, H, L, E, device=device)
+        self.v = torch.randn(N, H, L, E, device=device)
+        self.scale = E ** -0.5
+        self.op_func = op_func
+
+    def forward(self):
+        return self.op_func(self.q, self.k, self.v, self.scale)
+
+
+op_bench.generate_pt_tests_from_op_list(attention_ops_list,
+                                        attention_configs_short + attention_configs_long,
+                                        AttentionBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
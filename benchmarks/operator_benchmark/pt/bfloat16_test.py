@@ -0,0 +1,74 @@
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+from __future__ import unicode_literals
+
+import operator_benchmark as op_bench
+import torch
+import torch.nn.functional as F
+
+
+"""
+Microbenchmarks for the bfloat16 CPU kernels of memory-bound ops.
+
+Each op runs on float and bfloat16 inputs of the same shape. The bfloat16
+kernels compute in float, so the difference between the two is mostly the
+halved memory traffic.
+"""
+
+
+bfloat16_configs_short = op_bench.config_list(
+    attr_names=['M', 'N'],
+    attrs=[
+        [128, 1024],
+        [1024, 4096],
+    ],
+    cross_product_configs={
+        'device': ['cpu'],
+        'dtype': [torch.float, torch.bfloat16],
+    },
+    tags=['short']
+)
+
+
+bfloat16_configs_long = op_bench.cross_product_configs(
+    M=[64, 2048],
+    N=[768, 16384],
+    device=['cpu'],
+    dtype=[torch.float, torch.bfloat16],
+    tags=['long']
+)
+
+
+bfloat16_ops_list = op_bench.op_list(
+    attr_names=['op_name', 'op_func'],
+    attrs=[
+        ['softmax', lambda x: torch.softmax(x, -1)],
+        ['log_softmax', lambda x: torch.log_softmax(x, -1)],
+        ['layer_norm', lambda x: F.layer_norm(x, x.shape[-1:])],
+        ['sum', lambda x: x.sum(-1)],
+        ['sum_dim0', lambda x: x.sum(0)],
+        ['mean', torch.mean],
+        ['gelu', F.gelu],
+        ['leaky_relu', F.leaky_relu],
+        ['hardswish', F.hardswish],
+    ],
+)
+
+
+class BFloat16Benchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, device, dtype, op_func):
+        self.input_one = torch.randn(M, N, device=device).to(dtype=dtype)
+        self.op_func = op_func
+
+    def forward(self):
+        return self.op_func(self.input_one)
+
+
+op_bench.generate_pt_tests_from_op_list(bfloat16_ops_list,
+                                        bfloat16_configs_short + bfloat16_configs_long,
+                                        BFloat16Benchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
@@ -129,6 +129,73 @@ op_bench.generate_pt_test(conv_2d_configs_short + conv_2d_configs_long,
                           ConvTranspose2dBenchmark)
 
 
+"""
+Microbenchmarks for the CPU algorithms of Conv2d without MKL-DNN: im2col and
+gemm, Winograd F(4x4, 3x3), and the direct convolution of channels-last
+inputs. They run the stride-1 Conv2d configs above, which are all that
+Winograd computes, and convs with few channels.
+"""
+
+
+conv_2d_cpu_algorithm_configs = op_bench.config_list(
+    attr_names=[
+        'IC', 'OC', 'kernel', 'stride', 'N', 'H', 'W', 'G', 'pad',
+    ],
+    attrs=[
+        [256, 256, 3, 1, 1, 16, 16, 1, 0],
+        [128, 128, 3, 1, 4, 32, 32, 1, 0],
+        [3, 16, 3, 1, 1, 224, 224, 1, 1],
+        [16, 16, 3, 1, 8, 56, 56, 1, 1],
+        [32, 32, 3, 1, 8, 28, 28, 1, 1],
+    ],
+    cross_product_configs={
+        'device': ['cpu'],
+    },
+    tags=['short']
+)
+
+
+def conv2d_im2col(input, weight, bias, stride, pad):
+    return torch._C._nn.thnn_conv2d(input.contiguous(), weight, weight.shape[2:], bias, stride, pad)
+
+
+def conv2d_winograd(input, weight, bias, stride, pad):
+    return torch._winograd_convolution2d(input, weight, bias, (pad, pad))
+
+
+def conv2d_direct(input, weight, bias, stride, pad):
+    return torch._direct_convolution2d(input, weight, bias, (pad, pad), (stride, stride))
+
+
+conv_2d_cpu_algorithms = op_bench.op_list(
+    attr_names=['op_name', 'op_func'],
+    attrs=[
+        ['conv2d_im2col', conv2d_im2col],
+        ['conv2d_winograd', conv2d_winograd],
+        ['conv2d_direct', conv2d_direct],
+    ],
+)
+
+
+class Conv2dCPUAlgorithmBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, IC, OC, kernel, stride, N, H, W, G, pad, device, op_func):
+        memory_format = torch.channels_last if op_func is conv2d_direct else torch.contiguous_format
+        self.input = torch.rand(N, IC, H, W, device=device).contiguous(memory_format=memory_format)
+        self.weight = torch.rand(OC, IC, kernel, kernel, device=device)
+        self.bias = torch.rand(OC, device=device)
+        self.stride = stride
+        self.pad = pad
+        self.op_func = op_func
+
+    def forward(self):
+        return self.op_func(self.input, self.weight, self.bias, self.stride, self.pad)
+
+
+op_bench.generate_pt_tests_from_op_list(conv_2d_cpu_algorithms,
+                                        conv_2d_cpu_algorithm_configs,
+                                        Conv2dCPUAlgorithmBenchmark)
+
+
 """
 Microbenchmarks for Conv3d and ConvTranspose3d operators.
 """
@@ -0,0 +1,109 @@
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+from __future__ import unicode_literals
+
+
+import operator_benchmark as op_bench
+import torch
+
+
+"""
+Microbenchmarks for the CPU kernels that have AVX512 (Vec512) implementations.
+
+The CPU capability is picked once per process, so compare tiers by running
+this file once per ATEN_CPU_CAPABILITY value, e.g.
+
+  for cap in default avx avx2 avx512; do
+    ATEN_CPU_CAPABILITY=$cap python -m pt.cpu_capability_test \
+        --omp_num_threads 1 --mkl_num_threads 1
+  done
+
+Forcing a tier the machine does not support crashes with an illegal
+instruction; without the override, the "CPU capability usage" line printed
+at startup is the highest tier that is safe to request.
+"""
+
+
+binary_ops_list = op_bench.op_list(
+    attr_names=['op_name', 'op_func'],
+    attrs=[
+        ['add', torch.add],
+        ['mul', torch.mul],
+        ['div', torch.div],
+    ],
+)
+
+
+binary_configs_short = op_bench.config_list(
+    attr_names=['M', 'N'],
+    attrs=[
+        [64, 1024],
+        [1024, 1024],
+        [1023, 1023],
+    ],
+    cross_product_configs={
+        'device': ['cpu'],
+        'dtype': [torch.float, torch.double, torch.bfloat16],
+    },
+    tags=['short']
+)
+
+
+class BinaryCapabilityBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, dtype, device, op_func):
+        self.input_one = torch.rand(M, N, device=device).to(dtype=dtype)
+        self.input_two = torch.rand(M, N, device=device).add_(1).to(dtype=dtype)
+        self.op_func = op_func
+
+    def forward(self):
+        return self.op_func(self.input_one, self.input_two)
+
+
+op_bench.generate_pt_tests_from_op_list(binary_ops_list,
+                                        binary_configs_short,
+                                        BinaryCapabilityBenchmark)
+
+
+softmax_ops_list = op_bench.op_list(
+    attr_names=['op_name', 'op_func'],
+    attrs=[
+        ['softmax', torch.softmax],
+        ['log_softmax', torch.log_softmax],
+    ],
+)
+
+
+softmax_configs_short = op_bench.config_list(
+    attr_names=['M', 'N'],
+    attrs=[
+        [128, 1024],
+        [1024, 1000],
+    ],
+    cross_product_configs={
+        'device': ['cpu'],
+        'dtype': [torch.float, torch.double],
+    },
+    tags=['short']
+)
+
+
+class SoftmaxCapabilityBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, dtype, device, op_func):
+        self.input_one = torch.rand(M, N, device=device).to(dtype=dtype)
+        self.op_func = op_func
+
+    def forward(self):
+        return self.op_func(self.input_one, -1)
+
+
+op_bench.generate_pt_tests_from_op_list(softmax_ops_list,
+                                        softmax_configs_short,
+                                        SoftmaxCapabilityBenchmark)
+
+
+if __name__ == "__main__":
+    for line in torch.__config__.show().splitlines():
+        if 'CPU capability' in line:
+            print('#' + line)
+    op_bench.benchmark_runner.main()
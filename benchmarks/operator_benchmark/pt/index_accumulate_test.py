@@ -0,0 +1,74 @@
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+from __future__ import unicode_literals
+
+import operator_benchmark as op_bench
+import torch
+import numpy
+
+
+"""
+Microbenchmarks for the accumulating scatter operators, index_add_ and
+index_put_(accumulate=True), shaped like the sparse gradient of an embedding
+table: num_indices rows of width D added into a table of num_rows rows.
+
+The CPU kernels only split the work across threads when more than one is
+available; compare against the serial path with --omp_num_threads 1.
+"""
+
+index_accumulate_configs_short = op_bench.config_list(
+    attr_names=["num_rows", "num_indices", "D"],
+    attrs=[
+        [1000, 100000, 1],
+        [10000, 4096, 64],
+        [100000, 16384, 128],
+    ],
+    cross_product_configs={
+        'device': ['cpu'],
+    },
+    tags=["short"]
+)
+
+
+index_accumulate_configs_long = op_bench.cross_product_configs(
+    num_rows=[1000, 1000000],
+    num_indices=[16384, 131072],
+    D=[16, 256],
+    device=['cpu'],
+    tags=["long"]
+)
+
+
+class IndexAddBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, num_rows, num_indices, D, device):
+        self.input_one = torch.zeros(num_rows, D, device=device)
+        numpy.random.seed((1 << 32) - 1)
+        self.index = torch.tensor(numpy.random.randint(0, num_rows, num_indices), device=device)
+        self.source = torch.rand(num_indices, D, device=device)
+        self.set_module_name("index_add_")
+
+    def forward(self):
+        return self.input_one.index_add_(0, self.index, self.source)
+
+
+class IndexPutAccumulateBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, num_rows, num_indices, D, device):
+        self.input_one = torch.zeros(num_rows, D, device=device)
+        numpy.random.seed((1 << 32) - 1)
+        self.index = (torch.tensor(numpy.random.randint(0, num_rows, num_indices), device=device),)
+        self.source = torch.rand(num_indices, D, device=device)
+        self.set_module_name("index_put_accumulate")
+
+    def forward(self):
+        return self.input_one.index_put_(self.index, self.source, accumulate=True)
+
+
+op_bench.generate_pt_test(index_accumulate_configs_short + index_accumulate_configs_long,
+                          IndexAddBenchmark)
+op_bench.generate_pt_test(index_accumulate_configs_short + index_accumulate_configs_long,
+                          IndexPutAccumulateBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
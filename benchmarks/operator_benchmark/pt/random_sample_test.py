@@ -0,0 +1,61 @@
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+from __future__ import unicode_literals
+
+import operator_benchmark as op_bench
+import torch
+
+
+"""
+Microbenchmarks for the in-place sampling operators used to initialize
+weights and to build dropout masks.
+
+The philox_rng config runs the CPU kernels with torch.backends.cpu.philox_rng
+set, which fills the output on several threads; the default mt19937 kernels
+are serial.
+"""
+
+random_sample_ops_list = op_bench.op_list(
+    attr_names=['op_name', 'op_func'],
+    attrs=[
+        ['uniform_', lambda t: t.uniform_()],
+        ['normal_', lambda t: t.normal_()],
+        ['bernoulli_', lambda t: t.bernoulli_(0.5)],
+    ],
+)
+
+
+random_sample_configs_short = op_bench.config_list(
+    attr_names=['M', 'N'],
+    attrs=[
+        [64, 64],
+        [1024, 1024],
+    ],
+    cross_product_configs={
+        'device': ['cpu'],
+        'dtype': [torch.float, torch.double],
+        'philox_rng': [False, True],
+    },
+    tags=['short']
+)
+
+
+class RandomSampleBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, dtype, device, philox_rng, op_func):
+        self.input_one = torch.empty(M, N, dtype=dtype, device=device)
+        self.philox_rng = philox_rng
+        self.op_func = op_func
+
+    def forward(self):
+        with torch.backends.cpu.flags(philox_rng=self.philox_rng):
+            return self.op_func(self.input_one)
+
+
+op_bench.generate_pt_tests_from_op_list(random_sample_ops_list,
+                                        random_sample_configs_short,
+                                        RandomSampleBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
@@ -4,6 +4,7 @@ import timeit
 import torch
 
 profiling_enabled = None
+profiling_record_shapes = None
 profiling_tensor_size = None
 TENSOR_SIZES = [1, 32, 128, 256, 512]
 INTERNAL_ITER = 256
@@ -19,7 +20,7 @@ traced_loop_workload = None
 def run_profiler_benchmark_loop():
     x = torch.rand(profiling_tensor_size, profiling_tensor_size)
     if profiling_enabled:
-        with torch.autograd.profiler.profile() as prof:
+        with torch.autograd.profiler.profile(record_shapes=profiling_record_shapes) as prof:
             traced_loop_workload(x)
     else:
         traced_loop_workload(x)
@@ -41,7 +42,7 @@ traced_parallel_workload = None
 def run_profiler_benchmark_parallel():
     x = torch.rand(profiling_tensor_size, profiling_tensor_size)
     if profiling_enabled:
-        with torch.autograd.profiler.profile() as prof:
+        with torch.autograd.profiler.profile(record_shapes=profiling_record_shapes) as prof:
             traced_parallel_workload(x)
     else:
         traced_parallel_workload(x)
@@ -50,12 +51,16 @@ if __name__ == '__main__':
     for workload_name in ["loop", "parallel"]:
         print("Payload: {}; {} iterations, N = {}\n".format(
             workload_name, INTERNAL_ITER, N))
-        for params in itertools.product(TENSOR_SIZES, [False, True]):
+        for params in itertools.product(TENSOR_SIZES, [False, True], [False, True]):
             profiling_tensor_size = params[0]
             profiling_enabled = params[1]
+            profiling_record_shapes = params[2]
+            if profiling_record_shapes and not profiling_enabled:
+                continue
 
             print("Profiling {}, tensor size {}x{}".format(
-                "enabled " if profiling_enabled else "disabled",
+                ("enabled with shapes" if profiling_record_shapes else "enabled ")
+                if profiling_enabled else "disabled",
                 profiling_tensor_size, profiling_tensor_size))
 
             x = torch.rand(profiling_tensor_size, profiling_tensor_size)
@@ -7,10 +7,12 @@ for with_cuda in [False, True]:
     model = models.resnet18()
     inputs = torch.randn(5, 3, 224, 224)
     sort_key = "self_cpu_memory_usage"
+    memory_key = "cpu_memory_usage"
     if with_cuda and torch.cuda.is_available():
         model = model.cuda()
         inputs = inputs.cuda()
         sort_key = "self_cuda_memory_usage"
+        memory_key = "cuda_memory_usage"
         print("Profiling CUDA Resnet model")
     else:
         print("Profiling CPU Resnet model")
@@ -20,3 +22,5 @@ for with_cuda in [False, True]:
             model(inputs)
 
     print(prof.key_averages(group_by_input_shape=True).table(sort_by=sort_key, row_limit=-1))
+    print("Peak memory: {}".format(profiler.format_memory(
+        max(getattr(record, memory_key) for record in prof.memory_timeline))))
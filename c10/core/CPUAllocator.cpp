@@ -185,10 +185,26 @@ class DefaultMobileCPUAllocator final : public at::Allocator {
 
 void NoDelete(void*) {}
 
+namespace {
+thread_local at::Allocator* cpu_allocator_override = nullptr;
+} // namespace
+
 at::Allocator* GetCPUAllocator() {
+  if (C10_UNLIKELY(cpu_allocator_override != nullptr)) {
+    return cpu_allocator_override;
+  }
   return GetAllocator(DeviceType::CPU);
 }
 
+CPUAllocatorOverrideGuard::CPUAllocatorOverrideGuard(at::Allocator* alloc)
+    : prev_(cpu_allocator_override) {
+  cpu_allocator_override = alloc;
+}
+
+CPUAllocatorOverrideGuard::~CPUAllocatorOverrideGuard() {
+  cpu_allocator_override = prev_;
+}
+
 void SetCPUAllocator(at::Allocator* alloc, uint8_t priority) {
   SetAllocator(DeviceType::CPU, alloc, priority);
 }
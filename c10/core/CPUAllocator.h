@@ -59,6 +59,22 @@ C10_API at::Allocator* GetCPUAllocator();
 // ownership of the pointer.
 C10_API void SetCPUAllocator(at::Allocator* alloc, uint8_t priority = 0);
 
+// RAII guard that makes GetCPUAllocator() return `alloc` on the current
+// thread for the guard's lifetime. Allocators installed this way must not
+// call GetCPUAllocator() themselves; use GetAllocator(DeviceType::CPU) to
+// reach the registered allocator instead.
+class C10_API CPUAllocatorOverrideGuard {
+ public:
+  explicit CPUAllocatorOverrideGuard(at::Allocator* alloc);
+  ~CPUAllocatorOverrideGuard();
+  CPUAllocatorOverrideGuard(const CPUAllocatorOverrideGuard&) = delete;
+  CPUAllocatorOverrideGuard& operator=(const CPUAllocatorOverrideGuard&) =
+      delete;
+
+ private:
+  at::Allocator* prev_;
+};
+
 // Get the Default CPU Allocator
 C10_API at::Allocator* GetDefaultCPUAllocator();
 
@@ -0,0 +1,269 @@
+#include "caffe2/predictor/pooled_predictor.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "caffe2/core/timer.h"
+
+namespace caffe2 {
+
+class PooledPredictor::InstanceGuard {
+ public:
+  explicit InstanceGuard(PooledPredictor* predictor)
+      : predictor_(predictor), slot_(predictor->acquire()) {}
+
+  ~InstanceGuard() {
+    predictor_->release(slot_);
+  }
+
+  Instance& instance() {
+    return predictor_->slots_[slot_].instance;
+  }
+
+ private:
+  PooledPredictor* predictor_;
+  size_t slot_;
+
+  C10_DISABLE_COPY_AND_ASSIGN(InstanceGuard);
+};
+
+PooledPredictor::PooledPredictor(
+    PredictorConfig config,
+    PooledPredictorOptions options)
+    : config_(std::move(config)),
+      options_(std::move(options)),
+      stats_(options_.stats_name) {
+  CAFFE_ENFORCE(config_.ws, "PooledPredictor needs a parameter workspace");
+  CAFFE_ENFORCE_GT(options_.max_instances, 0);
+  net_def_ = std::make_shared<NetDef>(*config_.predict_net);
+  if (options_.async_scheduling) {
+    net_def_->set_type("async_scheduling");
+  }
+
+  std::unordered_set<std::string> inputs;
+  for (const auto& name : net_def_->external_input()) {
+    if (!config_.ws->HasBlob(name)) {
+      inputs.insert(name);
+    }
+  }
+  inputs.insert(config_.input_names.begin(), config_.input_names.end());
+  input_blobs_.assign(inputs.begin(), inputs.end());
+
+  std::unordered_set<std::string> outputs;
+  for (const auto& op : net_def_->op()) {
+    for (const auto& name : op.output()) {
+      if (!inputs.count(name)) {
+        outputs.insert(name);
+      }
+    }
+  }
+  output_blobs_.assign(outputs.begin(), outputs.end());
+
+  slots_.reset(new Slot[options_.max_instances]);
+  const size_t num_prewarmed =
+      std::min(options_.num_prewarmed, options_.max_instances);
+  for (size_t i = 0; i < num_prewarmed; ++i) {
+    createInstance(&slots_[i].instance);
+    slots_[i].state.store(kIdle);
+  }
+}
+
+PooledPredictor::~PooledPredictor() {
+  DCHECK_EQ(num_busy_.load(), 0) << "PooledPredictor destroyed while running";
+}
+
+void PooledPredictor::createInstance(Instance* instance) {
+  instance->ws = make_unique<Workspace>(config_.ws.get());
+  for (const auto& name : input_blobs_) {
+    BlobGetMutableTensor(instance->ws->CreateLocalBlob(name), CPU);
+  }
+  // Operators bind their outputs when the net is created; local blobs keep
+  // them from writing into the shared parameter workspace.
+  for (const auto& name : output_blobs_) {
+    instance->ws->CreateLocalBlob(name);
+  }
+  instance->net = instance->ws->CreateNet(net_def_);
+  CAFFE_ENFORCE(instance->net, "Failed to create net ", net_def_->name());
+  ++num_instances_;
+  CAFFE_EVENT(stats_, created_instances);
+}
+
+size_t PooledPredictor::acquire() {
+  Timer timer;
+  const size_t num_slots = options_.max_instances;
+  auto acquired = [&](size_t slot) {
+    ++num_busy_;
+    CAFFE_EVENT(stats_, busy_instances, 1);
+    CAFFE_EVENT(stats_, acquire_latency_ns, timer.NanoSeconds());
+    return slot;
+  };
+  // An empty slot is free too, e.g. after creating its instance failed.
+  auto has_free_slot = [&]() {
+    for (size_t i = 0; i < num_slots; ++i) {
+      if (slots_[i].state.load() != kBusy) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  while (true) {
+    // Prefer warm instances, so that activations are reused.
+    for (size_t i = 0; i < num_slots; ++i) {
+      int expected = kIdle;
+      if (slots_[i].state.compare_exchange_strong(expected, kBusy)) {
+        return acquired(i);
+      }
+    }
+    for (size_t i = 0; i < num_slots; ++i) {
+      int expected = kEmpty;
+      if (slots_[i].state.compare_exchange_strong(expected, kBusy)) {
+        try {
+          createInstance(&slots_[i].instance);
+        } catch (...) {
+          slots_[i].instance = Instance();
+          slots_[i].state.store(kEmpty);
+          notifyWaiter();
+          throw;
+        }
+        return acquired(i);
+      }
+    }
+    // Every instance is serving a request. release() only takes the mutex
+    // when it sees a waiter, so the uncontended path stays lock-free.
+    std::unique_lock<std::mutex> lock(wait_mutex_);
+    ++num_waiting_;
+    wait_cv_.wait(lock, has_free_slot);
+    --num_waiting_;
+  }
+}
+
+void PooledPredictor::release(size_t slot) {
+  --num_busy_;
+  CAFFE_EVENT(stats_, busy_instances, -1);
+  slots_[slot].state.store(kIdle);
+  notifyWaiter();
+}
+
+void PooledPredictor::notifyWaiter() {
+  if (num_waiting_.load() > 0) {
+    std::lock_guard<std::mutex> lock(wait_mutex_);
+    wait_cv_.notify_one();
+  }
+}
+
+void PooledPredictor::checkInputNames(const TensorMap& inputs) const {
+  if (config_.input_names.empty()) {
+    return;
+  }
+  CAFFE_ENFORCE_EQ(inputs.size(), input_names().size());
+  for (const auto& input : inputs) {
+    CAFFE_ENFORCE(
+        std::find(input_names().begin(), input_names().end(), input.first) !=
+            input_names().end(),
+        "Input can't be found: ",
+        input.first);
+  }
+}
+
+Blob* PooledPredictor::inputBlob(
+    const Instance& instance,
+    const std::string& name) const {
+  auto* blob = instance.ws->GetBlob(name);
+  CAFFE_ENFORCE(blob, "Blob does not exist: ", name);
+  CAFFE_ENFORCE(
+      blob != config_.ws->GetBlob(name),
+      "Input ",
+      name,
+      " is shared by all instances and cannot be fed");
+  return blob;
+}
+
+Tensor PooledPredictor::takeOutput(
+    const Instance& instance,
+    const std::string& name) const {
+  auto* blob = instance.ws->GetBlob(name);
+  CAFFE_ENFORCE(blob, "Blob does not exist: ", name);
+  CAFFE_ENFORCE(
+      BlobIsTensorType(*blob, CPU), "Blob is not a CPU Tensor: ", name);
+  auto tensor = BlobGetMutableTensor(blob, CPU)->UnsafeSharedInstance();
+  if (blob != config_.ws->GetBlob(name)) {
+    // The next request on this instance would otherwise overwrite the
+    // output while the caller may still be reading it.
+    blob->Reset();
+  }
+  return tensor;
+}
+
+bool PooledPredictor::operator()(
+    const TensorList& inputs,
+    TensorList* outputs) {
+  Timer timer;
+  CAFFE_ENFORCE(
+      inputs.size() <=
+      static_cast<unsigned>(net_def_->external_input_size()));
+  InstanceGuard guard(this);
+  auto& instance = guard.instance();
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    BlobSetTensor(
+        inputBlob(instance, net_def_->external_input(i)),
+        inputs[i].UnsafeSharedInstance());
+  }
+  if (!instance.net->Run()) {
+    CAFFE_EVENT(stats_, failed_requests);
+    return false;
+  }
+  outputs->clear();
+  for (const auto& name : net_def_->external_output()) {
+    outputs->push_back(takeOutput(instance, name));
+  }
+  CAFFE_EVENT(stats_, request_latency_ns, timer.NanoSeconds());
+  return true;
+}
+
+bool PooledPredictor::operator()(
+    const TensorMap& inputs,
+    TensorList* outputs) {
+  Timer timer;
+  checkInputNames(inputs);
+  InstanceGuard guard(this);
+  auto& instance = guard.instance();
+  for (const auto& input : inputs) {
+    BlobSetTensor(
+        inputBlob(instance, input.first), input.second.UnsafeSharedInstance());
+  }
+  if (!instance.net->Run()) {
+    CAFFE_EVENT(stats_, failed_requests);
+    return false;
+  }
+  outputs->clear();
+  for (const auto& name : net_def_->external_output()) {
+    outputs->push_back(takeOutput(instance, name));
+  }
+  CAFFE_EVENT(stats_, request_latency_ns, timer.NanoSeconds());
+  return true;
+}
+
+bool PooledPredictor::operator()(
+    const TensorMap& inputs,
+    TensorMap* outputs) {
+  Timer timer;
+  checkInputNames(inputs);
+  InstanceGuard guard(this);
+  auto& instance = guard.instance();
+  for (const auto& input : inputs) {
+    BlobSetTensor(
+        inputBlob(instance, input.first), input.second.UnsafeSharedInstance());
+  }
+  if (!instance.net->Run()) {
+    CAFFE_EVENT(stats_, failed_requests);
+    return false;
+  }
+  for (const std::string& name : output_names()) {
+    outputs->emplace(name, takeOutput(instance, name));
+  }
+  CAFFE_EVENT(stats_, request_latency_ns, timer.NanoSeconds());
+  return true;
+}
+
+} // namespace caffe2
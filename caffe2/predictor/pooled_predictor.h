@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "caffe2/core/net.h"
+#include "caffe2/core/stats.h"
+#include "caffe2/core/tensor.h"
+#include "caffe2/predictor/predictor.h"
+#include "caffe2/predictor/predictor_config.h"
+
+namespace caffe2 {
+
+struct CAFFE2_API PooledPredictorOptions {
+  // Upper bound on the number of concurrently running requests. Further
+  // requests block until an instance is returned to the pool.
+  size_t max_instances = 4;
+  // Instances created up front, so that the first requests do not pay for
+  // instantiating the net.
+  size_t num_prewarmed = 1;
+  // Runs the predict net with the async_scheduling executor. Its thread
+  // pools are process wide and therefore shared by all instances.
+  bool async_scheduling = false;
+  // Name under which request latency and pool occupancy are exported, see
+  // caffe2/core/stats.h.
+  std::string stats_name = "pooled_predictor";
+};
+
+/**
+ * A Predictor that can be called from several threads at once.
+ *
+ * All instances share the parameters in `config.ws`, which are never
+ * written. Each instance owns a child workspace, holding the inputs and
+ * activations of a request, and its own instantiation of the predict net.
+ * Instances are handed to requests without locking and are kept across
+ * requests, so activation blobs are reused once the pool is warm.
+ *
+ * Output tensors are handed over to the caller: the instance that produced
+ * them allocates new output blobs for its next request, so outputs stay
+ * valid after later requests without being copied. Outputs that are
+ * parameters of the shared workspace are shared, as with Predictor.
+ */
+class CAFFE2_API PooledPredictor {
+ public:
+  using TensorList = Predictor::TensorList;
+  using TensorMap = Predictor::TensorMap;
+
+  PooledPredictor(
+      PredictorConfig config,
+      PooledPredictorOptions options = PooledPredictorOptions());
+  ~PooledPredictor();
+
+  // Same contract as the corresponding Predictor::operator().
+  bool operator()(const TensorList& inputs, TensorList* outputs);
+  bool operator()(const TensorMap& inputs, TensorList* outputs);
+  bool operator()(const TensorMap& inputs, TensorMap* outputs);
+
+  // Number of instances created so far.
+  size_t num_instances() const {
+    return num_instances_.load();
+  }
+  // Number of instances currently serving a request.
+  size_t num_busy_instances() const {
+    return num_busy_.load();
+  }
+
+  const NetDef& def() const {
+    return *config_.predict_net;
+  }
+
+  const std::vector<std::string>& input_names() const {
+    return config_.input_names;
+  }
+
+  const std::vector<std::string>& output_names() const {
+    return config_.output_names;
+  }
+
+ private:
+  struct Instance {
+    std::unique_ptr<Workspace> ws;
+    NetBase* net = nullptr;
+  };
+
+  enum SlotState : int { kEmpty, kIdle, kBusy };
+
+  struct Slot {
+    std::atomic<int> state{kEmpty};
+    Instance instance;
+  };
+
+  class InstanceGuard;
+
+  // Takes an instance out of the pool, creating one if the pool is not
+  // full yet, or waiting for one to be released otherwise.
+  size_t acquire();
+  void release(size_t slot);
+  // Wakes up a request waiting in acquire() after a slot was freed.
+  void notifyWaiter();
+  void createInstance(Instance* instance);
+  // Same validation of the input names as Predictor.
+  void checkInputNames(const TensorMap& inputs) const;
+
+  Blob* inputBlob(const Instance& instance, const std::string& name) const;
+  // Hands the tensor of an output blob over to the caller; the blob is
+  // refilled by the next request.
+  Tensor takeOutput(const Instance& instance, const std::string& name) const;
+
+  PredictorConfig config_;
+  PooledPredictorOptions options_;
+  std::shared_ptr<NetDef> net_def_;
+  // Blobs that every instance owns instead of sharing them with the
+  // parameter workspace: inputs and operator outputs.
+  std::vector<std::string> input_blobs_;
+  std::vector<std::string> output_blobs_;
+
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<size_t> num_instances_{0};
+  std::atomic<size_t> num_busy_{0};
+
+  // Only used when all instances are busy.
+  std::atomic<int> num_waiting_{0};
+  std::mutex wait_mutex_;
+  std::condition_variable wait_cv_;
+
+  struct PoolStats {
+    CAFFE_STAT_CTOR(PoolStats);
+    CAFFE_AVG_EXPORTED_STAT(request_latency_ns);
+    CAFFE_AVG_EXPORTED_STAT(acquire_latency_ns);
+    CAFFE_EXPORTED_STAT(busy_instances);
+    CAFFE_EXPORTED_STAT(created_instances);
+    CAFFE_EXPORTED_STAT(failed_requests);
+  } stats_;
+};
+
+} // namespace caffe2
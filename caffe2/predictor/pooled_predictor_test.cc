@@ -0,0 +1,166 @@
+#include "caffe2/core/context.h"
+#include "caffe2/core/operator.h"
+#include "caffe2/core/tensor.h"
+#include "caffe2/predictor/pooled_predictor.h"
+#include "caffe2/utils/math.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace caffe2 {
+
+namespace {
+
+const char* predictSpec = R"DOC(
+        name: "predict"
+        type: "dag"
+        external_input: "data"
+        external_input: "W"
+        external_input: "b"
+        external_output: "y"
+        op {
+          input: "data"
+          input: "W"
+          input: "b"
+          output: "hidden"
+          type: "FC"
+        }
+        op {
+          input: "hidden"
+          output: "y"
+          type: "Relu"
+        }
+)DOC";
+
+const char* initSpec = R"DOC(
+        name: "init"
+        type: "dag"
+        op {
+          type: "GivenTensorFill"
+          output: "W"
+          arg {
+            name: "shape"
+            ints: 2
+            ints: 4
+          }
+          arg {
+            name: "values"
+            floats: [1, 2, 3, 4, -1, -2, -3, -4]
+          }
+        }
+        op {
+          type: "ConstantFill"
+          output: "b"
+          arg {
+            name: "shape"
+            ints: 2
+          }
+          arg {
+            name: "value"
+            f: 1.0
+          }
+        }
+)DOC";
+
+NetDef parseNetDef(const std::string& value) {
+  NetDef def;
+  CAFFE_ENFORCE(
+      TextFormat::ParseFromString(value, &def),
+      "Failed to parse NetDef with value: ",
+      value);
+  return def;
+}
+
+TensorCPU filledTensor(int64_t rows, float value) {
+  TensorCPU t(std::vector<int64_t>{rows, 4}, CPU);
+  auto* data = t.mutable_data<float>();
+  for (int64_t i = 0; i < t.numel(); ++i) {
+    data[i] = value;
+  }
+  return t;
+}
+
+} // namespace
+
+class PooledPredictorTest : public testing::Test {
+ public:
+  void SetUp() override {
+    PooledPredictorOptions options;
+    options.max_instances = 2;
+    options.num_prewarmed = 1;
+    p_ = std::make_unique<PooledPredictor>(
+        makePredictorConfig(parseNetDef(initSpec), parseNetDef(predictSpec)),
+        options);
+  }
+
+  std::unique_ptr<PooledPredictor> p_;
+};
+
+TEST_F(PooledPredictorTest, SingleRequest) {
+  EXPECT_EQ(p_->num_instances(), 1);
+  PooledPredictor::TensorList input;
+  input.emplace_back(filledTensor(3, 1.0));
+  PooledPredictor::TensorList output;
+  ASSERT_TRUE((*p_)(input, &output));
+  ASSERT_EQ(output.size(), 1);
+  EXPECT_EQ(output.front().size(0), 3);
+  EXPECT_EQ(output.front().size(1), 2);
+  EXPECT_FLOAT_EQ(output.front().data<float>()[0], 11);
+  EXPECT_FLOAT_EQ(output.front().data<float>()[1], 0);
+  EXPECT_EQ(p_->num_instances(), 1);
+  EXPECT_EQ(p_->num_busy_instances(), 0);
+}
+
+TEST_F(PooledPredictorTest, OutputsOutliveLaterRequests) {
+  PooledPredictor::TensorList input;
+  PooledPredictor::TensorList first;
+  PooledPredictor::TensorList second;
+  input.emplace_back(filledTensor(1, 1.0));
+  ASSERT_TRUE((*p_)(input, &first));
+  input[0] = filledTensor(1, 2.0);
+  ASSERT_TRUE((*p_)(input, &second));
+  EXPECT_FLOAT_EQ(first.front().data<float>()[0], 11);
+  EXPECT_FLOAT_EQ(second.front().data<float>()[0], 21);
+}
+
+TEST_F(PooledPredictorTest, UnknownInputName) {
+  auto config =
+      makePredictorConfig(parseNetDef(initSpec), parseNetDef(predictSpec));
+  config.input_names = {"data"};
+  PooledPredictor p(std::move(config));
+  PooledPredictor::TensorMap input;
+  input.emplace("hidden", filledTensor(1, 1.0));
+  PooledPredictor::TensorList output;
+  EXPECT_THROW(p(input, &output), EnforceNotMet);
+  EXPECT_EQ(p.num_busy_instances(), 0);
+}
+
+TEST_F(PooledPredictorTest, ConcurrentRequests) {
+  constexpr int kThreads = 8;
+  constexpr int kRequests = 50;
+  std::vector<std::thread> threads;
+  std::atomic<int> failures{0};
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kRequests; ++i) {
+        const float value = t + 1;
+        PooledPredictor::TensorMap input;
+        input.emplace("data", filledTensor(t + 1, value));
+        PooledPredictor::TensorList output;
+        if (!(*p_)(input, &output) || output.front().size(0) != t + 1 ||
+            output.front().data<float>()[0] != 10 * value + 1) {
+          ++failures;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(failures.load(), 0);
+  EXPECT_LE(p_->num_instances(), 2);
+  EXPECT_EQ(p_->num_busy_instances(), 0);
+}
+
+} // namespace caffe2
@@ -244,6 +244,16 @@ size_t PyTorchStreamReader::getRecordOffset(const std::string& name) {
   return stat.m_local_header_ofs + MZ_ZIP_LOCAL_DIR_HEADER_SIZE + filename_len + extra_len;
 }
 
+c10::optional<std::pair<size_t, size_t>>
+PyTorchStreamReader::getUncompressedRecordRegion(const std::string& name) {
+  mz_zip_archive_file_stat stat;
+  mz_zip_reader_file_stat(ar_.get(), getRecordID(name), &stat);
+  valid("retrieving file meta-data for ", name.c_str());
+  if (stat.m_method != 0 || stat.m_comp_size != stat.m_uncomp_size) {
+    return c10::nullopt;
+  }
+  return std::make_pair(getRecordOffset(name), (size_t)stat.m_uncomp_size);
+}
 
 PyTorchStreamReader::~PyTorchStreamReader() {
   mz_zip_clear_last_error(ar_.get());
@@ -9,6 +9,7 @@
 
 #include <c10/core/Allocator.h>
 #include <c10/core/Backend.h>
+#include <c10/util/Optional.h>
 
 #include "caffe2/serialize/istream_adapter.h"
 #include "caffe2/serialize/read_adapter_interface.h"
@@ -115,6 +116,11 @@ class CAFFE2_API PyTorchStreamReader final {
   // return dataptr, size
   std::tuple<at::DataPtr, size_t> getRecord(const std::string& name);
   size_t getRecordOffset(const std::string& name);
+  // return (offset, size) of the record data in the raw file if the record
+  // is stored uncompressed, so that it can be used in place from a mapping
+  // of the file, nullopt otherwise
+  c10::optional<std::pair<size_t, size_t>> getUncompressedRecordRegion(
+      const std::string& name);
   bool hasRecord(const std::string& name);
   std::vector<std::string> getAllRecords();
 
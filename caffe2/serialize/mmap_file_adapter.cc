@@ -0,0 +1,79 @@
+#include "caffe2/serialize/mmap_file_adapter.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include <c10/util/Exception.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace caffe2 {
+namespace serialize {
+
+MmapFileAdapter::MmapFileAdapter(const std::string& file_name) : size_(0) {
+#ifndef _WIN32
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    AT_ERROR("open file failed, file path: ", file_name);
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    AT_ERROR("cannot map empty or unreadable file, file path: ", file_name);
+  }
+  size_ = st.st_size;
+  void* addr =
+      mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+  if (addr == MAP_FAILED) {
+    AT_ERROR("mmap failed: ", std::strerror(errno), ", file path: ", file_name);
+  }
+  const size_t size = size_;
+  mapping_ =
+      std::shared_ptr<void>(addr, [size](void* ptr) { munmap(ptr, size); });
+#else
+  std::ifstream file(file_name, std::ifstream::in | std::ifstream::binary);
+  if (!file) {
+    AT_ERROR("open file failed, file path: ", file_name);
+  }
+  file.seekg(0, file.end);
+  size_ = file.tellg();
+  file.seekg(0, file.beg);
+  mapping_ = std::shared_ptr<void>(std::malloc(size_), std::free);
+  file.read(static_cast<char*>(mapping_.get()), size_);
+  if (!file) {
+    AT_ERROR("read file failed, file path: ", file_name);
+  }
+#endif
+}
+
+size_t MmapFileAdapter::size() const {
+  return size_;
+}
+
+size_t MmapFileAdapter::read(
+    uint64_t pos,
+    void* buf,
+    size_t n,
+    const char* what) const {
+  if (pos >= size_) {
+    return 0;
+  }
+  n = std::min(static_cast<size_t>(size_ - pos), n);
+  std::memcpy(buf, data() + pos, n);
+  return n;
+}
+
+MmapFileAdapter::~MmapFileAdapter() {}
+
+} // namespace serialize
+} // namespace caffe2
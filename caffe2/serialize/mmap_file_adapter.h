@@ -0,0 +1,43 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "c10/macros/Macros.h"
+#include "caffe2/serialize/read_adapter_interface.h"
+
+namespace caffe2 {
+namespace serialize {
+
+// Reads a file through a private, copy-on-write memory mapping of the whole
+// file. Besides the ReadAdapterInterface, it exposes the mapping itself so
+// that uncompressed records can be used in place instead of being copied
+// out of the archive. On platforms without mmap the file is read into memory
+// once.
+class CAFFE2_API MmapFileAdapter final : public ReadAdapterInterface {
+ public:
+  C10_DISABLE_COPY_AND_ASSIGN(MmapFileAdapter);
+  explicit MmapFileAdapter(const std::string& file_name);
+  size_t size() const override;
+  size_t read(uint64_t pos, void* buf, size_t n, const char* what = "")
+      const override;
+  ~MmapFileAdapter();
+
+  // Start of the mapped file. Pages are writable; writes are private to the
+  // process and never reach the file.
+  char* data() const {
+    return static_cast<char*>(mapping_.get());
+  }
+  // Keeps the mapping alive for as long as the returned pointer is held,
+  // independently of the adapter.
+  std::shared_ptr<void> mapping() const {
+    return mapping_;
+  }
+
+ private:
+  std::shared_ptr<void> mapping_;
+  size_t size_;
+};
+
+} // namespace serialize
+} // namespace caffe2
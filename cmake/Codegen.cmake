@@ -110,6 +110,17 @@ if(INTERN_BUILD_ATEN_OPS)
     endif(MSVC)
   endif(CXX_AVX2_FOUND)
 
+  # Like the Vec256 ones, the Vec512 specializations are compiled out under
+  # MSVC, so there is no point in building an AVX512 copy of the kernels
+  # there. The AVX512 copies also define CPU_CAPABILITY_AVX2: kernels that
+  # have not been ported to Vec512 keep using the AVX2 Vec256
+  # specializations instead of falling back to the scalar emulation.
+  if(CXX_AVX512_FOUND AND CXX_AVX2_FOUND AND NOT MSVC)
+    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DHAVE_AVX512_CPU_DEFINITION")
+    list(APPEND CPU_CAPABILITY_NAMES "AVX512")
+    list(APPEND CPU_CAPABILITY_FLAGS "${OPT_FLAG} -mavx512f -mavx512bw -mavx512vl -mavx512dq -mfma ${CPU_NO_AVX256_SPLIT_FLAGS} -DCPU_CAPABILITY_AVX2")
+  endif()
+
   list(LENGTH CPU_CAPABILITY_NAMES NUM_CPU_CAPABILITY_NAMES)
   math(EXPR NUM_CPU_CAPABILITY_NAMES "${NUM_CPU_CAPABILITY_NAMES}-1")
 
@@ -25,6 +25,23 @@ SET(AVX2_CODE "
   }
 ")
 
+SET(AVX512_CODE "
+  #include <immintrin.h>
+
+  int main()
+  {
+    __m512i a = _mm512_set1_epi16(1);
+    __m512 b = _mm512_set1_ps(0);
+    a = _mm512_abs_epi16(a); // AVX512BW
+    __m256i c = _mm512_cvtepi64_epi32(_mm512_set1_epi64(0)); // AVX512F
+    __mmask8 m = _mm256_cmpeq_epi32_mask(c, c); // AVX512VL
+    __m512d d = _mm512_and_pd(_mm512_set1_pd(0), _mm512_set1_pd(0)); // AVX512DQ
+    b = _mm512_fmadd_ps(b, b, b);
+    (void)a; (void)b; (void)m; (void)d;
+    return 0;
+  }
+")
+
 MACRO(CHECK_SSE lang type flags)
   SET(__FLAG_I 1)
   SET(CMAKE_REQUIRED_FLAGS_SAVE ${CMAKE_REQUIRED_FLAGS})
@@ -59,3 +76,4 @@ CHECK_SSE(C "AVX2" " ;-mavx2 -mfma;/arch:AVX2")
 
 CHECK_SSE(CXX "AVX" " ;-mavx;/arch:AVX")
 CHECK_SSE(CXX "AVX2" " ;-mavx2 -mfma;/arch:AVX2")
+CHECK_SSE(CXX "AVX512" " ;-mavx512f -mavx512bw -mavx512vl -mavx512dq -mfma;/arch:AVX512")
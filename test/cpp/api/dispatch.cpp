@@ -60,3 +60,19 @@ TEST_F(DispatchTest, TestDefault) {
     ASSERT_EQ(result[i], actual_pow_default[i].item<int>());
   }
 }
+
+TEST_F(DispatchTest, TestAVX512) {
+  const std::vector<int> ints {1, 2, 3, 4};
+  const std::vector<int> result {1, 4, 27, 256};
+  const auto vals_tensor = torch::tensor(ints);
+  const auto pows_tensor = torch::tensor(ints);
+#ifdef _WIN32
+  _putenv("ATEN_CPU_CAPABILITY=avx512");
+#else
+  setenv("ATEN_CPU_CAPABILITY", "avx512", 1);
+#endif
+  const auto actual_pow_avx512 = vals_tensor.pow(pows_tensor);
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(result[i], actual_pow_avx512[i].item<int>());
+  }
+}
@@ -3471,6 +3471,44 @@ TEST_F(ModulesTest, MultiheadAttention) {
   );
 }
 
+TEST_F(ModulesTest, MultiheadAttentionWithoutWeights) {
+  // Without the attention weights the forward takes the fused path; it must
+  // agree with the unfused one, including its gradients.
+  const int64_t tgt_len = 5, src_len = 7, bsz = 3, embed_dim = 8, num_heads = 2;
+  MultiheadAttention mha(MultiheadAttentionOptions(embed_dim, num_heads));
+  auto query = torch::randn({tgt_len, bsz, embed_dim}, torch::requires_grad());
+  auto key = torch::randn({src_len, bsz, embed_dim}, torch::requires_grad());
+  auto attn_mask = torch::randn({tgt_len, src_len});
+  auto key_padding_mask = torch::zeros({bsz, src_len}, torch::kBool);
+  key_padding_mask[0][src_len - 1].fill_(true);
+
+  torch::Tensor expected, weights;
+  std::tie(expected, weights) = mha(query, key, key, key_padding_mask, /*need_weights=*/true, attn_mask);
+  expected.sum().backward();
+  auto expected_query_grad = query.grad().clone();
+  auto expected_key_grad = key.grad().clone();
+  query.grad().zero_();
+  key.grad().zero_();
+
+  torch::Tensor result;
+  std::tie(result, weights) = mha(query, key, key, key_padding_mask, /*need_weights=*/false, attn_mask);
+  ASSERT_FALSE(weights.defined());
+  ASSERT_TRUE(torch::allclose(result, expected, 1e-5, 1e-5));
+  result.sum().backward();
+  ASSERT_TRUE(torch::allclose(query.grad(), expected_query_grad, 1e-4, 1e-5));
+  ASSERT_TRUE(torch::allclose(key.grad(), expected_key_grad, 1e-4, 1e-5));
+
+  // A mask that requires grad gets it from the unfused path
+  attn_mask.requires_grad_(true);
+  std::tie(expected, weights) = mha(query, key, key, key_padding_mask, /*need_weights=*/true, attn_mask);
+  expected.sum().backward();
+  auto expected_mask_grad = attn_mask.grad().clone();
+  attn_mask.grad().zero_();
+  std::tie(result, weights) = mha(query, key, key, key_padding_mask, /*need_weights=*/false, attn_mask);
+  result.sum().backward();
+  ASSERT_TRUE(torch::allclose(attn_mask.grad(), expected_mask_grad, 1e-4, 1e-5));
+}
+
 TEST_F(ModulesTest, PrettyPrintIdentity) {
   ASSERT_EQ(c10::str(Identity()), "torch::nn::Identity()");
 }
@@ -434,6 +434,64 @@ TEST(OptimTest, ExternalVectorOfParameters) {
   ASSERT_TRUE(parameters[2].allclose(original_parameters[2] - 1.0));
 }
 
+// Contiguous parameters are updated by the fused at::_fused_*_ kernels and
+// non-contiguous ones by the per-parameter ops, which should agree.
+template <typename OptimizerClass, typename Options>
+void check_fused_matches_unfused(Options options) {
+  torch::manual_seed(0);
+
+  std::vector<torch::Tensor> fused_parameters;
+  std::vector<torch::Tensor> unfused_parameters;
+  for (int64_t size : {1, 17, 3000}) {
+    auto parameter = torch::randn({size, 7}, torch::kFloat64);
+    fused_parameters.push_back(parameter.clone().requires_grad_());
+    unfused_parameters.push_back(
+        torch::empty_strided({size, 7}, {1, size}, torch::kFloat64)
+            .copy_(parameter)
+            .requires_grad_());
+  }
+  ASSERT_FALSE(unfused_parameters[2].is_contiguous());
+
+  auto fused_optimizer = OptimizerClass(fused_parameters, options);
+  auto unfused_optimizer = OptimizerClass(unfused_parameters, options);
+  for (int step = 0; step < 5; ++step) {
+    for (size_t i = 0; i < fused_parameters.size(); ++i) {
+      auto grad = torch::randn_like(fused_parameters[i]);
+      fused_parameters[i].grad() = grad;
+      unfused_parameters[i].grad() = grad.clone();
+    }
+    fused_optimizer.step();
+    unfused_optimizer.step();
+    for (size_t i = 0; i < fused_parameters.size(); ++i) {
+      ASSERT_TRUE(fused_parameters[i].allclose(unfused_parameters[i]));
+    }
+  }
+}
+
+TEST(OptimTest, FusedStepMatchesUnfused_SGD) {
+  check_fused_matches_unfused<SGD>(SGDOptions(0.1).weight_decay(1e-2));
+  check_fused_matches_unfused<SGD>(
+      SGDOptions(0.1).momentum(0.9).dampening(0.1).weight_decay(1e-2));
+  check_fused_matches_unfused<SGD>(
+      SGDOptions(0.1).momentum(0.9).nesterov(true));
+}
+
+TEST(OptimTest, FusedStepMatchesUnfused_Adam) {
+  check_fused_matches_unfused<Adam>(AdamOptions(0.1).weight_decay(1e-2));
+  check_fused_matches_unfused<Adam>(AdamOptions(0.1).amsgrad(true));
+}
+
+TEST(OptimTest, FusedStepMatchesUnfused_Adagrad) {
+  check_fused_matches_unfused<Adagrad>(
+      AdagradOptions(0.1).weight_decay(1e-2).lr_decay(1e-3));
+}
+
+TEST(OptimTest, FusedStepMatchesUnfused_RMSprop) {
+  check_fused_matches_unfused<RMSprop>(RMSpropOptions(0.1).weight_decay(1e-2));
+  check_fused_matches_unfused<RMSprop>(
+      RMSpropOptions(0.1).centered(true).momentum(0.9));
+}
+
 TEST(OptimTest, AddParameter_LBFGS) {
   torch::manual_seed(0);
 
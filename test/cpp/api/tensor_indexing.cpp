@@ -515,6 +515,47 @@ TEST(TensorIndexingTest, TestBasicAdvancedCombined) {
   }
 }
 
+TEST(TensorIndexingTest, TestFusedBasicIndexing) {
+  // Indexing a tensor that requires grad goes through a select / slice per
+  // index instead of computing the view directly, both must agree
+  auto x = torch::arange(0, 2 * 3 * 4 * 5, torch::kFloat).view({2, 3, 4, 5}).transpose(1, 2);
+  auto y = x.clone().requires_grad_();
+  std::vector<std::vector<TensorIndex>> all_indices = {
+    {0, Slice(1, 3)},
+    {-1, None, Slice(None, None, 2), 1},
+    {Ellipsis, 0, None},
+    {Slice(1), Ellipsis, Slice(-3, -1), None},
+    {None, 1, Slice(5, 10), Ellipsis},
+    {Slice(), torch::tensor({0, 2}), Slice(1, None, 3)},
+    {1, Slice(None, 2), torch::tensor({{2, 0}, {1, 2}})},
+  };
+  for (const auto& indices : all_indices) {
+    auto fused = x.index(indices);
+    auto unfused = y.index(indices);
+    ASSERT_EQ(fused.sizes(), unfused.sizes());
+    assert_tensor_equal(fused, unfused.detach());
+    bool is_view = std::none_of(
+        indices.begin(), indices.end(), [](const TensorIndex& index) { return index.is_tensor(); });
+    if (is_view) {
+      ASSERT_EQ(fused.strides(), unfused.strides());
+      ASSERT_EQ(fused.storage_offset(), unfused.storage_offset());
+    }
+  }
+
+  // Views write through to the indexed tensor
+  x.index({1, Slice(None, None, 2), 0}).fill_(-1);
+  ASSERT_EQ(x.index({1, 2, 0, 0}).item<float>(), -1);
+  ASSERT_EQ(x.index({1, 1, 0, 0}).item<float>(), 65);
+
+  // Assigning a value that requires grad takes the unfused path
+  auto value = torch::randn({4}, torch::requires_grad());
+  auto z = torch::zeros({2, 3, 4});
+  z.index_put_({1, Slice(None, None, 2)}, value);
+  assert_tensor_equal(z.index({1, 2}), value.detach());
+  z.sum().backward();
+  assert_tensor_equal(value.grad(), torch::full({4}, 2));
+}
+
 TEST(TensorIndexingTest, TestIntAssignment) {
   {
     auto x = torch::arange(0, 4).to(torch::kLong).view({2, 2});
@@ -1,4 +1,6 @@
+#include <atomic>
 #include <memory>
+#include <thread>
 
 #include <gtest/gtest.h>
 
@@ -104,6 +106,39 @@ TEST_F(DistAutogradTest, TestInitializedContextCleanupSendFunction) {
   ASSERT_EQ(0, engine.numBackwardPasses());
 }
 
+TEST_F(DistAutogradTest, TestConcurrentBackwardPasses) {
+  // The backward passes of the contexts run concurrently on the CPU worker
+  // pool of the local engine.
+  autogradContainer_->newContext();
+  auto& engine = DistEngine::getInstance();
+  const int numThreads = 8;
+  std::vector<std::thread> threads;
+  std::atomic<int> numCorrect{0};
+  for (int i = 0; i < numThreads; ++i) {
+    threads.emplace_back([&engine, &numCorrect, i]() {
+      auto context = autogradContainer_->newContext();
+      auto options = at::TensorOptions().requires_grad(true);
+      auto x = torch::full({10, 10}, i + 1, options);
+      auto y = torch::ones({10, 10}, options);
+      auto loss = (x * y).relu().sum() + (x.exp() * y).sum();
+
+      engine.execute(context->contextId(), {loss}, /* retainGraph */ false);
+
+      auto grads = context->getGradients();
+      if (grads.at(x).allclose(y + x.exp().detach()) &&
+          grads.at(y).allclose(x.detach() + x.exp().detach())) {
+        ++numCorrect;
+      }
+      autogradContainer_->releaseContext(context->contextId());
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(numThreads, numCorrect.load());
+  ASSERT_EQ(0, engine.numBackwardPasses());
+}
+
 } // namespace autograd
 } // namespace distributed
 } // namespace torch
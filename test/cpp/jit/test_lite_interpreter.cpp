@@ -2,8 +2,11 @@
 #include <test/cpp/jit/test_base.h>
 #include <torch/csrc/autograd/generated/variable_factories.h>
 #include <torch/csrc/jit/api/module.h>
+#include <torch/csrc/jit/mobile/function.h>
 #include <torch/csrc/jit/mobile/import.h>
 #include <torch/csrc/jit/mobile/module.h>
+#include <torch/csrc/jit/mobile/observer.h>
+#include <torch/csrc/jit/runtime/instruction.h>
 #include <torch/csrc/jit/serialization/import.h>
 #include <torch/custom_class.h>
 #include <torch/torch.h>
@@ -157,6 +160,129 @@ void testLiteInterpreterDict() {
   AT_ASSERT(output.toGenericDict().at("result").toTensor().item().toInt() == 2);
 }
 
+void testLiteInterpreterMemoryPlan() {
+  Module m("m");
+  m.define(R"JIT(
+  def forward(self, x):
+      a = x * 2
+      b = a + 1
+      c = torch.relu(b)
+      d = c * 3
+      return d + x
+  )JIT");
+  std::vector<IValue> inputs({torch::randn({4, 8})});
+  auto ref = m.forward(inputs).toTensor();
+
+  std::stringstream ss;
+  m._save_for_mobile(ss);
+  mobile::Module bc = _load_for_mobile(ss);
+  ASSERT_EQ(bc.memory_arena_size(), 0);
+
+  // The first run learns the slot sizes, later runs are served by the arena.
+  auto res = bc.forward(inputs).toTensor();
+  ASSERT_TRUE(res.equal(ref));
+  auto arena_size = bc.memory_arena_size();
+  ASSERT_TRUE(arena_size > 0);
+  // Intermediates with disjoint lifetimes share slots, the arena is smaller
+  // than all four of them.
+  ASSERT_TRUE(arena_size < 4 * ref.nbytes());
+
+  res = bc.forward(inputs).toTensor();
+  ASSERT_TRUE(res.equal(ref));
+  ASSERT_EQ(bc.memory_arena_size(), arena_size);
+
+  // The returned tensor is never served from the arena, so holding on to it
+  // cannot be clobbered by later runs.
+  auto held = bc.forward(inputs).toTensor();
+  bc.forward({torch::zeros({4, 8})});
+  ASSERT_TRUE(held.equal(ref));
+}
+
+namespace {
+class LoadStageRecorder : public torch::MobileModuleObserver {
+ public:
+  explicit LoadStageRecorder(std::vector<std::string>* stages)
+      : stages_(stages) {}
+  void onLoadStage(const std::string& stage, int64_t duration_us) override {
+    stages_->push_back(stage);
+  }
+
+ private:
+  std::vector<std::string>* stages_;
+};
+} // namespace
+
+void testLiteInterpreterLoadMmap() {
+  Module m("m");
+  m.register_parameter("weight", torch::randn({8, 4}), false);
+  m.define(R"JIT(
+  def forward(self, x):
+      return torch.matmul(x, self.weight) + 1
+
+  def unused(self, x):
+      return x * 2
+  )JIT");
+  std::vector<IValue> inputs({torch::randn({2, 8})});
+  auto ref = m.forward(inputs).toTensor();
+
+  const std::string filename = "lite_interpreter_load_mmap_test.ptl";
+  m._save_for_mobile(filename);
+
+  std::vector<std::string> stages;
+  torch::observerConfig().setModuleObserver(
+      std::make_unique<LoadStageRecorder>(&stages));
+  {
+    mobile::Module bc = _load_for_mobile_mmap(filename);
+    std::vector<std::string> expected_stages = {
+        "read_bytecode", "parse_methods", "read_data"};
+    ASSERT_EQ(stages, expected_stages);
+    // Parameters alias the mapped file and are writable without touching it.
+    auto params = bc.parameters();
+    ASSERT_EQ(params.size(), 1);
+    ASSERT_TRUE(params[0].equal(m.attr("weight").toTensor()));
+
+    auto res = bc.forward(inputs).toTensor();
+    ASSERT_TRUE(res.equal(ref));
+    // Only the method that ran was parsed.
+    ASSERT_EQ(stages.size(), 4);
+    ASSERT_EQ(stages.back(), "parse_method:__torch__.m.forward");
+    res = bc.forward(inputs).toTensor();
+    ASSERT_TRUE(res.equal(ref));
+    ASSERT_EQ(stages.size(), 4);
+
+    params[0].zero_();
+  }
+  torch::observerConfig().setModuleObserver(nullptr);
+
+  mobile::Module bc = _load_for_mobile(filename);
+  ASSERT_TRUE(bc.forward(inputs).toTensor().equal(ref));
+  std::remove(filename.c_str());
+}
+
+void testLiteInterpreterLazyLoadRetry() {
+  mobile::Function function(c10::QualifiedName("lazy"));
+  int attempts = 0;
+  function.set_lazy_loader([&attempts](mobile::Function& fn) {
+    fn.append_constant(++attempts);
+    if (attempts == 1) {
+      throw std::runtime_error("truncated method");
+    }
+    fn.append_instruction(LOADC, 0, 0);
+    fn.append_instruction(RET, 0, 0);
+    fn.set_register_size(0);
+  });
+
+  Stack stack;
+  ASSERT_ANY_THROW(function.run(stack));
+  // The failed attempt left nothing behind, the retry loads from scratch.
+  ASSERT_TRUE(stack.empty());
+  function.run(stack);
+  ASSERT_EQ(stack.size(), 1);
+  ASSERT_EQ(stack.back().toInt(), 2);
+  function.run(stack);
+  ASSERT_EQ(attempts, 2);
+}
+
 void testLiteInterpreterPrimOverload() {
   /*
   // temporarily disabled
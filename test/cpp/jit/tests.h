@@ -93,6 +93,9 @@ namespace jit {
   _(LiteInterpreterSetState)           \
   _(TorchbindIValueAPI)                \
   _(LiteInterpreterDict)               \
+  _(LiteInterpreterMemoryPlan)         \
+  _(LiteInterpreterLoadMmap)           \
+  _(LiteInterpreterLazyLoadRetry)      \
   _(FusionAliasing)
 
 #if defined(USE_CUDA)
@@ -2124,6 +2124,57 @@ class TestQuantizeScriptPTSQOps(QuantizationTestCase):
             FileCheck().check_not("aten::hardswish") \
                        .run(m.graph)
 
+    def test_softmax(self):
+        data = [(torch.rand((1, 2, 5, 5), dtype=torch.float), torch.randint(0, 1, (1,), dtype=torch.long)) for _ in range(2)]
+        softmax = torch.nn.Softmax(dim=1)
+        for tracing in [True, False]:
+            m = self.checkGraphModeOp(softmax, data, "quantized::softmax", tracing)
+            FileCheck().check_not("aten::softmax") \
+                       .run(m.graph)
+
+    def test_quantized_bmm_matmul(self):
+        class QuantizedAttentionScores(torch.nn.Module):
+            def __init__(self, use_bmm):
+                super(QuantizedAttentionScores, self).__init__()
+                self.q = torch.nn.Linear(4, 4).float()
+                self.k = torch.nn.Linear(4, 4).float()
+                self.use_bmm = use_bmm
+
+            def forward(self, x):
+                q = self.q(x)
+                k = self.k(x).transpose(1, 2)
+                if self.use_bmm:
+                    return torch.bmm(q, k)
+                return torch.matmul(q, k)
+
+        data = [(torch.rand((2, 3, 4), dtype=torch.float), torch.randint(0, 1, (1,), dtype=torch.long)) for _ in range(2)]
+        for use_bmm, op in [(True, "bmm"), (False, "matmul")]:
+            for tracing in [True, False]:
+                # aten::matmul is only quantized when the shapes of its inputs
+                # are known to be supported, which requires tracing
+                if op == "matmul" and not tracing:
+                    continue
+                m = self.checkGraphModeOp(QuantizedAttentionScores(use_bmm), data,
+                                          "quantized::" + op, tracing)
+                FileCheck().check_not("aten::" + op + "(") \
+                           .run(m.graph)
+
+        class BroadcastMatmul(torch.nn.Module):
+            def __init__(self):
+                super(BroadcastMatmul, self).__init__()
+                self.q = torch.nn.Linear(4, 4).float()
+                self.k = torch.nn.Linear(4, 4).float()
+
+            def forward(self, x):
+                # the batch dimension of k is broadcast
+                return torch.matmul(self.q(x), self.k(x[:1]).transpose(1, 2))
+
+        # quantized::matmul doesn't broadcast, the float matmul is kept
+        for tracing in [True, False]:
+            m = self.checkGraphModeOp(BroadcastMatmul(), data, "aten::matmul(", tracing)
+            FileCheck().check_not("quantized::matmul") \
+                       .run(m.graph)
+
     def test_layer_norm(self):
         data = [(torch.rand((1, 2, 5, 5), dtype=torch.float), torch.randint(0, 1, (1,), dtype=torch.long)) for _ in range(2)]
         layer_norm = torch.nn.LayerNorm([2, 5, 5])
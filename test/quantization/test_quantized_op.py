@@ -863,6 +863,74 @@ class TestQuantizedOps(TestCase):
         np.testing.assert_equal(qC, qC_hat.int_repr(),
                                 "Quantized multiplication failed.")
 
+    """Tests the correctness of the quantized bmm, matmul and their relu variants."""
+    def test_qbmm_qmatmul(self):
+        for dtype in [torch.quint8, torch.qint8]:
+            A = torch.randn(4, 5, 7)
+            B = torch.randn(4, 7, 19)
+            scale_A, zero_point_A = 0.05, 3
+            scale_B, zero_point_B = 0.03, 7
+            scale_C, zero_point_C = 0.1, 10
+
+            qA = torch.quantize_per_tensor(A, scale=scale_A, zero_point=zero_point_A,
+                                           dtype=dtype)
+            qB = torch.quantize_per_tensor(B, scale=scale_B, zero_point=zero_point_B,
+                                           dtype=dtype)
+
+            C = torch.bmm(qA.dequantize(), qB.dequantize()).numpy()
+            qC = _quantize(C, scale_C, zero_point_C, dtype=np_dtype[dtype])
+            qC_hat = torch.ops.quantized.bmm(qA, qB, scale_C, zero_point_C)
+            np.testing.assert_allclose(qC, qC_hat.int_repr().numpy(), atol=1,
+                                       err_msg="Quantized bmm failed.")
+
+            Crelu = C.copy()
+            Crelu[C < 0] = 0
+            qCrelu = _quantize(Crelu, scale_C, zero_point_C, dtype=np_dtype[dtype])
+            qCrelu_hat = torch.ops.quantized.bmm_relu(qA, qB, scale_C, zero_point_C)
+            np.testing.assert_allclose(qCrelu, qCrelu_hat.int_repr().numpy(), atol=1,
+                                       err_msg="Quantized bmm with ReLU failed.")
+
+            # 4-D attention style inputs and a shared 2-D right hand side
+            qA4 = qA.reshape(2, 2, 5, 7)
+            qB4 = qB.reshape(2, 2, 7, 19)
+            qC4_hat = torch.ops.quantized.matmul(qA4, qB4, scale_C, zero_point_C)
+            self.assertEqual(qC4_hat.int_repr(), qC_hat.int_repr().reshape(2, 2, 5, 19))
+
+            C2 = torch.matmul(qA.dequantize(), qB[0].dequantize()).numpy()
+            qC2 = _quantize(C2, scale_C, zero_point_C, dtype=np_dtype[dtype])
+            qC2_hat = torch.ops.quantized.matmul(qA, qB[0], scale_C, zero_point_C)
+            np.testing.assert_allclose(qC2, qC2_hat.int_repr().numpy(), atol=1,
+                                       err_msg="Quantized matmul failed.")
+
+            # An empty reduction (K == 0) gives zeros, with a 2-D and a 3-D right hand side
+            qA0 = torch.quantize_per_tensor(torch.randn(2, 3, 0), scale=scale_A, zero_point=zero_point_A,
+                                            dtype=dtype)
+            for B0 in [torch.randn(0, 4), torch.randn(2, 0, 4)]:
+                qB0 = torch.quantize_per_tensor(B0, scale=scale_B, zero_point=zero_point_B, dtype=dtype)
+                for op in [torch.ops.quantized.matmul, torch.ops.quantized.matmul_relu]:
+                    qC0_hat = op(qA0, qB0, scale_C, zero_point_C)
+                    self.assertEqual(qC0_hat.shape, (2, 3, 4))
+                    self.assertEqual(qC0_hat.dequantize(), torch.zeros(2, 3, 4))
+
+    """Tests the correctness of the quantized softmax op."""
+    @given(dims=st.lists(st.integers(2, 40), min_size=1, max_size=4),
+           dim=st.integers(-1, 0),
+           qtype=st.sampled_from([torch.quint8, torch.qint8]))
+    def test_qsoftmax(self, dims, dim, qtype):
+        X = torch.randn(*dims) * 5
+        qX = torch.quantize_per_tensor(X, scale=0.1, zero_point=10 if qtype == torch.quint8 else 0,
+                                       dtype=qtype)
+        output_scale = 1.0 / 256
+        output_zero_point = 0 if qtype == torch.quint8 else -128
+
+        Y = torch.softmax(qX.dequantize(), dim=dim)
+        qY = torch.quantize_per_tensor(Y, output_scale, output_zero_point, dtype=qtype)
+        qY_hat = torch.ops.quantized.softmax(qX, dim, output_scale, output_zero_point)
+        self.assertEqual(qY_hat.q_scale(), output_scale)
+        self.assertEqual(qY_hat.q_zero_point(), output_zero_point)
+        np.testing.assert_allclose(qY.int_repr().numpy(), qY_hat.int_repr().numpy(), atol=1,
+                                   err_msg="Quantized softmax failed.")
+
     """Tests channel shuffle operation on quantized tensors."""
     @given(X=hu.tensor(shapes=hu.array_shapes(min_dims=4, max_dims=4,
                                               min_side=2, max_side=32, max_numel=10**5),
@@ -2322,6 +2390,55 @@ class TestDynamicQuantizedRNNOp(TestCase):
 
                 self.assertEqual(result_ref[0], result_dynamic[0], msg="torch.quantized_lstm results are off")
 
+    @given(
+        num_batches=st.integers(1, 4),
+        input_size=st.integers(16, 32),
+        hidden_size=st.integers(4, 20),
+        per_channel_quant=st.booleans())
+    @override_qengines
+    def test_qlstmGRU_fused_gates(self, num_batches, input_size, hidden_size, per_channel_quant):
+        # Nothing requires grad in quantized_lstm/quantized_gru, so their cells
+        # compute the gates with the fused CPU kernels. Compare them with the
+        # chunk/sigmoid/tanh path, which _VF.lstm/_VF.gru take when the weights
+        # require grad. hidden_size covers both the vectorized loop and the
+        # scalar tail of the kernels.
+        seq_len = 1
+
+        for rnn_type in ['LSTM', 'GRU']:
+            for dtype in [torch.qint8, torch.float16]:
+                # Fp16 quantization is not supported for qnnpack
+                if torch.backends.quantized.engine == 'qnnpack' and dtype == torch.float16:
+                    continue
+
+                Xq, Hq, Cq = self._get_rnn_inputs(seq_len, num_batches, input_size, hidden_size, 1)
+                Wq1, Wq2, b1, b2 = self._get_rnn_weights_and_bias(input_size, hidden_size, 1, per_channel_quant, rnn_type)
+                if dtype == torch.qint8:
+                    packed_ih = torch.ops.quantized.linear_prepack(Wq1, b1)
+                    packed_hh = torch.ops.quantized.linear_prepack(Wq2, b2)
+                    cell_params = torch.ops.quantized.make_quantized_cell_params_dynamic(packed_ih, packed_hh, b1, b2, True)
+                    W_ref1 = Wq1.dequantize()
+                    W_ref2 = Wq2.dequantize()
+                else:
+                    packed_ih = torch.ops.quantized.linear_prepack_fp16(Wq1.dequantize(), b1)
+                    packed_hh = torch.ops.quantized.linear_prepack_fp16(Wq2.dequantize(), b2)
+                    cell_params = torch.ops.quantized.make_quantized_cell_params_fp16(packed_ih, packed_hh)
+                    W_ref1 = Wq1.dequantize().to(torch.float16).to(torch.float32)
+                    W_ref2 = Wq2.dequantize().to(torch.float16).to(torch.float32)
+                weights_ref = [W_ref1.requires_grad_(), W_ref2.requires_grad_(), b1, b2]
+
+                X, H, C = Xq.dequantize(), Hq.dequantize(), Cq.dequantize()
+                if rnn_type == 'LSTM':
+                    result_ref = _VF.lstm(X, (H, C), weights_ref, True, 1, 0, False, False, False)
+                    result_fused = torch.quantized_lstm(X, (H, C), [cell_params], True, 1, 0, False, False, False,
+                                                        dtype=torch.qint8, use_dynamic=True)
+                    self.assertEqual(result_ref[2].detach(), result_fused[2], msg="quantized_lstm cell state is off")
+                else:
+                    result_ref = _VF.gru(X, H, weights_ref, True, 1, 0, False, False, False)
+                    result_fused = torch.quantized_gru(X, H, [cell_params], True, 1, 0, False, False, False)
+                self.assertFalse(result_fused[0].requires_grad)
+                self.assertEqual(result_ref[0].detach(), result_fused[0], msg="fused {} gates are off".format(rnn_type))
+                self.assertEqual(result_ref[1].detach(), result_fused[1], msg="fused {} hidden state is off".format(rnn_type))
+
     @given(
         num_batches=st.integers(1, 4),
         input_size=st.integers(16, 32),
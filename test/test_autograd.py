@@ -1,5 +1,6 @@
 import contextlib
 import gc
+import json
 import sys
 import math
 import tempfile
@@ -2841,6 +2842,111 @@ class TestAutograd(TestCase):
                 self.assertEqual(event.input_shapes, input_shape_expected)
                 last_end = event.cpu_interval.end
 
+    def test_profiler_shapes_multithreaded(self):
+        def mm_loop(x):
+            for _ in range(4):
+                x = torch.mm(x, x)
+            return x
+
+        x = torch.rand(16, 16)
+        traced_mm_loop = torch.jit.trace(mm_loop, x)
+
+        def forked_mm_loops(x):
+            futs = [torch.jit._fork(traced_mm_loop, x) for _ in range(4)]
+            return [torch.jit._wait(fut) for fut in futs]
+
+        traced_forked_mm_loops = torch.jit.trace(forked_mm_loops, x)
+
+        # events of the forked tasks are recorded on the inter-op threads
+        with profile(record_shapes=True) as prof:
+            traced_forked_mm_loops(x)
+
+        mm_events = [event for event in prof.function_events if event.name == 'mm']
+        self.assertEqual(len(mm_events), 16)
+        for event in mm_events:
+            self.assertEqual(event.input_shapes, [[16, 16], [16, 16]])
+            self.assertGreaterEqual(event.cpu_interval.end, event.cpu_interval.start)
+
+    def test_profiler_flops(self):
+        x = torch.randn(8, 16)
+        w = torch.randn(32, 16)
+        img = torch.randn(2, 3, 10, 10)
+        conv_weight = torch.randn(4, 3, 3, 3)
+        with profile(with_flops=True) as prof:
+            torch.mm(x, w.t())
+            torch.nn.functional.conv2d(img, conv_weight, stride=2, padding=1)
+            x.add(x)
+            x.sum(dim=1)
+
+        def event(name):
+            events = [evt for evt in prof.function_events if evt.name == name]
+            self.assertEqual(len(events), 1)
+            return events[0]
+
+        mm = event('mm')
+        self.assertEqual(mm.flops, 2 * 8 * 16 * 32)
+        self.assertEqual(mm.bytes_accessed, 4 * (8 * 16 + 16 * 32 + 8 * 32))
+        # output of the convolution is 2x4x5x5
+        conv = event('convolution')
+        self.assertEqual(conv.flops, 2 * 2 * 4 * 5 * 5 * 3 * 3 * 3)
+        self.assertEqual(conv.bytes_accessed, 4 * (2 * 3 * 10 * 10 + 4 * 3 * 3 * 3 + 2 * 4 * 5 * 5))
+        add = event('add')
+        self.assertEqual(add.flops, 8 * 16)
+        self.assertEqual(add.bytes_accessed, 3 * 4 * 8 * 16)
+        reduction = event('sum')
+        self.assertEqual(reduction.flops, 8 * 16)
+        self.assertEqual(reduction.bytes_accessed, 4 * (8 * 16 + 8))
+        self.assertGreater(mm.gflops_per_s, 0)
+        self.assertGreater(mm.gbytes_per_s, 0)
+
+        averages = {evt.key: evt for evt in prof.key_averages()}
+        self.assertEqual(averages['mm'].flops, mm.flops)
+        self.assertIn('GFLOP/s', prof.key_averages().table())
+
+        with tempfile.NamedTemporaryFile(mode="w+") as f:
+            prof.export_chrome_trace(f.name)
+            trace = json.load(f)
+        mm_trace = [evt for evt in trace if evt["name"] == "mm"]
+        self.assertEqual(mm_trace[0]["args"]["flops"], mm.flops)
+
+        # The dtype of sum(self, dtype) isn't a reduced dimension
+        with profile(with_flops=True) as prof:
+            x.sum(dtype=torch.float64)
+        reduction = event('sum')
+        self.assertEqual(reduction.flops, 8 * 16)
+        self.assertEqual(reduction.bytes_accessed, 4 * (8 * 16 + 1))
+
+    def test_latency_observer(self):
+        from torch.autograd.profiler import (
+            enable_latency_observer, disable_latency_observer, reset_latency_stats,
+            latency_stats, latency_stats_prometheus)
+
+        x = torch.randn(3, 4)
+        reset_latency_stats()
+        enable_latency_observer(sampling_prob=1.0, record_shapes=True)
+        try:
+            for _ in range(10):
+                torch.mm(x, x.t())
+        finally:
+            disable_latency_observer()
+
+        stats = latency_stats()
+        self.assertEqual(stats['sampling_prob'], 1.0)
+        mm_stats = [op for op in stats['ops'] if op['name'] == 'mm']
+        self.assertEqual(sum(op['count'] for op in mm_stats), 10)
+        for op in mm_stats:
+            self.assertTrue(op['shapes'].startswith('[[3, 4]'))
+            self.assertLessEqual(op['min_ns'], op['p50_ns'])
+            self.assertLessEqual(op['p50_ns'], op['max_ns'])
+            self.assertEqual(sum(bucket[2] for bucket in op['buckets']), op['count'])
+        self.assertIn('torch_op_latency_seconds_count{op="', latency_stats_prometheus())
+
+        # the statistics are kept after disabling the observer
+        torch.mm(x, x.t())
+        self.assertEqual(latency_stats(), stats)
+        reset_latency_stats()
+        self.assertEqual(latency_stats()['ops'], [])
+
     def test_profiler_no_cuda(self):
         print("")
         layer = torch.nn.Linear(20, 30)
@@ -2996,6 +3102,36 @@ class TestAutograd(TestCase):
             ]
         )
 
+    def test_memory_profiler_peak_and_timeline(self):
+        with profile(profile_memory=True) as prof:
+            with record_function("test_temporary_alloc"):
+                x = torch.rand(100, 100)
+                y = x * 2
+                del x, y
+
+        for evt in prof.function_events:
+            if evt.name == "test_temporary_alloc":
+                # everything allocated in the scope was freed
+                self.assertEqual(evt.cpu_memory_usage, 0)
+                self.assertGreaterEqual(evt.cpu_memory_peak, 2 * 100 * 100 * 4)
+                break
+        else:
+            self.fail("test_temporary_alloc not found")
+
+        timeline = prof.memory_timeline
+        self.assertTrue(len(timeline) >= 4)
+        self.assertEqual([record.time for record in timeline],
+                         sorted(record.time for record in timeline))
+        self.assertGreaterEqual(max(record.cpu_memory_usage for record in timeline),
+                                evt.cpu_memory_peak)
+
+        with tempfile.NamedTemporaryFile(mode="w+") as f:
+            prof.export_chrome_trace(f.name)
+            trace = json.load(f)
+        counters = [event for event in trace if event["ph"] == "C"]
+        self.assertEqual([counter["args"]["CPU"] for counter in counters],
+                         [record.cpu_memory_usage for record in timeline])
+
     def test_record_function(self):
         x = torch.randn(10, 10)
 
@@ -3648,6 +3784,67 @@ for shape in [(1,), ()]:
         mean_combined = torch.stack(feat_combined).mean()
         mean_combined.backward()
 
+    def test_rematerialize(self):
+        def run(x, w):
+            h = torch.sigmoid(torch.tanh(x.mm(w)))
+            return torch.relu(h).softmax(1).mm(w.t()).sum()
+
+        x = torch.randn(4, 5, requires_grad=True)
+        w = torch.randn(5, 5, requires_grad=True)
+        expected = torch.autograd.grad(run(x, w), (x, w))
+        nbytes = x.numel() * x.element_size()
+
+        torch.autograd.reset_rematerialization_stats()
+        with torch.autograd.rematerialize():
+            out = run(x, w)
+        stats = torch.autograd.rematerialization_stats()
+        self.assertEqual(stats['rematerialized_tensors'], 4)
+        self.assertEqual(stats['rematerialized_bytes'], 4 * nbytes)
+        self.assertEqual(stats['recomputations'], 0)
+        self.assertEqual(torch.autograd.grad(out, (x, w)), expected)
+        # Each output is recomputed once, even if it is saved twice
+        self.assertEqual(torch.autograd.rematerialization_stats()['recomputations'], 4)
+
+        # The recomputed outputs are not kept after the backward pass that
+        # needed them, so they are recomputed again with a retained graph
+        torch.autograd.reset_rematerialization_stats()
+        with torch.autograd.rematerialize():
+            out = run(x, w)
+        for _ in range(2):
+            self.assertEqual(torch.autograd.grad(out, (x, w), retain_graph=True), expected)
+        self.assertEqual(torch.autograd.rematerialization_stats()['recomputations'], 8)
+
+        # The output of gelu is only recomputed for the backward of softmax,
+        # as the output of softmax stays alive. Its recipe never recomputes,
+        # so the recomputed output of gelu must not be kept for it: the second
+        # backward pass recomputes it again.
+        torch.autograd.reset_rematerialization_stats()
+        with torch.autograd.rematerialize():
+            out = torch.nn.functional.gelu(x).softmax(1)
+        for _ in range(2):
+            torch.autograd.grad(out.sum(), x, retain_graph=True)
+        self.assertEqual(torch.autograd.rematerialization_stats()['recomputations'], 2)
+
+        # All the outputs fit in the budget
+        torch.autograd.reset_rematerialization_stats()
+        with torch.autograd.rematerialize(memory_budget=4 * nbytes):
+            out = run(x, w)
+        stats = torch.autograd.rematerialization_stats()
+        self.assertEqual(stats['rematerialized_tensors'], 0)
+        self.assertEqual(stats['kept_bytes'], 4 * nbytes)
+        self.assertEqual(torch.autograd.grad(out, (x, w)), expected)
+        stats = torch.autograd.rematerialization_stats()
+        self.assertEqual(stats['recomputations'], 0)
+        self.assertEqual(stats['kept_bytes'], 0)
+
+        # The input of a recomputed output can't be modified in-place
+        with torch.autograd.rematerialize():
+            y = x * 2
+            out = torch.sigmoid(y).sum()
+        y.add_(1)
+        with self.assertRaisesRegex(RuntimeError, "modified by an inplace operation"):
+            out.backward()
+
     def _test_reentrant_with_callbacks(self, install_callbacks_in_depths):
         counter = {}
         counter["inner"] = 0
@@ -331,6 +331,45 @@ class TestIndexing(TestCase):
         x[1:2, [1, 2]] = 0
         self.assertNotEqual(x, unmodified)
 
+    def test_fused_basic_indexing(self, device):
+        # Indexing a tensor that requires grad goes through a select / slice
+        # per index instead of computing the view directly, both must agree
+        x = torch.arange(0., 120, device=device).view(2, 3, 4, 5).transpose(1, 2)
+        y = x.clone().requires_grad_()
+        idx = torch.tensor([[2, 0], [1, 2]], device=device)
+        indices = [
+            (0, slice(1, 3)),
+            (-1, None, slice(None, None, 2), 1),
+            (Ellipsis, 0, None),
+            (slice(1, None), Ellipsis, slice(-3, -1), None),
+            (None, 1, slice(5, 10), Ellipsis),
+            (slice(None), [0, 2], slice(1, None, 3)),
+            (1, slice(None, 2), idx),
+            (torch.tensor([1, 0], device=device), Ellipsis, torch.tensor([4, 0], device=device)),
+        ]
+        for index in indices:
+            fused = x[index]
+            unfused = y[index]
+            self.assertEqual(fused, unfused.detach())
+            if not any(isinstance(i, (list, torch.Tensor)) for i in index):
+                self.assertEqual(fused.stride(), unfused.stride())
+                self.assertEqual(fused.storage_offset(), unfused.storage_offset())
+
+        # views write through to the indexed tensor
+        x[1, ::2, 0] = -1
+        self.assertEqual(x[1, 2, 0, 0].item(), -1)
+        self.assertEqual(x[1, 1, 0, 0].item(), 65)
+        x[:, idx, 1] = -2
+        self.assertEqual(x[1, 2, 1, 0].item(), -2)
+
+        # assigning a value that requires grad takes the unfused path
+        value = torch.randn(4, device=device, requires_grad=True)
+        z = torch.zeros(2, 3, 4, device=device)
+        z[1, ::2] = value
+        self.assertEqual(z[1, 2], value.detach())
+        z.sum().backward()
+        self.assertEqual(value.grad, torch.full_like(value, 2))
+
     def test_int_assignment(self, device):
         x = torch.arange(0, 4, device=device).view(2, 2)
         x[1] = 5
@@ -150,6 +150,19 @@ def mixed_type_producer(queue, event):
         event.wait()
         event.clear()
 
+def pooled_shared_memory_producer(queue, ack, count):
+    mp._set_shared_memory_pool(True, 1 << 20)
+    for i in range(count):
+        storage = torch.FloatStorage._new_shared(1000)
+        queue.put(torch.FloatTensor(storage).fill_(i))
+        del storage
+        # Wait until the receiver freed the block
+        ack.get()
+    queue.put(mp._shared_memory_pool_stats())
+    mp._set_shared_memory_pool(False, 0)
+    ack.get()
+
+
 def simple_autograd_function(a=1):
     torch.rand(3).requires_grad_(True).mean().backward()
     return a ** 2
@@ -319,6 +332,55 @@ class TestMultiprocessing(TestCase):
     def test_fd_pool(self):
         self._test_pool(repeat=TEST_REPEATS)
 
+    @unittest.skipIf(platform == 'darwin', "file descriptor strategy is not supported on macOS")
+    @unittest.skipIf(IS_WINDOWS, "file descriptor strategy is not supported on Windows")
+    def test_shared_memory_pool(self):
+        count = 5
+        queue = mp.Queue()
+        ack = mp.Queue()
+        p = mp.Process(target=pooled_shared_memory_producer, args=(queue, ack, count))
+        p.start()
+        for i in range(count):
+            t = queue.get()
+            self.assertTrue(t.is_shared())
+            self.assertEqual(t, torch.full([1000], float(i)))
+            if i == count - 1:
+                # Moving a received block to shared memory again copies it
+                # to a regular shared memory file and frees the block
+                t.share_memory_()
+                self.assertTrue(t.is_shared())
+                self.assertEqual(t, torch.full([1000], float(i)))
+            del t
+            ack.put(None)
+        stats = queue.get()
+        # All the batches after the first reused its segment, which stayed
+        # mapped in this process
+        self.assertEqual(stats['allocations'], count)
+        self.assertEqual(stats['reused_allocations'], count - 1)
+        self.assertEqual(mp._shared_memory_pool_stats()['mapped_segments'], 1)
+        ack.put(None)
+        p.join()
+        mp._release_shared_memory_pool_segments(p.pid)
+        self.assertEqual(mp._shared_memory_pool_stats()['mapped_segments'], 0)
+
+    @unittest.skipIf(platform == 'darwin', "file descriptor strategy is not supported on macOS")
+    @unittest.skipIf(IS_WINDOWS, "file descriptor strategy is not supported on Windows")
+    def test_shared_memory_pool_killed_producer(self):
+        queue = mp.Queue()
+        ack = mp.Queue()
+        p = mp.Process(target=pooled_shared_memory_producer, args=(queue, ack, 1))
+        p.start()
+        t = queue.get()
+        # The producer never drops its segments
+        p.terminate()
+        p.join()
+        mp._release_shared_memory_pool_segments(p.pid)
+        # The segment stays mapped while the block is in use
+        self.assertEqual(mp._shared_memory_pool_stats()['mapped_segments'], 1)
+        self.assertEqual(t, torch.full([1000], 0.))
+        del t
+        self.assertEqual(mp._shared_memory_pool_stats()['mapped_segments'], 0)
+
     @unittest.skipIf(TEST_WITH_ASAN,
                      "seems to hang with ASAN, see https://github.com/pytorch/pytorch/issues/5326")
     def test_fs_sharing(self):
@@ -3397,6 +3397,46 @@ class TestNN(NNTestCase):
             # output_2d in shape of [T, 1, D]
             self.assertEqual(output_3d[i].unsqueeze(0).transpose(0, 1), output_2d)
 
+    def test_fused_attention(self):
+        def reference(q, k, v, mask, scale):
+            scores = torch.matmul(q, k.transpose(-2, -1)) * scale
+            if mask is not None:
+                if mask.dtype == torch.bool:
+                    mask = torch.zeros(mask.shape, dtype=q.dtype).masked_fill(mask, float('-inf'))
+                scores = scores + mask
+            return torch.matmul(torch.softmax(scores, dim=-1), v)
+
+        # The second case spans several blocks of queries and keys.
+        for dtype, (L, S) in product((torch.float, torch.double), ((5, 7), (70, 300))):
+            q = torch.randn(2, 3, L, 8, dtype=dtype)
+            k = torch.randn(2, 3, S, 8, dtype=dtype)
+            v = torch.randn(2, 3, S, 6, dtype=dtype)
+            float_mask = torch.randn(L, S, dtype=dtype)
+            bool_mask = torch.rand(2, 1, L, S) < 0.3
+            bool_mask[..., 0] = False
+            for mask in (None, float_mask, bool_mask):
+                out, lse = torch._fused_attention(q, k, v, mask, 0.5)
+                self.assertEqual(out, reference(q, k, v, mask, 0.5))
+                self.assertEqual(lse.shape, (2, 3, L))
+
+            # Non-contiguous inputs
+            out, _ = torch._fused_attention(q.transpose(0, 1), k.transpose(0, 1), v.transpose(0, 1), float_mask, 0.5)
+            self.assertEqual(out, reference(q, k, v, float_mask, 0.5).transpose(0, 1))
+
+        # A row that is masked out entirely is NaN, as with softmax.
+        q, k, v = torch.randn(1, 2, 4), torch.randn(1, 3, 4), torch.randn(1, 3, 4)
+        mask = torch.zeros(2, 3, dtype=torch.bool)
+        mask[1] = True
+        out, _ = torch._fused_attention(q, k, v, mask, 1.0)
+        self.assertFalse(out[0, 0].isnan().any())
+        self.assertTrue(out[0, 1].isnan().all())
+
+        q = torch.randn(2, 5, 4, dtype=torch.double, requires_grad=True)
+        k = torch.randn(2, 7, 4, dtype=torch.double, requires_grad=True)
+        v = torch.randn(2, 7, 3, dtype=torch.double, requires_grad=True)
+        mask = torch.randn(5, 7, dtype=torch.double)
+        gradcheck(lambda q, k, v: torch._fused_attention(q, k, v, mask, 0.5)[0], (q, k, v))
+
     def test_normalize(self):
         inputs = torch.randn(1, 3, 4, 4, requires_grad=True)
         self.assertTrue(gradcheck(lambda x: F.normalize(x, p=1, dim=-1), (inputs,)))
@@ -4623,6 +4663,18 @@ class TestNN(NNTestCase):
 
             (hx + cx).sum().backward()
 
+    def test_RNN_cpu_fused_cell_inference(self):
+        # without autograd the CPU LSTM/GRU cells use a fused pointwise
+        # kernel, which must agree with the unfused autograd path
+        for module in (nn.LSTM, nn.GRU):
+            for hidden_size in (7, 32):
+                rnn = module(5, hidden_size, num_layers=2, bidirectional=True).double()
+                input = torch.randn(6, 3, 5, dtype=torch.double)
+                expected = rnn(input)
+                with torch.no_grad():
+                    actual = rnn(input)
+                self.assertEqual(expected, actual)
+
     @unittest.skipIf(not TEST_CUDA, 'CUDA not available')
     def test_pack_sequence_batch_sizes_throw(self):
         with self.assertRaisesRegex(ValueError, r"batch_sizes should always be on CPU"):
@@ -8007,6 +8059,44 @@ class TestNN(NNTestCase):
                     for gr, gr_expected in zip(grads, grads_expected):
                         self.assertAlmostEqual(gr, gr_expected, delta=3e-4)
 
+    def test_winograd_and_direct_conv(self):
+        for batch, chan_in, chan_out, size, padding, has_bias in \
+                product([1, 3], [1, 3, 16], [5, 8], [(4, 4), (9, 7), (17, 20)], [(0, 0), (1, 1), (2, 1)], [True, False]):
+            input = torch.randn(batch, chan_in, *size, dtype=torch.double)
+            weight = torch.randn(chan_out, chan_in, 3, 3, dtype=torch.double)
+            bias = torch.randn(chan_out, dtype=torch.double) if has_bias else None
+            output_expected = torch.nn.functional.conv2d(input, weight, bias, padding=padding)
+
+            # Winograd is only used for float by the convolutions, but the
+            # kernel is exact up to rounding in double too.
+            output = torch._winograd_convolution2d(input, weight, bias, padding)
+            self.assertEqual(output, output_expected)
+            output = torch._winograd_convolution2d(input.float(), weight.float(),
+                                                   bias.float() if has_bias else None, padding)
+            self.assertEqual(output, output_expected.float(), prec=1e-4 * chan_in)
+
+            for stride in [(1, 1), (2, 3)]:
+                output_expected = torch.nn.functional.conv2d(input, weight, bias, stride=stride, padding=padding)
+                output = torch._direct_convolution2d(
+                    input.contiguous(memory_format=torch.channels_last), weight, bias, padding, stride)
+                self.assertTrue(output.is_contiguous(memory_format=torch.channels_last))
+                self.assertEqual(output, output_expected)
+
+        input = torch.randn(2, 3, 6, 7, dtype=torch.double, requires_grad=True)
+        weight = torch.randn(4, 3, 3, 3, dtype=torch.double, requires_grad=True)
+        bias = torch.randn(4, dtype=torch.double, requires_grad=True)
+        gradcheck(lambda i, w, b: torch._winograd_convolution2d(i, w, b, (1, 1)), (input, weight, bias))
+        gradcheck(lambda i, w, b: torch._direct_convolution2d(i, w, b, (1, 0), (2, 1)), (input, weight, bias))
+
+        # Without MKL-DNN, conv2d picks the algorithms for small channels.
+        with torch.backends.mkldnn.flags(enabled=False):
+            for memory_format in [torch.contiguous_format, torch.channels_last]:
+                input = torch.randn(2, 4, 16, 16).contiguous(memory_format=memory_format)
+                conv = torch.nn.Conv2d(4, 4, 3, padding=1)
+                output_expected = torch.nn.functional.conv2d(
+                    input.double(), conv.weight.double(), conv.bias.double(), padding=1)
+                self.assertEqual(conv(input), output_expected.float(), prec=1e-4)
+
     def test_fold_invalid_arg(self):
         # input wrong dimension
 
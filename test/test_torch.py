@@ -2472,6 +2472,27 @@ class AbstractTestCases:
                     added = zeros.index_add(0, torch.arange(0, size[0], dtype=torch.long, device=device), tensor)
                     self.assertEqual(added, tensor)
 
+        # The multi-threaded accumulate paths group the updates by destination
+        # and must give bitwise the same result as the single-threaded ones.
+        @unittest.skipIf(torch.get_num_threads() < 2, "needs more than one intra-op thread")
+        def test_index_add_index_put_accumulate_threads(self):
+            num_threads = torch.get_num_threads()
+            for size, num_indices in (((1000,), 100000), ((1000, 8), 20000)):
+                dest = torch.randn(*size)
+                idx = torch.randint(0, size[0], (num_indices,))
+                src = torch.randn(num_indices, *size[1:])
+
+                results = []
+                for threads in (1, num_threads):
+                    torch.set_num_threads(threads)
+                    try:
+                        results.append((dest.index_add(0, idx, src),
+                                        dest.index_put((idx,), src, accumulate=True)))
+                    finally:
+                        torch.set_num_threads(num_threads)
+                for serial, parallel in zip(*results):
+                    self.assertEqual(serial, parallel, atol=0, rtol=0)
+
         def test_t(self):
             # Test 0D tensors
             x = torch.randn(())
@@ -3662,6 +3683,26 @@ class AbstractTestCases:
                                    "missing 1 required positional arguments",
                                    lambda: torch.tensor().new_zeros((5, 5), 0))
 
+        def test_parsing_cached_overloads(self):
+            # the parser remembers the overload that matched for the types of
+            # the arguments, arguments of the same types that match another
+            # overload must still be parsed right
+            x = torch.ones(2, 3, names=('N', 'C'))
+            for _ in range(3):
+                self.assertEqual(x.sum((1,)).rename(None), torch.full((2,), 3.))
+                self.assertEqual(x.sum(('N',)).rename(None), torch.full((3,), 2.))
+            y = torch.ones(2, 3)
+            for _ in range(3):
+                self.assertEqual(y.transpose(0, 1).shape, (3, 2))
+                self.assertEqual(y.transpose(torch.tensor(0), torch.tensor(1)).shape, (3, 2))
+                self.assertRaises(TypeError, lambda: y.transpose(torch.tensor(0.), torch.tensor(1)))
+            for _ in range(3):
+                self.assertEqual(y.view(-1).shape, (6,))
+                self.assertEqual(y.view(3, 2).shape, (3, 2))
+                self.assertEqual(y.view(size=(6,)).shape, (6,))
+                self.assertEqual(y.add(y, alpha=2), torch.full((2, 3), 3.))
+                self.assertEqual(y.add(1), torch.full((2, 3), 2.))
+
         def test_half_tensor(self):
             x = torch.randn(5, 5).float()
             y = torch.randn(5, 5).float()
@@ -11038,6 +11079,89 @@ class TestTorchDeviceType(TestCase):
                 res = stats.kstest(t.cpu().to(torch.double), 'norm', args=(mean, std))
                 self.assertTrue(res.statistic < 0.1)
 
+    # With the Philox CPU RNG, the samples only depend on the seed: not on the
+    # number of threads, nor on the strides of the output.
+    @onlyCPU
+    @dtypes(torch.half, torch.float, torch.double)
+    def test_philox_cpu_rng(self, device, dtype):
+        size = (300, 301)
+        p = torch.rand(size, dtype=torch.double, device=device)
+        samplers = [
+            lambda t: t.uniform_(-2, 3),
+            lambda t: t.normal_(1, 2),
+        ]
+        # bernoulli_ is not implemented for half on CPU
+        if dtype != torch.half:
+            samplers += [
+                lambda t: t.bernoulli_(0.3),
+                lambda t: t.bernoulli_(p),
+            ]
+        num_threads = torch.get_num_threads()
+        with torch.backends.cpu.flags(philox_rng=True):
+            for sample in samplers:
+                results = []
+                for threads in (1, max(num_threads, 4)):
+                    torch.set_num_threads(threads)
+                    try:
+                        torch.manual_seed(123)
+                        results.append(sample(torch.empty(size, dtype=dtype, device=device)))
+                        torch.manual_seed(123)
+                        results.append(sample(torch.empty(size[::-1], dtype=dtype, device=device).t()))
+                    finally:
+                        torch.set_num_threads(num_threads)
+                for result in results[1:]:
+                    self.assertEqual(results[0], result, atol=0, rtol=0)
+                # the generator moved on, so the next call draws new values
+                self.assertNotEqual(results[0], sample(torch.empty(size, dtype=dtype, device=device)))
+
+            t = torch.empty(size, dtype=dtype, device=device)
+            t.uniform_(-2, 3)
+            self.assertGreaterEqual(t.double().min(), -2)
+            self.assertLessEqual(t.double().max(), 3)
+            self.assertEqual(t.double().mean(), 0.5, atol=0.05, rtol=0)
+            t.normal_(1, 2)
+            self.assertEqual(t.double().mean(), 1, atol=0.05, rtol=0)
+            self.assertEqual(t.double().std(), 2, atol=0.05, rtol=0)
+            if dtype != torch.half:
+                self.assertEqual(t.bernoulli_(0.3).double().mean(), 0.3, atol=0.01, rtol=0)
+                self.assertEqual(t.bernoulli_(p).double().mean(), p.mean(), atol=0.01, rtol=0)
+
+    @onlyCPU
+    def test_bfloat16_kernels_accumulate_in_float(self, device):
+        # The bfloat16 CPU kernels compute in float and round once, so they
+        # should match the float kernels run on the same (bfloat16) values.
+        def check(fn, *shapes):
+            inputs = [torch.randn(shape, device=device).bfloat16().requires_grad_() for shape in shapes]
+            ref_inputs = [x.detach().float().requires_grad_() for x in inputs]
+            out = fn(*inputs)
+            ref = fn(*ref_inputs)
+            self.assertEqual(out.dtype, torch.bfloat16)
+            self.assertEqual(out.float(), ref, atol=1e-2, rtol=1e-2)
+            grad = torch.randn_like(ref)
+            out.backward(grad.bfloat16())
+            ref.backward(grad)
+            for x, ref_x in zip(inputs, ref_inputs):
+                self.assertEqual(x.grad.float(), ref_x.grad, atol=5e-2, rtol=2e-2)
+
+        for dim in (-1, 0):
+            check(lambda x: torch.softmax(x, dim), (64, 1000))
+            check(lambda x: torch.log_softmax(x, dim), (64, 1000))
+        check(lambda x, w, b: torch.nn.functional.layer_norm(x, (257,), w, b), (32, 257), (257,), (257,))
+        check(torch.nn.functional.gelu, (1000, 37))
+        check(torch.nn.functional.hardswish, (1000, 37))
+        check(lambda x: torch.nn.functional.leaky_relu(x, 0.1), (1000, 37))
+
+        # A bfloat16 accumulator stops growing at 256 when adding ones
+        x = torch.ones(10000, 3, device=device, dtype=torch.bfloat16)
+        self.assertEqual(x.sum().float(), torch.tensor(30000.), atol=0, rtol=1e-2)
+        self.assertEqual(x.sum(0).float(), torch.full((3,), 10000.), atol=0, rtol=1e-2)
+        self.assertEqual(x.t().sum(1).float(), torch.full((3,), 10000.), atol=0, rtol=1e-2)
+        self.assertEqual(x.mean().float(), torch.tensor(1.), atol=0, rtol=0)
+
+        x = torch.randn(100, 300, device=device).bfloat16()
+        self.assertEqual(x.max_values((0, 1)).float(), x.float().max())
+        self.assertEqual(x.min_values((0, 1)).float(), x.float().min())
+
     @skipIfNoSciPy
     @dtypes(*torch.testing.get_all_fp_dtypes())
     def test_lognormal_kstest(self, device, dtype):
@@ -11609,6 +11733,25 @@ class TestTorchDeviceType(TestCase):
         # Check that output maintained correct shape
         self.assertEqual(raw_tensor.shape, raw_tensor.grad.shape)
 
+    # Few slices with a long scanned dimension, which the CPU kernels scan in
+    # parallel blocks
+    def test_cum_ops_long_dim(self, device):
+        for shape, dim in (((200003,), 0), ((2, 100003), 1), ((100003, 2), 0)):
+            x = torch.randint(-5, 5, shape, device=device)
+            self.assertEqual(x.cumsum(dim), x.double().cumsum(dim).long(), atol=0, rtol=0)
+
+            x = torch.randn(shape, device=device)
+            self.assertEqual(x.cumsum(dim), x.double().cumsum(dim).float(), atol=1e-3, rtol=1e-5)
+            x = 1 + torch.randn(shape, device=device) * 1e-5
+            self.assertEqual(x.cumprod(dim), x.double().cumprod(dim).float(), atol=0, rtol=1e-4)
+            x = torch.randn(shape, device=device)
+            self.assertEqual(x.logcumsumexp(dim), x.double().logcumsumexp(dim).float(), atol=0, rtol=1e-4)
+            # -inf, e.g. log(0), at the start of the slice and of the blocks
+            x.narrow(dim, 0, 40000).fill_(-float('inf'))
+            x.narrow(dim, 65536, 100).fill_(-float('inf'))
+            expected = x.double().exp().cumsum(dim).log().float()
+            self.assertEqual(x.logcumsumexp(dim), expected, atol=0, rtol=1e-4)
+
     def test_cumprod(self, device):
         x = torch.rand(100, 100, device=device)
         res1 = torch.cumprod(x, 1)
@@ -11814,6 +11957,17 @@ class TestTorchDeviceType(TestCase):
         res1 = torch.zeros_like(expected)
         self.assertEqual(res1, expected)
 
+    @onlyCPU
+    def test_histc_large(self, device):
+        for dtype in (torch.float, torch.double):
+            tensor = torch.randn(1000003, dtype=dtype, device=device)
+            bins, min, max = 37, -2, 2.5
+            actual = torch.histc(tensor, bins=bins, min=min, max=max)
+            in_range = tensor[(tensor >= min) & (tensor <= max)]
+            bin_index = ((in_range - min) / (max - min) * bins).long().clamp(max=bins - 1)
+            expected = torch.bincount(bin_index.cpu(), minlength=bins).to(dtype=dtype, device=device)
+            self.assertEqual(actual, expected, atol=0, rtol=0)
+
     def test_histc(self, device):
         # negative nbins throws
         with self.assertRaisesRegex(RuntimeError, 'bins must be > 0'):
@@ -12914,6 +13068,17 @@ class TestTorchDeviceType(TestCase):
         nz = x.nonzero()
         self.assertFalse(nz.requires_grad)
 
+    # Large enough to be split across threads
+    @unittest.skipIf(not TEST_NUMPY, 'Numpy not found')
+    def test_nonzero_large(self, device):
+        for shape in ((1000003,), (37, 513, 61), (2, 1, 300000)):
+            for dtype in (torch.bool, torch.float, torch.long):
+                tensor = (torch.rand(shape, device=device) < 0.3).to(dtype)
+                expected = np.stack(tensor.cpu().numpy().nonzero(), axis=1)
+                self.assertEqual(tensor.nonzero().cpu().numpy(), expected)
+                self.assertEqual(tensor.transpose(0, -1).nonzero().cpu().numpy(),
+                                 np.stack(tensor.transpose(0, -1).cpu().numpy().nonzero(), axis=1))
+
     def _brute_pdist(self, inp, p=2):
         """Computes the same as torch.pdist using primitives"""
         n = inp.shape[-2]
@@ -16118,6 +16283,53 @@ scipy_lobpcg  | {:10.2e}  | {:10.2e}  | {:6} | N/A
         torch.dot(v1, v2, out=out)
         self.assertEqual(res1, out)
 
+    @onlyCPU
+    @unittest.skipIf(not TEST_NUMPY, "Numpy not found")
+    @dtypes(torch.float, torch.double, torch.int, torch.long)
+    def test_blas_layouts_and_sizes(self, device, dtype):
+        # Covers both the small-size loops and the BLAS calls behind addmm,
+        # with every operand row-major, column-major or strided.
+        def make(*shape):
+            return torch.randint(-4, 5, shape, device=device).to(dtype)
+
+        def layouts(t):
+            yield t
+            yield t.t().contiguous().t()
+            yield torch.repeat_interleave(t, 2, dim=1)[:, ::2]
+
+        def ref_addmm(M, m1, m2, beta, alpha):
+            prod = m1.numpy().astype(np.float64).dot(m2.numpy().astype(np.float64))
+            ref = alpha * prod if beta == 0 else beta * M.numpy().astype(np.float64) + alpha * prod
+            return torch.from_numpy(ref).to(dtype)
+
+        for n, k, m in [(3, 4, 5), (1, 7, 1), (5, 0, 4), (40, 50, 60)]:
+            for m1, m2, out in product(layouts(make(n, k)), layouts(make(k, m)), layouts(make(n, m))):
+                M = make(n, m)
+                self.assertEqual(torch.addmm(M, m1, m2, beta=2, alpha=3), ref_addmm(M, m1, m2, 2, 3))
+                torch.mm(m1, m2, out=out)
+                self.assertEqual(out, ref_addmm(M, m1, m2, 0, 1))
+
+        # beta=0 ignores self, even when it holds NaN
+        if dtype.is_floating_point:
+            M = torch.full((4, 6), float('nan'), dtype=dtype, device=device)
+            m1, m2 = make(4, 5), make(5, 6)
+            self.assertEqual(torch.addmm(M, m1, m2, beta=0), ref_addmm(M, m1, m2, 0, 1))
+
+        b1, b2, M = make(3, 4, 5), make(3, 5, 6), make(4, 6)
+        prod = sum(b1[i].numpy().astype(np.float64).dot(b2[i].numpy().astype(np.float64)) for i in range(3))
+        expected = torch.from_numpy(2 * M.numpy().astype(np.float64) + 3 * prod).to(dtype)
+        self.assertEqual(torch.addbmm(M, b1, b2, beta=2, alpha=3), expected)
+        self.assertEqual(torch.addbmm(M, b1[:0], b2[:0], beta=2), M * 2)
+
+        v1, v2, M = make(7), make(9), make(7, 9)
+        self.assertEqual(torch.addr(M, v1, v2, beta=2, alpha=3), ref_addmm(M, v1[:, None], v2[None, :], 2, 3))
+        v1, v2 = make(14)[::2], make(7)
+        self.assertEqual(torch.dot(v1, v2), torch.tensor(np.dot(v1.numpy(), v2.numpy()), dtype=dtype))
+
+        t = make(5, 7)
+        self.assertEqual(torch.trace(t), torch.tensor(t.long().diag().sum().item(), dtype=dtype))
+        self.assertEqual(torch.trace(t.t()), torch.trace(t))
+
     @onlyCPU
     @slowTest
     @dtypes(torch.float)
@@ -428,6 +428,53 @@ class TestBottleneck(TestCase):
         self._check_cuda(out)
 
 
+class TestExecutionDomain(TestCase):
+    # Domains can't be unregistered, so each test registers its own names in
+    # case the tests are repeated in the same process
+    _counter = 0
+
+    def _unique_name(self, name):
+        TestExecutionDomain._counter += 1
+        return '{}_{}'.format(name, TestExecutionDomain._counter)
+
+    def test_register(self):
+        from torch.utils.execution_domain import register_execution_domain
+        name = self._unique_name('register')
+        register_execution_domain(name, num_intraop_threads=2, num_interop_threads=1)
+        with self.assertRaisesRegex(RuntimeError, name):
+            register_execution_domain(name)
+        with self.assertRaisesRegex(RuntimeError, "priority"):
+            register_execution_domain(self._unique_name('priority'), priority='urgent')
+
+    def test_context_manager(self):
+        from torch.utils.execution_domain import (
+            register_execution_domain, execution_domain, current_execution_domain)
+        outer = self._unique_name('outer')
+        inner = self._unique_name('inner')
+        register_execution_domain(outer, num_intraop_threads=2)
+        register_execution_domain(inner, num_intraop_threads=1)
+
+        x = torch.randn(100, 100)
+        expected = x.mm(x)
+        self.assertIsNone(current_execution_domain())
+        with execution_domain(outer):
+            self.assertEqual(current_execution_domain(), outer)
+            with execution_domain(inner):
+                self.assertEqual(current_execution_domain(), inner)
+                self.assertEqual(x.mm(x), expected)
+                with execution_domain(None):
+                    self.assertIsNone(current_execution_domain())
+                self.assertEqual(current_execution_domain(), inner)
+            self.assertEqual(current_execution_domain(), outer)
+            self.assertEqual(x.mm(x), expected)
+        self.assertIsNone(current_execution_domain())
+
+        with self.assertRaisesRegex(RuntimeError, "No execution domain named"):
+            with execution_domain(self._unique_name('unregistered')):
+                pass
+        self.assertIsNone(current_execution_domain())
+
+
 from torch.utils.collect_env import get_pretty_env_info
 
 
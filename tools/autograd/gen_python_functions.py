@@ -800,7 +800,7 @@ def is_noarg_binding(overloads):
 # python binding for all overloads of a particular function/method
 PY_VARIABLE_METHOD_VARARGS = CodeTemplate(r"""\
 // ${name}
-static PyObject * ${pycname}(PyObject* self_, PyObject* args, PyObject* kwargs)
+static PyObject * ${pycname}(${pycparams})
 {
   ${method_header}
   static PythonArgParser parser({
@@ -808,7 +808,7 @@ static PyObject * ${pycname}(PyObject* self_, PyObject* args, PyObject* kwargs)
   }, /*traceable=*/${traceable});
 
   ParsedArgs<${max_args}> parsed_args;
-  auto _r = parser.parse(args, kwargs, parsed_args);
+  auto _r = parser.parse(${parse_args}, parsed_args);
   ${check_has_torch_function}
   switch (_r.idx) {
     ${dispatch}
@@ -821,7 +821,7 @@ static PyObject * ${pycname}(PyObject* self_, PyObject* args, PyObject* kwargs)
 # python binding for single-overload function/method
 PY_VARIABLE_METHOD_VARARGS_SINGLETON = CodeTemplate("""\
 // ${name}
-static PyObject * ${pycname}(PyObject* self_, PyObject* args, PyObject* kwargs)
+static PyObject * ${pycname}(${pycparams})
 {
   ${method_header}
   static PythonArgParser parser({
@@ -829,7 +829,7 @@ static PyObject * ${pycname}(PyObject* self_, PyObject* args, PyObject* kwargs)
   }, /*traceable=*/${traceable});
 
   ParsedArgs<${max_args}> parsed_args;
-  auto _r = parser.parse(args, kwargs, parsed_args);
+  auto _r = parser.parse(${parse_args}, parsed_args);
   ${check_has_torch_function}
   ${dispatch}
   ${method_footer}
@@ -849,6 +849,40 @@ static PyObject * ${pycname}(PyObject* self_, PyObject* args)
 
 """)
 
+# entry points of a method implemented by ${pycname}_impl,
+# see Note [Fastcall methods] in torch/csrc/utils/python_arg_parser.h
+PY_VARIABLE_METHOD_FASTCALL = CodeTemplate("""\
+static PyObject * ${pycname}(PyObject* self_, PyObject* args, PyObject* kwargs)
+{
+  PythonCallArgs call_args(args, kwargs);
+  return ${pycname}_impl(self_, call_args);
+}
+
+#ifdef TORCH_PYTHON_HAS_FASTCALL
+static PyObject * ${pycname}_fastcall(PyObject* self_, PyObject* const* args, Py_ssize_t nargs, PyObject* kwnames)
+{
+  PythonCallArgs call_args(args, nargs, kwnames);
+  return ${pycname}_impl(self_, call_args);
+}
+#endif
+
+""")
+
+# Tensor methods called often enough for the cost of building the args tuple
+# and kwargs dict of a call to matter, bound as fastcall functions on Python
+# versions that support it
+FASTCALL_METHOD_NAMES = {
+    'add', 'add_', 'sub', 'sub_', 'mul', 'mul_', 'div', 'div_',
+    'view', 'reshape', 'expand', 'permute', 'transpose',
+    'squeeze', 'unsqueeze', 'select', 'narrow', 'index_select',
+}
+
+
+def is_fastcall_method(name, declarations, is_python_method):
+    return (is_python_method and name in FASTCALL_METHOD_NAMES and
+            not is_noarg_binding(declarations))
+
+
 TORCH_FUNCTION_CHECK = CodeTemplate("""\
 if(_r.has_torch_function()) {
   return handle_torch_function(_r, args, kwargs, ${namespace}, ${modulename});
@@ -917,9 +951,27 @@ def method_impl(name, declarations, is_python_method, module):
     max_args = max([get_python_argc(decl) for decl in declarations])
     traceable = 'true' if all(should_trace(d) for d in declarations) else 'false'
 
+    if is_fastcall_method(name, declarations, is_python_method):
+        impl = template.substitute(
+            name=name,
+            pycname=pycname + '_impl',
+            pycparams='PyObject* self_, PythonCallArgs& call_args',
+            parse_args='call_args',
+            method_header=method_header,
+            max_args=max_args,
+            signatures=signatures,
+            traceable=traceable,
+            check_has_torch_function=check_has_torch_function,
+            dispatch=dispatch,
+            method_footer=method_footer,
+        )
+        return impl + PY_VARIABLE_METHOD_FASTCALL.substitute(pycname=pycname)
+
     return template.substitute(
         name=name,
         pycname=pycname,
+        pycparams='PyObject* self_, PyObject* args, PyObject* kwargs',
+        parse_args='args, kwargs',
         method_header=method_header,
         max_args=max_args,
         signatures=signatures,
@@ -990,6 +1042,14 @@ PY_VARIABLE_METHOD_BINOP_DEF = CodeTemplate("""\
 PY_VARIABLE_METHOD_DEF = CodeTemplate("""\
 {"${name}", (PyCFunction)${pycfunc_voidcast}${pycname}, ${flags}, NULL},""")
 
+# PyMethodDef entry of a fastcall method, see Note [Fastcall methods]
+PY_VARIABLE_METHOD_FASTCALL_DEF = CodeTemplate("""\
+#ifdef TORCH_PYTHON_HAS_FASTCALL
+{"${name}", (PyCFunction)(void(*)(void))${pycname}_fastcall, METH_FASTCALL | METH_KEYWORDS, NULL},
+#else
+{"${name}", (PyCFunction)(void(*)(void))${pycname}, METH_VARARGS | METH_KEYWORDS, NULL},
+#endif""")
+
 
 def method_def(name, declarations, is_python_method, module):
     """
@@ -997,6 +1057,9 @@ def method_def(name, declarations, is_python_method, module):
     """
     pycname = get_pycname(name)
 
+    if is_fastcall_method(name, declarations, is_python_method):
+        return PY_VARIABLE_METHOD_FASTCALL_DEF.substitute(name=name, pycname=pycname)
+
     if is_noarg_binding(declarations):
         pycfunc_voidcast = ''
         flags = 'METH_NOARGS' if is_python_method else 'METH_VARARGS | METH_KEYWORDS'
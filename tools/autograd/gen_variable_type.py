@@ -114,6 +114,17 @@ DONT_REQUIRE_DERIVATIVE = {
     'argmax', 'argmin', 'argsort',
 }
 
+# Cheap ops whose first output can be recomputed from their inputs instead of
+# being saved for backward, see Note [Rematerialization]. They must be
+# deterministic and their arguments other than tensors must be copyable.
+# batch_norm is not listed, as recomputing it would update the running stats
+# again.
+REMATERIALIZABLE = {
+    'sigmoid', 'tanh', 'exp', 'relu', 'gelu', 'elu', 'hardtanh', 'leaky_relu',
+    'softplus', 'hardsigmoid', 'hardswish', '_softmax', '_log_softmax',
+    'native_layer_norm',
+}
+
 # Some operators invalidate the grad_accumulator. Let's reset it.
 RESET_GRAD_ACCUMULATOR = {
     'set', 'resize'
@@ -281,6 +292,14 @@ if (${cond}) {
 }
 """)
 
+SET_REMATERIALIZER = CodeTemplate("""\
+if (grad_fn && RematerializationMode::is_enabled()) {
+  impl::set_rematerializer(${output}, std::make_shared<Rematerializer>(
+      "${name}", variable_list{ ${tensor_args} },
+      [${captures}](const variable_list& inputs) { return ${recompute}; }, ${output}));
+}
+""")
+
 RECORD_FUNCTION = CodeTemplate("""\
 RECORD_FUNCTION("${name}", std::vector<c10::IValue>({${input_names}}), Node::peek_at_next_sequence_nr());
 """)
@@ -1122,6 +1141,23 @@ def emit_body(declaration):
             return CONDITIONAL.substitute(cond='grad_fn', statements=stmts)
         return ''
 
+    def emit_set_rematerializer():
+        if name not in REMATERIALIZABLE:
+            return ''
+        tensor_args = [arg['name'] for arg in inputs if arg['type'] == 'const Tensor &']
+        other_args = [arg['name'] for arg in inputs if arg['type'] != 'const Tensor &']
+        for arg in inputs:
+            assert arg['type'] in ('const Tensor &', 'Scalar', 'int64_t', 'double', 'bool'), \
+                'Unsupported argument type {} for rematerializing {}'.format(arg['type'], name)
+        call_args = ['inputs[{}]'.format(tensor_args.index(arg['name']))
+                     if arg['type'] == 'const Tensor &' else arg['name'] for arg in inputs]
+        recompute = 'at::{}({})'.format(name, ', '.join(call_args))
+        if len(returns) > 1:
+            recompute = 'std::get<0>({})'.format(recompute)
+        return SET_REMATERIALIZER.substitute(
+            output=returns[0]['name'], name=name, tensor_args=tensor_args,
+            captures=', '.join(other_args), recompute=recompute)
+
     def emit_check_inplace():
         if not inplace:
             return []
@@ -1153,6 +1189,8 @@ def emit_body(declaration):
         body.extend(emit_increment_version())
         body.append(emit_history())
     if requires_derivative:
+        # The recipe has to be set before the outputs are saved
+        body.append(emit_set_rematerializer())
         body.append(emit_save_outputs())
     if base_name in RESET_GRAD_ACCUMULATOR:
         # `inplace` implies that there is exactly one output named `self`,
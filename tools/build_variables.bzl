@@ -91,8 +91,11 @@ libtorch_core_sources = [
     "torch/csrc/autograd/functions/tensor.cpp",
     "torch/csrc/autograd/functions/utils.cpp",
     "torch/csrc/autograd/input_buffer.cpp",
+    "torch/csrc/autograd/latency_observer.cpp",
     "torch/csrc/autograd/profiler.cpp",
+    "torch/csrc/autograd/profiler_flops.cpp",
     "torch/csrc/autograd/record_function_ops.cpp",
+    "torch/csrc/autograd/rematerialization.cpp",
     "torch/csrc/autograd/saved_variable.cpp",
     "torch/csrc/autograd/variable.cpp",
     "torch/csrc/jit/api/function_impl.cpp",
@@ -290,6 +293,7 @@ libtorch_extra_sources = libtorch_core_jit_sources + [
     "torch/csrc/jit/mobile/function.cpp",
     "torch/csrc/jit/mobile/import.cpp",
     "torch/csrc/jit/mobile/interpreter.cpp",
+    "torch/csrc/jit/mobile/memory_arena.cpp",
     "torch/csrc/jit/mobile/module.cpp",
     "torch/csrc/jit/mobile/observer.cpp",
     "torch/csrc/jit/mobile/register_mobile_autograd.cpp",
@@ -466,6 +470,7 @@ libtorch_python_core_sources = [
     "torch/csrc/jit/python/python_sugared_value.cpp",
     "torch/csrc/jit/python/python_tree_views.cpp",
     "torch/csrc/multiprocessing/init.cpp",
+    "torch/csrc/multiprocessing/shared_memory_pool.cpp",
     "torch/csrc/onnx/init.cpp",
     "torch/csrc/serialization.cpp",
     "torch/csrc/tensor/python_tensor.cpp",
@@ -466,6 +466,7 @@ import torch.hub
 import torch.random
 import torch.distributions
 import torch.testing
+import torch.backends.cpu
 import torch.backends.cuda
 import torch.backends.mkl
 import torch.backends.mkldnn
@@ -16,6 +16,7 @@ from .function import Function, NestedIOFunction
 from .gradcheck import gradcheck, gradgradcheck
 from .grad_mode import no_grad, enable_grad, set_grad_enabled
 from .anomaly_mode import detect_anomaly, set_detect_anomaly
+from .rematerialization import rematerialize, rematerialization_stats, reset_rematerialization_stats
 from . import profiler
 from . import functional
 
@@ -1,4 +1,5 @@
 import itertools
+import json
 import torch
 
 from collections import defaultdict, namedtuple
@@ -25,10 +26,14 @@ class EventList(list):
     def __init__(self, *args, **kwargs):
         use_cuda = kwargs.pop('use_cuda', True)
         profile_memory = kwargs.pop('profile_memory', False)
+        memory_timeline = kwargs.pop('memory_timeline', None)
+        with_flops = kwargs.pop('with_flops', False)
         super(EventList, self).__init__(*args, **kwargs)
         self._cpu_children_populated = False
         self._use_cuda = use_cuda
         self._profile_memory = profile_memory
+        self.memory_timeline = memory_timeline
+        self._with_flops = with_flops
 
     def __str__(self):
         return self.table()
@@ -113,7 +118,9 @@ class EventList(list):
                 they are printed in the same order as they were registered.
                 Valid keys include: ``cpu_time``, ``cuda_time``, ``cpu_time_total``,
                 ``cuda_time_total``, ``cpu_memory_usage``, ``cuda_memory_usage``,
-                ``self_cpu_memory_usage``, ``self_cuda_memory_usage``, ``count``.
+                ``self_cpu_memory_usage``, ``self_cuda_memory_usage``,
+                ``cpu_memory_peak``, ``cuda_memory_peak``, ``flops``,
+                ``gflops_per_s``, ``gbytes_per_s``, ``count``.
 
         Returns:
             A string containing the table.
@@ -124,12 +131,15 @@ class EventList(list):
             row_limit=row_limit,
             header=header,
             use_cuda=self._use_cuda,
-            profile_memory=self._profile_memory)
+            profile_memory=self._profile_memory,
+            with_flops=self._with_flops)
 
     def export_chrome_trace(self, path):
         """Exports an EventList as a Chrome tracing tools file.
 
         The checkpoint can be later loaded and inspected under ``chrome://tracing`` URL.
+        With memory profiling, the trace also has a counter of the memory allocated
+        since the start of profiling.
 
         Arguments:
             path (str): Path where the trace will be written.
@@ -149,7 +159,7 @@ class EventList(list):
                     '"dur": %s, '
                     '"tid": %s, '
                     '"pid": "CPU functions", '
-                    '"args": {}}, '
+                    '"args": {%s}}, '
                     % (
                         evt.name,
                         evt.cpu_interval.start,
@@ -157,6 +167,8 @@ class EventList(list):
                         evt.thread
                         if not evt.is_remote
                         else f'" node_id:{evt.node_id}, thread_id:{evt.thread} "',
+                        '"flops": %s, "bytes_accessed": %s' % (evt.flops, evt.bytes_accessed)
+                        if evt.flops or evt.bytes_accessed else '',
                     )
                 )
                 for k in evt.kernels:
@@ -189,6 +201,18 @@ class EventList(list):
                                                k.interval.elapsed_us(), k.device))
                     next_id += 1
 
+            for record in self.memory_timeline or []:
+                f.write('{"name": "Memory", '
+                        '"ph": "C", '
+                        '"ts": %s, '
+                        '"pid": "CPU functions", '
+                        '"args": {"CPU": %s%s}}, '
+                        % (
+                            record.time,
+                            record.cpu_memory_usage,
+                            ', "CUDA": %s' % record.cuda_memory_usage if self._use_cuda else '',
+                        ))
+
             # remove trailing whitespace and comma
             f.seek(f.tell() - 2, os.SEEK_SET)
             f.truncate()
@@ -216,7 +240,9 @@ class EventList(list):
         for evt in self:
             stats[get_key(evt, group_by_input_shapes)].add(
                 evt, group_by_input_shapes)
-        return EventList(stats.values(), use_cuda=self._use_cuda, profile_memory=self._profile_memory)
+        return EventList(
+            stats.values(), use_cuda=self._use_cuda, profile_memory=self._profile_memory,
+            with_flops=self._with_flops)
 
     def total_average(self):
         """Averages all events.
@@ -258,7 +284,18 @@ class profile(object):
             self cpu time might be artificially increased because of the shape
             collection.
 
-        profile_memory (bool, optional): Whether to report memory usage, default: ``False``
+        profile_memory (bool, optional): Whether to report memory usage, default: ``False``.
+            Each function reports the memory it allocated minus the memory it freed,
+            with and without its children, and the peak of that value while it ran.
+            The memory allocated since the start of profiling is available as
+            ``memory_timeline`` and in the exported Chrome trace.
+
+        with_flops (bool, optional): Whether to estimate the flops and the bytes
+            accessed by matrix multiplications, convolutions, embedding_bag,
+            pointwise ops and reductions, from their inputs. Events report them
+            as ``flops`` and ``bytes_accessed``, with the achieved ``gflops_per_s``
+            and ``gbytes_per_s``, which tell compute bound ops from memory bound
+            ones. Default: ``False``
 
     .. warning:
         Enabling memory profiling incurs additional profiler overhead
@@ -297,7 +334,8 @@ class profile(object):
             enabled=True,
             use_cuda=False,
             record_shapes=False,
-            profile_memory=False):
+            profile_memory=False,
+            with_flops=False):
         self.enabled = enabled
         self.use_cuda = use_cuda
         self.function_events = None
@@ -306,6 +344,7 @@ class profile(object):
         self.entered = False
         self.record_shapes = record_shapes
         self.profile_memory = profile_memory
+        self.with_flops = with_flops
 
     def __enter__(self):
         if not self.enabled:
@@ -316,7 +355,8 @@ class profile(object):
         profiler_kind = torch.autograd.ProfilerState.CUDA if self.use_cuda \
             else torch.autograd.ProfilerState.CPU
 
-        config = torch.autograd.ProfilerConfig(profiler_kind, self.record_shapes, self.profile_memory)
+        config = torch.autograd.ProfilerConfig(
+            profiler_kind, self.record_shapes, self.profile_memory, self.with_flops)
         torch.autograd._enable_profiler(config)
         return self
 
@@ -327,7 +367,9 @@ class profile(object):
         self.function_events = EventList(
             parse_cpu_trace(records),
             use_cuda=self.use_cuda,
-            profile_memory=self.profile_memory)
+            profile_memory=self.profile_memory,
+            memory_timeline=parse_memory_timeline(records) if self.profile_memory else None,
+            with_flops=self.with_flops)
         return False
 
     def __repr__(self):
@@ -375,6 +417,15 @@ class profile(object):
         self._check_finish()
         return self.function_events.self_cpu_time_total
 
+    @property
+    def memory_timeline(self):
+        """ Returns the memory allocated since the start of profiling after
+        each allocation and free, as a list of MemoryRecords sorted by time,
+        or None without memory profiling.
+        """
+        self._check_finish()
+        return self.function_events.memory_timeline
+
 
 class record_function(ContextDecorator):
     """Context manager/function decorator that adds a label to a block of
@@ -563,6 +614,61 @@ class emit_nvtx(object):
         return False
 
 
+def enable_latency_observer(sampling_prob=0.01, record_shapes=False):
+    """Starts aggregating the latency of a sample of the operator calls.
+
+    Unlike :class:`profile`, the latency observer does not keep the events:
+    it aggregates the latency of each operator into a histogram, on all the
+    threads, which makes it cheap enough to stay enabled in production jobs.
+    The latency of an operator includes the latency of the operators it calls.
+
+    .. warning::
+        Enabling and disabling the observer is not thread safe, it is supposed
+        to be done while no operators are running, e.g. at the start of the
+        program.
+
+    Arguments:
+        sampling_prob (float, optional): probability to observe each operator
+            call. Default: ``0.01``
+        record_shapes (bool, optional): aggregate the calls of each operator
+            per input sizes. Default: ``False``
+
+    Example:
+        >>> torch.autograd.profiler.enable_latency_observer(sampling_prob=0.01)
+        >>> for _ in range(1000):
+        >>>     model(x)
+        >>> print(torch.autograd.profiler.latency_stats_prometheus())
+    """
+    torch.autograd._enable_latency_observer(sampling_prob, record_shapes)
+
+
+def disable_latency_observer():
+    """Stops the latency observer, the statistics are kept."""
+    torch.autograd._disable_latency_observer()
+
+
+def reset_latency_stats():
+    """Clears the statistics of the latency observer."""
+    torch.autograd._reset_latency_stats()
+
+
+def latency_stats():
+    """Returns the statistics of the latency observer as a dict.
+
+    ``ops`` holds a dict per operator (and input sizes, if recorded) with the
+    number of sampled calls, the total, min, max and approximate percentile
+    latencies in nanoseconds, and the non-empty histogram buckets as
+    ``[lower bound, upper bound, count]`` lists.
+    """
+    return json.loads(torch.autograd._latency_stats_json())
+
+
+def latency_stats_prometheus():
+    """Returns the statistics of the latency observer in the Prometheus text
+    exposition format."""
+    return torch.autograd._latency_stats_prometheus()
+
+
 def load_nvprof(path):
     """Opens an nvprof trace file and parses autograd annotations.
 
@@ -614,7 +720,8 @@ def attr_formatter(name):
 class FormattedTimesMixin(object):
     """Helpers for FunctionEvent and FunctionEventAvg.
 
-    The subclass should define `*_time_total` and `count` attributes.
+    The subclass should define `*_time_total`, `count`, `flops` and
+    `bytes_accessed` attributes.
     """
     cpu_time_str = attr_formatter('cpu_time')
     cuda_time_str = attr_formatter('cuda_time')
@@ -630,6 +737,20 @@ class FormattedTimesMixin(object):
     def cuda_time(self):
         return 0.0 if self.count == 0 else 1.0 * self.cuda_time_total / self.count
 
+    def _compute_time_us(self):
+        # time of the kernels if they were recorded, CPU time otherwise
+        return self.cuda_time_total if self.cuda_time_total > 0 else self.cpu_time_total
+
+    @property
+    def gflops_per_s(self):
+        time_us = self._compute_time_us()
+        return 0.0 if time_us <= 0 else self.flops / time_us / 1e3
+
+    @property
+    def gbytes_per_s(self):
+        time_us = self._compute_time_us()
+        return 0.0 if time_us <= 0 else self.bytes_accessed / time_us / 1e3
+
 
 class Interval(object):
     def __init__(self, start, end):
@@ -647,7 +768,9 @@ class FunctionEvent(FormattedTimesMixin):
     """Profiling information about a single function."""
     def __init__(
             self, id, node_id, name, thread, cpu_start, cpu_end, input_shapes=None,
-            cpu_memory_usage=0, cuda_memory_usage=0, is_async=False, is_remote=True):
+            cpu_memory_usage=0, cuda_memory_usage=0, cpu_memory_peak=0,
+            cuda_memory_peak=0, flops=0, bytes_accessed=0, is_async=False,
+            is_remote=True):
         self.id = id
         self.node_id = node_id
         self.name = name
@@ -659,6 +782,11 @@ class FunctionEvent(FormattedTimesMixin):
         self.input_shapes = input_shapes
         self.cpu_memory_usage = cpu_memory_usage
         self.cuda_memory_usage = cuda_memory_usage
+        # highest value of the memory usage while the function was running
+        self.cpu_memory_peak = cpu_memory_peak
+        self.cuda_memory_peak = cuda_memory_peak
+        self.flops = flops
+        self.bytes_accessed = bytes_accessed
         self.is_async = is_async
         self.is_remote = is_remote
 
@@ -751,6 +879,10 @@ class FunctionEventAvg(FormattedTimesMixin):
         self.cuda_memory_usage = 0
         self.self_cpu_memory_usage = 0
         self.self_cuda_memory_usage = 0
+        self.cpu_memory_peak = 0
+        self.cuda_memory_peak = 0
+        self.flops = 0
+        self.bytes_accessed = 0
 
     def add(self, other, group_by_input_shapes=False):
         if self.key is None:
@@ -776,6 +908,10 @@ class FunctionEventAvg(FormattedTimesMixin):
         self.cuda_memory_usage += other.cuda_memory_usage
         self.self_cpu_memory_usage += other.self_cpu_memory_usage
         self.self_cuda_memory_usage += other.self_cuda_memory_usage
+        self.cpu_memory_peak = max(self.cpu_memory_peak, other.cpu_memory_peak)
+        self.cuda_memory_peak = max(self.cuda_memory_peak, other.cuda_memory_peak)
+        self.flops += other.flops
+        self.bytes_accessed += other.bytes_accessed
         self.count += other.count
         return self
 
@@ -862,6 +998,9 @@ def parse_cpu_trace(thread_records):
         # accumulated memory allocations per handle
         cpu_memory_allocs = {}
         cuda_memory_allocs = {}
+        # highest accumulated memory allocations per handle
+        cpu_memory_peaks = {}
+        cuda_memory_peaks = {}
         # ranges per handle
         range_starts = {}
 
@@ -890,6 +1029,8 @@ def parse_cpu_trace(thread_records):
                 range_starts[record_key] = record
                 cpu_memory_allocs[record_key] = 0
                 cuda_memory_allocs[record_key] = 0
+                cpu_memory_peaks[record_key] = 0
+                cuda_memory_peaks[record_key] = 0
             elif record.kind() == 'pop':
                 assert (
                     record_key in range_starts
@@ -915,6 +1056,10 @@ def parse_cpu_trace(thread_records):
                     input_shapes=start.shapes(),
                     cpu_memory_usage=cpu_memory_usage,
                     cuda_memory_usage=cuda_memory_usage,
+                    cpu_memory_peak=cpu_memory_peaks[record_key],
+                    cuda_memory_peak=cuda_memory_peaks[record_key],
+                    flops=start.flops(),
+                    bytes_accessed=start.bytes_accessed(),
                     is_async=is_async,
                     is_remote=is_remote_event,
                 )
@@ -931,11 +1076,17 @@ def parse_cpu_trace(thread_records):
                 del range_starts[record_key]
                 del cpu_memory_allocs[record_key]
                 del cuda_memory_allocs[record_key]
+                del cpu_memory_peaks[record_key]
+                del cuda_memory_peaks[record_key]
             elif record.kind() == 'memory_alloc':
                 for handle in cpu_memory_allocs.keys():
                     cpu_memory_allocs[handle] += record.cpu_memory_usage()
+                    cpu_memory_peaks[handle] = max(
+                        cpu_memory_peaks[handle], cpu_memory_allocs[handle])
                 for handle in cuda_memory_allocs.keys():
                     cuda_memory_allocs[handle] += record.cuda_memory_usage()
+                    cuda_memory_peaks[handle] = max(
+                        cuda_memory_peaks[handle], cuda_memory_allocs[handle])
             prev_record = record
 
     # Sort functions by start time then by end time ascending.
@@ -948,6 +1099,35 @@ def parse_cpu_trace(thread_records):
     return functions
 
 
+MemoryRecord = namedtuple('MemoryRecord', ['time', 'cpu_memory_usage', 'cuda_memory_usage'])
+
+
+def parse_memory_timeline(thread_records):
+    """Returns the memory allocated since the start of profiling, on all the
+    threads, after each allocation and free as a list of MemoryRecords sorted
+    by time (in us since the start of profiling).
+    """
+    start_record = None
+    memory_records = []
+    for record in itertools.chain(*thread_records):
+        if start_record is None and record.name() == '__start_profile':
+            start_record = record
+        # remote events are timed by another clock
+        elif record.kind() == 'memory_alloc' and not record.is_remote():
+            memory_records.append(record)
+    assert start_record is not None
+
+    timeline = []
+    cpu_memory_usage = 0
+    cuda_memory_usage = 0
+    for record in sorted(memory_records, key=start_record.cpu_elapsed_us):
+        cpu_memory_usage += record.cpu_memory_usage()
+        cuda_memory_usage += record.cuda_memory_usage()
+        timeline.append(MemoryRecord(
+            start_record.cpu_elapsed_us(record), cpu_memory_usage, cuda_memory_usage))
+    return timeline
+
+
 ################################################################################
 # CUDA checkpoints
 
@@ -1035,7 +1215,8 @@ def build_table(
         header=None,
         row_limit=100,
         use_cuda=True,
-        profile_memory=False):
+        profile_memory=False,
+        with_flops=False):
     """Prints a summary of events (which can be a list of FunctionEvent or FunctionEventAvg)."""
     if len(events) == 0:
         return ""
@@ -1043,7 +1224,7 @@ def build_table(
     if sort_by is not None:
         events = EventList(sorted(
             events, key=lambda evt: getattr(evt, sort_by), reverse=True
-        ), use_cuda=use_cuda, profile_memory=profile_memory)
+        ), use_cuda=use_cuda, profile_memory=profile_memory, with_flops=with_flops)
 
     has_input_shapes = any(
         [event.input_shapes is not None for event in events])
@@ -1069,12 +1250,19 @@ def build_table(
         headers.extend([
             'CPU Mem',
             'Self CPU Mem',
+            'CPU Mem Peak',
         ])
         if torch.cuda.is_available():
             headers.extend([
                 'CUDA Mem',
                 'Self CUDA Mem',
+                'CUDA Mem Peak',
             ])
+    if with_flops:
+        headers.extend([
+            'GFLOP/s',
+            'GB/s',
+        ])
     headers.append(
         'Number of Calls'
     )
@@ -1151,6 +1339,8 @@ def build_table(
                 format_memory(evt.cpu_memory_usage),
                 # Self CPU Mem Total
                 format_memory(evt.self_cpu_memory_usage),
+                # CPU Mem Peak
+                format_memory(evt.cpu_memory_peak),
             ])
             if torch.cuda.is_available():
                 row_values.extend([
@@ -1158,7 +1348,14 @@ def build_table(
                     format_memory(evt.cuda_memory_usage),
                     # Self CUDA Mem Total
                     format_memory(evt.self_cuda_memory_usage),
+                    # CUDA Mem Peak
+                    format_memory(evt.cuda_memory_peak),
                 ])
+        if with_flops:
+            row_values.extend([
+                '{:.3f}'.format(evt.gflops_per_s),
+                '{:.3f}'.format(evt.gbytes_per_s),
+            ])
         row_values.append(
             evt.count,  # Number of calls
         )
@@ -0,0 +1,76 @@
+import torch
+
+from typing import Any, Dict
+
+
+class rematerialize(object):
+    r"""Context-manager that recomputes the outputs of cheap operations during
+    the backward pass instead of saving them for it.
+
+    The outputs of the activations (e.g. ``relu``, ``sigmoid``, ``gelu``),
+    ``softmax``, ``log_softmax`` and ``layer_norm`` computed in the context are
+    not kept by the autograd graph once the outputs kept so far exceed
+    :attr:`memory_budget`. When the backward pass needs one of them, it is
+    computed again from the inputs of the operation, which are kept instead.
+    As the inputs of a chain of such operations are the outputs of the
+    previous ones, only the input of the chain is kept. Nothing is recomputed
+    for an output that is still alive.
+
+    Unlike :func:`torch.utils.checkpoint.checkpoint`, the model doesn't have to
+    be split into segments.
+
+    A recomputed output is freed once all the backward functions that need it
+    are done. With ``retain_graph=True``, the inputs of the recomputed
+    operations stay saved and each backward pass recomputes the outputs again;
+    an output needed by a backward function that the pass doesn't run stays
+    alive until the graph is freed.
+
+    .. warning::
+        The inputs of the recomputed operations must not be modified in-place
+        before the backward pass: the backward pass then fails as it would for
+        a saved tensor modified in-place.
+
+    Arguments:
+        memory_budget (int): number of bytes of outputs that are kept rather
+            than recomputed. The default, 0, recomputes all of them.
+
+    Example::
+
+        >>> with torch.autograd.rematerialize():
+        ...     loss = model(input).sum()
+        >>> loss.backward()
+        >>> torch.autograd.rematerialization_stats()
+    """
+
+    def __init__(self, memory_budget: int = 0) -> None:
+        self.memory_budget = memory_budget
+
+    def __enter__(self) -> None:
+        self.prev = torch.autograd._rematerialization_enabled()
+        self.prev_memory_budget = torch.autograd._rematerialization_memory_budget()
+        torch.autograd._set_rematerialization_memory_budget(self.memory_budget)
+        torch.autograd._set_rematerialization_enabled(True)
+
+    def __exit__(self, *args: Any) -> None:
+        torch.autograd._set_rematerialization_enabled(self.prev)
+        torch.autograd._set_rematerialization_memory_budget(self.prev_memory_budget)
+
+
+def rematerialization_stats() -> Dict[str, int]:
+    r"""Returns the cost of the recomputations against the memory they saved,
+    since the start of the program or the last call to
+    :func:`reset_rematerialization_stats`, as a dict with the keys:
+
+    - ``rematerialized_tensors``, ``rematerialized_bytes``: number and size of
+      the outputs that are recomputed rather than kept for the backward pass
+    - ``kept_bytes``: size of the outputs currently kept in the memory budget
+    - ``recomputations``, ``recompute_time_ns``: number and total duration of
+      the recomputations
+    """
+    return torch.autograd._rematerialization_stats()
+
+
+def reset_rematerialization_stats() -> None:
+    r"""Resets the counters of :func:`rematerialization_stats`, except
+    ``kept_bytes``."""
+    torch.autograd._reset_rematerialization_stats()
@@ -0,0 +1,32 @@
+import sys
+import torch
+from contextlib import contextmanager
+from torch.backends import ContextProp, PropModule, __allow_nonbracketed_mutation
+
+def set_flags(_philox_rng):
+    orig_flags = (torch._C._get_philox_cpu_rng(),)
+    torch._C._set_philox_cpu_rng(_philox_rng)
+    return orig_flags
+
+@contextmanager
+def flags(philox_rng=False):
+    with __allow_nonbracketed_mutation():
+        orig_flags = set_flags(philox_rng)
+    try:
+        yield
+    finally:
+        with __allow_nonbracketed_mutation():
+            set_flags(orig_flags[0])
+
+class CpuModule(PropModule):
+    def __init__(self, m, name):
+        super(CpuModule, self).__init__(m, name)
+
+    # When set, uniform_, normal_ and bernoulli_ on CPU tensors draw from a
+    # Philox stream keyed by a single draw from the generator, and fill the
+    # tensor on several threads. The values depend only on the generator
+    # state, not on the number of threads, but differ from the default
+    # (mt19937) stream.
+    philox_rng = ContextProp(torch._C._get_philox_cpu_rng, torch._C._set_philox_cpu_rng)
+
+sys.modules[__name__] = CpuModule(sys.modules[__name__], __name__)
@@ -14,6 +14,7 @@
 #include <ATen/ExpandUtils.h>
 #include <ATen/dlpack.h>
 #include <ATen/DLConvertor.h>
+#include <ATen/ExecutionDomain.h>
 #include <ATen/Parallel.h>
 #include <ATen/Utils.h>
 #include <pybind11/pybind11.h>
@@ -412,6 +413,20 @@ PyObject *THPModule_userEnabledMkldnn(PyObject *_unused, PyObject *noargs)
   else Py_RETURN_FALSE;
 }
 
+PyObject *THPModule_setPhiloxCPURNG(PyObject *_unused, PyObject *arg)
+{
+  THPUtils_assert(PyBool_Check(arg), "set_philox_cpu_rng expects a bool, "
+          "but got %s", THPUtils_typename(arg));
+  at::globalContext().setPhiloxCPURNG(arg == Py_True);
+  Py_RETURN_NONE;
+}
+
+PyObject *THPModule_philoxCPURNG(PyObject *_unused, PyObject *noargs)
+{
+  if (at::globalContext().philoxCPURNG()) Py_RETURN_TRUE;
+  else Py_RETURN_FALSE;
+}
+
 PyObject *THPModule_setDeterministicCuDNN(PyObject *_unused, PyObject *arg)
 {
   THPUtils_assert(PyBool_Check(arg), "set_deterministic_cudnn expects a bool, "
@@ -547,6 +562,8 @@ static PyMethodDef TorchMethods[] = {
   {"_set_cudnn_enabled", (PyCFunction)THPModule_setUserEnabledCuDNN, METH_O,  nullptr},
   {"_get_mkldnn_enabled", (PyCFunction)THPModule_userEnabledMkldnn, METH_NOARGS,     nullptr},
   {"_set_mkldnn_enabled", (PyCFunction)THPModule_setUserEnabledMkldnn, METH_O,  nullptr},
+  {"_get_philox_cpu_rng", (PyCFunction)THPModule_philoxCPURNG, METH_NOARGS,     nullptr},
+  {"_set_philox_cpu_rng", (PyCFunction)THPModule_setPhiloxCPURNG, METH_O,  nullptr},
   {"_get_cudnn_benchmark", (PyCFunction)THPModule_benchmarkCuDNN, METH_NOARGS,     nullptr},
   {"_set_cudnn_benchmark", (PyCFunction)THPModule_setBenchmarkCuDNN, METH_O,  nullptr},
   {"_get_cudnn_deterministic", (PyCFunction)THPModule_deterministicCuDNN, METH_NOARGS,     nullptr},
@@ -763,6 +780,45 @@ Call this whenever a new thread is created in order to propagate values from
 :func:`torch.set_num_threads` onto the new thread.
 )");
 
+  // See Note [Execution domains]; torch/utils/execution_domain.py wraps these
+  py_module.def(
+    "_register_execution_domain",
+    [](const std::string& name,
+       int num_intraop_threads,
+       int num_interop_threads,
+       std::vector<int> cpus,
+       const std::string& priority) {
+      at::ExecutionDomainOptions options;
+      options.num_intraop_threads = num_intraop_threads;
+      options.num_interop_threads = num_interop_threads;
+      options.cpus = std::move(cpus);
+      if (priority == "low") {
+        options.priority = at::ExecutionPriority::Low;
+      } else if (priority == "high") {
+        options.priority = at::ExecutionPriority::High;
+      } else {
+        TORCH_CHECK(priority == "normal",
+            "Expected the priority of an execution domain to be 'low', "
+            "'normal' or 'high', but got '", priority, "'");
+      }
+      at::register_execution_domain(name, std::move(options));
+    });
+  py_module.def("_get_execution_domain", []() -> c10::optional<std::string> {
+    const auto& domain = at::current_execution_domain();
+    if (!domain) {
+      return c10::nullopt;
+    }
+    return domain->name();
+  });
+  py_module.def("_set_execution_domain", [](c10::optional<std::string> name) {
+    std::shared_ptr<at::ExecutionDomain> domain;
+    if (name) {
+      domain = at::get_execution_domain(*name);
+      TORCH_CHECK(domain, "No execution domain named ", *name, " is registered");
+    }
+    at::internal::set_current_execution_domain(std::move(domain));
+  });
+
   ASSERT_TRUE(set_module_attr("has_openmp", at::hasOpenMP() ? Py_True : Py_False));
   ASSERT_TRUE(set_module_attr("has_mkl", at::hasMKL() ? Py_True : Py_False));
   ASSERT_TRUE(set_module_attr("has_lapack", at::hasLAPACK() ? Py_True : Py_False));
@@ -18,6 +18,7 @@
 #include <torch/csrc/DynamicTypes.h>
 #include <torch/csrc/CudaIPCTypes.h>
 #include <torch/csrc/Device.h>
+#include <torch/csrc/multiprocessing/shared_memory_pool.h>
 #include <torch/csrc/autograd/utils/wrap_outputs.h>
 
 #include <torch/csrc/generic/Storage.cpp>
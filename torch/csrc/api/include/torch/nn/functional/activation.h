@@ -795,6 +795,30 @@ inline std::tuple<Tensor, Tensor> multi_head_attention_forward(
         }, /*dim=*/1);
     }
   }
+  if (!need_weights && (dropout_p == 0 || !training) && q.device().is_cpu() &&
+      (q.scalar_type() == torch::kFloat || q.scalar_type() == torch::kDouble) &&
+      (!attn_mask_.defined() ||
+       (attn_mask_.is_floating_point() && !attn_mask_.requires_grad()))) {
+    // The attention weights are not returned and there is no dropout to apply
+    // to them, so the fused kernel can compute the output without
+    // materializing them. q is already scaled. The derivative of the fused
+    // kernel doesn't cover the mask, so a mask that requires grad takes the
+    // unfused path.
+    const auto q4 = q.reshape({bsz, num_heads, tgt_len, head_dim});
+    const auto k4 = k.reshape({bsz, num_heads, src_len, head_dim});
+    const auto v4 = v.reshape({bsz, num_heads, src_len, head_dim});
+    Tensor mask = attn_mask_;
+    if (key_padding_mask_.defined()) {
+      auto padding_mask = torch::zeros({bsz, 1, 1, src_len}, q.options()).masked_fill_(
+        key_padding_mask_.to(torch::kBool).view({bsz, 1, 1, src_len}),
+        -std::numeric_limits<double>::infinity());
+      mask = mask.defined() ? mask + padding_mask : padding_mask;
+    }
+    auto attn_output = std::get<0>(torch::_fused_attention(q4, k4, v4, mask, /*scale=*/1.0));
+    attn_output = attn_output.permute({2, 0, 1, 3}).contiguous().view({tgt_len, bsz, embed_dim});
+    attn_output = F::linear(attn_output, out_proj_weight, out_proj_bias);
+    return std::make_tuple(attn_output, Tensor());
+  }
   auto attn_output_weights = torch::bmm(q, k.transpose(1, 2));
   TORCH_CHECK(attn_output_weights.sizes() == IntArrayRef({bsz * num_heads, tgt_len, src_len}));
   if (attn_mask_.defined()) {
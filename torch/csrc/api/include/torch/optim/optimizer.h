@@ -177,5 +177,13 @@ TORCH_API serialize::InputArchive& operator>>(
     serialize::InputArchive& archive,
     Optimizer& optimizer);
 
+namespace detail {
+/// Returns whether the tensors of one parameter (the parameter, its gradient
+/// and its state) can be updated by the fused `at::_fused_*_` kernels, i.e.
+/// they are dense contiguous CPU tensors with the same float or double dtype
+/// and the same number of elements.
+TORCH_API bool can_use_fused_step(at::TensorList tensors);
+} // namespace detail
+
 } // namespace optim
 } // namespace torch
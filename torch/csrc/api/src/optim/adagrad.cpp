@@ -8,6 +8,7 @@
 #include <ATen/ATen.h>
 
 #include <functional>
+#include <vector>
 
 namespace torch {
 namespace optim {
@@ -63,6 +64,10 @@ Tensor Adagrad::step(LossClosure closure) {
     loss = closure();
   }
   for (auto& group : param_groups_) {
+    auto& options = static_cast<AdagradOptions&>(group.options());
+    // Parameters updated together by at::_fused_adagrad_
+    std::vector<Tensor> fused_params, fused_grads, fused_sums;
+    std::vector<int64_t> fused_steps;
     for (auto& p : group.params()) {
       if (!p.grad().defined()) {
         continue;
@@ -70,10 +75,17 @@ Tensor Adagrad::step(LossClosure closure) {
       auto grad = p.grad();
       TORCH_INTERNAL_ASSERT(state_[c10::guts::to_string(p.unsafeGetTensorImpl())] != nullptr, "state found NULL for the Tensor ", p);
       auto& state = static_cast<AdagradParamState&>(*state_[c10::guts::to_string(p.unsafeGetTensorImpl())]);
-      auto& options = static_cast<AdagradOptions&>(group.options());
 
       state.step(state.step() + 1);
 
+      if (detail::can_use_fused_step({p, grad, state.sum()})) {
+        fused_params.push_back(p);
+        fused_grads.push_back(grad);
+        fused_sums.push_back(state.sum());
+        fused_steps.push_back(state.step());
+        continue;
+      }
+
       if (options.weight_decay() != 0) {
         TORCH_CHECK(!p.grad().is_sparse(), "weight_decay option is not compatible with sparse gradients");
         grad = grad.add(p, options.weight_decay());
@@ -105,6 +117,10 @@ Tensor Adagrad::step(LossClosure closure) {
         p.addcdiv_(grad, std, -clr);
       }
     }
+    if (!fused_params.empty()) {
+      at::_fused_adagrad_(fused_params, fused_grads, fused_sums, fused_steps, options.lr(),
+          options.lr_decay(), options.weight_decay(), options.eps());
+    }
   }
   return loss;
 }
@@ -9,6 +9,7 @@
 
 #include <cmath>
 #include <functional>
+#include <vector>
 
 namespace torch {
 namespace optim {
@@ -69,6 +70,10 @@ Tensor Adam::step(LossClosure closure)  {
     loss = closure();
   }
   for (auto& group : param_groups_) {
+    auto& options = static_cast<AdamOptions&>(group.options());
+    // Parameters updated together by at::_fused_adam_
+    std::vector<Tensor> fused_params, fused_grads, fused_exp_avgs, fused_exp_avg_sqs, fused_max_exp_avg_sqs;
+    std::vector<int64_t> fused_steps;
     for (auto& p : group.params()) {
       if (!p.grad().defined()) {
         continue;
@@ -76,7 +81,6 @@ Tensor Adam::step(LossClosure closure)  {
       auto grad = p.grad();
       TORCH_CHECK(!grad.is_sparse(), "Adam does not support sparse gradients"/*, please consider SparseAdam instead*/);
       auto param_state = state_.find(c10::guts::to_string(p.unsafeGetTensorImpl()));
-      auto& options = static_cast<AdamOptions&>(group.options());
 
       // State initialization
       if(param_state == state_.end()) {
@@ -99,6 +103,20 @@ Tensor Adam::step(LossClosure closure)  {
       auto& max_exp_avg_sq = state.max_exp_avg_sq();
 
       state.step(state.step()+1);
+
+      if (detail::can_use_fused_step({p, grad, exp_avg, exp_avg_sq}) &&
+          (!options.amsgrad() || detail::can_use_fused_step({p, max_exp_avg_sq}))) {
+        fused_params.push_back(p);
+        fused_grads.push_back(grad);
+        fused_exp_avgs.push_back(exp_avg);
+        fused_exp_avg_sqs.push_back(exp_avg_sq);
+        if (options.amsgrad()) {
+          fused_max_exp_avg_sqs.push_back(max_exp_avg_sq);
+        }
+        fused_steps.push_back(state.step());
+        continue;
+      }
+
       auto beta1 = std::get<0>(options.betas());
       auto beta2 = std::get<1>(options.betas());
 
@@ -126,6 +144,11 @@ Tensor Adam::step(LossClosure closure)  {
       auto step_size = options.lr() / bias_correction1;
       p.addcdiv_(exp_avg, denom, -step_size);
     }
+    if (!fused_params.empty()) {
+      at::_fused_adam_(fused_params, fused_grads, fused_exp_avgs, fused_exp_avg_sqs,
+          fused_max_exp_avg_sqs, fused_steps, options.lr(), std::get<0>(options.betas()),
+          std::get<1>(options.betas()), options.weight_decay(), options.eps(), options.amsgrad());
+    }
   }
   return loss;
 }
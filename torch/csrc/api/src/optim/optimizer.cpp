@@ -172,5 +172,25 @@ serialize::InputArchive& operator>>(
   return archive;
 }
 
+namespace detail {
+bool can_use_fused_step(at::TensorList tensors) {
+  if (!tensors[0].defined()) {
+    return false;
+  }
+  const auto dtype = tensors[0].scalar_type();
+  const auto numel = tensors[0].numel();
+  if (dtype != at::kFloat && dtype != at::kDouble) {
+    return false;
+  }
+  for (const auto& t : tensors) {
+    if (!t.defined() || !t.device().is_cpu() || t.layout() != at::kStrided ||
+        t.scalar_type() != dtype || t.numel() != numel || !t.is_contiguous()) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace detail
+
 } // namespace optim
 } // namespace torch
@@ -7,6 +7,7 @@
 #include <ATen/ATen.h>
 
 #include <functional>
+#include <vector>
 
 namespace torch {
 namespace optim {
@@ -71,6 +72,9 @@ Tensor RMSprop::step(LossClosure closure)  {
     loss = closure();
   }
   for (auto& group : param_groups_) {
+    auto& options = static_cast<RMSpropOptions&>(group.options());
+    // Parameters updated together by at::_fused_rmsprop_
+    std::vector<Tensor> fused_params, fused_grads, fused_square_avgs, fused_grad_avgs, fused_momentum_buffers;
     for (auto& p : group.params()) {
       if (!p.grad().defined()) {
         continue;
@@ -78,7 +82,6 @@ Tensor RMSprop::step(LossClosure closure)  {
       auto grad = p.grad();
       TORCH_CHECK(!grad.is_sparse(), "RMSprop does not support sparse gradients");
       auto param_state = state_.find(c10::guts::to_string(p.unsafeGetTensorImpl()));
-      auto& options = static_cast<RMSpropOptions&>(group.options());
 
       // State initialization
       if (param_state == state_.end()) {
@@ -100,6 +103,21 @@ Tensor RMSprop::step(LossClosure closure)  {
 
       state.step(state.step() + 1);
 
+      if (detail::can_use_fused_step({p, grad, square_avg}) &&
+          (!options.centered() || detail::can_use_fused_step({p, state.grad_avg()})) &&
+          (options.momentum() <= 0 || detail::can_use_fused_step({p, state.momentum_buffer()}))) {
+        fused_params.push_back(p);
+        fused_grads.push_back(grad);
+        fused_square_avgs.push_back(square_avg);
+        if (options.centered()) {
+          fused_grad_avgs.push_back(state.grad_avg());
+        }
+        if (options.momentum() > 0) {
+          fused_momentum_buffers.push_back(state.momentum_buffer());
+        }
+        continue;
+      }
+
       if (options.weight_decay() != 0) {
         grad = grad.add(p, options.weight_decay());
       }
@@ -125,6 +143,11 @@ Tensor RMSprop::step(LossClosure closure)  {
         p.addcdiv_(grad, avg, -options.lr());
       }
     }
+    if (!fused_params.empty()) {
+      at::_fused_rmsprop_(fused_params, fused_grads, fused_square_avgs, fused_grad_avgs,
+          fused_momentum_buffers, options.lr(), options.alpha(), options.eps(),
+          options.weight_decay(), options.momentum(), options.centered());
+    }
   }
   return loss;
 }
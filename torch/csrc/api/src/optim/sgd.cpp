@@ -10,6 +10,7 @@
 #include <ATen/ATen.h>
 
 #include <functional>
+#include <vector>
 
 namespace torch {
 namespace optim {
@@ -65,11 +66,40 @@ Tensor SGD::step(LossClosure closure)  {
     auto momentum = options.momentum();
     auto dampening = options.dampening();
     auto nesterov = options.nesterov();
+    // Parameters updated together by at::_fused_sgd_, split by whether their
+    // momentum buffer was created by this step.
+    std::vector<Tensor> fused_params, fused_grads, fused_momentum_buffers;
+    std::vector<Tensor> first_step_params, first_step_grads, first_step_momentum_buffers;
 
     for (auto& p : group.params()) {
       if (!p.grad().defined()) {
         continue;
       }
+      if (detail::can_use_fused_step({p, p.grad()})) {
+        if (momentum == 0) {
+          fused_params.push_back(p);
+          fused_grads.push_back(p.grad());
+          continue;
+        }
+        auto param_state = state_.find(c10::guts::to_string(p.unsafeGetTensorImpl()));
+        if (param_state == state_.end()) {
+          auto buf = torch::empty_like(p, MemoryFormat::Contiguous);
+          auto state = std::make_unique<SGDParamState>();
+          state->momentum_buffer(buf);
+          state_[c10::guts::to_string(p.unsafeGetTensorImpl())] = std::move(state);
+          first_step_params.push_back(p);
+          first_step_grads.push_back(p.grad());
+          first_step_momentum_buffers.push_back(buf);
+          continue;
+        }
+        auto& buf = static_cast<SGDParamState&>(*param_state->second).momentum_buffer();
+        if (detail::can_use_fused_step({p, buf})) {
+          fused_params.push_back(p);
+          fused_grads.push_back(p.grad());
+          fused_momentum_buffers.push_back(buf);
+          continue;
+        }
+      }
       auto d_p = p.grad().data();
       if (weight_decay != 0) {
         d_p = d_p.add(p.data(), weight_decay);
@@ -94,6 +124,14 @@ Tensor SGD::step(LossClosure closure)  {
       }
       p.data().add_(d_p, -1 * options.lr());
     }
+    if (!fused_params.empty()) {
+      at::_fused_sgd_(fused_params, fused_grads, fused_momentum_buffers, options.lr(), momentum,
+          dampening, weight_decay, nesterov, /*is_first_step=*/false);
+    }
+    if (!first_step_params.empty()) {
+      at::_fused_sgd_(first_step_params, first_step_grads, first_step_momentum_buffers, options.lr(),
+          momentum, dampening, weight_decay, nesterov, /*is_first_step=*/true);
+    }
   }
   return loss;
 }
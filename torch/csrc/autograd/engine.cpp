@@ -9,6 +9,7 @@
 #include <torch/csrc/utils/memory.h>
 
 #include <ATen/DeviceGuard.h>
+#include <ATen/ExecutionDomain.h>
 #include <ATen/ExpandUtils.h>
 #include <ATen/Parallel.h>
 #include <c10/util/Exception.h>
@@ -127,6 +128,30 @@ static thread_local std::shared_ptr<ReadyQueue> local_ready_queue = nullptr;
 // When the GraphTask is finished, the parent worker thread that is waiting on
 // the task is notified and the current thread returns to the pool.
 
+// Note [Shared CPU worker pool]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The CPU work of a backward call is normally run by the thread that called
+// it, which blocks until the GraphTask completes. That doesn't suit callers
+// that run many backward passes concurrently, like the RPC server running
+// distributed backward passes: each one would hold a thread for its whole
+// duration. Engine::execute_on_cpu_worker_pool instead runs the CPU work of
+// a GraphTask on a pool of CPU worker threads shared by all the graph tasks,
+// and the caller waits on the future of the GraphTask (or adds callbacks).
+//
+// Such a GraphTask has a cpu_ready_queue_ which schedules the GraphTask on
+// the pool whenever a NodeTask is pushed to it, whether by a worker or by a
+// device thread. The pool keeps a FIFO of the graph tasks with ready work,
+// each in it at most once. A worker takes the first GraphTask, pops one
+// NodeTask from its ready queue and, if more are ready, puts the GraphTask
+// back at the end of the FIFO before running the NodeTask. So the graph
+// tasks take turns (one NodeTask per turn), and independent nodes of a
+// single GraphTask can still run on several workers at once.
+//
+// The workers are CPU worker threads like the caller of backward(), so a
+// reentrant backward call on a worker runs inline on it, see
+// Note [Reentrant backwards]. The pool has get_num_interop_threads() threads
+// and is started on first use.
+
 // Note [Streaming backwards]
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~
 // On CUDA devices the autograd engine's device operations are run on the
@@ -180,6 +205,9 @@ auto ReadyQueue::push(NodeTask item, bool incrementOutstandingTasks) -> void {
     heap_.push(std::move(item));
   }
   not_empty_.notify_one();
+  if (on_push_) {
+    on_push_();
+  }
 }
 
 auto ReadyQueue::pushShutdownTask() -> void {
@@ -205,6 +233,17 @@ auto ReadyQueue::pop() -> NodeTask {
   return task;
 }
 
+c10::optional<NodeTask> ReadyQueue::try_pop() {
+  // Lock mutex for accesses to heap_
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (heap_.empty()) {
+    return c10::nullopt;
+  }
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  auto task = std::move(const_cast<NodeTask&>(heap_.top())); heap_.pop();
+  return task;
+}
+
 bool ReadyQueue::empty() const {
   // Lock mutex for accesses to heap_
   std::unique_lock<std::mutex> lock(mutex_);
@@ -447,6 +486,81 @@ void Engine::reentrant_thread_init() {
   }
 }
 
+void Engine::CPUWorkerPoolShared::schedule(
+    const std::shared_ptr<GraphTask>& graph_task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (graph_task->cpu_worker_pool_scheduled_) {
+      return;
+    }
+    graph_task->cpu_worker_pool_scheduled_ = true;
+    graph_tasks_.push_back(graph_task);
+  }
+  work_.notify_one();
+}
+
+void Engine::cpu_worker_thread_init() {
+  at::init_num_threads();
+  cpu_worker_thread_main();
+}
+
+// See Note [Shared CPU worker pool]
+void Engine::cpu_worker_thread_main() {
+  set_device(CPU_DEVICE);
+  // Only used by reentrant backward calls on this thread
+  init_local_ready_queue();
+  auto pool_shared = cpu_worker_pool_shared_;
+  while (true) {
+    std::shared_ptr<GraphTask> graph_task;
+    {
+      std::unique_lock<std::mutex> lk(pool_shared->mutex_);
+      pool_shared->work_.wait(lk, [&pool_shared]{ return !pool_shared->graph_tasks_.empty(); });
+      graph_task = pool_shared->graph_tasks_.front().lock();
+      pool_shared->graph_tasks_.pop_front();
+      if (!graph_task) {
+        // GraphTask is no longer valid, skipping further execution.
+        continue;
+      }
+      graph_task->cpu_worker_pool_scheduled_ = false;
+    }
+
+    {
+      // Scope this block of execution since NodeTask is not needed after this
+      // block and can be deallocated (release any references to grad tensors
+      // as part of inputs_).
+      c10::optional<NodeTask> task = graph_task->cpu_ready_queue_->try_pop();
+      if (!task) {
+        // Another worker took the task this GraphTask was scheduled for
+        continue;
+      }
+      // Let the other graph tasks have their turn before the next NodeTask
+      // of this one, and another worker run it concurrently
+      if (!graph_task->cpu_ready_queue_->empty()) {
+        pool_shared->schedule(graph_task);
+      }
+
+      if (task->fn_ && !graph_task->has_error_.load()) {
+        AutoGradMode grad_mode(graph_task->grad_mode_);
+        try {
+          GraphTaskGuard guard(graph_task);
+          evaluate_function(graph_task, task->fn_.get(), task->inputs_, graph_task->cpu_ready_queue_);
+        } catch (std::exception& e) {
+          thread_on_exception(graph_task, task->fn_, e);
+        }
+      }
+    }
+
+    // Decrement the outstanding tasks.
+    --graph_task->outstanding_tasks_;
+
+    // Check if we've completed execution. The caller waits on the future, so
+    // there is no owning thread to wake up.
+    if (graph_task->completed()) {
+      graph_task->mark_as_completed_and_run_post_processing();
+    }
+  }
+}
+
 void Engine::thread_on_exception(
     std::shared_ptr<GraphTask> graph_task,
     const std::shared_ptr<Node>& fn,
@@ -957,6 +1071,43 @@ std::shared_ptr<FutureVariableList> Engine::execute_with_graph_task(
   return graph_task->future_result_;
 }
 
+std::shared_ptr<FutureVariableList> Engine::execute_on_cpu_worker_pool(
+    const std::shared_ptr<GraphTask>& graph_task,
+    std::shared_ptr<Node> graph_root,
+    bool incrementOutstandingTasks) {
+  initialize_device_threads_pool();
+  std::call_once(start_cpu_worker_pool_flag_, &Engine::start_cpu_worker_pool, this);
+
+  std::shared_ptr<ReadyQueue> cpu_ready_queue;
+  {
+    // Lock mutex for the accesses to GraphTask cpu_ready_queue_, as several
+    // threads may run roots of the same GraphTask
+    std::lock_guard<std::mutex> lock(graph_task->mutex_);
+    if (!graph_task->cpu_ready_queue_) {
+      std::weak_ptr<GraphTask> weak_graph_task = graph_task;
+      auto pool_shared = cpu_worker_pool_shared_;
+      graph_task->cpu_ready_queue_ = std::make_shared<ReadyQueue>(
+          [pool_shared, weak_graph_task]() {
+            if (auto graph_task = weak_graph_task.lock()) {
+              pool_shared->schedule(graph_task);
+            }
+          });
+      // The workers are CPU threads, see Note [Shared CPU worker pool]
+      graph_task->owner_ = CPU_DEVICE;
+    } else {
+      TORCH_INTERNAL_ASSERT(
+          graph_task->owner_ == CPU_DEVICE,
+          "GraphTask is not run on the CPU worker pool");
+    }
+    cpu_ready_queue = graph_task->cpu_ready_queue_;
+  }
+
+  cpu_ready_queue->push(
+      NodeTask(graph_task, std::move(graph_root), InputBuffer(0)),
+      incrementOutstandingTasks);
+  return graph_task->future_result_;
+}
+
 // note that when python is present, this base engine will be overriden
 // with a PythonEngine. Because this typically happens before get_default_engine
 // is called, this base engine will never be created.
@@ -1066,6 +1217,24 @@ auto Engine::start_device_threads() -> void {
   }
 }
 
+void Engine::start_cpu_worker_pool() {
+  cpu_worker_pool_shared_ = std::make_shared<CPUWorkerPoolShared>();
+  // The threads are leaked like the reentrant backward threads, since they
+  // may be waiting on the pool when the engine is destroyed
+  int num_threads;
+  {
+    // The pool serves every backward pass of the process: size it with the
+    // global inter-op setting, not with the one of the execution domain the
+    // first backward pass happens to run in
+    at::ExecutionDomainGuard no_domain{std::shared_ptr<at::ExecutionDomain>()};
+    num_threads = at::get_num_interop_threads();
+  }
+  for (int i = 0; i < num_threads; ++i) {
+    std::thread t(&Engine::cpu_worker_thread_init, this);
+    t.detach();
+  }
+}
+
 void Engine::add_thread_pool_task(const std::weak_ptr<GraphTask>& graph_task) {
   std::unique_lock<std::mutex> lck(thread_pool_shared_->mutex_);
   // There may already be some items on the graphtasks_queue_ added by other
@@ -11,6 +11,7 @@
 #include <torch/csrc/autograd/functions/basic_ops.h>
 #include <torch/csrc/autograd/input_buffer.h>
 #include <torch/csrc/utils/future.h>
+#include <c10/util/Optional.h>
 
 #include <deque>
 #include <exception>
@@ -151,6 +152,11 @@ struct GraphTask: std::enable_shared_from_this<GraphTask> {
   // and but next NodeTask should be run on CPU.
   std::shared_ptr<ReadyQueue> cpu_ready_queue_;
 
+  // Whether the graph task is waiting for a worker of the shared CPU worker
+  // pool, protected by the mutex of the pool.
+  // See Note [Shared CPU worker pool]
+  bool cpu_worker_pool_scheduled_ = false;
+
   // Future representing the completion of the graph task. Notified when all
   // tasks are done.
   std::shared_ptr<FutureVariableList> future_result_;
@@ -243,7 +249,15 @@ struct ReadyQueue {
 
   std::priority_queue<NodeTask, std::vector<NodeTask>, CompareNodeTaskTime> heap_;
 
+  // Called after each push, to schedule the graph task owning the queue on
+  // the shared CPU worker pool. See Note [Shared CPU worker pool]
+  std::function<void()> on_push_;
+
  public:
+  ReadyQueue() = default;
+  explicit ReadyQueue(std::function<void()> on_push)
+      : on_push_(std::move(on_push)) {}
+
   // incrementOutstandingTasks indicates whether or not we should increment
   // 'outstanding_tasks_' for the associated GraphTask. This should mostly
   // always be true, see the doc for 'enqueue_blocked_task_on_cpu' for when we
@@ -251,6 +265,8 @@ struct ReadyQueue {
   void push(NodeTask item, bool incrementOutstandingTasks = true);
   void pushShutdownTask();
   NodeTask pop();
+  // Returns nullopt instead of waiting if the queue is empty
+  c10::optional<NodeTask> try_pop();
   bool empty() const;
   size_t size() const;
 };
@@ -285,6 +301,21 @@ struct TORCH_API Engine {
       const std::shared_ptr<GraphTask>& graph_task,
       std::shared_ptr<Node> graph_root);
 
+  // Same as execute_with_graph_task, but the CPU work of the graph task is
+  // run by the shared CPU worker pool of the engine and the future is
+  // returned right away, instead of the calling thread running the work
+  // until the graph task completes. The graph task must not have a
+  // cpu_ready_queue_ yet, one is created on the first call. It can be called
+  // several times with different roots for the same graph task.
+  // See Note [Shared CPU worker pool]
+  //
+  // NB: like execute_with_graph_task, this API should only be used by
+  // internal autograd specific machinery.
+  std::shared_ptr<FutureVariableList> execute_on_cpu_worker_pool(
+      const std::shared_ptr<GraphTask>& graph_task,
+      std::shared_ptr<Node> graph_root,
+      bool incrementOutstandingTasks = true);
+
   virtual std::unique_ptr<AnomalyMetadata> make_anomaly_metadata() {
     return nullptr;
   }
@@ -340,6 +371,10 @@ struct TORCH_API Engine {
       bool reentrant_thread);
   void reentrant_thread_init();
   void add_thread_pool_task(const std::weak_ptr<GraphTask>& graph_task);
+  // start the threads of the shared CPU worker pool
+  void start_cpu_worker_pool();
+  virtual void cpu_worker_thread_init();
+  void cpu_worker_thread_main();
 
   // Ensures device_ready_queues_ are initialized only once
   std::once_flag start_device_threads_flag_;
@@ -376,6 +411,25 @@ struct TORCH_API Engine {
  // for the graphtasks_queue_ to be nonempty.
  std::shared_ptr<ThreadPoolShared> thread_pool_shared_;
 
+  struct CPUWorkerPoolShared {
+    // Graph tasks with ready CPU work, each at most once (see
+    // GraphTask::cpu_worker_pool_scheduled_). The workers take turns
+    // between them. See Note [Shared CPU worker pool]
+    std::deque<std::weak_ptr<GraphTask>> graph_tasks_;
+    // The workers will wait on work_ to be notified of graph tasks
+    std::condition_variable work_;
+    // To protect reads and writes to graph_tasks_ and to the
+    // cpu_worker_pool_scheduled_ flags of the graph tasks
+    std::mutex mutex_;
+
+    void schedule(const std::shared_ptr<GraphTask>& graph_task);
+  };
+
+  // Ensures the CPU worker pool is started only once
+  std::once_flag start_cpu_worker_pool_flag_;
+  // Shared with the workers and the ready queues, which outlive the engine
+  std::shared_ptr<CPUWorkerPoolShared> cpu_worker_pool_shared_;
+
 private:
   // Number of non-reentrant threads
   std::atomic<uint32_t> non_reentrant_device_thread_count_;
@@ -4,8 +4,10 @@
 #include <torch/csrc/utils/pybind.h>
 #include <torch/csrc/autograd/grad_mode.h>
 #include <ATen/autocast_mode.h>
+#include <torch/csrc/autograd/latency_observer.h>
 #include <torch/csrc/autograd/profiler.h>
 #include <torch/csrc/autograd/python_function.h>
+#include <torch/csrc/autograd/rematerialization.h>
 #include <torch/csrc/autograd/function.h>
 
 PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject *unused) {
@@ -37,7 +39,8 @@ PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject *unused) {
       .value("NVTX", ProfilerState::NVTX);
 
   py::class_<ProfilerConfig>(m, "ProfilerConfig")
-      .def(py::init<ProfilerState, bool, bool>());
+      .def(py::init<ProfilerState, bool, bool>())
+      .def(py::init<ProfilerState, bool, bool, bool>());
 
   py::class_<Event>(m, "ProfilerEvent")
       .def("kind", &Event::kind)
@@ -50,6 +53,8 @@ PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject *unused) {
       .def("shapes", &Event::shapes)
       .def("cpu_memory_usage", &Event::cpu_memory_usage)
       .def("cuda_memory_usage", &Event::cuda_memory_usage)
+      .def("flops", &Event::flops)
+      .def("bytes_accessed", &Event::bytes_accessed)
       .def("handle", &Event::handle)
       .def("node_id", &Event::node_id)
       .def("is_remote", &Event::isRemote);
@@ -58,6 +63,39 @@ PyObject* THPAutograd_initExtension(PyObject* _unused, PyObject *unused) {
   m.def("_disable_profiler", disableProfiler);
   m.def("_profiler_enabled", profilerEnabled);
 
+  m.def("_enable_latency_observer", enableLatencyObserver);
+  m.def("_disable_latency_observer", disableLatencyObserver);
+  m.def("_latency_observer_enabled", latencyObserverEnabled);
+  m.def("_reset_latency_stats", resetLatencyStats);
+  m.def("_latency_stats_json", latencyStatsToJson);
+  m.def("_latency_stats_prometheus", latencyStatsToPrometheus);
+
+  m.def("_set_rematerialization_enabled", [](bool enabled) {
+    torch::autograd::RematerializationMode::set_enabled(enabled);
+  });
+  m.def("_rematerialization_enabled", []() {
+    return torch::autograd::RematerializationMode::is_enabled();
+  });
+  m.def("_set_rematerialization_memory_budget", [](int64_t memory_budget) {
+    torch::autograd::RematerializationMode::set_memory_budget(memory_budget);
+  });
+  m.def("_rematerialization_memory_budget", []() {
+    return torch::autograd::RematerializationMode::memory_budget();
+  });
+  m.def("_rematerialization_stats", []() {
+    auto stats = torch::autograd::RematerializationMode::stats();
+    py::dict result;
+    result["rematerialized_tensors"] = stats.rematerialized_tensors;
+    result["rematerialized_bytes"] = stats.rematerialized_bytes;
+    result["kept_bytes"] = stats.kept_bytes;
+    result["recomputations"] = stats.recomputations;
+    result["recompute_time_ns"] = stats.recompute_time_ns;
+    return result;
+  });
+  m.def("_reset_rematerialization_stats", []() {
+    torch::autograd::RematerializationMode::reset_stats();
+  });
+
   Py_RETURN_TRUE;
 }
 
@@ -0,0 +1,406 @@
+#include <torch/csrc/autograd/latency_observer.h>
+#include <torch/csrc/autograd/profiler.h>
+
+#include <ATen/record_function.h>
+#include <c10/util/Exception.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+namespace torch { namespace autograd { namespace profiler {
+
+namespace {
+
+using OpKey = std::pair<std::string, std::string>;
+
+struct OpKeyHash {
+  size_t operator()(const OpKey& key) const {
+    return std::hash<std::string>()(key.first) ^
+        (std::hash<std::string>()(key.second) << 1);
+  }
+};
+
+using OpHistograms = std::unordered_map<OpKey, LatencyHistogram, OpKeyHash>;
+
+// The histograms of one thread; the mutex is only contended while the
+// shards are merged.
+struct LatencyShard {
+  std::mutex mutex;
+  OpHistograms histograms;
+};
+
+void mergeInto(OpHistograms& dst, const OpHistograms& src) {
+  for (const auto& kv : src) {
+    dst[kv.first].merge(kv.second);
+  }
+}
+
+class LatencyShards {
+ public:
+  std::shared_ptr<LatencyShard> add() {
+    auto shard = std::make_shared<LatencyShard>();
+    std::lock_guard<std::mutex> guard(mutex_);
+    shards_.push_back(shard);
+    return shard;
+  }
+
+  // Called when a thread exits, keeps its statistics
+  void retire(const std::shared_ptr<LatencyShard>& shard) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    {
+      std::lock_guard<std::mutex> shard_guard(shard->mutex);
+      mergeInto(retired_, shard->histograms);
+    }
+    shards_.erase(
+        std::remove(shards_.begin(), shards_.end(), shard), shards_.end());
+  }
+
+  OpHistograms merge() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    OpHistograms result = retired_;
+    for (const auto& shard : shards_) {
+      std::lock_guard<std::mutex> shard_guard(shard->mutex);
+      mergeInto(result, shard->histograms);
+    }
+    return result;
+  }
+
+  void reset() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    retired_.clear();
+    for (const auto& shard : shards_) {
+      std::lock_guard<std::mutex> shard_guard(shard->mutex);
+      shard->histograms.clear();
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::shared_ptr<LatencyShard>> shards_;
+  OpHistograms retired_;
+};
+
+LatencyShards& latencyShards() {
+  // Leaked, thread local shards may be retired after static destructors ran
+  static auto* shards = new LatencyShards();
+  return *shards;
+}
+
+struct ThreadLatencyShard {
+  ThreadLatencyShard() : shard(latencyShards().add()) {}
+  ~ThreadLatencyShard() {
+    latencyShards().retire(shard);
+  }
+  std::shared_ptr<LatencyShard> shard;
+};
+
+thread_local ThreadLatencyShard thread_latency_shard;
+
+// Start times of the observed ranges on this thread. An end callback that
+// runs on another thread than its start callback does not find its start
+// time and is ignored.
+thread_local std::vector<std::pair<const at::RecordFunction*, int64_t>>
+    observed_starts;
+constexpr size_t kMaxObservedStarts = 256;
+
+// Instead of drawing a random number for every call, draw the number of calls
+// to skip before the next observed one from the geometric distribution, which
+// samples each call with the same probability.
+thread_local int64_t calls_to_skip = -1;
+
+bool sampleCall(double sampling_prob) {
+  if (sampling_prob >= 1.0) {
+    return true;
+  }
+  static thread_local std::mt19937 gen{std::random_device()()};
+  std::geometric_distribution<int64_t> dist(sampling_prob);
+  if (calls_to_skip < 0) {
+    calls_to_skip = dist(gen);
+  }
+  if (calls_to_skip > 0) {
+    --calls_to_skip;
+    return false;
+  }
+  calls_to_skip = dist(gen);
+  return true;
+}
+
+std::string shapesStr(const std::vector<c10::IValue>& inputs) {
+  std::ostringstream ss;
+  ss << "[";
+  for (size_t idx = 0; idx < inputs.size(); ++idx) {
+    if (idx > 0) {
+      ss << ", ";
+    }
+    ss << "[";
+    if (inputs[idx].isTensor() && inputs[idx].toTensor().defined()) {
+      auto sizes = inputs[idx].toTensor().sizes();
+      for (size_t dim = 0; dim < sizes.size(); ++dim) {
+        if (dim > 0) {
+          ss << ", ";
+        }
+        ss << sizes[dim];
+      }
+    }
+    ss << "]";
+  }
+  ss << "]";
+  return ss.str();
+}
+
+struct LatencyObserverState {
+  at::CallbackHandle handle = 0;
+  double sampling_prob = 0.0;
+  bool record_shapes = false;
+};
+
+LatencyObserverState& observerState() {
+  static LatencyObserverState state;
+  return state;
+}
+
+void escapeJson(std::ostream& out, const std::string& str) {
+  for (char c : str) {
+    switch (c) {
+      case '"': out << "\\\""; break;
+      case '\\': out << "\\\\"; break;
+      case '\n': out << "\\n"; break;
+      case '\t': out << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+              << static_cast<int>(c) << std::dec << std::setfill(' ');
+        } else {
+          out << c;
+        }
+    }
+  }
+}
+
+void escapePrometheusLabel(std::ostream& out, const std::string& str) {
+  for (char c : str) {
+    switch (c) {
+      case '"': out << "\\\""; break;
+      case '\\': out << "\\\\"; break;
+      case '\n': out << "\\n"; break;
+      default: out << c;
+    }
+  }
+}
+
+} // namespace
+
+constexpr int LatencyHistogram::kSubBucketBits;
+constexpr int64_t LatencyHistogram::kSubBuckets;
+constexpr int LatencyHistogram::kMaxValueBits;
+constexpr size_t LatencyHistogram::kNumBuckets;
+
+/* static */ size_t LatencyHistogram::bucketIndex(int64_t latency_ns) {
+  if (latency_ns < kSubBuckets) {
+    return latency_ns > 0 ? latency_ns : 0;
+  }
+  if (latency_ns >= (int64_t(1) << kMaxValueBits)) {
+    return kNumBuckets - 1;
+  }
+  int msb = 63;
+  while (!(latency_ns >> msb)) {
+    --msb;
+  }
+  const int shift = msb - kSubBucketBits;
+  return (shift + 1) * kSubBuckets + (latency_ns >> shift) - kSubBuckets;
+}
+
+/* static */ int64_t LatencyHistogram::bucketLowerBound(size_t idx) {
+  if (idx < static_cast<size_t>(kSubBuckets)) {
+    return idx;
+  }
+  const int shift = idx / kSubBuckets - 1;
+  return (static_cast<int64_t>(idx % kSubBuckets) + kSubBuckets) << shift;
+}
+
+void LatencyHistogram::add(int64_t latency_ns) {
+  if (count == 0 || latency_ns < min_ns) {
+    min_ns = latency_ns;
+  }
+  if (count == 0 || latency_ns > max_ns) {
+    max_ns = latency_ns;
+  }
+  ++count;
+  total_ns += latency_ns;
+  ++buckets[bucketIndex(latency_ns)];
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+  if (other.count == 0) {
+    return;
+  }
+  min_ns = count == 0 ? other.min_ns : std::min(min_ns, other.min_ns);
+  max_ns = count == 0 ? other.max_ns : std::max(max_ns, other.max_ns);
+  count += other.count;
+  total_ns += other.total_ns;
+  for (size_t idx = 0; idx < kNumBuckets; ++idx) {
+    buckets[idx] += other.buckets[idx];
+  }
+}
+
+int64_t LatencyHistogram::quantile(double q) const {
+  if (count == 0) {
+    return 0;
+  }
+  auto rank = static_cast<uint64_t>(std::ceil(q * count));
+  rank = std::min(std::max(rank, uint64_t(1)), count);
+  uint64_t seen = 0;
+  for (size_t idx = 0; idx < kNumBuckets; ++idx) {
+    seen += buckets[idx];
+    if (seen >= rank) {
+      return std::max(
+          std::min(bucketLowerBound(idx + 1) - 1, max_ns), min_ns);
+    }
+  }
+  return max_ns;
+}
+
+void enableLatencyObserver(double sampling_prob, bool record_shapes) {
+  auto& state = observerState();
+  TORCH_CHECK(!state.handle, "Latency observer is already enabled");
+  TORCH_CHECK(sampling_prob > 0.0 && sampling_prob <= 1.0,
+      "Expected a sampling probability in (0, 1], but got ", sampling_prob);
+  state.sampling_prob = sampling_prob;
+  state.record_shapes = record_shapes;
+  state.handle = at::addGlobalCallback(at::RecordFunctionCallback(
+      [](const at::RecordFunction& fn) {
+        auto& starts = observed_starts;
+        if (starts.size() >= kMaxObservedStarts) {
+          // Ranges that ended on other threads
+          starts.erase(starts.begin(), starts.begin() + kMaxObservedStarts / 2);
+        }
+        starts.emplace_back(&fn, getTime());
+      },
+      [](const at::RecordFunction& fn) {
+        const int64_t end_ns = getTime();
+        auto& starts = observed_starts;
+        auto it = std::find_if(starts.rbegin(), starts.rend(),
+            [&fn](const std::pair<const at::RecordFunction*, int64_t>& start) {
+              return start.first == &fn;
+            });
+        if (it == starts.rend()) {
+          return;
+        }
+        const int64_t latency_ns = end_ns - it->second;
+        starts.erase(std::next(it).base());
+
+        OpKey key(fn.name().str(), std::string());
+        if (observerState().record_shapes) {
+          key.second = shapesStr(fn.inputs());
+        }
+        auto& shard = *thread_latency_shard.shard;
+        std::lock_guard<std::mutex> guard(shard.mutex);
+        shard.histograms[key].add(latency_ns);
+      })
+    .needsInputs(record_shapes)
+    .setShouldRun([sampling_prob](const at::RecordFunctionCallback&) {
+      return sampleCall(sampling_prob);
+    }));
+}
+
+void disableLatencyObserver() {
+  auto& state = observerState();
+  TORCH_CHECK(state.handle, "Latency observer is not enabled");
+  at::removeCallback(state.handle);
+  state.handle = 0;
+}
+
+bool latencyObserverEnabled() {
+  return observerState().handle != 0;
+}
+
+std::vector<OpLatencyStats> latencyStats() {
+  std::vector<OpLatencyStats> result;
+  for (auto& kv : latencyShards().merge()) {
+    result.push_back({kv.first.first, kv.first.second, kv.second});
+  }
+  std::sort(result.begin(), result.end(),
+      [](const OpLatencyStats& a, const OpLatencyStats& b) {
+        return std::tie(a.name, a.shapes) < std::tie(b.name, b.shapes);
+      });
+  return result;
+}
+
+void resetLatencyStats() {
+  latencyShards().reset();
+}
+
+std::string latencyStatsToJson() {
+  std::ostringstream out;
+  out << "{\"sampling_prob\": " << observerState().sampling_prob
+      << ", \"ops\": [";
+  bool first = true;
+  for (const auto& stats : latencyStats()) {
+    const auto& h = stats.histogram;
+    out << (first ? "" : ", ") << "{\"name\": \"";
+    escapeJson(out, stats.name);
+    out << "\", \"shapes\": \"";
+    escapeJson(out, stats.shapes);
+    out << "\", \"count\": " << h.count
+        << ", \"total_ns\": " << h.total_ns
+        << ", \"min_ns\": " << h.min_ns
+        << ", \"max_ns\": " << h.max_ns
+        << ", \"p50_ns\": " << h.quantile(0.5)
+        << ", \"p90_ns\": " << h.quantile(0.9)
+        << ", \"p99_ns\": " << h.quantile(0.99)
+        << ", \"buckets\": [";
+    // Only the non-empty buckets, as [lower bound, upper bound, count]
+    bool first_bucket = true;
+    for (size_t idx = 0; idx < LatencyHistogram::kNumBuckets; ++idx) {
+      if (h.buckets[idx] == 0) {
+        continue;
+      }
+      out << (first_bucket ? "" : ", ") << "["
+          << LatencyHistogram::bucketLowerBound(idx) << ", "
+          << LatencyHistogram::bucketLowerBound(idx + 1) << ", "
+          << h.buckets[idx] << "]";
+      first_bucket = false;
+    }
+    out << "]}";
+    first = false;
+  }
+  out << "]}";
+  return out.str();
+}
+
+std::string latencyStatsToPrometheus() {
+  std::ostringstream out;
+  out << "# HELP torch_op_latency_seconds Latency of the sampled calls of PyTorch operators.\n"
+      << "# TYPE torch_op_latency_seconds summary\n";
+  for (const auto& stats : latencyStats()) {
+    const auto& h = stats.histogram;
+    std::ostringstream labels;
+    labels << "op=\"";
+    escapePrometheusLabel(labels, stats.name);
+    labels << "\"";
+    if (!stats.shapes.empty()) {
+      labels << ",shapes=\"";
+      escapePrometheusLabel(labels, stats.shapes);
+      labels << "\"";
+    }
+    for (double q : {0.5, 0.9, 0.99}) {
+      out << "torch_op_latency_seconds{" << labels.str() << ",quantile=\""
+          << q << "\"} " << h.quantile(q) / 1e9 << "\n";
+    }
+    out << "torch_op_latency_seconds_sum{" << labels.str() << "} "
+        << h.total_ns / 1e9 << "\n";
+    out << "torch_op_latency_seconds_count{" << labels.str() << "} "
+        << h.count << "\n";
+  }
+  return out.str();
+}
+
+}}} // namespace torch::autograd::profiler
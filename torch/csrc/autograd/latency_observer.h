@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+namespace torch { namespace autograd { namespace profiler {
+
+// The latency observer is an always-on, low overhead alternative to the
+// profiler for production jobs. It is a global RecordFunction callback that
+// samples a fraction of the operator calls on all threads and aggregates
+// their latency into per-operator histograms, instead of keeping every event.
+//
+// Each thread aggregates into its own shard, the shards are only merged when
+// the statistics are requested. The latency of an operator includes the
+// latency of the operators it calls.
+//
+// Usage:
+//   enableLatencyObserver(/* sampling_prob */ 0.01);
+//   ... run the model ...
+//   std::cout << latencyStatsToPrometheus();
+
+// Log-linear histogram of latencies in nanoseconds, in the style of
+// HdrHistogram: each power of two range is split into kSubBuckets buckets,
+// so the bucket of a value is within 1 / kSubBuckets of it.
+struct TORCH_API LatencyHistogram {
+  static constexpr int kSubBucketBits = 3;
+  static constexpr int64_t kSubBuckets = 1 << kSubBucketBits;
+  // Larger latencies (about 18 minutes) go to the last bucket
+  static constexpr int kMaxValueBits = 40;
+  static constexpr size_t kNumBuckets =
+      (kMaxValueBits - kSubBucketBits + 1) * kSubBuckets;
+
+  void add(int64_t latency_ns);
+  void merge(const LatencyHistogram& other);
+
+  // Approximate latency at quantile q in [0, 1], the upper bound of the
+  // bucket it falls in.
+  int64_t quantile(double q) const;
+
+  static size_t bucketIndex(int64_t latency_ns);
+  // Bucket idx holds latencies in [bucketLowerBound(idx), bucketLowerBound(idx + 1))
+  static int64_t bucketLowerBound(size_t idx);
+
+  uint64_t count = 0;
+  int64_t total_ns = 0;
+  int64_t min_ns = 0;
+  int64_t max_ns = 0;
+  std::array<uint64_t, kNumBuckets> buckets{};
+};
+
+struct TORCH_API OpLatencyStats {
+  std::string name;
+  // Sizes of the inputs, e.g. "[[2, 3], []]", if recorded
+  std::string shapes;
+  LatencyHistogram histogram;
+};
+
+// Adds the global callback; as at::addGlobalCallback, it is not thread safe
+// and is supposed to be called when no operators are running, typically at
+// the start of the program.
+// sampling_prob is the probability to observe each operator call;
+// record_shapes aggregates the calls of an operator per input sizes.
+TORCH_API void enableLatencyObserver(
+    double sampling_prob = 0.01,
+    bool record_shapes = false);
+// Removes the global callback, keeps the statistics
+TORCH_API void disableLatencyObserver();
+TORCH_API bool latencyObserverEnabled();
+
+// Merges the shards of all threads, sorted by name and shapes
+TORCH_API std::vector<OpLatencyStats> latencyStats();
+TORCH_API void resetLatencyStats();
+
+TORCH_API std::string latencyStatsToJson();
+// Prometheus text exposition format, as a summary with the 0.5, 0.9 and 0.99
+// quantiles in seconds
+TORCH_API std::string latencyStatsToPrometheus();
+
+}}} // namespace torch::autograd::profiler
@@ -1,5 +1,6 @@
 #include <torch/csrc/autograd/profiler.h>
 #include <torch/csrc/autograd/function.h>
+#include <torch/csrc/autograd/profiler_flops.h>
 #include <torch/csrc/jit/frontend/code_template.h>
 
 #include <torch/csrc/jit/runtime/operator.h>
@@ -7,16 +8,21 @@
 #include <ATen/core/op_registration/op_registration.h>
 #include <torch/library.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <fstream>
 #include <list>
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <ATen/record_function.h>
 #include <c10/core/Allocator.h>
 #include <c10/util/ThreadLocalDebugInfo.h>
+#include <c10/util/string_view.h>
 
 #include <iostream>
 
@@ -24,8 +30,12 @@ namespace torch { namespace autograd { namespace profiler {
 
 namespace {
 
-  constexpr auto kProfilerConfigIValuesSize = 3;
-  constexpr auto kEventIValuesSize = 11;
+  constexpr auto kProfilerConfigIValuesSize = 4;
+  // Configs serialized before with_flops was added don't have it
+  constexpr auto kProfilerConfigMinIValuesSize = 3;
+  constexpr auto kEventIValuesSize = 13;
+  // Events serialized before flops were added don't have them
+  constexpr auto kEventMinIValuesSize = 11;
   enum EventIValueIdx {
     KIND = 0,
     NAME,
@@ -37,13 +47,16 @@ namespace {
     CUDA_RECORDED,
     CUDA_MEM_USAGE,
     CUDA_DEVICE,
-    CUDA_US
+    CUDA_US,
+    FLOPS,
+    BYTES_ACCESSED
   };
 
   enum ProfilerIValueIdx {
     STATE = 0,
     REPORT_INPUT_SHAPES,
     PROFILE_MEMORY,
+    WITH_FLOPS,
   };
 
 CUDAStubs default_stubs;
@@ -139,15 +152,250 @@ static CUDAStubs* cuda_stubs = default_stubs_addr;
 //
 // Profiler callbacks:
 //  - get the current profiling state (PROFILER slot in ThreadLocalDebugInfo)
-//  - save profiling events into the profiling state
+//  - save profiling events into the current thread's buffer in the profiling
+//    state (see Event buffers below)
 //
 
+// Event buffers
+//
+// The profiler callbacks run on every op of every profiled thread, so they
+// must not contend on a lock or allocate per event. Each thread records its
+// events into its own ThreadEventBuffer, written without locking by that
+// thread only. The buffer stores compact POD RecordedEvents with an interned
+// name and the input shapes appended to a shared arena of the thread. They
+// are turned into Events only when the profiler is disabled.
+//
+// The buffer of the current thread is cached in a thread local variable,
+// tagged with the id of the profiling run, so that the state mutex is only
+// taken for the first event of a thread in a run.
+
+// A list of fixed size chunks that its owning thread appends to without
+// locking. Elements are never moved, and the size is published after the
+// element is written, so that the first size() elements can be read by any
+// thread while the owner keeps appending.
+template <typename T, size_t ChunkSize>
+class AppendOnlyList {
+ public:
+  AppendOnlyList() : head_(new Chunk()), tail_(head_.get()) {}
+
+  ~AppendOnlyList() {
+    // Free the chunks iteratively, a long list would overflow the stack
+    auto next = std::move(head_->next);
+    while (next) {
+      next = std::move(next->next);
+    }
+  }
+
+  AppendOnlyList(const AppendOnlyList&) = delete;
+  AppendOnlyList& operator=(const AppendOnlyList&) = delete;
+
+  // Only to be called by the owning thread.
+  void push_back(T value) {
+    if (tail_size_ == ChunkSize) {
+      tail_->next.reset(new Chunk());
+      tail_ = tail_->next.get();
+      tail_size_ = 0;
+    }
+    tail_->data[tail_size_++] = std::move(value);
+    size_.store(
+        size_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  // Only to be called by the owning thread.
+  const T& back() const {
+    return tail_->data[tail_size_ - 1];
+  }
+
+  size_t size() const {
+    return size_.load(std::memory_order_acquire);
+  }
+
+  template <typename F>
+  void forEach(F f) const {
+    const size_t size = this->size();
+    const Chunk* chunk = head_.get();
+    for (size_t idx = 0; idx < size; ++idx) {
+      if (idx > 0 && idx % ChunkSize == 0) {
+        chunk = chunk->next.get();
+      }
+      f(chunk->data[idx % ChunkSize]);
+    }
+  }
+
+ private:
+  struct Chunk {
+    std::array<T, ChunkSize> data;
+    std::unique_ptr<Chunk> next;
+  };
+
+  std::unique_ptr<Chunk> head_;
+  Chunk* tail_;
+  size_t tail_size_ = 0;
+  std::atomic<size_t> size_{0};
+};
+
+struct RecordedEvent {
+  int64_t cpu_ns;
+  at::RecordFunctionHandle handle;
+  // Thread whose event list the event goes to, see popRange
+  uint64_t list_thread_id;
+  // Offset of the input shapes in the shapes arena, or -1 if not recorded
+  int64_t shapes_offset;
+  int64_t alloc_size;
+  int64_t flops;
+  int64_t bytes_accessed;
+  CUDAEventStub cuda_event;
+  uint32_t name_id;
+  int node_id;
+  int device;
+  EventKind kind;
+  uint16_t thread_id;
+  c10::DeviceType alloc_device_type;
+};
+
+// FNV-1a, std::hash<c10::string_view> copies the string into a std::string
+struct NameHash {
+  size_t operator()(c10::string_view name) const noexcept {
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : name) {
+      hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    return static_cast<size_t>(hash);
+  }
+};
+
+class ThreadEventBuffer {
+ public:
+  explicit ThreadEventBuffer(uint64_t thread_id) : thread_id_(thread_id) {
+    intern("");
+  }
+
+  uint64_t threadId() const {
+    return thread_id_;
+  }
+
+  uint32_t intern(const char* name) {
+    auto it = name_ids_.find(c10::string_view(name));
+    if (it != name_ids_.end()) {
+      return it->second;
+    }
+    auto name_id = static_cast<uint32_t>(names_.size());
+    names_.push_back(name);
+    // The key points into names_, whose elements are never moved
+    name_ids_.emplace(c10::string_view(names_.back()), name_id);
+    return name_id;
+  }
+
+  // Appends the sizes of the tensor inputs to the shapes arena: the number of
+  // inputs, followed by the number of dimensions and the sizes of each input
+  // (no dimensions for the inputs that are not defined tensors).
+  int64_t recordShapes(const std::vector<c10::IValue>& inputs) {
+    auto offset = static_cast<int64_t>(shapes_.size());
+    shapes_.push_back(inputs.size());
+    for (const c10::IValue& input : inputs) {
+      if (input.isTensor() && input.toTensor().defined()) {
+        auto sizes = input.toTensor().sizes();
+        shapes_.push_back(sizes.size());
+        for (auto size : sizes) {
+          shapes_.push_back(size);
+        }
+      } else {
+        shapes_.push_back(0);
+      }
+    }
+    return offset;
+  }
+
+  // Takes the time of the event and appends it to the buffer.
+  void record(RecordedEvent& evt, bool record_cuda) {
+    if (record_cuda) {
+      cuda_stubs->record(&evt.device, &evt.cuda_event, &evt.cpu_ns);
+    } else {
+      evt.cpu_ns = getTime();
+    }
+    events_.push_back(evt);
+  }
+
+  // Turns the recorded events into Events, passing each one to
+  // emit(list_thread_id, Event&&) in the order they were recorded.
+  template <typename F>
+  void materialize(F emit) const {
+    // Threads that inherited the profiler state may keep recording while we
+    // read. An event is appended after its name and shapes, so copying the
+    // events first guarantees that the names and shapes copied next cover
+    // all of them.
+    std::vector<RecordedEvent> events;
+    events.reserve(events_.size());
+    events_.forEach([&](const RecordedEvent& recorded) {
+      events.push_back(recorded);
+    });
+
+    std::vector<at::StringView> names;
+    names.reserve(names_.size());
+    names_.forEach([&](const std::string& name) {
+      // Events share the storage of their name
+      names.emplace_back(name);
+    });
+    std::vector<int64_t> shapes;
+    shapes.reserve(shapes_.size());
+    shapes_.forEach([&](int64_t value) { shapes.push_back(value); });
+
+    for (const RecordedEvent& recorded : events) {
+      std::vector<std::vector<int64_t>> input_sizes;
+      if (recorded.shapes_offset >= 0) {
+        const int64_t* data = shapes.data() + recorded.shapes_offset;
+        input_sizes.resize(*data++);
+        for (auto& sizes : input_sizes) {
+          const int64_t dim = *data++;
+          sizes.assign(data, data + dim);
+          data += dim;
+        }
+      }
+      Event evt(
+          recorded.kind,
+          names[recorded.name_id],
+          recorded.thread_id,
+          recorded.handle,
+          std::move(input_sizes),
+          recorded.node_id,
+          recorded.cpu_ns,
+          recorded.device,
+          recorded.cuda_event);
+      if (recorded.kind == EventKind::MemoryAlloc) {
+        evt.updateMemoryStats(
+            recorded.alloc_size, c10::Device(recorded.alloc_device_type));
+      }
+      evt.setFlops(recorded.flops, recorded.bytes_accessed);
+      emit(recorded.list_thread_id, std::move(evt));
+    }
+  }
+
+ private:
+  const uint64_t thread_id_;
+  AppendOnlyList<RecordedEvent, 1024> events_;
+  AppendOnlyList<int64_t, 4096> shapes_;
+  AppendOnlyList<std::string, 64> names_;
+  // Only used by the owning thread
+  std::unordered_map<c10::string_view, uint32_t, NameHash> name_ids_;
+};
+
+std::atomic<uint64_t> next_profile_id{1};
+
+struct ThreadEventBufferCache {
+  uint64_t profile_id = 0;
+  ThreadEventBuffer* buffer = nullptr;
+};
+
+thread_local ThreadEventBufferCache thread_event_buffer_cache;
+
 // Profiler state
 struct ProfilerThreadLocalState
     : public c10::MemoryReportingInfoBase {
   explicit ProfilerThreadLocalState(
       const ProfilerConfig& config)
-    : config_(config), remoteProfiledEvents_{c10::nullopt} {}
+    : config_(config),
+      profile_id_(next_profile_id++),
+      remoteProfiledEvents_{c10::nullopt} {}
   ~ProfilerThreadLocalState() override = default;
 
   inline const ProfilerConfig& config() const {
@@ -157,9 +405,37 @@ struct ProfilerThreadLocalState
   thread_event_lists consolidate() {
     std::lock_guard<std::mutex> g(state_mutex_);
     thread_event_lists result;
-    for (auto& kv : event_lists_map_) {
-      auto& list = kv.second;
-      result.emplace_back(list->consolidate());
+    std::unordered_map<uint64_t, size_t> list_idx;
+    for (const auto& kv : event_buffers_map_) {
+      list_idx.emplace(kv.first, result.size());
+      result.emplace_back();
+    }
+    std::vector<bool> needs_sort(result.size(), false);
+    for (const auto& kv : event_buffers_map_) {
+      kv.second->materialize([&](uint64_t list_thread_id, Event&& evt) {
+        auto it = list_idx.find(list_thread_id);
+        if (it == list_idx.end()) {
+          it = list_idx.emplace(list_thread_id, result.size()).first;
+          result.emplace_back();
+          needs_sort.push_back(false);
+        }
+        result[it->second].push_back(std::move(evt));
+        if (list_thread_id != kv.first) {
+          needs_sort[it->second] = true;
+        }
+      });
+    }
+    // Events popped on other threads were appended after the events recorded
+    // by the thread itself
+    for (size_t idx = 0; idx < result.size(); ++idx) {
+      if (needs_sort[idx]) {
+        std::stable_sort(
+            result[idx].begin(),
+            result[idx].end(),
+            [](const Event& a, const Event& b) {
+              return a.cpu_us() < b.cpu_us();
+            });
+      }
     }
     // Consolidate remote events if applicable as well.
     if (remoteProfiledEvents_) {
@@ -180,14 +456,10 @@ struct ProfilerThreadLocalState
     if (config_.state == ProfilerState::NVTX) {
       cuda_stubs->nvtxMarkA(name.c_str());
     } else {
-      Event evt(
-        EventKind::Mark,
-        at::StringView(std::move(name)),
-        at::RecordFunction::currentThreadId(),
-        include_cuda && config_.state == ProfilerState::CUDA
-      );
-      evt.setNodeId(at::RecordFunction::getDefaultNodeId());
-      getEventList().record(std::move(evt));
+      auto& buffer = getEventBuffer();
+      RecordedEvent evt = makeEvent(buffer, EventKind::Mark);
+      evt.name_id = buffer.intern(name.c_str());
+      buffer.record(evt, include_cuda && config_.state == ProfilerState::CUDA);
     }
   }
 
@@ -205,23 +477,33 @@ struct ProfilerThreadLocalState
       const at::StringView& name,
       const char* msg = "",
       int64_t sequence_nr = -1,
-      std::vector<std::vector<int64_t>>&& shapes = {},
+      const std::vector<c10::IValue>* inputs = nullptr,
       at::RecordFunctionHandle handle = 0) {
     if (config_.state == ProfilerState::Disabled) {
       return;
     }
     if (config_.state == ProfilerState::NVTX) {
       cuda_stubs->nvtxRangePushA(getNvtxStr(
-          name, msg, sequence_nr, shapes).c_str());
+          name, msg, sequence_nr,
+          inputs && config_.report_input_shapes
+              ? inputSizes(*inputs)
+              : std::vector<std::vector<int64_t>>())
+          .c_str());
     } else {
-      getEventList().record(
-          EventKind::PushRange,
-          name,
-          at::RecordFunction::currentThreadId(),
-          config_.state == ProfilerState::CUDA,
-          handle,
-          std::move(shapes),
-          at::RecordFunction::getDefaultNodeId());
+      auto& buffer = getEventBuffer();
+      RecordedEvent evt = makeEvent(buffer, EventKind::PushRange);
+      evt.handle = handle;
+      evt.name_id = buffer.intern(name.str());
+      if (inputs && config_.report_input_shapes) {
+        evt.shapes_offset = buffer.recordShapes(*inputs);
+      }
+      if (inputs && config_.with_flops) {
+        if (auto estimate = estimateFlops(name.str(), *inputs)) {
+          evt.flops = estimate->flops;
+          evt.bytes_accessed = estimate->bytes_accessed;
+        }
+      }
+      buffer.record(evt, config_.state == ProfilerState::CUDA);
     }
   }
 
@@ -236,13 +518,11 @@ struct ProfilerThreadLocalState
       // called on a different thread than pushRange
       // As a convention, we put the async pop on the original
       // thread and save current thread id in pop event
-      Event evt(EventKind::PopRange,
-          at::StringView(""),
-          at::RecordFunction::currentThreadId(),
-          config_.state == ProfilerState::CUDA,
-          handle);
-      evt.setNodeId(at::RecordFunction::getDefaultNodeId());
-      getEventList(thread_id).record(std::move(evt));
+      auto& buffer = getEventBuffer();
+      RecordedEvent evt = makeEvent(buffer, EventKind::PopRange);
+      evt.handle = handle;
+      evt.list_thread_id = thread_id;
+      buffer.record(evt, config_.state == ProfilerState::CUDA);
     }
   }
 
@@ -257,14 +537,12 @@ struct ProfilerThreadLocalState
   void reportMemoryUsage(
       void* /* unused */, int64_t alloc_size, c10::Device device) override {
     if (config_.profile_memory && config_.state != ProfilerState::Disabled) {
-      uint64_t thread_id = at::RecordFunction::currentThreadId();
-      Event evt(
-          EventKind::MemoryAlloc,
-          at::StringView(""),
-          thread_id,
-          config_.state == ProfilerState::CUDA);
-      evt.updateMemoryStats(alloc_size, device);
-      getEventList(thread_id).record(evt);
+      auto& buffer = getEventBuffer();
+      RecordedEvent evt = makeEvent(buffer, EventKind::MemoryAlloc);
+      evt.node_id = -1;
+      evt.alloc_size = alloc_size;
+      evt.alloc_device_type = device.type();
+      buffer.record(evt, config_.state == ProfilerState::CUDA);
     }
   }
 
@@ -273,6 +551,20 @@ struct ProfilerThreadLocalState
   }
 
  private:
+  static std::vector<std::vector<int64_t>> inputSizes(
+      const std::vector<c10::IValue>& inputs) {
+    std::vector<std::vector<int64_t>> sizes;
+    sizes.reserve(inputs.size());
+    for (const c10::IValue& input : inputs) {
+      if (input.isTensor() && input.toTensor().defined()) {
+        sizes.push_back(input.toTensor().sizes().vec());
+      } else {
+        sizes.emplace_back();
+      }
+    }
+    return sizes;
+  }
+
   std::string getNvtxStr(
       const at::StringView& name,
       const char* msg,
@@ -310,28 +602,51 @@ struct ProfilerThreadLocalState
     }
   }
 
-  RangeEventList& getEventList(int64_t thread_id = -1) {
-    if (thread_id < 0) {
-      thread_id = at::RecordFunction::currentThreadId();
+  static RecordedEvent makeEvent(
+      const ThreadEventBuffer& buffer, EventKind kind) {
+    RecordedEvent evt;
+    evt.cpu_ns = 0;
+    evt.handle = 0;
+    evt.list_thread_id = buffer.threadId();
+    evt.shapes_offset = -1;
+    evt.alloc_size = 0;
+    evt.flops = 0;
+    evt.bytes_accessed = 0;
+    evt.cuda_event = nullptr;
+    evt.name_id = 0;
+    evt.node_id = at::RecordFunction::getDefaultNodeId();
+    evt.device = -1;
+    evt.kind = kind;
+    evt.thread_id = buffer.threadId();
+    evt.alloc_device_type = c10::DeviceType::CPU;
+    return evt;
+  }
+
+  ThreadEventBuffer& getEventBuffer() {
+    auto& cache = thread_event_buffer_cache;
+    if (C10_LIKELY(cache.profile_id == profile_id_)) {
+      return *cache.buffer;
     }
-    RangeEventList* list_ptr = nullptr;
+    // First event of this thread in this profiling run, or an event after
+    // a nested profiling run on this thread replaced the cached buffer
+    uint64_t thread_id = at::RecordFunction::currentThreadId();
     std::lock_guard<std::mutex> guard(state_mutex_);
-    auto it = event_lists_map_.find(thread_id);
-    if (it != event_lists_map_.end()) {
-      list_ptr = it->second.get();
-    } else {
-      auto event_list = std::make_shared<RangeEventList>();
-      event_lists_map_[thread_id] = event_list;
-      list_ptr = event_list.get();
+    auto& buffer = event_buffers_map_[thread_id];
+    if (!buffer) {
+      buffer = std::make_unique<ThreadEventBuffer>(thread_id);
     }
-    return *list_ptr;
+    cache.profile_id = profile_id_;
+    cache.buffer = buffer.get();
+    return *buffer;
   }
 
   std::mutex state_mutex_;
-  std::unordered_map<uint64_t, std::shared_ptr<RangeEventList>>
-      event_lists_map_;
+  std::unordered_map<uint64_t, std::unique_ptr<ThreadEventBuffer>>
+      event_buffers_map_;
 
   ProfilerConfig config_ = ProfilerConfig(ProfilerState::Disabled, false, false);
+  // Unique id of the profiling run, used to validate thread_event_buffer_cache
+  const uint64_t profile_id_;
   at::CallbackHandle handle_ = 0;
   c10::optional<std::vector<std::vector<Event>>> remoteProfiledEvents_;
 };
@@ -352,26 +667,13 @@ void pushProfilingCallbacks() {
         }
 
         auto* msg = (fn.seqNr() >= 0) ? ", seq = " : "";
-        if (state_ptr->config().report_input_shapes) {
-          std::vector<std::vector<int64_t>> inputSizes;
-          inputSizes.reserve(fn.inputs().size());
-          for (const c10::IValue& input : fn.inputs()) {
-            if (!input.isTensor()) {
-              inputSizes.emplace_back();
-              continue;
-            }
-            const at::Tensor& tensor = input.toTensor();
-            if (tensor.defined()) {
-              inputSizes.push_back(input.toTensor().sizes().vec());
-            } else {
-              inputSizes.emplace_back();
-            }
-          }
-          state_ptr->pushRange(
-              fn.name(), msg, fn.seqNr(), std::move(inputSizes), fn.handle());
-        } else {
-          state_ptr->pushRange(fn.name(), msg, fn.seqNr(), {}, fn.handle());
-        }
+        const auto& config = state_ptr->config();
+        state_ptr->pushRange(
+            fn.name(),
+            msg,
+            fn.seqNr(),
+            config.report_input_shapes || config.with_flops ? &fn.inputs() : nullptr,
+            fn.handle());
       },
       [](const at::RecordFunction& fn) {
         auto state_ptr = getProfilerTLSState();
@@ -380,7 +682,8 @@ void pushProfilingCallbacks() {
         }
         state_ptr->popRange(fn.getStartCallbacksThreadId(), fn.handle());
       })
-    .needsInputs(state_ptr->config().report_input_shapes)
+    .needsInputs(
+        state_ptr->config().report_input_shapes || state_ptr->config().with_flops)
     .needsIds(true));
   state_ptr->setCallbackHandle(handle);
 }
@@ -404,6 +707,7 @@ at::IValue ProfilerConfig::toIValue() const {
   eventIValueList.emplace_back(static_cast<int64_t>(state));
   eventIValueList.emplace_back(report_input_shapes);
   eventIValueList.emplace_back(profile_memory);
+  eventIValueList.emplace_back(with_flops);
   return eventIValueList;
 }
 
@@ -414,15 +718,20 @@ ProfilerConfig ProfilerConfig::fromIValue(
       "Expected IValue to contain type c10::impl::GenericList");
   auto ivalues = profilerConfigIValue.toList();
   TORCH_INTERNAL_ASSERT(
-      ivalues.size() == kProfilerConfigIValuesSize,
+      ivalues.size() >= kProfilerConfigMinIValuesSize &&
+          ivalues.size() <= kProfilerConfigIValuesSize,
       c10::str(
-          "Expected exactly ",
+          "Expected ",
+          kProfilerConfigMinIValuesSize,
+          " to ",
           kProfilerConfigIValuesSize,
           " ivalues to resconstruct ProfilerConfig."));
   return ProfilerConfig(
       static_cast<ProfilerState>(ivalues.get(ProfilerIValueIdx::STATE).toInt()),
       ivalues.get(ProfilerIValueIdx::REPORT_INPUT_SHAPES).toBool(),
-      ivalues.get(ProfilerIValueIdx::PROFILE_MEMORY).toBool());
+      ivalues.get(ProfilerIValueIdx::PROFILE_MEMORY).toBool(),
+      ivalues.size() > ProfilerIValueIdx::WITH_FLOPS &&
+          ivalues.get(ProfilerIValueIdx::WITH_FLOPS).toBool());
 }
 
 ProfilerConfig getProfilerConfig() {
@@ -510,9 +819,9 @@ void Event::record(bool record_cuda) {
       "Expected IValue to contain type c10::impl::GenericList");
   auto ivalues = eventIValue.toList();
   TORCH_INTERNAL_ASSERT(
-      ivalues.size() >= kEventIValuesSize,
+      ivalues.size() >= kEventMinIValuesSize,
       "Expected at least ",
-      kEventIValuesSize,
+      kEventMinIValuesSize,
       " elements to reconstruct Event.");
 
   Event evt(
@@ -532,6 +841,11 @@ void Event::record(bool record_cuda) {
       ivalues.get(EventIValueIdx::CUDA_DEVICE).toInt(), // device
       ivalues.get(EventIValueIdx::CUDA_US).toInt() // cuda_us
   );
+  if (ivalues.size() > EventIValueIdx::BYTES_ACCESSED) {
+    evt.setFlops(
+        ivalues.get(EventIValueIdx::FLOPS).toInt(),
+        ivalues.get(EventIValueIdx::BYTES_ACCESSED).toInt());
+  }
   return evt;
 }
 
@@ -551,6 +865,8 @@ at::IValue Event::toIValue() const {
   eventIValueList.emplace_back(static_cast<int64_t>(cuda_memory_usage_));
   eventIValueList.emplace_back(device_);
   eventIValueList.emplace_back(cuda_us_);
+  eventIValueList.emplace_back(flops_);
+  eventIValueList.emplace_back(bytes_accessed_);
   return at::IValue(eventIValueList);
 }
 
@@ -104,14 +104,18 @@ struct TORCH_API ProfilerConfig {
   ProfilerConfig(
       ProfilerState state,
       bool report_input_shapes,
-      bool profile_memory)
+      bool profile_memory,
+      bool with_flops = false)
       : state(state),
         report_input_shapes(report_input_shapes),
-        profile_memory(profile_memory) {}
+        profile_memory(profile_memory),
+        with_flops(with_flops) {}
   ~ProfilerConfig();
   ProfilerState state;
   bool report_input_shapes;
   bool profile_memory;
+  // Estimate the flops and bytes accessed of the ops, see estimateFlops
+  bool with_flops;
 
   // Returns IValues corresponding to ProfilerConfig struct, to be used for
   // serialization.
@@ -185,6 +189,28 @@ struct TORCH_API Event final {
     }
   }
 
+  // Constructor for the events that the profiler recorded into its per-thread
+  // buffers and turns into Events when it is disabled.
+  Event(
+      EventKind kind,
+      at::StringView name,
+      uint16_t thread_id,
+      at::RecordFunctionHandle handle,
+      std::vector<std::vector<int64_t>>&& shapes,
+      int node_id,
+      int64_t cpu_ns,
+      int device,
+      CUDAEventStub cuda_event)
+      : cpu_ns_(cpu_ns),
+        name_(std::move(name)),
+        kind_(kind),
+        thread_id_(thread_id),
+        handle_(handle),
+        shapes_(std::move(shapes)),
+        device_(device),
+        cuda_event(cuda_event),
+        node_id_(node_id) {}
+
   // Returns IValues corresponding to event structure, to be used for
   // serialization.
   at::IValue toIValue() const;
@@ -254,6 +280,19 @@ struct TORCH_API Event final {
     return cuda_memory_usage_;
   }
 
+  void setFlops(int64_t flops, int64_t bytes_accessed) {
+    flops_ = flops;
+    bytes_accessed_ = bytes_accessed;
+  }
+
+  int64_t flops() const {
+    return flops_;
+  }
+
+  int64_t bytes_accessed() const {
+    return bytes_accessed_;
+  }
+
   at::RecordFunctionHandle handle() const {
     return handle_;
   }
@@ -286,6 +325,8 @@ private:
   std::vector<std::vector<int64_t>> shapes_;
   int64_t cpu_memory_usage_ = 0;
   int64_t cuda_memory_usage_ = 0;
+  int64_t flops_ = 0;
+  int64_t bytes_accessed_ = 0;
   int device_ = -1;
   struct CUevent_st* cuda_event = nullptr;
   int node_id_ = 0;
@@ -0,0 +1,268 @@
+#include <torch/csrc/autograd/profiler_flops.h>
+
+#include <ATen/ATen.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+namespace torch { namespace autograd { namespace profiler {
+
+namespace {
+
+using Inputs = std::vector<c10::IValue>;
+using Estimator = c10::optional<FlopsEstimate> (*)(const Inputs&);
+
+bool isDefinedTensor(const Inputs& inputs, size_t idx) {
+  return idx < inputs.size() && inputs[idx].isTensor() &&
+      inputs[idx].toTensor().defined();
+}
+
+int64_t nbytes(const at::Tensor& tensor) {
+  return tensor.numel() * tensor.element_size();
+}
+
+int64_t tensorInputBytes(const Inputs& inputs) {
+  int64_t bytes = 0;
+  for (const auto& input : inputs) {
+    if (input.isTensor() && input.toTensor().defined()) {
+      bytes += nbytes(input.toTensor());
+    }
+  }
+  return bytes;
+}
+
+// An int[] argument may be given as a single value for all the dimensions
+int64_t listValue(const std::vector<int64_t>& values, size_t idx, int64_t default_value) {
+  if (values.empty()) {
+    return default_value;
+  }
+  return values[std::min(idx, values.size() - 1)];
+}
+
+// mm, addmm, bmm and baddbmm, with the matrices at inputs[first]
+c10::optional<FlopsEstimate> estimateMatmul(const Inputs& inputs, size_t first, bool batched) {
+  if (!isDefinedTensor(inputs, first) || !isDefinedTensor(inputs, first + 1)) {
+    return c10::nullopt;
+  }
+  const auto& a = inputs[first].toTensor();
+  const auto& b = inputs[first + 1].toTensor();
+  const int64_t dim = batched ? 3 : 2;
+  if (a.dim() != dim || b.dim() != dim) {
+    return c10::nullopt;
+  }
+  const int64_t batch = batched ? a.size(0) : 1;
+  const int64_t n = a.size(dim - 2);
+  const int64_t k = a.size(dim - 1);
+  const int64_t m = b.size(dim - 1);
+  FlopsEstimate estimate;
+  estimate.flops = 2 * batch * n * k * m;
+  estimate.bytes_accessed = tensorInputBytes(inputs) + batch * n * m * a.element_size();
+  return estimate;
+}
+
+c10::optional<FlopsEstimate> estimateMm(const Inputs& inputs) {
+  return estimateMatmul(inputs, 0, /*batched=*/false);
+}
+
+c10::optional<FlopsEstimate> estimateAddmm(const Inputs& inputs) {
+  return estimateMatmul(inputs, 1, /*batched=*/false);
+}
+
+c10::optional<FlopsEstimate> estimateBmm(const Inputs& inputs) {
+  return estimateMatmul(inputs, 0, /*batched=*/true);
+}
+
+c10::optional<FlopsEstimate> estimateBaddbmm(const Inputs& inputs) {
+  return estimateMatmul(inputs, 1, /*batched=*/true);
+}
+
+// convolution(input, weight, bias, stride, padding, dilation, transposed,
+//             output_padding, groups)
+c10::optional<FlopsEstimate> estimateConvolution(const Inputs& inputs) {
+  if (inputs.size() < 9 || !isDefinedTensor(inputs, 0) || !isDefinedTensor(inputs, 1) ||
+      !inputs[3].isIntList() || !inputs[4].isIntList() || !inputs[5].isIntList() ||
+      !inputs[6].isBool() || !inputs[7].isIntList() || !inputs[8].isInt()) {
+    return c10::nullopt;
+  }
+  const auto& input = inputs[0].toTensor();
+  const auto& weight = inputs[1].toTensor();
+  if (input.dim() < 3 || input.dim() != weight.dim()) {
+    return c10::nullopt;
+  }
+  const auto stride = inputs[3].toIntVector();
+  const auto padding = inputs[4].toIntVector();
+  const auto dilation = inputs[5].toIntVector();
+  const bool transposed = inputs[6].toBool();
+  const auto output_padding = inputs[7].toIntVector();
+  const int64_t groups = inputs[8].toInt();
+
+  int64_t kernel_size = 1;
+  int64_t input_spatial = 1;
+  int64_t output_spatial = 1;
+  for (int64_t d = 2; d < input.dim(); ++d) {
+    const size_t idx = d - 2;
+    const int64_t kernel = weight.size(d);
+    const int64_t size = input.size(d);
+    const int64_t dilated_kernel = listValue(dilation, idx, 1) * (kernel - 1);
+    const int64_t output_size = transposed
+        ? (size - 1) * listValue(stride, idx, 1) - 2 * listValue(padding, idx, 0) +
+            dilated_kernel + listValue(output_padding, idx, 0) + 1
+        : (size + 2 * listValue(padding, idx, 0) - dilated_kernel - 1) /
+            listValue(stride, idx, 1) + 1;
+    kernel_size *= kernel;
+    input_spatial *= size;
+    output_spatial *= std::max<int64_t>(output_size, 0);
+  }
+
+  const int64_t batch = input.size(0);
+  FlopsEstimate estimate;
+  int64_t output_channels = 0;
+  if (transposed) {
+    // weight is [in_channels, out_channels / groups, kernel...], each input
+    // element is scattered into the output
+    output_channels = weight.size(1) * groups;
+    estimate.flops = 2 * batch * input_spatial * weight.size(0) * weight.size(1) * kernel_size;
+  } else {
+    // weight is [out_channels, in_channels / groups, kernel...]
+    output_channels = weight.size(0);
+    estimate.flops = 2 * batch * output_spatial * weight.size(0) * weight.size(1) * kernel_size;
+  }
+  estimate.bytes_accessed = tensorInputBytes(inputs) +
+      batch * output_channels * output_spatial * input.element_size();
+  return estimate;
+}
+
+// embedding_bag(weight, indices, offsets, scale_grad_by_freq, mode, sparse,
+//               per_sample_weights, include_last_offset)
+c10::optional<FlopsEstimate> estimateEmbeddingBag(const Inputs& inputs) {
+  if (!isDefinedTensor(inputs, 0) || !isDefinedTensor(inputs, 1) || !isDefinedTensor(inputs, 2)) {
+    return c10::nullopt;
+  }
+  const auto& weight = inputs[0].toTensor();
+  const auto& indices = inputs[1].toTensor();
+  const auto& offsets = inputs[2].toTensor();
+  if (weight.dim() != 2) {
+    return c10::nullopt;
+  }
+  const bool include_last_offset = inputs.size() > 7 && inputs[7].isBool() && inputs[7].toBool();
+  const bool weighted = isDefinedTensor(inputs, 6);
+  const int64_t embedding_dim = weight.size(1);
+  const int64_t num_bags = include_last_offset
+      ? std::max<int64_t>(offsets.numel() - 1, 0) : offsets.numel();
+  const int64_t gathered = indices.numel() * embedding_dim;
+  FlopsEstimate estimate;
+  estimate.flops = weighted ? 2 * gathered : gathered;
+  // Only the rows of weight that are looked up are read
+  estimate.bytes_accessed = (gathered + num_bags * embedding_dim) * weight.element_size() +
+      nbytes(indices) + nbytes(offsets) +
+      (weighted ? nbytes(inputs[6].toTensor()) : 0);
+  return estimate;
+}
+
+// One flop per output element, the output has the broadcast size of the
+// tensor inputs
+c10::optional<FlopsEstimate> estimatePointwise(const Inputs& inputs) {
+  int64_t numel = 0;
+  int64_t element_size = 0;
+  for (const auto& input : inputs) {
+    if (input.isTensor() && input.toTensor().defined()) {
+      const auto& tensor = input.toTensor();
+      if (element_size == 0) {
+        element_size = tensor.element_size();
+      }
+      numel = std::max(numel, tensor.numel());
+    }
+  }
+  if (element_size == 0) {
+    return c10::nullopt;
+  }
+  FlopsEstimate estimate;
+  estimate.flops = numel;
+  estimate.bytes_accessed = tensorInputBytes(inputs) + numel * element_size;
+  return estimate;
+}
+
+// One flop per input element. The overloads that take the reduced dimensions
+// have them in inputs[1] with at least keepdim after them. With two inputs,
+// inputs[1] is something else, e.g. the dtype of sum(self, dtype), which is
+// an int too.
+c10::optional<FlopsEstimate> estimateReduction(const Inputs& inputs) {
+  if (!isDefinedTensor(inputs, 0)) {
+    return c10::nullopt;
+  }
+  if (isDefinedTensor(inputs, 1)) {
+    // binary max and min
+    return estimatePointwise(inputs);
+  }
+  const auto& self = inputs[0].toTensor();
+  int64_t output_numel = 1;
+  if (inputs.size() > 2 && (inputs[1].isIntList() || inputs[1].isInt()) && self.dim() > 0) {
+    std::vector<int64_t> dims = inputs[1].isInt()
+        ? std::vector<int64_t>{inputs[1].toInt()} : inputs[1].toIntVector();
+    if (!dims.empty()) {
+      std::vector<bool> reduced(self.dim(), false);
+      for (auto dim : dims) {
+        if (dim < -self.dim() || dim >= self.dim()) {
+          return c10::nullopt;
+        }
+        reduced[dim < 0 ? dim + self.dim() : dim] = true;
+      }
+      for (int64_t d = 0; d < self.dim(); ++d) {
+        if (!reduced[d]) {
+          output_numel *= self.size(d);
+        }
+      }
+    }
+  }
+  FlopsEstimate estimate;
+  estimate.flops = self.numel();
+  estimate.bytes_accessed = nbytes(self) + output_numel * self.element_size();
+  return estimate;
+}
+
+const std::unordered_map<std::string, Estimator>& estimators() {
+  static const std::unordered_map<std::string, Estimator> estimators = [] {
+    std::unordered_map<std::string, Estimator> result = {
+      {"mm", estimateMm},
+      {"addmm", estimateAddmm},
+      {"bmm", estimateBmm},
+      {"baddbmm", estimateBaddbmm},
+      {"convolution", estimateConvolution},
+      {"embedding_bag", estimateEmbeddingBag},
+    };
+    for (const char* name : {
+        "add", "sub", "mul", "div", "neg", "abs", "exp", "log", "sqrt", "rsqrt",
+        "pow", "clamp", "relu", "sigmoid", "tanh", "gelu", "hardtanh", "leaky_relu",
+        "threshold", "addcmul", "addcdiv", "lerp", "where"}) {
+      result.emplace(name, estimatePointwise);
+      result.emplace(std::string(name) + "_", estimatePointwise);
+    }
+    for (const char* name : {
+        "sum", "mean", "prod", "std", "var", "amax", "amin", "max", "min",
+        "argmax", "argmin", "logsumexp"}) {
+      result.emplace(name, estimateReduction);
+    }
+    return result;
+  }();
+  return estimators;
+}
+
+} // namespace
+
+c10::optional<FlopsEstimate> estimateFlops(
+    const char* op_name,
+    const std::vector<c10::IValue>& inputs) {
+  if (std::strncmp(op_name, "aten::", 6) == 0) {
+    op_name += 6;
+  }
+  const auto& all_estimators = estimators();
+  auto it = all_estimators.find(op_name);
+  if (it == all_estimators.end()) {
+    return c10::nullopt;
+  }
+  return it->second(inputs);
+}
+
+}}} // namespace torch::autograd::profiler
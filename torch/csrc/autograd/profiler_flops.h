@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <ATen/core/ivalue.h>
+#include <c10/util/Optional.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+namespace torch { namespace autograd { namespace profiler {
+
+// Analytical cost of an operator call, to tell compute bound ops from memory
+// bound ones. A multiply-add counts as 2 flops. bytes_accessed is the size of
+// the tensors read and written, assuming each is accessed once.
+struct FlopsEstimate {
+  int64_t flops = 0;
+  int64_t bytes_accessed = 0;
+};
+
+// Estimates the cost of the call of op_name (with or without the "aten::"
+// prefix) from its inputs, for matrix multiplications, convolutions,
+// embedding_bag, pointwise ops and reductions; returns nullopt for the
+// other ops.
+TORCH_API c10::optional<FlopsEstimate> estimateFlops(
+    const char* op_name,
+    const std::vector<c10::IValue>& inputs);
+
+}}} // namespace torch::autograd::profiler
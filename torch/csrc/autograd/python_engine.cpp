@@ -59,6 +59,13 @@ void PythonEngine::thread_init(int device, const std::shared_ptr<ReadyQueue>& re
   Engine::thread_init(device, ready_queue, false);
 }
 
+void PythonEngine::cpu_worker_thread_init() {
+  // See the comment in thread_init above
+  pybind11::gil_scoped_acquire gil;
+  pybind11::gil_scoped_release no_gil;
+  Engine::cpu_worker_thread_init();
+}
+
 void PythonEngine::thread_on_exception(
     std::shared_ptr<GraphTask> graph_task,
     const std::shared_ptr<Node>& fn,
@@ -14,6 +14,7 @@ struct PythonEngine : public Engine {
   void thread_init(int device,
       const std::shared_ptr<ReadyQueue>& ready_queue,
       bool should_increment) override;
+  void cpu_worker_thread_init() override;
   void thread_on_exception(
       std::shared_ptr<GraphTask> graph_task,
       const std::shared_ptr<Node>& fn,
@@ -197,6 +197,56 @@ static inline Variable applySlicing(
   return result;
 }
 
+// Converts the index tuple for at::indexing::impl::applySlicingFused, returns
+// false if it has indices other than integers, slices, None, ellipsis and
+// tensors
+static inline bool unpackFusedIndices(
+    PyObject* index,
+    c10::SmallVectorImpl<at::indexing::TensorIndex>& out) {
+  int64_t size = PyTuple_GET_SIZE(index); // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+  for (int64_t i = 0; i < size; i++) {
+    PyObject* obj = PyTuple_GET_ITEM(index, i); // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    if (THPVariable_Check(obj)) {
+      out.emplace_back(THPVariable_Unpack(obj));
+    } else if (THPUtils_checkLong(obj)) {
+      out.emplace_back(THPUtils_unpackLong(obj));
+    } else if (PySlice_Check(obj)) {
+      Py_ssize_t start, stop, step;
+      checkUnpackSlice(obj, &start, &stop, &step);
+      out.emplace_back(at::indexing::Slice(start, stop, step));
+    } else if (obj == Py_Ellipsis) {
+      out.emplace_back(at::indexing::Ellipsis);
+    } else if (obj == Py_None) {
+      out.emplace_back(at::indexing::None);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+// See Note [Fused basic indexing] in ATen/TensorIndexing.h. can_fuse is
+// canApplySlicingFused, or canSetItemFused for __setitem__.
+static inline Variable applySlicingMaybeFused(
+    const Variable& self,
+    PyObject* index,
+    variable_list& outIndices,
+    bool is_tracing,
+    bool can_fuse,
+    const at::Device& self_device,
+    const IntArrayRef& self_sizes) {
+  if (!is_tracing && can_fuse) {
+    c10::SmallVector<at::indexing::TensorIndex, 5> indices;
+    if (unpackFusedIndices(index, indices)) {
+      auto fused = at::indexing::impl::applySlicingFused(self, indices, outIndices, self_sizes);
+      if (fused) {
+        return std::move(*fused);
+      }
+    }
+  }
+  return applySlicing(self, index, outIndices, is_tracing, self_device, self_sizes);
+}
+
 static inline bool treatSequenceAsTuple(PyObject* index) {
   if (PyTuple_Check(index)) {
     return true;
@@ -298,8 +348,10 @@ PyObject* THPVariable_getitem(PyObject* self, PyObject* index) {
   THPObjectPtr holder = wrapTuple(index);
 
   variable_list variableIndices;
-  Variable sliced = applySlicing(
-    self_, holder.get(), variableIndices, /*is_tracing=*/is_tracing, self_.device(), self_.sizes());
+  Variable sliced = applySlicingMaybeFused(
+    self_, holder.get(), variableIndices, /*is_tracing=*/is_tracing,
+    /*can_fuse=*/at::indexing::impl::canApplySlicingFused(self_, self_.device()),
+    self_.device(), self_.sizes());
   if (variableIndices.empty()) {
     if (sliced.is_same(self_)) {
       // ensure we return a shallow copy for things like x[...]
@@ -384,8 +436,10 @@ int THPVariable_setitem(PyObject* self, PyObject* index, PyObject* py_value) {
   THPObjectPtr holder = wrapTuple(index);
 
   variable_list variableIndices;
-  Variable sliced = applySlicing(
-    self_, holder.get(), variableIndices, /*is_tracing=*/is_tracing, self_device, self_.sizes());
+  Variable sliced = applySlicingMaybeFused(
+    self_, holder.get(), variableIndices, /*is_tracing=*/is_tracing,
+    /*can_fuse=*/at::indexing::impl::canSetItemFused(self_, value, self_device),
+    self_device, self_.sizes());
   if (variableIndices.empty()) {
     at::indexing::copy_to(sliced, value);
     return 0;
@@ -0,0 +1,190 @@
+#include <torch/csrc/autograd/rematerialization.h>
+
+#include <torch/csrc/autograd/grad_mode.h>
+#include <torch/csrc/autograd/variable.h>
+
+#include <chrono>
+
+namespace torch { namespace autograd {
+
+namespace {
+
+std::atomic<int64_t> rematerialized_tensors_{0};
+std::atomic<int64_t> rematerialized_bytes_{0};
+std::atomic<int64_t> kept_bytes_{0};
+std::atomic<int64_t> recomputations_{0};
+std::atomic<int64_t> recompute_time_ns_{0};
+
+// Reserves nbytes in the budget, returns false if they don't fit
+bool reserve_kept_bytes(int64_t nbytes) {
+  const int64_t budget = RematerializationMode::memory_budget();
+  int64_t kept = kept_bytes_.load();
+  do {
+    if (kept + nbytes > budget) {
+      return false;
+    }
+  } while (!kept_bytes_.compare_exchange_weak(kept, kept + nbytes));
+  return true;
+}
+
+} // namespace
+
+bool RematerializationMode::_enabled = false;
+std::atomic<int64_t> RematerializationMode::_memory_budget{0};
+
+void RematerializationMode::set_memory_budget(int64_t memory_budget) {
+  TORCH_CHECK(memory_budget >= 0, "Expected a non-negative memory budget, got ", memory_budget);
+  _memory_budget = memory_budget;
+}
+
+RematerializationStats RematerializationMode::stats() {
+  RematerializationStats stats;
+  stats.rematerialized_tensors = rematerialized_tensors_;
+  stats.rematerialized_bytes = rematerialized_bytes_;
+  stats.kept_bytes = kept_bytes_;
+  stats.recomputations = recomputations_;
+  stats.recompute_time_ns = recompute_time_ns_;
+  return stats;
+}
+
+void RematerializationMode::reset_stats() {
+  rematerialized_tensors_ = 0;
+  rematerialized_bytes_ = 0;
+  recomputations_ = 0;
+  recompute_time_ns_ = 0;
+}
+
+Rematerializer::Rematerializer(
+    const char* name,
+    const variable_list& inputs,
+    Recipe recipe,
+    const Variable& output)
+    : name_(name),
+      recipe_(std::move(recipe)),
+      output_(output.getIntrusivePtr()),
+      output_version_(impl::version_counter(output).current_version()),
+      output_nbytes_(output.numel() * output.element_size()) {
+  inputs_.reserve(inputs.size());
+  for (const auto& input : inputs) {
+    inputs_.emplace_back(input, /*is_output=*/false);
+    // This recipe may never recompute, e.g. if its output stays alive, so a
+    // recomputed input isn't kept for it
+    if (const auto& use = inputs_.back().rematerializer_) {
+      use->rematerializer->remove_use(*use);
+    }
+  }
+}
+
+Rematerializer::~Rematerializer() {
+  if (kept_) {
+    kept_bytes_ -= output_nbytes_;
+  }
+}
+
+bool Rematerializer::should_rematerialize(const Variable& output) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (impl::version_counter(output).current_version() != output_version_) {
+    // The recipe can't recompute the output anymore, and the saved variables
+    // of the output that rely on it fail their version check
+    inputs_.clear();
+    recipe_ = nullptr;
+    return false;
+  }
+  if (!decided_) {
+    decided_ = true;
+    kept_ = reserve_kept_bytes(output_nbytes_);
+    if (kept_) {
+      // The inputs are only needed to recompute
+      inputs_.clear();
+      recipe_ = nullptr;
+    } else {
+      ++rematerialized_tensors_;
+      rematerialized_bytes_ += output_nbytes_;
+    }
+  }
+  return !kept_;
+}
+
+at::Tensor Rematerializer::get(RematerializerUse& use) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  TORCH_INTERNAL_ASSERT(!kept_, "Recomputing the kept output of ", name_);
+  if (auto output = output_.lock()) {
+    return at::Tensor(std::move(output));
+  }
+  if (!data_.defined()) {
+    variable_list inputs;
+    inputs.reserve(inputs_.size());
+    for (const auto& input : inputs_) {
+      inputs.push_back(input.unpack());
+    }
+    at::NoGradGuard no_grad;
+    auto start = std::chrono::steady_clock::now();
+    data_ = recipe_(inputs);
+    auto end = std::chrono::steady_clock::now();
+    ++recomputations_;
+    recompute_time_ns_ +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    ++generation_;
+    num_pending_uses_ = num_uses_;
+  }
+  auto data = data_;
+  // A use that unpacks again, e.g. when the graph is retained, already
+  // counted
+  if (use.tracked && use.generation != generation_) {
+    use.generation = generation_;
+    --num_pending_uses_;
+  }
+  // Also when no backward function waits for the output, which was only
+  // recomputed as the input of a recipe
+  if (num_pending_uses_ == 0) {
+    data_.reset();
+  }
+  return data;
+}
+
+void Rematerializer::add_use(RematerializerUse& use) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++num_uses_;
+  // Doesn't wait for a new use to unpack the output recomputed before it
+  use.generation = generation_;
+}
+
+void Rematerializer::remove_use(RematerializerUse& use) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!use.tracked) {
+    return;
+  }
+  use.tracked = false;
+  --num_uses_;
+  if (data_.defined() && use.generation != generation_ &&
+      --num_pending_uses_ == 0) {
+    data_.reset();
+  }
+}
+
+RematerializerUse::RematerializerUse(
+    std::shared_ptr<Rematerializer> rematerializer)
+    : rematerializer(std::move(rematerializer)) {
+  this->rematerializer->add_use(*this);
+}
+
+RematerializerUse::~RematerializerUse() {
+  rematerializer->remove_use(*this);
+}
+
+namespace impl {
+
+std::shared_ptr<Rematerializer> rematerializer(const Variable& self) {
+  auto autograd_meta = get_autograd_meta(self);
+  return autograd_meta ? autograd_meta->rematerializer_ : nullptr;
+}
+
+void set_rematerializer(
+    const Variable& self,
+    std::shared_ptr<Rematerializer> rematerializer) {
+  materialize_autograd_meta(self)->rematerializer_ = std::move(rematerializer);
+}
+
+} // namespace impl
+
+}} // namespace torch::autograd
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/csrc/autograd/saved_variable.h>
+
+#include <ATen/ATen.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace torch { namespace autograd {
+
+using Variable = at::Tensor;
+using variable_list = std::vector<Variable>;
+
+// Note [Rematerialization]
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// A SavedVariable keeps the saved tensor alive until the backward pass, so
+// the activations of a network dominate the memory of training. Many of them
+// are the outputs of ops that are cheap to compute again from their inputs
+// (activations, softmax, layer norm), which is what activation checkpointing
+// exploits, by hand and for whole segments.
+//
+// When rematerialization is enabled, the ops listed in REMATERIALIZABLE in
+// gen_variable_type.py attach a Rematerializer to their output: a recipe
+// that saves the inputs of the op and calls it again. The first time the
+// output is saved for backward (by the op itself or by a later op), the
+// recipe decides whether to keep it: outputs are kept as long as the outputs
+// kept so far fit in the memory budget, and the others are dropped. A
+// SavedVariable of a dropped output doesn't keep the tensor, and recomputes
+// it when it is unpacked. The recomputed tensor is cached until each of the
+// SavedVariables of the output held by backward functions either unpacked it
+// or was released, so that it is recomputed once per backward pass even if
+// several backward functions need it. The recipes that take the output as an
+// input don't keep it cached, as they may never recompute. Nothing is
+// recomputed while the output itself is still alive.
+//
+// The inputs of a recipe are SavedVariables too, so a chain of recomputable
+// ops only keeps the input of the chain. They are version checked like any
+// other saved tensor: an input that is modified in-place after the forward
+// can't be used to recompute, and unpacking throws the usual error.
+//
+// Usage:
+//   RematerializationMode::set_enabled(true);
+//   RematerializationMode::set_memory_budget(/* bytes */ 0);
+//   loss = model(input); loss.backward();
+//   auto stats = RematerializationMode::stats();
+
+struct TORCH_API RematerializationStats {
+  // Outputs not kept by their SavedVariables, and their size
+  int64_t rematerialized_tensors = 0;
+  int64_t rematerialized_bytes = 0;
+  // Size of the recomputable outputs currently kept in the budget
+  int64_t kept_bytes = 0;
+  int64_t recomputations = 0;
+  int64_t recompute_time_ns = 0;
+};
+
+struct TORCH_API RematerializationMode {
+  static bool is_enabled() {
+    return _enabled;
+  }
+  static void set_enabled(bool enabled) {
+    _enabled = enabled;
+  }
+  // Bytes of recomputable outputs that are kept rather than recomputed, 0 to
+  // recompute all of them
+  static int64_t memory_budget() {
+    return _memory_budget;
+  }
+  static void set_memory_budget(int64_t memory_budget);
+
+  static RematerializationStats stats();
+  // Resets the counters, but not kept_bytes which tracks live tensors
+  static void reset_stats();
+
+private:
+  static bool _enabled;
+  static std::atomic<int64_t> _memory_budget;
+};
+
+struct RematerializerUse;
+
+struct TORCH_API Rematerializer {
+  using Recipe = std::function<at::Tensor(const variable_list&)>;
+
+  Rematerializer(
+      const char* name,
+      const variable_list& inputs,
+      Recipe recipe,
+      const Variable& output);
+  ~Rematerializer();
+
+  // Called when output is saved for backward. Decides whether the output is
+  // kept the first time it is called, and returns true if it isn't. Returns
+  // false if output was modified in-place since the recipe was created.
+  bool should_rematerialize(const Variable& output);
+
+  // Returns the output if it is still alive, or else recomputes it. The
+  // recomputed tensor is dropped once all the uses unpacked it.
+  at::Tensor get(RematerializerUse& use);
+
+  const char* name() const {
+    return name_;
+  }
+
+ private:
+  friend struct RematerializerUse;
+  void add_use(RematerializerUse& use);
+  void remove_use(RematerializerUse& use);
+
+  const char* name_;
+  std::vector<SavedVariable> inputs_;
+  Recipe recipe_;
+  c10::weak_intrusive_ptr<at::TensorImpl, at::UndefinedTensorImpl> output_;
+  const uint32_t output_version_;
+  const int64_t output_nbytes_;
+
+  std::mutex mutex_;
+  bool decided_ = false;
+  bool kept_ = false;
+  at::Tensor data_;
+  // Bumped every time the output is recomputed
+  uint64_t generation_ = 0;
+  // Uses of backward functions; the recipes using the output as an input
+  // only unpack it when they recompute, which they may never do
+  int64_t num_uses_ = 0;
+  // Uses that didn't unpack data_ yet
+  int64_t num_pending_uses_ = 0;
+};
+
+// A SavedVariable of the output of a Rematerializer
+struct TORCH_API RematerializerUse {
+  explicit RematerializerUse(std::shared_ptr<Rematerializer> rematerializer);
+  ~RematerializerUse();
+  RematerializerUse(const RematerializerUse&) = delete;
+  RematerializerUse& operator=(const RematerializerUse&) = delete;
+
+  at::Tensor get() {
+    return rematerializer->get(*this);
+  }
+
+  const std::shared_ptr<Rematerializer> rematerializer;
+  // Generation of the recomputed output this use unpacked last
+  uint64_t generation = 0;
+  // Whether the recomputed output is kept until this use unpacks it, false
+  // for the inputs of a recipe
+  bool tracked = true;
+};
+
+namespace impl {
+  // Recipe attached to the variable, nullptr if there is none
+  TORCH_API std::shared_ptr<Rematerializer> rematerializer(const Variable&);
+  TORCH_API void set_rematerializer(
+      const Variable&,
+      std::shared_ptr<Rematerializer> rematerializer);
+}
+
+}} // namespace torch::autograd
@@ -4,6 +4,7 @@
 #include <torch/csrc/autograd/function.h>
 #include <torch/csrc/autograd/variable.h>
 #include <torch/csrc/autograd/anomaly_mode.h>
+#include <torch/csrc/autograd/rematerialization.h>
 
 #include <ATen/Tensor.h>
 
@@ -23,7 +24,17 @@ SavedVariable::SavedVariable(const Variable& variable, bool is_output, bool is_i
     is_inplace_view_ = is_inplace_view;
     // These copies are all shared_ptr copies, so slightly more expensive.
     // Do them here instead of in the init list in case data is undefined.
-    data_ = variable.tensor_data();
+    // The rematerializer of a kept output is saved too, as it accounts for
+    // its size in the memory budget until it is released.
+    if (auto rematerializer = impl::rematerializer(variable)) {
+      const bool rematerialize = rematerializer->should_rematerialize(variable);
+      rematerializer_ = std::make_shared<RematerializerUse>(std::move(rematerializer));
+      if (!rematerialize) {
+        data_ = variable.tensor_data();
+      }
+    } else {
+      data_ = variable.tensor_data();
+    }
     if (variable.is_leaf()) {
       grad_accumulator_ = impl::grad_accumulator(variable);
     } else if (!is_output) {
@@ -37,7 +48,7 @@ SavedVariable::SavedVariable(const Variable& variable, bool is_output, bool is_i
 }
 
 Variable SavedVariable::unpack(std::shared_ptr<Node> saved_for) const {
-  if (!data_.defined()) {
+  if (!data_.defined() && !rematerializer_) {
     if (!was_default_constructed_) {
       throw std::runtime_error(ERR_BACKWARD_TWICE);
     }
@@ -57,8 +68,10 @@ Variable SavedVariable::unpack(std::shared_ptr<Node> saved_for) const {
   if (saved_version_ != version_counter_.current_version()) {
     std::stringstream message;
     message << "one of the variables needed for gradient computation has been "
-        "modified by an inplace operation: [" << data_.toString() << " "
-        << data_.sizes() << "]";
+        "modified by an inplace operation";
+    if (data_.defined()) {
+      message << ": [" << data_.toString() << " " << data_.sizes() << "]";
+    }
     if (grad_fn) {
         message << ", which is output " << output_nr_
             << " of " << grad_fn->name() << ",";
@@ -81,11 +94,12 @@ Variable SavedVariable::unpack(std::shared_ptr<Node> saved_for) const {
   // NB: saved views are unpacked as normal Variables (not views) even though
   // they still share the same storage. This works only because we never call
   // in-place functions on unpacked variables.
+  const auto& data = data_.defined() ? data_ : rematerializer_->get();
   Variable var;
   if (grad_fn) {
-    var = make_variable(data_, Edge(std::move(grad_fn), output_nr_));
+    var = make_variable(data, Edge(std::move(grad_fn), output_nr_));
   } else {
-    var = make_variable(data_, requires_grad_);
+    var = make_variable(data, requires_grad_);
   }
   impl::set_version_counter(var, saved_version_);
 
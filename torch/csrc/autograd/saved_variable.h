@@ -11,6 +11,8 @@ namespace torch { namespace autograd {
 
 using Variable = at::Tensor;
 struct Node;
+struct Rematerializer;
+struct RematerializerUse;
 
 TORCH_API extern const char* ERR_BACKWARD_TWICE;
 
@@ -29,7 +31,8 @@ class TORCH_API SavedVariable {
   Variable unpack(std::shared_ptr<Node> saved_for = nullptr) const;
 
   void reset_data() {
-    return data_.reset();
+    data_.reset();
+    rematerializer_.reset();
   }
 
   void reset_grad_function() {
@@ -37,7 +40,12 @@ class TORCH_API SavedVariable {
   }
 
  private:
+  friend struct Rematerializer;
+
   at::Tensor data_;
+  // Set if the variable was saved as the output of a recomputable op, see
+  // Note [Rematerialization]. data_ is undefined if it is recomputed.
+  std::shared_ptr<RematerializerUse> rematerializer_;
 
   // The gradient function associated with this node. If has_grad_fn
   // is false, then this is a leaf node. Note that the grad_fn is not saved if
@@ -99,6 +99,7 @@ struct Node;
 
 struct AutogradMeta;
 struct DifferentiableViewMeta;
+struct Rematerializer;
 
 // Private-ish functions for manipulating variables; we don't want to put them
 // on Tensor proper
@@ -210,6 +211,10 @@ struct TORCH_API AutogradMeta : public c10::AutogradMetaInterface {
   // correctly when this variable is passed to another function.
   uint32_t output_nr_;
 
+  // Recipe to recompute this variable instead of saving it for backward, see
+  // Note [Rematerialization]
+  std::shared_ptr<Rematerializer> rematerializer_;
+
   // Mutex to ensure that concurrent read operations that modify internal
   // state are still thread-safe. Used by grad_fn() and
   // grad_accumulator().
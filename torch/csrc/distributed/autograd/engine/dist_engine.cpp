@@ -16,11 +16,7 @@ using torch::autograd::Engine;
 using torch::autograd::FutureVariableList;
 using torch::autograd::GraphRoot;
 using torch::autograd::GraphTask;
-using torch::autograd::GraphTaskGuard;
-using torch::autograd::InputBuffer;
 using torch::autograd::Node;
-using torch::autograd::NodeTask;
-using torch::autograd::ReadyQueue;
 using torch::autograd::validate_outputs;
 using torch::autograd::variable_list;
 
@@ -124,8 +120,8 @@ void DistEngine::computeDependencies(
 
   // Build the graph task and graph root.
   // NOTE: we don't need to build and pass a cpu_ready_queue to GraphTask
-  // as we use execute_graph_task_until_ready_queue_empty, which will build
-  // a separate ReadyQueue for each call.
+  // as the local engine creates one when it first runs the GraphTask on its
+  // CPU worker pool.
   auto graphTask = std::make_shared<GraphTask>(
       /* keep_graph */ retainGraph,
       /* create_graph */ false,
@@ -250,59 +246,6 @@ void DistEngine::computeDependencies(
   autogradContext->setGraphTask(std::move(graphTask));
 }
 
-void DistEngine::execute_graph_task_until_ready_queue_empty(
-    const std::shared_ptr<GraphTask>& graph_task,
-    std::shared_ptr<Node> root_to_execute,
-    bool incrementOutstandingTasks) {
-  engine_.initialize_device_threads_pool();
-  // Create a ready queue per call to traverse the graph_task from
-  // root_to_execute This allow concurrent execution of the same GraphTask from
-  // different threads
-  std::shared_ptr<ReadyQueue> cpu_ready_queue = std::make_shared<ReadyQueue>();
-  cpu_ready_queue->push(
-      NodeTask(graph_task, std::move(root_to_execute), InputBuffer(0)),
-      incrementOutstandingTasks);
-
-  torch::autograd::set_device(torch::autograd::CPU_DEVICE);
-  graph_task->owner_ = torch::autograd::CPU_DEVICE;
-  while (!cpu_ready_queue->empty()) {
-    std::shared_ptr<GraphTask> local_graph_task;
-    {
-      // Scope this block of execution since NodeTask is not needed after this
-      // block and can be deallocated (release any references to grad tensors
-      // as part of inputs_)
-      NodeTask task = cpu_ready_queue->pop();
-      if (!(local_graph_task = task.base_.lock())) {
-        continue;
-      }
-      if (task.fn_ && !local_graph_task->has_error_.load()) {
-        AutoGradMode grad_mode(local_graph_task->grad_mode_);
-        try {
-          GraphTaskGuard guard(local_graph_task);
-          engine_.evaluate_function(
-              local_graph_task, task.fn_.get(), task.inputs_, cpu_ready_queue);
-        } catch (std::exception& e) {
-          engine_.thread_on_exception(local_graph_task, task.fn_, e);
-          // break the loop in error so that we immediately stop the execution
-          // of this GraphTask, mark it completed if necessary and return the
-          // future with proper ErrorMessage
-          break;
-        }
-      }
-    }
-    // Decrement the outstanding task.
-    --local_graph_task->outstanding_tasks_;
-  }
-  // Check if we've completed execution.
-  if (graph_task->completed()) {
-    // We don't need to explicitly notify the owner thread, since
-    // 'mark_as_completed_and_run_post_processing' would mark the Future as
-    // completed and this would notify the owner thread that the task has been
-    // completed.
-    graph_task->mark_as_completed_and_run_post_processing();
-  }
-}
-
 std::shared_ptr<rpc::FutureMessage> DistEngine::runEngineAndAccumulateGradients(
     const ContextPtr& autogradContext,
     const std::shared_ptr<Node>& graphRoot,
@@ -313,12 +256,11 @@ std::shared_ptr<rpc::FutureMessage> DistEngine::runEngineAndAccumulateGradients(
   // passes ran into errors.
   autogradContext->clearOutstandingRpcs();
   auto graphTask = autogradContext->retrieveGraphTask();
-  at::launch([this, graphTask, graphRoot, incrementOutstandingTasks]() {
-    execute_graph_task_until_ready_queue_empty(
-        /*graph_task*/ graphTask,
-        /*root_to_execute*/ graphRoot,
-        /*incrementOutstandingTasks*/ incrementOutstandingTasks);
-  });
+  // The CPU worker pool of the local engine runs the graph task, so that no
+  // thread is blocked for the duration of the backward pass. We don't keep
+  // the returned future, see the use_count check in cleanupBackwardPass.
+  engine_.execute_on_cpu_worker_pool(
+      graphTask, graphRoot, incrementOutstandingTasks);
   // Use a reference here to avoid refcount bump on futureGrads.
   auto& futureGrads = graphTask->future_result_;
 
@@ -429,12 +371,8 @@ std::shared_ptr<rpc::FutureMessage> DistEngine::executeSendFunctionAsync(
   } else {
     lock.unlock();
     auto graphTask = autogradContext->retrieveGraphTask();
-    at::launch([this, graphTask, sendFunction]() {
-      execute_graph_task_until_ready_queue_empty(
-          /*graph_task*/ graphTask,
-          /*root_to_execute*/ sendFunction,
-          /*incrementOutstandingTasks*/ false);
-    });
+    engine_.execute_on_cpu_worker_pool(
+        graphTask, sendFunction, /*incrementOutstandingTasks*/ false);
     return std::make_shared<rpc::FutureMessage>(rpc::Message());
   }
 }
@@ -88,17 +88,12 @@ class TORCH_API DistEngine {
       torch::autograd::edge_list& outputEdges,
       bool retainGraph);
 
-  // Given a pre-populated GraphTask and a root node, compute the backward pass
-  // for the autograd graph until the graph task ready queue is empty.
-  //
-  // This method assumes that the appropriate GraphTask has already been
-  // initialized appropriately. It will construct a local ready queue to
-  // traverse the GraphTask instead of using the GraphTask embedded
-  // cpu_ready_queue, this is because dist engine might run the same GraphTask
-  // from different SendFunctions concurrently in different threads. The method
-  // will only mark the GraphTask as completed when it needes to, which means it
-  // might not mark as completed for every call as dist engine would like to
-  // keep the GraphTask alive when it not receives all gradients.
+  // Run the local autograd engine using the provided graphTask and graphRoot
+  // and accumulate the gradients part 'outputEdges' in the provided autograd
+  // context. The graph task is run by the CPU worker pool of the local
+  // engine, it may already be running there from other roots (i.e.
+  // SendFunctions) and it is only marked as completed once all the roots are
+  // done.
   //
   // When `incrementOutstandingTasks=false`, the function does not increment
   // 'outstanding_tasks_' in the appropriate GraphTask. It is assumed we've
@@ -107,25 +102,6 @@ class TORCH_API DistEngine {
   // case where we need to increment 'outstanding_tasks_' first to indicate the
   // local autograd engine the graph task is not completed until it receives the
   // signals from other workers over the network.
-  //
-  // XXX: calling this function assumes that we will have NO GPU nodetasks be
-  // executed for the graph_task, the caller of this function need to ensure
-  // this otherwise there will be undefined behaviors. A correct way to fix this
-  // is to re-design the autograd engine so that GPU worker thread to behave the
-  // same as CPU caller thread, record the operation/thread for the device, and
-  // reuse it in backward.
-  // TODO: 1. Add assert in the dist engine to ensure no GPU NodeTasks during
-  // backward
-  //       2. properly setup the thread local ready queue to enable reentrant
-  //       backwards
-  void execute_graph_task_until_ready_queue_empty(
-      const std::shared_ptr<torch::autograd::GraphTask>& graph_task,
-      std::shared_ptr<torch::autograd::Node> root_to_execute,
-      bool incrementOutstandingTasks = true);
-
-  // Run the local autograd engine using the provided graphTask and graphRoot
-  // and accumulate the gradients part 'outputEdges' in the provided autograd
-  // context.
   std::shared_ptr<rpc::FutureMessage> runEngineAndAccumulateGradients(
       const ContextPtr& autogradContext,
       const std::shared_ptr<torch::autograd::Node>& graphRoot,
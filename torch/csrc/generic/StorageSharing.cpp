@@ -14,6 +14,8 @@ static PyObject * THPStorage_(sharedDecref)(THPStorage *self, PyObject *noargs)
   THManagedMapAllocator *ctx = THManagedMapAllocator::fromDataPtr(storage->data_ptr());
   if (ctx) {
     ctx->decref();
+  } else {
+    torch::decrefSharedMemoryPoolBlock(storage->data_ptr());
   }
 #endif
   Py_INCREF(self);
@@ -212,6 +214,74 @@ static PyObject * THPStorage_(newSharedFd)(PyObject *_unused, PyObject *args)
   END_HANDLE_TH_ERRORS
 }
 
+// See Note [Shared memory pool]
+static PyObject * THPStorage_(pyNewPooledStorage)(PyObject *_unused, PyObject *args)
+{
+  HANDLE_TH_ERRORS
+  long long size;
+  if (!PyArg_ParseTuple(args, "L", &size)) {
+    return nullptr;
+  }
+  return THPStorage_(New)(THWStorage_(newWithDataAndAllocator)(
+      torch::allocateFromSharedMemoryPool(size * sizeof(scalar_t)), size, /* allocator */ nullptr));
+  END_HANDLE_TH_ERRORS
+}
+
+// Returns None if the storage isn't a block of the shared memory pool of this
+// process; the caller sends the file descriptor only if it isn't -1
+static PyObject * THPStorage_(sharePooled)(THPStorage *self, PyObject *noargs)
+{
+  HANDLE_TH_ERRORS
+  THWStorage *storage = self->cdata;
+  auto handle = torch::shareSharedMemoryPoolBlock(storage->data_ptr());
+  if (!handle) {
+    Py_RETURN_NONE;
+  }
+
+  THPObjectPtr name(PyBytes_FromString(handle->name.c_str()));
+  if (!name) return nullptr;
+  THPObjectPtr fd(PyLong_FromLong(handle->fd));
+  if (!fd) return nullptr;
+  THPObjectPtr segment_size(PyLong_FromSize_t(handle->segment_size));
+  if (!segment_size) return nullptr;
+  THPObjectPtr size(PyLong_FromLong(storage->nbytes() / sizeof(scalar_t)));
+  if (!size) return nullptr;
+
+  THPObjectPtr tuple(PyTuple_New(4));
+  if (!tuple) return nullptr;
+  PyTuple_SET_ITEM(tuple.get(), 0, name.release());
+  PyTuple_SET_ITEM(tuple.get(), 1, fd.release());
+  PyTuple_SET_ITEM(tuple.get(), 2, segment_size.release());
+  PyTuple_SET_ITEM(tuple.get(), 3, size.release());
+  return tuple.release();
+  END_HANDLE_TH_ERRORS
+}
+
+static PyObject * THPStorage_(newSharedPooled)(PyObject *_unused, PyObject *args)
+{
+  HANDLE_TH_ERRORS
+  THPUtils_assert(PyTuple_GET_SIZE(args) == 4, "tuple of 4 items expected");
+  PyObject *_name = PyTuple_GET_ITEM(args, 0);
+  PyObject *_fd = PyTuple_GET_ITEM(args, 1);
+  PyObject *_segment_size = PyTuple_GET_ITEM(args, 2);
+  PyObject *_size = PyTuple_GET_ITEM(args, 3);
+  if (!PyBytes_Check(_name) || !THPUtils_checkLong(_fd) ||
+      !THPUtils_checkLong(_segment_size) || !THPUtils_checkLong(_size)) {
+    THPUtils_invalidArguments(args, nullptr, "_new_shared_pooled", 1,
+        "a segment name (bytes), a file descriptor (int), a segment size (int) and storage size (int)");
+    return nullptr;
+  }
+  std::string name = PyBytes_AS_STRING(_name);
+  int fd = (int) THPUtils_unpackLong(_fd);
+  size_t segment_size = (size_t) THPUtils_unpackLong(_segment_size);
+  int64_t size = THPUtils_unpackLong(_size);
+  return THPStorage_(New)(
+          THWStorage_(newWithDataAndAllocator)(
+            torch::receiveSharedMemoryPoolBlock(name, fd, segment_size),
+            size, /* allocator */ nullptr));
+  END_HANDLE_TH_ERRORS
+}
+
 #else // THC_GENERIC_FILE
 
 static PyObject * THPStorage_(shareCuda)(THPStorage *self, PyObject *noargs)
@@ -518,7 +588,8 @@ PyObject * THPStorage_(isShared)(THPStorage *self, PyObject *noargs)
   Py_RETURN_TRUE;
 #else
   if (THMapAllocator::fromDataPtr(self->cdata->data_ptr()) ||
-      THManagedMapAllocator::fromDataPtr(self->cdata->data_ptr())) {
+      THManagedMapAllocator::fromDataPtr(self->cdata->data_ptr()) ||
+      torch::isSharedMemoryPoolBlock(self->cdata->data_ptr())) {
     Py_RETURN_TRUE;
   } else {
     Py_RETURN_FALSE;
@@ -539,6 +610,9 @@ static PyMethodDef THPStorage_(sharingMethods)[] = {
   {"_share_filename_", (PyCFunction)THPStorage_(shareFilename), METH_NOARGS, nullptr},
   {"_new_shared_filename", (PyCFunction)(void(*)(void))THPStorage_(newSharedFilename), METH_VARARGS | METH_STATIC, nullptr},
   {"_new_using_filename", (PyCFunction)(void(*)(void))THPStorage_(pyNewFilenameStorage), METH_VARARGS | METH_STATIC, nullptr},
+  {"_new_pooled", (PyCFunction)(void(*)(void))THPStorage_(pyNewPooledStorage), METH_VARARGS | METH_STATIC, nullptr},
+  {"_share_pooled_", (PyCFunction)THPStorage_(sharePooled), METH_NOARGS, nullptr},
+  {"_new_shared_pooled", (PyCFunction)(void(*)(void))THPStorage_(newSharedPooled), METH_VARARGS | METH_STATIC, nullptr},
 #endif
   {"_weak_ref", (PyCFunction)THPStorage_(weakRef), METH_NOARGS, nullptr},
   {"_free_weak_ref", (PyCFunction)(void(*)(void))THPStorage_(freeWeakRef), METH_O | METH_STATIC, nullptr},
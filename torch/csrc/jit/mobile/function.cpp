@@ -60,7 +60,56 @@ void Function::set_register_size(size_t size) {
   code_->register_size_ = size;
 }
 
+void Function::set_memory_plan(
+    const std::vector<std::pair<int64_t, int64_t>>& plan) {
+  if (plan.empty()) {
+    return;
+  }
+  const int64_t num_instructions = code_->instructions_.size();
+  code_->memory_plan_.assign(num_instructions, -1);
+  int64_t num_slots = 0;
+  for (const auto& entry : plan) {
+    TORCH_CHECK(
+        entry.first >= 0 && entry.first < num_instructions &&
+            code_->instructions_[entry.first].op == OP && entry.second >= 0,
+        "Invalid memory plan entry (",
+        entry.first,
+        ", ",
+        entry.second,
+        ") in function ",
+        name_.qualifiedName());
+    code_->memory_plan_[entry.first] = entry.second;
+    num_slots = std::max(num_slots, entry.second + 1);
+  }
+  code_->memory_arena_ = std::make_shared<MemoryArena>(num_slots);
+}
+
+size_t Function::memory_arena_size() const {
+  return code_->memory_arena_ ? code_->memory_arena_->size() : 0;
+}
+
+void Function::set_lazy_loader(std::function<void(Function&)> loader) {
+  lazy_loader_ = std::move(loader);
+}
+
 bool Function::run(Stack& stack) const {
+  if (lazy_loader_) {
+    // Loading only fills in code_, which is logically part of the
+    // function's state from the start.
+    std::call_once(lazy_loaded_, [this]() {
+      auto& self = const_cast<Function&>(*this);
+      // Load into a fresh Code, so that a loader that throws halfway doesn't
+      // leave a partly filled one behind for the next run to append to.
+      auto empty_code = std::move(self.code_);
+      self.code_ = std::make_shared<Code>();
+      try {
+        lazy_loader_(self);
+      } catch (...) {
+        self.code_ = std::move(empty_code);
+        throw;
+      }
+    });
+  }
   InterpreterState interp_state(code_);
   return interp_state.run(stack);
 }
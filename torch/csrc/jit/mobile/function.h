@@ -1,6 +1,8 @@
 #pragma once
 #include <ATen/core/ivalue.h>
 //#include <aten/src/Aten/core/operator_name.h>
+#include <functional>
+#include <mutex>
 #include <vector>
 
 namespace torch {
@@ -25,10 +27,22 @@ class Function {
   void append_type(const c10::TypePtr& type);
 
   void set_register_size(size_t size);
+  // Installs the ahead-of-time memory plan: a list of (instruction index,
+  // arena slot) pairs for OP instructions whose outputs are served from the
+  // function's memory arena.
+  void set_memory_plan(const std::vector<std::pair<int64_t, int64_t>>& plan);
+  // Bytes currently reserved by the memory arena, 0 without a memory plan.
+  size_t memory_arena_size() const;
+  // Defers populating the function until it is first run. `loader` is called
+  // with this function as argument before the first run, and again before
+  // the next run if it throws; it succeeds at most once.
+  void set_lazy_loader(std::function<void(Function&)> loader);
 
  private:
   c10::QualifiedName name_;
   std::shared_ptr<Code> code_;
+  std::function<void(Function&)> lazy_loader_;
+  mutable std::once_flag lazy_loaded_;
 };
 
 } // namespace mobile
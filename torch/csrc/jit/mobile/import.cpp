@@ -1,13 +1,16 @@
 #include <torch/csrc/jit/mobile/import.h>
 #include <ATen/core/ivalue.h>
 #include <caffe2/serialize/inline_container.h>
+#include <caffe2/serialize/mmap_file_adapter.h>
 #include <torch/csrc/jit/api/compilation_unit.h>
+#include <torch/csrc/jit/mobile/observer.h>
 #include <torch/csrc/jit/mobile/type_parser.h>
 #include <torch/csrc/jit/runtime/instruction.h>
 #include <torch/csrc/jit/serialization/import_export_constants.h>
 #include <torch/csrc/jit/serialization/unpickler.h>
 #include <torch/custom_class.h>
 
+#include <chrono>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -28,7 +31,11 @@
 //       ('RET', 0, 0))),
 //     ('operators', (('_aten::add', 'Tensor'), ('_aten::add', 'Scalar'))),
 //     ('constants', (1, 4)),
-//     ('register_size', 2))),)
+//     ('register_size', 2),
+//     ('memory_plan', ((5, 0), (8, 1))))),)
+//
+// 'memory_plan' is optional; it lists (instruction index, arena slot) pairs
+// for operators whose outputs can be served from a per-function arena.
 
 // Note that currently the backward compatibility is not supported by bytecode.
 // This format and process need to be revisted and redesigned if we want to
@@ -82,72 +89,131 @@ void print_unsupported_ops_and_throw(
   TORCH_CHECK(false, "Following ops cannot be found:", error_message);
 }
 
-void parseMethods(
-    const std::vector<IValue>& vals,
-    mobile::CompilationUnit& mcu) {
-  for (const auto& element : vals) {
-    const auto& m_tuple = element.toTuple()->elements();
-    const std::string& function_name = m_tuple[0].toStringRef();
-    IValue table = m_tuple[1];
+// Reports the wall time of a stage of loading to the module observer, if
+// one is installed.
+class LoadStageTimer {
+ public:
+  explicit LoadStageTimer(std::string stage)
+      : observer_(torch::observerConfig().getModuleObserver()),
+        stage_(std::move(stage)) {
+    if (observer_) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
 
-    auto function = std::unique_ptr<mobile::Function>(
-        new mobile::Function(c10::QualifiedName(function_name)));
+  ~LoadStageTimer() {
+    if (observer_) {
+      auto duration = std::chrono::steady_clock::now() - start_;
+      observer_->onLoadStage(
+          stage_,
+          std::chrono::duration_cast<std::chrono::microseconds>(duration)
+              .count());
+    }
+  }
 
-    const auto& ins_list =
-        expect_field(table, "instructions", BYTECODE_INDEX_INSTRUCTION)
-            .toTuple()
-            ->elements();
-    const auto& ops_list =
-        expect_field(table, "operators", BYTECODE_INDEX_OPERATOR)
-            .toTuple()
-            ->elements();
-    const auto& consts_list =
-        expect_field(table, "constants", BYTECODE_INDEX_CONSTANT)
-            .toTuple()
-            ->elements();
-    const auto& types_list =
-        expect_field(table, "types", BYTECODE_INDEX_TYPE).toTuple()->elements();
-    const auto& register_size = expect_field(table, "register_size", 4).toInt();
+ private:
+  MobileModuleObserver* observer_;
+  std::string stage_;
+  std::chrono::steady_clock::time_point start_;
+};
 
-    for (const auto& ins : ins_list) {
-      auto ins_item = ins.toTuple()->elements();
-      TORCH_CHECK(
-          ins_item.size() == 3,
-          "There should be three parts in an instruction.");
-      OpCode op_code = parseOpCode(ins_item[0].toString()->string().c_str());
-      int X = ins_item[1].toInt();
-      int N = ins_item[2].toInt();
-      function->append_instruction(op_code, X, N);
-    }
+void parseMethod(const IValue& table, mobile::Function* function) {
+  const auto& ins_list =
+      expect_field(table, "instructions", BYTECODE_INDEX_INSTRUCTION)
+          .toTuple()
+          ->elements();
+  const auto& ops_list =
+      expect_field(table, "operators", BYTECODE_INDEX_OPERATOR)
+          .toTuple()
+          ->elements();
+  const auto& consts_list =
+      expect_field(table, "constants", BYTECODE_INDEX_CONSTANT)
+          .toTuple()
+          ->elements();
+  const auto& types_list =
+      expect_field(table, "types", BYTECODE_INDEX_TYPE).toTuple()->elements();
+  const auto& register_size =
+      expect_field(table, "register_size", BYTECODE_INDEX_REGISTER_SIZE)
+          .toInt();
+
+  for (const auto& ins : ins_list) {
+    auto ins_item = ins.toTuple()->elements();
+    TORCH_CHECK(
+        ins_item.size() == 3, "There should be three parts in an instruction.");
+    OpCode op_code = parseOpCode(ins_item[0].toString()->string().c_str());
+    int X = ins_item[1].toInt();
+    int N = ins_item[2].toInt();
+    function->append_instruction(op_code, X, N);
+  }
 
-    std::unordered_set<std::string> unsupported_op_names;
-    for (const auto& op : ops_list) {
-      auto op_item = op.toTuple()->elements();
-      TORCH_CHECK(
-          op_item.size() == 2,
-          "There should be two parts in an operator name.");
-      auto op_found = function->append_operator(
-          op_item[0].toString()->string(), op_item[1].toString()->string());
-      if (!op_found) {
-        unsupported_op_names.emplace(operator_str(
-            op_item[0].toString()->string(), op_item[1].toString()->string()));
-      }
+  std::unordered_set<std::string> unsupported_op_names;
+  for (const auto& op : ops_list) {
+    auto op_item = op.toTuple()->elements();
+    TORCH_CHECK(
+        op_item.size() == 2, "There should be two parts in an operator name.");
+    auto op_found = function->append_operator(
+        op_item[0].toString()->string(), op_item[1].toString()->string());
+    if (!op_found) {
+      unsupported_op_names.emplace(operator_str(
+          op_item[0].toString()->string(), op_item[1].toString()->string()));
     }
+  }
 
-    if (!unsupported_op_names.empty()) {
-      print_unsupported_ops_and_throw(unsupported_op_names);
-    };
+  if (!unsupported_op_names.empty()) {
+    print_unsupported_ops_and_throw(unsupported_op_names);
+  };
 
-    for (const auto& constant : consts_list) {
-      function->append_constant(constant);
-    }
+  for (const auto& constant : consts_list) {
+    function->append_constant(constant);
+  }
+
+  for (const auto& t : types_list) {
+    function->append_type(c10::parseType(t.toStringRef()));
+  }
 
-    for (const auto& t : types_list) {
-      function->append_type(c10::parseType(t.toStringRef()));
+  function->set_register_size(register_size);
+
+  if (table.toTuple()->elements().size() > BYTECODE_INDEX_MEMORY_PLAN) {
+    const auto& plan_list =
+        expect_field(table, "memory_plan", BYTECODE_INDEX_MEMORY_PLAN)
+            .toTuple()
+            ->elements();
+    std::vector<std::pair<int64_t, int64_t>> plan;
+    plan.reserve(plan_list.size());
+    for (const auto& entry : plan_list) {
+      auto entry_item = entry.toTuple()->elements();
+      TORCH_CHECK(
+          entry_item.size() == 2,
+          "There should be two parts in a memory plan entry.");
+      plan.emplace_back(entry_item[0].toInt(), entry_item[1].toInt());
     }
+    function->set_memory_plan(plan);
+  }
+}
 
-    function->set_register_size(register_size);
+// Registers the methods of the bytecode archive with `mcu`. With `lazy`,
+// each method is only parsed, and its operators resolved, when it is first
+// run; otherwise all methods are parsed, and unsupported operators reported,
+// here.
+void parseMethods(
+    const std::vector<IValue>& vals,
+    mobile::CompilationUnit& mcu,
+    bool lazy) {
+  for (const auto& element : vals) {
+    const auto& m_tuple = element.toTuple()->elements();
+    const std::string& function_name = m_tuple[0].toStringRef();
+    IValue table = m_tuple[1];
 
+    auto function = std::unique_ptr<mobile::Function>(
+        new mobile::Function(c10::QualifiedName(function_name)));
+    if (lazy) {
+      function->set_lazy_loader([table](mobile::Function& fn) {
+        LoadStageTimer timer("parse_method:" + fn.qualname().qualifiedName());
+        parseMethod(table, &fn);
+      });
+    } else {
+      parseMethod(table, function.get());
+    }
     mcu.register_function(std::move(function));
   }
 }
@@ -156,16 +222,24 @@ void parseMethods(
 class BytecodeDeserializer final {
  public:
   explicit BytecodeDeserializer(std::unique_ptr<PyTorchStreamReader> reader);
+  // Reads uncompressed records in place from `mapping`, the memory mapped
+  // archive, and defers parsing methods until their first call.
+  BytecodeDeserializer(
+      std::unique_ptr<PyTorchStreamReader> reader,
+      std::shared_ptr<void> mapping);
   mobile::Module deserialize(c10::optional<at::Device> device);
 
  private:
   c10::IValue readArchive(
       const std::string& archive_name,
       std::shared_ptr<mobile::CompilationUnit> mcu);
+  // Returns the record data and size, aliasing the mapping if possible.
+  std::tuple<at::DataPtr, size_t> getRecord(const std::string& name);
   std::shared_ptr<CompilationUnit> compilation_unit_;
   std::unordered_set<std::string> imported_libs_;
   std::unique_ptr<PyTorchStreamReader> reader_;
   c10::optional<at::Device> device_;
+  std::shared_ptr<void> mapping_;
 };
 
 BytecodeDeserializer::BytecodeDeserializer(
@@ -173,14 +247,56 @@ BytecodeDeserializer::BytecodeDeserializer(
     : compilation_unit_(std::make_shared<CompilationUnit>()),
       reader_(std::move(reader)) {}
 
+BytecodeDeserializer::BytecodeDeserializer(
+    std::unique_ptr<PyTorchStreamReader> reader,
+    std::shared_ptr<void> mapping)
+    : compilation_unit_(std::make_shared<CompilationUnit>()),
+      reader_(std::move(reader)),
+      mapping_(std::move(mapping)) {}
+
 mobile::Module BytecodeDeserializer::deserialize(
     c10::optional<at::Device> device) {
   device_ = device;
+  auto observer = torch::observerConfig().getModuleObserver();
+  if (observer) {
+    observer->onEnterLoadModel();
+  }
   auto mcu = std::make_shared<mobile::CompilationUnit>();
-  auto bvals = readArchive("bytecode", mcu).toTuple()->elements();
-  parseMethods(bvals, *mcu);
+  {
+    std::vector<IValue> bvals;
+    {
+      LoadStageTimer timer("read_bytecode");
+      bvals = readArchive("bytecode", mcu).toTuple()->elements();
+    }
+    LoadStageTimer timer("parse_methods");
+    parseMethods(bvals, *mcu, /*lazy=*/mapping_ != nullptr);
+  }
+  c10::intrusive_ptr<c10::ivalue::Object> object;
+  {
+    LoadStageTimer timer("read_data");
+    object = readArchive("data", mcu).toObject();
+  }
+  if (observer) {
+    observer->onExitLoadModel();
+  }
+  return mobile::Module(std::move(object), mcu);
+}
 
-  return mobile::Module(readArchive("data", mcu).toObject(), mcu);
+std::tuple<at::DataPtr, size_t> BytecodeDeserializer::getRecord(
+    const std::string& name) {
+  if (mapping_) {
+    if (auto region = reader_->getUncompressedRecordRegion(name)) {
+      // The deleter context keeps the mapping alive as long as the data.
+      auto ctx = new std::shared_ptr<void>(mapping_);
+      at::DataPtr data_ptr(
+          static_cast<char*>(mapping_.get()) + region->first,
+          ctx,
+          [](void* ctx) { delete static_cast<std::shared_ptr<void>*>(ctx); },
+          at::kCPU);
+      return std::make_tuple(std::move(data_ptr), region->second);
+    }
+  }
+  return reader_->getRecord(name);
 }
 
 c10::IValue BytecodeDeserializer::readArchive(
@@ -190,7 +306,7 @@ c10::IValue BytecodeDeserializer::readArchive(
   picklename << archive_name << ".pkl";
   at::DataPtr pickle_ptr;
   size_t pickle_size;
-  std::tie(pickle_ptr, pickle_size) = reader_->getRecord(picklename.str());
+  std::tie(pickle_ptr, pickle_size) = getRecord(picklename.str());
 
   size_t bytes_read = 0;
   auto data = reinterpret_cast<const char*>(pickle_ptr.get());
@@ -264,7 +380,7 @@ c10::IValue BytecodeDeserializer::readArchive(
   auto read_record = [&](const std::string& name) {
     std::stringstream ss;
     ss << archive_name << "/" << name;
-    return std::get<0>(reader_->getRecord(ss.str()));
+    return std::get<0>(getRecord(ss.str()));
   };
 
   Unpickler unpickler(
@@ -302,5 +418,15 @@ mobile::Module _load_for_mobile(
   return deserializer.deserialize(device);
 }
 
+mobile::Module _load_for_mobile_mmap(
+    const std::string& filename,
+    c10::optional<at::Device> device) {
+  auto rai = torch::make_unique<MmapFileAdapter>(filename);
+  auto mapping = rai->mapping();
+  auto reader = torch::make_unique<PyTorchStreamReader>(std::move(rai));
+  BytecodeDeserializer deserializer(std::move(reader), std::move(mapping));
+  return deserializer.deserialize(device);
+}
+
 } // namespace jit
 } // namespace torch
@@ -5,11 +5,13 @@
 #include <memory>
 
 #include <caffe2/serialize/file_adapter.h>
+#include <caffe2/serialize/mmap_file_adapter.h>
 
 namespace torch {
 namespace jit {
 using caffe2::serialize::FileAdapter;
 using caffe2::serialize::IStreamAdapter;
+using caffe2::serialize::MmapFileAdapter;
 using caffe2::serialize::ReadAdapterInterface;
 
 TORCH_API mobile::Module _load_for_mobile(
@@ -23,5 +25,14 @@ TORCH_API mobile::Module _load_for_mobile(
 TORCH_API mobile::Module _load_for_mobile(
     std::unique_ptr<ReadAdapterInterface> rai,
     c10::optional<c10::Device> device = c10::nullopt);
+
+// Loads a mobile module from a memory mapped file. Tensor data and pickles
+// are used in place from the mapping instead of being copied out of the
+// archive, and each method is parsed on its first call, so unsupported
+// operators are only reported then. Modifying a tensor copies the affected
+// pages; the file itself is never written.
+TORCH_API mobile::Module _load_for_mobile_mmap(
+    const std::string& filename,
+    c10::optional<at::Device> device = c10::nullopt);
 } // namespace jit
 } // namespace torch
@@ -16,6 +16,15 @@ namespace mobile {
 InterpreterState::InterpreterState(std::shared_ptr<Code> code)
     : code_(std::move(code)) {
   registers_.resize(code_->register_size_);
+  if (code_->memory_arena_) {
+    // Only one run at a time can use the arena; concurrent runs of the same
+    // method allocate as usual.
+    arena_lock_ = std::unique_lock<std::mutex>(
+        code_->memory_arena_->mutex(), std::try_to_lock);
+    if (arena_lock_.owns_lock()) {
+      arena_ = code_->memory_arena_.get();
+    }
+  }
 }
 
 using namespace at;
@@ -56,7 +65,12 @@ bool InterpreterState::run(Stack& stack) {
         if (!prev_value) {
           enableRecordFunction(false);
         }
-        code_->operators_[inst.X](stack);
+        if (arena_ && code_->memory_plan_[pc] >= 0) {
+          MemoryArena::SlotGuard guard(*arena_, code_->memory_plan_[pc]);
+          code_->operators_[inst.X](stack);
+        } else {
+          code_->operators_[inst.X](stack);
+        }
         ++pc;
       } break;
       case OPN: {
@@ -148,6 +162,9 @@ bool InterpreterState::run(Stack& stack) {
         }
       } break;
       case RET:
+        if (arena_) {
+          arena_->finishRun();
+        }
         return false;
       case LIST_CONSTRUCT: {
         auto type = code_->types_[inst.X]->expect<at::ListType>();
@@ -2,8 +2,11 @@
 #include <ATen/core/dispatch/Dispatcher.h>
 #include <ATen/core/ivalue.h>
 #include <ATen/core/operator_name.h>
+#include <torch/csrc/jit/mobile/memory_arena.h>
 #include <torch/csrc/jit/runtime/instruction.h>
 
+#include <mutex>
+
 namespace torch {
 namespace jit {
 namespace mobile {
@@ -15,6 +18,10 @@ struct Code {
   std::vector<c10::IValue> constants_;
   std::vector<c10::TypePtr> types_;
   size_t register_size_; // Aggregated output size.
+  // Arena slot for the output of each instruction, -1 if unplanned. Empty
+  // if the function was exported without a memory plan.
+  std::vector<int64_t> memory_plan_;
+  std::shared_ptr<MemoryArena> memory_arena_;
 };
 
 struct InterpreterState {
@@ -25,6 +32,8 @@ struct InterpreterState {
   std::shared_ptr<Code> code_;
   c10::IValue& reg(size_t reg);
   std::vector<c10::IValue> registers_;
+  std::unique_lock<std::mutex> arena_lock_;
+  MemoryArena* arena_ = nullptr;
 };
 
 } // namespace mobile
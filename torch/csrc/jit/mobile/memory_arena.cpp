@@ -0,0 +1,138 @@
+#include <torch/csrc/jit/mobile/memory_arena.h>
+
+#include <c10/core/CPUAllocator.h>
+#include <c10/util/Exception.h>
+
+namespace torch {
+namespace jit {
+namespace mobile {
+
+namespace {
+// Slots are laid out at gAlignment boundaries. The tail padding keeps the
+// out-of-bounds reads that XNNPACK and QNNPACK kernels are allowed to do past
+// the last slot inside the buffer.
+constexpr size_t kArenaTailPadding = 64;
+
+size_t roundUp(size_t nbytes) {
+  return (nbytes + c10::gAlignment - 1) / c10::gAlignment * c10::gAlignment;
+}
+
+c10::Allocator* backingAllocator() {
+  // Not GetCPUAllocator(): that returns the arena itself while a
+  // SlotGuard is active.
+  return c10::GetAllocator(c10::DeviceType::CPU);
+}
+} // namespace
+
+struct MemoryArena::Buffer {
+  at::DataPtr data;
+  std::vector<size_t> offsets;
+  std::vector<size_t> capacities;
+  std::unique_ptr<std::atomic<bool>[]> in_use;
+  size_t nbytes = 0;
+};
+
+namespace {
+// Deleter context of tensors served from the arena. Holding the buffer keeps
+// it alive until the last such tensor is released, even if the arena has
+// been regrown or destroyed in the meantime.
+struct SlotContext {
+  std::shared_ptr<void> buffer;
+  std::atomic<bool>* in_use;
+};
+
+void releaseSlot(void* ctx) {
+  auto* slot_ctx = static_cast<SlotContext*>(ctx);
+  slot_ctx->in_use->store(false, std::memory_order_release);
+  delete slot_ctx;
+}
+
+// Arena and slot of the active SlotGuard on this thread, cleared by the
+// first allocation.
+thread_local MemoryArena* pending_arena = nullptr;
+thread_local size_t pending_slot = 0;
+} // namespace
+
+class MemoryArena::Allocator final : public c10::Allocator {
+ public:
+  at::DataPtr allocate(size_t nbytes) const override {
+    // Only the first allocation of a planned operator is its output; any
+    // further allocations are temporaries and go to the backing allocator.
+    MemoryArena* arena = pending_arena;
+    pending_arena = nullptr;
+    if (arena && nbytes > 0) {
+      return arena->allocateFromSlot(pending_slot, nbytes);
+    }
+    return backingAllocator()->allocate(nbytes);
+  }
+
+  at::DeleterFnPtr raw_deleter() const override {
+    return nullptr;
+  }
+};
+
+MemoryArena::MemoryArena(size_t num_slots) : required_(num_slots, 0) {}
+
+MemoryArena::~MemoryArena() = default;
+
+MemoryArena::SlotGuard::SlotGuard(MemoryArena& arena, int64_t slot)
+    : override_guard_([] {
+        static auto* allocator = new MemoryArena::Allocator();
+        return allocator;
+      }()) {
+  TORCH_INTERNAL_ASSERT(
+      slot >= 0 && static_cast<size_t>(slot) < arena.required_.size());
+  pending_arena = &arena;
+  pending_slot = slot;
+}
+
+MemoryArena::SlotGuard::~SlotGuard() {
+  pending_arena = nullptr;
+}
+
+at::DataPtr MemoryArena::allocateFromSlot(size_t slot, size_t nbytes) {
+  required_[slot] = std::max(required_[slot], nbytes);
+  if (buffer_ && nbytes <= buffer_->capacities[slot] &&
+      !buffer_->in_use[slot].exchange(true, std::memory_order_acquire)) {
+    void* ptr =
+        static_cast<char*>(buffer_->data.get()) + buffer_->offsets[slot];
+    auto* ctx = new SlotContext{buffer_, &buffer_->in_use[slot]};
+    return {ptr, ctx, &releaseSlot, at::Device(at::kCPU)};
+  }
+  return backingAllocator()->allocate(nbytes);
+}
+
+void MemoryArena::finishRun() {
+  bool grow = !buffer_;
+  for (size_t i = 0; !grow && i < required_.size(); ++i) {
+    grow = required_[i] > buffer_->capacities[i];
+  }
+  if (!grow) {
+    return;
+  }
+  auto buffer = std::make_shared<Buffer>();
+  buffer->offsets.resize(required_.size());
+  buffer->capacities.resize(required_.size());
+  buffer->in_use.reset(new std::atomic<bool>[required_.size()]);
+  size_t offset = 0;
+  for (size_t i = 0; i < required_.size(); ++i) {
+    buffer->offsets[i] = offset;
+    buffer->capacities[i] = roundUp(required_[i]);
+    buffer->in_use[i].store(false, std::memory_order_relaxed);
+    offset += buffer->capacities[i];
+  }
+  if (offset == 0) {
+    return;
+  }
+  buffer->nbytes = offset + kArenaTailPadding;
+  buffer->data = backingAllocator()->allocate(buffer->nbytes);
+  buffer_ = std::move(buffer);
+}
+
+size_t MemoryArena::size() const {
+  return buffer_ ? buffer_->nbytes : 0;
+}
+
+} // namespace mobile
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <c10/core/Allocator.h>
+#include <c10/core/CPUAllocator.h>
+#include <c10/macros/Macros.h>
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace torch {
+namespace jit {
+namespace mobile {
+
+// Serves the outputs of memory-planned operators from a single preallocated
+// buffer. The memory plan, computed at export time, gives every planned
+// operator a slot; operators whose outputs are never alive at the same time
+// share a slot and therefore share memory.
+//
+// Each slot owns a fixed range of the buffer. Slot sizes are learned from the
+// allocations a slot could not serve, and the buffer is regrown between runs
+// (see finishRun), so after the first run of a method with static shapes all
+// planned allocations are served from the arena. A slot is only handed out
+// while no tensor from an earlier allocation still refers to it; a tensor that
+// outlives its planned lifetime therefore stays valid and merely costs a
+// regular allocation on the next run.
+class TORCH_API MemoryArena final {
+ public:
+  explicit MemoryArena(size_t num_slots);
+  ~MemoryArena();
+
+  // Serves the first CPU allocation of the current thread made while the
+  // guard is alive from `slot` of `arena`.
+  class SlotGuard {
+   public:
+    SlotGuard(MemoryArena& arena, int64_t slot);
+    ~SlotGuard();
+
+   private:
+    c10::CPUAllocatorOverrideGuard override_guard_;
+  };
+
+  // Grows the buffer if any slot was too small during the last run.
+  void finishRun();
+
+  // Number of bytes currently reserved by the arena.
+  size_t size() const;
+  size_t num_slots() const {
+    return required_.size();
+  }
+
+  // Held by the interpreter for the duration of a run; concurrent runs of the
+  // same method fall back to the regular allocator.
+  std::mutex& mutex() {
+    return mutex_;
+  }
+
+ private:
+  struct Buffer;
+  // Storages remember the allocator that created them and may use it again
+  // to resize, possibly after the arena is gone. The allocator installed by
+  // SlotGuard is therefore a process-wide one that only consults the arena
+  // of the active guard.
+  class Allocator;
+
+  at::DataPtr allocateFromSlot(size_t slot, size_t nbytes);
+
+  std::mutex mutex_;
+  std::shared_ptr<Buffer> buffer_;
+  std::vector<size_t> required_;
+};
+
+} // namespace mobile
+} // namespace jit
+} // namespace torch
@@ -84,6 +84,14 @@ const std::vector<at::Tensor> Module::parameters() const {
   slot_params_recurse(object_, &params);
   return params;
 }
+
+size_t Module::memory_arena_size() const {
+  size_t total = 0;
+  for (const auto& method : cu_->methods()) {
+    total += method->memory_arena_size();
+  }
+  return total;
+}
 } // namespace mobile
 } // namespace jit
 } // namespace torch
@@ -38,6 +38,8 @@ class TORCH_API Module {
     return object_->slots();
   }
   const std::vector<at::Tensor> parameters() const;
+  // Total bytes reserved by the memory arenas of all memory-planned methods.
+  size_t memory_arena_size() const;
 
  private:
   c10::intrusive_ptr<c10::ivalue::Object> object_;
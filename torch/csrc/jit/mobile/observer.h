@@ -47,6 +47,12 @@ class MobileModuleObserver {
       const std::string& model_name,
       const std::string& method_name) {}
   virtual void onExit() {}
+  virtual void onEnterLoadModel() {}
+  // Wall time of a stage of loading a model, such as reading an archive or
+  // parsing the methods. Methods that are loaded lazily report their parsing
+  // stage on first use.
+  virtual void onLoadStage(const std::string& stage, int64_t duration_us) {}
+  virtual void onExitLoadModel() {}
 };
 
 class MobileObserverConfig {
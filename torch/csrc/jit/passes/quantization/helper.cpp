@@ -20,6 +20,7 @@ std::vector<std::string> _static_quantizable_call_funcs = {
     "linear",
     "batch_norm",
     "hardswish",
+    "softmax",
     "layer_norm",
     "group_norm",
     "instance_norm",
@@ -32,7 +33,9 @@ std::vector<std::string> _static_quantizable_aten_funcs = {
     "linear",
     "addmm",
     "matmul",
+    "bmm",
     "hardswish",
+    "softmax",
     "batch_norm",
     "layer_norm",
     "group_norm",
@@ -207,6 +207,33 @@ bool input_b_is_scalar(
   return isScalar(b_scalar);
 }
 
+// filter that checks the inputs of aten::matmul are supported by
+// quantized::matmul: aten::matmul also takes 1-D inputs and broadcasts the
+// batch dimensions, so we only fuse when the types show that both inputs have
+// the same rank, at least 2, and the same batch sizes
+bool matmul_inputs_are_supported(
+    const Match& match,
+    const std::unordered_map<std::string, Value*>& vmap) {
+  const auto& match_vmap = match.values_map;
+  auto a_type = match_vmap.at(vmap.at("a_dequant"))->type()->cast<TensorType>();
+  auto b_type = match_vmap.at(vmap.at("b_dequant"))->type()->cast<TensorType>();
+  if (!a_type || !b_type) {
+    return false;
+  }
+  auto dim = a_type->dim();
+  if (!dim || *dim < 2 || b_type->dim() != dim) {
+    return false;
+  }
+  auto a_sizes = a_type->sizes();
+  auto b_sizes = b_type->sizes();
+  for (size_t i = 0; i + 2 < *dim; ++i) {
+    if (!a_sizes[i] || a_sizes[i] != b_sizes[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // Patterns for ops that require observation for output quantization parameters
 // Example:
 //
@@ -249,6 +276,40 @@ QuantFusionInfo getObservedQParamOpFusionInfo(
   return {q_op_name, op_pattern, aten_op_pattern};
 }
 
+// Patterns for ops that take two quantized activations and observe the
+// output, optionally followed by a relu that is fused into the quantized op,
+// e.g. aten::bmm - aten::relu -> quantized::bmm_relu
+QuantFusionInfo getBinaryObservedQParamOpFusionInfo(
+    const std::string& fp_op_name,
+    const std::string& q_op_name,
+    const std::string& relu_op_name = "") {
+  std::string op_pattern = R"(
+graph(%a_quant, %b_quant, %scale, %zero_point, %dtype):
+         %a_dequant = aten::dequantize(%a_quant)
+         %b_dequant = aten::dequantize(%b_quant)
+         %r_op = )" +
+      fp_op_name + "(%a_dequant, %b_dequant)";
+  std::string r = "%r_op";
+  if (!relu_op_name.empty()) {
+    op_pattern += R"(
+         %r_relu = )" +
+        relu_op_name + "(%r_op)";
+    r = "%r_relu";
+  }
+  op_pattern += R"(
+         %r = aten::quantize_per_tensor()" +
+      r + R"(, %scale, %zero_point, %dtype)
+         return (%r) )";
+
+  std::string aten_op_pattern = R"(
+graph(%a_quant, %b_quant, %scale, %zero_point, %dtype):
+         %r = )" +
+      q_op_name + R"((%a_quant, %b_quant, %scale, %zero_point)
+         return (%r) )";
+
+  return {q_op_name, op_pattern, aten_op_pattern};
+}
+
 } // namespace
 
 std::vector<QuantFusionInfo> quant_fusion_pattern_and_replacements() {
@@ -808,6 +869,31 @@ graph(%a_quant, %b_scalar):
   auto hardswish = getObservedQParamOpFusionInfo(
       "aten::hardswish", "quantized::hardswish", {}, {});
 
+  auto softmax = getObservedQParamOpFusionInfo(
+      "aten::softmax", "quantized::softmax", {"%dim", "%dtype"}, {"%dim"});
+
+  auto matmul =
+      getBinaryObservedQParamOpFusionInfo("aten::matmul", "quantized::matmul");
+  matmul.filters = {matmul_inputs_are_supported};
+
+  auto matmul_relu = getBinaryObservedQParamOpFusionInfo(
+      "aten::matmul", "quantized::matmul_relu", "aten::relu");
+  matmul_relu.filters = {matmul_inputs_are_supported};
+
+  auto matmul_inplace_relu = getBinaryObservedQParamOpFusionInfo(
+      "aten::matmul", "quantized::matmul_relu", "aten::relu_");
+  matmul_inplace_relu.filters = {matmul_inputs_are_supported};
+
+  // aten::bmm already requires 3-D inputs with the same batch size, as
+  // quantized::bmm does, so it doesn't need a filter
+  auto bmm = getBinaryObservedQParamOpFusionInfo("aten::bmm", "quantized::bmm");
+
+  auto bmm_relu = getBinaryObservedQParamOpFusionInfo(
+      "aten::bmm", "quantized::bmm_relu", "aten::relu");
+
+  auto bmm_inplace_relu = getBinaryObservedQParamOpFusionInfo(
+      "aten::bmm", "quantized::bmm_relu", "aten::relu_");
+
   auto layer_norm = getObservedQParamOpFusionInfo(
       "aten::layer_norm",
       "quantized::layer_norm",
@@ -925,6 +1011,14 @@ graph(%a_quant, %b_scalar):
       {"quantized::mul_relu", inplace_mul_inplace_relu, quantized_mul_relu},
       {"quantized::mul", mul, quantized_mul},
       {"quantized::mul", inplace_mul, quantized_mul},
+      // note that the relu variants must come before the plain ops
+      matmul_relu,
+      matmul_inplace_relu,
+      matmul,
+      bmm_relu,
+      bmm_inplace_relu,
+      bmm,
+      softmax,
       hardswish,
       layer_norm,
       group_norm,
@@ -18,7 +18,11 @@
 
 #include <ATen/core/jit_type.h>
 #include <ATen/core/qualified_name.h>
+#include <algorithm>
+#include <map>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace torch {
@@ -45,6 +49,161 @@ static IValue Table(
   return Tup(std::move(ivalue_entries));
 }
 
+// Computes the memory plan of a function for the lite interpreter: every OP
+// instruction at the top level of the graph that produces a fresh tensor gets
+// an arena slot, and instructions whose outputs are never alive at the same
+// time share a slot. Lifetimes are conservative: values that may alias each
+// other are merged into one lifetime, and tensors that may escape the
+// function (outputs, attributes, values stored in containers with wildcard
+// aliasing) are left unplanned. The runtime double-checks that a slot is
+// free before reusing it, so the plan only needs to be a good hint.
+// Returns (instruction index, slot) pairs.
+std::vector<std::pair<int64_t, int64_t>> computeMemoryPlan(
+    const Code& code,
+    const std::vector<Instruction>& instructions) {
+  const auto& sources = code.instructions_source();
+  std::vector<std::pair<int64_t, int64_t>> plan;
+  if (sources.empty() || !sources[0]) {
+    return plan;
+  }
+  // The nodes belong to the graph the Code was emitted from, which is a
+  // preprocessed copy of the function's graph.
+  Graph* graph = sources[0]->owningGraph();
+  Block* top = graph->block();
+  auto topLevelNode = [&](Node* n) {
+    while (n->owningBlock() != top) {
+      n = n->owningBlock()->owningNode();
+    }
+    return n;
+  };
+
+  // Position of the last instruction emitted for each top-level node,
+  // including the instructions of its nested blocks.
+  std::unordered_map<Node*, int64_t> end_pos;
+  for (size_t i = 0; i < sources.size(); ++i) {
+    if (sources[i]) {
+      auto& pos = end_pos[topLevelNode(sources[i])];
+      pos = std::max(pos, static_cast<int64_t>(i));
+    }
+  }
+  auto lastUse = [&](Value* v) {
+    int64_t last = -1;
+    for (const Use& use : v->uses()) {
+      auto it = end_pos.find(topLevelNode(use.user));
+      if (it != end_pos.end()) {
+        last = std::max(last, it->second);
+      }
+    }
+    return last;
+  };
+
+  // Union-find over values that may share memory.
+  std::unordered_map<Value*, Value*> parent;
+  std::function<Value*(Value*)> find = [&](Value* v) -> Value* {
+    auto it = parent.find(v);
+    if (it == parent.end() || it->second == v) {
+      return v;
+    }
+    return it->second = find(it->second);
+  };
+  auto unite = [&](Value* a, Value* b) { parent[find(a)] = find(b); };
+  std::unordered_set<Value*> escapes(
+      graph->inputs().begin(), graph->inputs().end());
+  escapes.insert(graph->outputs().begin(), graph->outputs().end());
+
+  for (Node* n : top->nodes()) {
+    if (n->kind() == prim::SetAttr) {
+      escapes.insert(n->inputs().begin(), n->inputs().end());
+      continue;
+    }
+    const FunctionSchema* schema = n->maybeSchema();
+    if (!schema || !n->blocks().empty()) {
+      // Containers, control flow and other prim ops: assume every output may
+      // alias every input.
+      for (Value* output : n->outputs()) {
+        for (Value* input : n->inputs()) {
+          unite(output, input);
+        }
+      }
+      continue;
+    }
+    const auto& args = schema->arguments();
+    for (size_t i = 0; i < n->inputs().size() && i < args.size(); ++i) {
+      if (args[i].alias_info() && args[i].alias_info()->isWildcardAfter()) {
+        escapes.insert(n->input(i));
+      }
+    }
+    const auto& returns = schema->returns();
+    for (size_t i = 0; i < n->outputs().size() && i < returns.size(); ++i) {
+      if (!returns[i].alias_info()) {
+        continue;
+      }
+      for (size_t j = 0; j < n->inputs().size() && j < args.size(); ++j) {
+        if (args[j].alias_info()) {
+          unite(n->output(i), n->input(j));
+        }
+      }
+    }
+  }
+
+  // Lifetime end and escape status of each alias set.
+  std::unordered_map<Value*, int64_t> set_end;
+  std::unordered_set<Value*> set_escapes;
+  auto visit = [&](Value* v) {
+    Value* root = find(v);
+    auto& end = set_end[root];
+    end = std::max(end, lastUse(v));
+    if (escapes.count(v)) {
+      set_escapes.insert(root);
+    }
+  };
+  for (Value* input : graph->inputs()) {
+    visit(input);
+  }
+  for (Node* n : top->nodes()) {
+    for (Value* output : n->outputs()) {
+      visit(output);
+    }
+  }
+
+  // Greedy interval coloring in instruction order. Slots are released once
+  // the instruction that last uses them has run.
+  std::multimap<int64_t, int64_t> busy; // lifetime end -> slot
+  std::vector<int64_t> free_slots;
+  int64_t num_slots = 0;
+  for (size_t i = 0; i < instructions.size(); ++i) {
+    if (instructions[i].op != OP || !sources[i]) {
+      continue;
+    }
+    Node* n = sources[i];
+    const FunctionSchema* schema = n->maybeSchema();
+    if (n->owningBlock() != top || n->outputs().size() != 1 || !schema ||
+        schema->returns().size() != 1 || schema->returns()[0].alias_info() ||
+        !n->output()->type()->isSubtypeOf(TensorType::get())) {
+      continue;
+    }
+    Value* root = find(n->output());
+    if (set_escapes.count(root)) {
+      continue;
+    }
+    const int64_t pos = static_cast<int64_t>(i);
+    while (!busy.empty() && busy.begin()->first < pos) {
+      free_slots.push_back(busy.begin()->second);
+      busy.erase(busy.begin());
+    }
+    int64_t slot;
+    if (free_slots.empty()) {
+      slot = num_slots++;
+    } else {
+      slot = free_slots.back();
+      free_slots.pop_back();
+    }
+    busy.emplace(std::max(set_end[root], pos), slot);
+    plan.emplace_back(pos, slot);
+  }
+  return plan;
+}
+
 c10::IValue getFunctionTuple(const Function& func) {
   auto graph = func.graph()->copy();
   Inline(*graph);
@@ -118,11 +277,22 @@ c10::IValue getFunctionTuple(const Function& func) {
   // register size
   auto register_size = static_cast<int>(code.register_size());
 
-  auto table = Table({{"instructions", Tup(instructions)},
-                      {"operators", Tup(operators)},
-                      {"constants", Tup(constants)},
-                      {"types", Tup(types)},
-                      {"register_size", register_size}});
+  // memory plan
+  std::vector<IValue> memory_plan;
+  for (const auto& entry : computeMemoryPlan(code, instructions_copy)) {
+    memory_plan.emplace_back(Tup({entry.first, entry.second}));
+  }
+
+  std::vector<std::pair<std::string, IValue>> entries = {
+      {"instructions", Tup(instructions)},
+      {"operators", Tup(operators)},
+      {"constants", Tup(constants)},
+      {"types", Tup(types)},
+      {"register_size", register_size}};
+  if (!memory_plan.empty()) {
+    entries.emplace_back("memory_plan", Tup(memory_plan));
+  }
+  auto table = Table(entries);
 
   return Tup({func.qualname().qualifiedName(), table});
 }
@@ -6,5 +6,8 @@ constexpr size_t BYTECODE_INDEX_INSTRUCTION = 0;
 constexpr size_t BYTECODE_INDEX_OPERATOR = 1;
 constexpr size_t BYTECODE_INDEX_CONSTANT = 2;
 constexpr size_t BYTECODE_INDEX_TYPE = 3;
+constexpr size_t BYTECODE_INDEX_REGISTER_SIZE = 4;
+// Optional, only present for functions exported with a memory plan.
+constexpr size_t BYTECODE_INDEX_MEMORY_PLAN = 5;
 } // namespace jit
 } // namespace torch
@@ -1,4 +1,5 @@
 #include <torch/csrc/python_headers.h>
+#include <torch/csrc/multiprocessing/shared_memory_pool.h>
 #include <torch/csrc/utils/object_ptr.h>
 #include <torch/csrc/utils/pybind.h>
 
@@ -34,6 +35,20 @@ PyObject* multiprocessing_init(PyObject* _unused, PyObject *noargs) {
 #endif
   });
 
+  module.def("_set_shared_memory_pool", &setSharedMemoryPoolEnabled);
+  module.def("_shared_memory_pool_enabled", &sharedMemoryPoolEnabled);
+  module.def("_release_shared_memory_pool_segments", &releaseSharedMemoryPoolSegmentsOf);
+  module.def("_shared_memory_pool_stats", []() {
+    auto stats = sharedMemoryPoolStats();
+    py::dict result;
+    result["segments"] = stats.segments;
+    result["cached_bytes"] = stats.cached_bytes;
+    result["allocations"] = stats.allocations;
+    result["reused_allocations"] = stats.reused_allocations;
+    result["mapped_segments"] = stats.mapped_segments;
+    return result;
+  });
+
   Py_RETURN_TRUE;
 }
 
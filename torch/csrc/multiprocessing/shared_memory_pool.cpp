@@ -0,0 +1,349 @@
+#include <torch/csrc/multiprocessing/shared_memory_pool.h>
+
+#include <TH/THAllocator.h>
+#include <c10/util/Exception.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+namespace torch {
+
+namespace {
+
+// See Note [Shared memory pool]. The header of a segment is a single word:
+// the refcount of the block in the low bits and two flags.
+constexpr uint64_t kRefcountMask = (uint64_t(1) << 32) - 1;
+constexpr uint64_t kMappedBit = uint64_t(1) << 32;
+constexpr uint64_t kReleasedBit = uint64_t(1) << 33;
+// Keeps the data of the block aligned as the allocations of the CPU allocator
+constexpr size_t kHeaderSize = 64;
+constexpr size_t kPageSize = 4096;
+
+int64_t currentPid() {
+#ifdef _MSC_VER
+  return GetCurrentProcessId();
+#else
+  return getpid();
+#endif
+}
+
+std::string newSegmentName() {
+  static std::random_device rd;
+  std::string name = "/torch_";
+  name += std::to_string(currentPid());
+  name += "_";
+  name += std::to_string(rd());
+  return name;
+}
+
+struct Segment {
+  Segment(std::string name, at::DataPtr mapping, size_t size, bool owned)
+      : name(std::move(name)),
+        mapping(std::move(mapping)),
+        size(size),
+        owned(owned) {}
+
+  std::atomic<uint64_t>& state() {
+    return *static_cast<std::atomic<uint64_t>*>(mapping.get());
+  }
+  void* data() {
+    return static_cast<char*>(mapping.get()) + kHeaderSize;
+  }
+  bool idle() {
+    return (state().load(std::memory_order_acquire) & kRefcountMask) == 0;
+  }
+
+  std::string name;
+  at::DataPtr mapping;
+  // Size of the mapping, header included
+  size_t size;
+  // Created by this process, as opposed to received from another one
+  bool owned;
+  uint64_t last_use = 0;
+};
+
+// Context of the DataPtr of the storages in a block, holds one reference
+struct Block {
+  std::shared_ptr<Segment> segment;
+  // A process forked while the storage was alive doesn't own the reference
+  int64_t pid;
+};
+
+struct ProducerPool {
+  explicit ProducerPool(int64_t pid) : pid(pid) {}
+
+  const int64_t pid;
+  std::mutex mutex;
+  bool enabled = false;
+  size_t max_cached_bytes = 0;
+  uint64_t clock = 0;
+  std::vector<std::shared_ptr<Segment>> segments;
+  size_t allocations = 0;
+  size_t reused_allocations = 0;
+};
+
+struct ReceivedSegments {
+  explicit ReceivedSegments(int64_t pid) : pid(pid) {}
+
+  const int64_t pid;
+  std::mutex mutex;
+  std::unordered_map<std::string, std::shared_ptr<Segment>> segments;
+};
+
+std::atomic<ProducerPool*> producer_pool{nullptr};
+std::atomic<ReceivedSegments*> received_segments{nullptr};
+
+// After a fork, the state of the parent may be inconsistent (e.g. its mutex
+// may be held by a thread that doesn't exist in the child), so the child
+// leaks it and starts afresh
+template <typename T>
+T& forCurrentProcess(std::atomic<T*>& instance) {
+  const int64_t pid = currentPid();
+  T* current = instance.load(std::memory_order_acquire);
+  while (!current || current->pid != pid) {
+    T* fresh = new T(pid);
+    if (instance.compare_exchange_strong(current, fresh)) {
+      current = fresh;
+    } else {
+      delete fresh;
+    }
+  }
+  return *current;
+}
+
+// Idle segments will be unmapped by their receiver, in use ones once the
+// receiver frees its storage
+void releaseSegment(Segment& segment) {
+  segment.state().fetch_or(kReleasedBit, std::memory_order_acq_rel);
+}
+
+// Drops the least recently used idle segments over max_cached_bytes
+void trimLocked(ProducerPool& pool) {
+  size_t cached_bytes = 0;
+  for (const auto& segment : pool.segments) {
+    if (segment->idle()) {
+      cached_bytes += segment->size;
+    }
+  }
+  while (cached_bytes > pool.max_cached_bytes) {
+    auto lru = pool.segments.end();
+    for (auto it = pool.segments.begin(); it != pool.segments.end(); ++it) {
+      if ((*it)->idle() && (lru == pool.segments.end() || (*it)->last_use < (*lru)->last_use)) {
+        lru = it;
+      }
+    }
+    if (lru == pool.segments.end()) {
+      break;
+    }
+    cached_bytes -= (*lru)->size;
+    releaseSegment(**lru);
+    pool.segments.erase(lru);
+  }
+}
+
+// Unmaps the received segments that are idle and dropped by their owner
+void unmapReleasedSegmentsLocked(ReceivedSegments& received) {
+  for (auto it = received.segments.begin(); it != received.segments.end();) {
+    const uint64_t state = it->second->state().load(std::memory_order_acquire);
+    if ((state & kReleasedBit) && (state & kRefcountMask) == 0) {
+      it = received.segments.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void deleteBlock(void* ptr) {
+  std::unique_ptr<Block> block(static_cast<Block*>(ptr));
+  if (block->pid != currentPid()) {
+    return;
+  }
+  auto& segment = *block->segment;
+  const uint64_t old_state = segment.state().fetch_sub(1, std::memory_order_acq_rel);
+  if (!segment.owned && (old_state & kRefcountMask) == 1) {
+    // Also picks up the segments the owner dropped while they were idle, so
+    // that they don't stay mapped until the next block is received
+    auto& received = forCurrentProcess(received_segments);
+    std::lock_guard<std::mutex> lock(received.mutex);
+    unmapReleasedSegmentsLocked(received);
+  }
+}
+
+Block* blockFromDataPtr(const at::DataPtr& data_ptr) {
+  return data_ptr.cast_context<Block>(&deleteBlock);
+}
+
+} // namespace
+
+void setSharedMemoryPoolEnabled(bool enabled, size_t max_cached_bytes) {
+#ifdef _WIN32
+  TORCH_CHECK(!enabled, "the shared memory pool is not supported on Windows");
+#endif
+  auto& pool = forCurrentProcess(producer_pool);
+  std::lock_guard<std::mutex> lock(pool.mutex);
+  pool.enabled = enabled;
+  pool.max_cached_bytes = max_cached_bytes;
+  if (enabled) {
+    trimLocked(pool);
+  } else {
+    for (const auto& segment : pool.segments) {
+      releaseSegment(*segment);
+    }
+    pool.segments.clear();
+  }
+}
+
+bool sharedMemoryPoolEnabled() {
+  auto& pool = forCurrentProcess(producer_pool);
+  std::lock_guard<std::mutex> lock(pool.mutex);
+  return pool.enabled;
+}
+
+at::DataPtr allocateFromSharedMemoryPool(size_t nbytes) {
+  auto& pool = forCurrentProcess(producer_pool);
+  const size_t size = (nbytes + kHeaderSize + kPageSize - 1) / kPageSize * kPageSize;
+  std::shared_ptr<Segment> segment;
+  {
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    TORCH_CHECK(pool.enabled, "the shared memory pool is disabled");
+    // Best fit among the idle segments, wasting at most half of the segment
+    for (const auto& candidate : pool.segments) {
+      if (candidate->size >= size && candidate->size <= 2 * size &&
+          (!segment || candidate->size < segment->size) && candidate->idle()) {
+        segment = candidate;
+      }
+    }
+    pool.allocations++;
+    if (segment) {
+      pool.reused_allocations++;
+    } else {
+      int flags = TH_ALLOCATOR_MAPPED_SHAREDMEM |
+                  TH_ALLOCATOR_MAPPED_EXCLUSIVE |
+                  TH_ALLOCATOR_MAPPED_KEEPFD |
+                  TH_ALLOCATOR_MAPPED_UNLINK;
+      std::string name = newSegmentName();
+      auto mapping = THMapAllocator::makeDataPtr(name.c_str(), flags, size, nullptr);
+      segment = std::make_shared<Segment>(std::move(name), std::move(mapping), size, /*owned=*/true);
+      new (segment->mapping.get()) std::atomic<uint64_t>(0);
+      pool.segments.push_back(segment);
+    }
+    // Only this process adds references to its segments, so the block can't
+    // be taken by someone else between the idle check and here
+    segment->state().fetch_add(1, std::memory_order_acq_rel);
+    segment->last_use = ++pool.clock;
+    trimLocked(pool);
+  }
+  void* data = segment->data();
+  return {data, new Block{std::move(segment), pool.pid}, &deleteBlock, at::DeviceType::CPU};
+}
+
+bool isSharedMemoryPoolBlock(const at::DataPtr& data_ptr) {
+  return blockFromDataPtr(data_ptr) != nullptr;
+}
+
+c10::optional<SharedMemoryBlockHandle> shareSharedMemoryPoolBlock(
+    const at::DataPtr& data_ptr) {
+  Block* block = blockFromDataPtr(data_ptr);
+  if (!block || !block->segment->owned || block->pid != currentPid()) {
+    return c10::nullopt;
+  }
+  auto& segment = *block->segment;
+  const uint64_t old_state = segment.state().fetch_add(1, std::memory_order_acq_rel);
+  SharedMemoryBlockHandle handle;
+  handle.name = segment.name;
+  handle.fd = (old_state & kMappedBit) ? -1 : THMapAllocator::fromDataPtr(segment.mapping)->fd();
+  handle.segment_size = segment.size;
+  return handle;
+}
+
+at::DataPtr receiveSharedMemoryPoolBlock(
+    const std::string& name,
+    int fd,
+    size_t segment_size) {
+  auto& received = forCurrentProcess(received_segments);
+  std::shared_ptr<Segment> segment;
+  {
+    std::lock_guard<std::mutex> lock(received.mutex);
+    unmapReleasedSegmentsLocked(received);
+    auto it = received.segments.find(name);
+    if (it != received.segments.end()) {
+      segment = it->second;
+    } else {
+      TORCH_CHECK(fd >= 0,
+          "Received the shared memory pool block ", name, " but its segment is "
+          "not mapped in this process. Tensors allocated from the shared memory "
+          "pool of a process can only be sent to the process that received them "
+          "first; clone them before sending them to another process.");
+#ifdef _WIN32
+      AT_ERROR("the shared memory pool is not supported on Windows");
+#else
+      int segment_fd = dup(fd);
+      TORCH_CHECK(segment_fd != -1, "could not duplicate a shared memory file descriptor");
+      int flags = TH_ALLOCATOR_MAPPED_SHAREDMEM |
+                  TH_ALLOCATOR_MAPPED_NOCREATE |
+                  TH_ALLOCATOR_MAPPED_FROMFD;
+      auto mapping = THMapAllocator::makeDataPtr(
+          WITH_FD, name.c_str(), segment_fd, flags, segment_size, nullptr);
+      segment = std::make_shared<Segment>(name, std::move(mapping), segment_size, /*owned=*/false);
+      segment->state().fetch_or(kMappedBit, std::memory_order_acq_rel);
+      received.segments.emplace(name, segment);
+#endif
+    }
+  }
+  void* data = segment->data();
+  return {data, new Block{std::move(segment), received.pid}, &deleteBlock, at::DeviceType::CPU};
+}
+
+void decrefSharedMemoryPoolBlock(const at::DataPtr& data_ptr) {
+  if (Block* block = blockFromDataPtr(data_ptr)) {
+    block->segment->state().fetch_sub(1, std::memory_order_acq_rel);
+  }
+}
+
+void releaseSharedMemoryPoolSegmentsOf(int64_t pid) {
+  const std::string prefix = "/torch_" + std::to_string(pid) + "_";
+  auto& received = forCurrentProcess(received_segments);
+  std::lock_guard<std::mutex> lock(received.mutex);
+  for (const auto& entry : received.segments) {
+    if (entry.first.compare(0, prefix.size(), prefix) == 0) {
+      releaseSegment(*entry.second);
+    }
+  }
+  unmapReleasedSegmentsLocked(received);
+}
+
+SharedMemoryPoolStats sharedMemoryPoolStats() {
+  SharedMemoryPoolStats stats;
+  {
+    auto& pool = forCurrentProcess(producer_pool);
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    stats.segments = pool.segments.size();
+    for (const auto& segment : pool.segments) {
+      if (segment->idle()) {
+        stats.cached_bytes += segment->size;
+      }
+    }
+    stats.allocations = pool.allocations;
+    stats.reused_allocations = pool.reused_allocations;
+  }
+  {
+    auto& received = forCurrentProcess(received_segments);
+    std::lock_guard<std::mutex> lock(received.mutex);
+    stats.mapped_segments = received.segments.size();
+  }
+  return stats;
+}
+
+} // namespace torch
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <c10/core/Allocator.h>
+#include <c10/util/Optional.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace torch {
+
+// Note [Shared memory pool]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+// Moving every batch produced by a DataLoader worker to a fresh shared memory
+// file costs a shm_open/ftruncate/mmap in the worker, an fd transfer and a mmap
+// in the receiver, munmaps on both sides and page faults on every page of the
+// batch. With small batches these dominate the input pipeline.
+//
+// Instead, a worker can allocate the storages of its batches from a pool of
+// long-lived shared memory segments (one block per segment). The segments are
+// created unlinked and shared by file descriptor, as in the file_descriptor
+// sharing strategy, and each starts with a header holding its state in
+// shared memory:
+//
+//   - the number of storages referencing the block in all the processes.
+//     Sending a block adds a reference that is adopted by the receiver, so a
+//     block is idle (and can be reused by the worker) only once the receiver
+//     freed its storage;
+//   - whether the receiver has the segment mapped. The receiver keeps the
+//     segments it received mapped, so the fd is only sent the first time and
+//     later batches in the same segment only send its name;
+//   - whether the worker dropped the segment, in which case the receiver
+//     unmaps it once it is idle. A worker that is killed never drops its
+//     segments, so the receiver drops them itself once the worker is gone
+//     (see releaseSharedMemoryPoolSegmentsOf).
+//
+// A block sent once can only be received by the process that received it
+// first (for the DataLoader, the main process). Sending a received block
+// again copies it to a regular shared memory storage, as for any storage
+// that is not in shared memory.
+
+// Enables or disables the pool of the current process. At most
+// max_cached_bytes of idle segments are kept for reuse. Disabling drops all
+// the segments, blocks still in use remain valid until they are freed.
+void setSharedMemoryPoolEnabled(bool enabled, size_t max_cached_bytes);
+bool sharedMemoryPoolEnabled();
+
+// Allocates a block of nbytes from the pool, it must be enabled
+at::DataPtr allocateFromSharedMemoryPool(size_t nbytes);
+
+bool isSharedMemoryPoolBlock(const at::DataPtr& data_ptr);
+
+struct SharedMemoryBlockHandle {
+  std::string name;
+  // -1 when the receiver already has the segment mapped
+  int fd;
+  size_t segment_size;
+};
+
+// Adds the reference the receiver adopts and returns how to find the block;
+// nullopt if data_ptr isn't a block allocated by this process
+c10::optional<SharedMemoryBlockHandle> shareSharedMemoryPoolBlock(
+    const at::DataPtr& data_ptr);
+// Maps the block (or reuses the mapping of its segment) and adopts the
+// reference added by the sender. fd isn't consumed.
+at::DataPtr receiveSharedMemoryPoolBlock(
+    const std::string& name,
+    int fd,
+    size_t segment_size);
+// Drops a reference adopted from the sender, when the receiver already had a
+// storage for the block
+void decrefSharedMemoryPoolBlock(const at::DataPtr& data_ptr);
+
+// Drops the segments received from the process pid, which must have exited.
+// The idle ones are unmapped now, the others once their storages are freed.
+void releaseSharedMemoryPoolSegmentsOf(int64_t pid);
+
+struct SharedMemoryPoolStats {
+  // Segments created by this process and kept in its pool
+  size_t segments = 0;
+  size_t cached_bytes = 0;
+  size_t allocations = 0;
+  size_t reused_allocations = 0;
+  // Segments of other processes mapped in this process
+  size_t mapped_segments = 0;
+};
+
+SharedMemoryPoolStats sharedMemoryPoolStats();
+
+} // namespace torch
@@ -619,10 +619,77 @@ static void extra_kwargs(FunctionSignature& signature, PyObject* kwargs, ssize_t
   throw TypeError("invalid keyword arguments");
 }
 
+PyObject* PythonCallArgs::fastcall_kwarg(PyObject* name) const {
+  const Py_ssize_t num_kwargs = PyTuple_GET_SIZE(kwnames_);
+  // The names are usually interned, as the names of the parameters
+  for (Py_ssize_t i = 0; i < num_kwargs; ++i) {
+    if (PyTuple_GET_ITEM(kwnames_, i) == name) {
+      return args_[nargs_ + i];
+    }
+  }
+  for (Py_ssize_t i = 0; i < num_kwargs; ++i) {
+    int cmp = PyObject_RichCompareBool(PyTuple_GET_ITEM(kwnames_, i), name, Py_EQ);
+    if (cmp < 0) {
+      throw python_error();
+    } else if (cmp) {
+      return args_[nargs_ + i];
+    }
+  }
+  return nullptr;
+}
+
+PyObject* PythonCallArgs::args_tuple() {
+  if (!args_tuple_) {
+    owned_args_tuple_ = PyTuple_New(nargs_);
+    if (!owned_args_tuple_) {
+      throw python_error();
+    }
+    for (Py_ssize_t i = 0; i < nargs_; ++i) {
+      Py_INCREF(args_[i]);
+      PyTuple_SET_ITEM(owned_args_tuple_.get(), i, args_[i]);
+    }
+    args_tuple_ = owned_args_tuple_.get();
+  }
+  return args_tuple_;
+}
+
+PyObject* PythonCallArgs::kwargs_dict() {
+  if (!kwargs_ && kwnames_) {
+    owned_kwargs_ = PyDict_New();
+    if (!owned_kwargs_) {
+      throw python_error();
+    }
+    for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(kwnames_); ++i) {
+      if (PyDict_SetItem(owned_kwargs_.get(), PyTuple_GET_ITEM(kwnames_, i), args_[nargs_ + i]) < 0) {
+        throw python_error();
+      }
+    }
+    kwargs_ = owned_kwargs_.get();
+  }
+  return kwargs_;
+}
+
+// Whether a check that failed for obj might succeed for another object of the
+// same type, see Note [Signature match cache]
+static bool check_depends_on_value(PyObject* obj) {
+  if (THPVariable_Check(obj) || PyTuple_Check(obj) || PyList_Check(obj)) {
+    return true;
+  }
+  // Objects other than ints may convert to an index depending on their value
+  auto as_number = Py_TYPE(obj)->tp_as_number;
+  return !PyLong_Check(obj) && as_number && as_number->nb_index;
+}
+
 bool FunctionSignature::parse(PyObject* args, PyObject* kwargs, PyObject* dst[],
                               bool raise_exception) {
-  auto nargs = PyTuple_GET_SIZE(args);
-  ssize_t remaining_kwargs = kwargs ? PyDict_Size(kwargs) : 0;
+  PythonCallArgs call_args(args, kwargs);
+  return parse(call_args, dst, raise_exception);
+}
+
+bool FunctionSignature::parse(PythonCallArgs& call_args, PyObject* dst[],
+                              bool raise_exception, bool* depends_on_value) {
+  auto nargs = call_args.nargs();
+  ssize_t remaining_kwargs = call_args.num_kwargs();
   ssize_t arg_pos = 0;
   bool allow_varargs_intlist = false;
 
@@ -656,14 +723,14 @@ bool FunctionSignature::parse(PyObject* args, PyObject* kwargs, PyObject* dst[],
         }
         return false;
       }
-      obj = PyTuple_GET_ITEM(args, arg_pos);
-    } else if (kwargs) {
-      obj = PyDict_GetItem(kwargs, param.python_name);
+      obj = call_args.arg(arg_pos);
+    } else if (call_args.has_kwargs()) {
+      obj = call_args.kwarg(param.python_name);
       for (PyObject *numpy_name: param.numpy_python_names) {
         if (obj) {
           break;
         }
-        obj = PyDict_GetItem(kwargs, numpy_name);
+        obj = call_args.kwarg(numpy_name);
       }
       is_kwd = true;
     }
@@ -688,7 +755,7 @@ bool FunctionSignature::parse(PyObject* args, PyObject* kwargs, PyObject* dst[],
                THPUtils_checkIndex(obj)) {
       // take all positional arguments as this parameter
       // e.g. permute(1, 2, 3) -> permute((1, 2, 3))
-      dst[i++] = args;
+      dst[i++] = call_args.args_tuple();
       arg_pos = nargs;
       continue;
     } else if (raise_exception) {
@@ -704,6 +771,9 @@ bool FunctionSignature::parse(PyObject* args, PyObject* kwargs, PyObject* dst[],
             param.type_name().c_str(), Py_TYPE(obj)->tp_name);
       }
     } else {
+      if (depends_on_value) {
+        *depends_on_value = check_depends_on_value(obj);
+      }
       return false;
     }
 
@@ -717,7 +787,7 @@ bool FunctionSignature::parse(PyObject* args, PyObject* kwargs, PyObject* dst[],
   if (remaining_kwargs > 0) {
     if (raise_exception) {
       // foo() got an unexpected keyword argument "b"
-      extra_kwargs(*this, kwargs, nargs);
+      extra_kwargs(*this, call_args.kwargs_dict(), nargs);
     }
     return false;
   }
@@ -767,25 +837,81 @@ void PythonArgParser::check_deprecated(const FunctionSignature & signature) {
   }
 }
 
-PythonArgs PythonArgParser::raw_parse(PyObject* args, PyObject* kwargs, PyObject* parsed_args[]) {
+auto PythonArgParser::signature_cache_entry(const PythonCallArgs& call_args) -> SignatureCacheEntry& {
+  size_t hash = call_args.nargs();
+  for (Py_ssize_t i = 0; i < call_args.nargs(); ++i) {
+    hash = hash * 31 + (reinterpret_cast<uintptr_t>(Py_TYPE(call_args.arg(i))) >> 4);
+  }
+  return signature_cache_[hash % kSignatureCacheSize];
+}
+
+bool PythonArgParser::SignatureCacheEntry::matches(const PythonCallArgs& call_args) const {
+  if (nargs != call_args.nargs()) {
+    return false;
+  }
+  for (Py_ssize_t i = 0; i < nargs; ++i) {
+    if (types[i] != Py_TYPE(call_args.arg(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void PythonArgParser::SignatureCacheEntry::assign(const PythonCallArgs& call_args, size_t idx) {
+  for (Py_ssize_t i = 0; i < call_args.nargs(); ++i) {
+    Py_INCREF(Py_TYPE(call_args.arg(i)));
+  }
+  for (Py_ssize_t i = 0; i < nargs; ++i) {
+    Py_DECREF(types[i]);
+  }
+  nargs = call_args.nargs();
+  for (Py_ssize_t i = 0; i < nargs; ++i) {
+    types[i] = Py_TYPE(call_args.arg(i));
+  }
+  signature = idx;
+}
+
+PythonArgs PythonArgParser::raw_parse(PythonCallArgs& call_args, PyObject* parsed_args[]) {
   if (signatures_.size() == 1) {
     auto& signature = signatures_[0];
-    signature.parse(args, kwargs, parsed_args, true);
+    signature.parse(call_args, parsed_args, true);
     check_deprecated(signature);
     return PythonArgs(traceable, signature, parsed_args);
   }
 
-  for (auto& signature : signatures_) {
-    if (signature.parse(args, kwargs, parsed_args, false)) {
+  // See Note [Signature match cache]
+  SignatureCacheEntry* entry = nullptr;
+  if (call_args.nargs() <= kMaxCachedArgs && call_args.num_kwargs() == 0) {
+    entry = &signature_cache_entry(call_args);
+    if (entry->matches(call_args)) {
+      auto& signature = signatures_[entry->signature];
+      if (signature.parse(call_args, parsed_args, false)) {
+        check_deprecated(signature);
+        return PythonArgs(traceable, signature, parsed_args);
+      }
+    }
+  }
+
+  bool depends_on_value = false;
+  for (size_t i = 0; i < signatures_.size(); ++i) {
+    auto& signature = signatures_[i];
+    bool rejected_on_value = false;
+    if (signature.parse(call_args, parsed_args, false, &rejected_on_value)) {
+      if (entry && !depends_on_value) {
+        entry->assign(call_args, i);
+      }
       check_deprecated(signature);
       return PythonArgs(traceable, signature, parsed_args);
     }
+    depends_on_value = depends_on_value || rejected_on_value;
   }
 
-  print_error(args, kwargs, parsed_args);
+  print_error(call_args, parsed_args);
 }
 
-void PythonArgParser::print_error(PyObject* args, PyObject* kwargs, PyObject* parsed_args[]) {
+void PythonArgParser::print_error(PythonCallArgs& call_args, PyObject* parsed_args[]) {
+  PyObject* args = call_args.args_tuple();
+  PyObject* kwargs = call_args.kwargs_dict();
   auto num_args = PyTuple_GET_SIZE(args) + (kwargs ? PyDict_Size(kwargs) : 0);
   std::vector<int> plausible_idxs;
   ssize_t i = 0;
@@ -798,7 +924,7 @@ void PythonArgParser::print_error(PyObject* args, PyObject* kwargs, PyObject* pa
 
   if (plausible_idxs.size() == 1) {
     auto& signature = signatures_[plausible_idxs[0]];
-    signature.parse(args, kwargs, parsed_args, true);
+    signature.parse(call_args, parsed_args, true);
   }
 
   auto options = get_signatures();
@@ -92,6 +92,75 @@ struct ParsedArgs {
   PyObject* args[N];
 };
 
+// Note [Fastcall methods]
+// ~~~~~~~~~~~~~~~~~~~~~~~
+// CPython calls METH_VARARGS | METH_KEYWORDS functions with a tuple and a dict
+// that it builds for every call. On Python >= 3.7, the hottest Tensor methods
+// (FASTCALL_METHOD_NAMES in tools/autograd/gen_python_functions.py) are bound
+// as METH_FASTCALL | METH_KEYWORDS functions instead, which get the arguments
+// as a C array followed by the values of the keyword arguments, whose names
+// are in the kwnames tuple.
+//
+// PythonCallArgs holds the arguments of either kind of call so that they are
+// parsed by the same code. The tuple and the dict of a fastcall are only
+// built when they are needed, e.g. to report an error.
+#if PY_VERSION_HEX >= 0x03070000
+#define TORCH_PYTHON_HAS_FASTCALL
+#endif
+
+struct PythonCallArgs {
+  PythonCallArgs(PyObject* args, PyObject* kwargs)
+    : args_(&PyTuple_GET_ITEM(args, 0))
+    , nargs_(PyTuple_GET_SIZE(args))
+    , args_tuple_(args)
+    , kwargs_(kwargs) {}
+
+  PythonCallArgs(PyObject* const* args, Py_ssize_t nargs, PyObject* kwnames)
+    : args_(args)
+    , nargs_(nargs)
+    , kwnames_(kwnames) {}
+
+  Py_ssize_t nargs() const {
+    return nargs_;
+  }
+  PyObject* arg(Py_ssize_t i) const {
+    return args_[i];
+  }
+  bool has_kwargs() const {
+    return kwargs_ || kwnames_;
+  }
+  Py_ssize_t num_kwargs() const {
+    if (kwnames_) {
+      return PyTuple_GET_SIZE(kwnames_);
+    }
+    return kwargs_ ? PyDict_Size(kwargs_) : 0;
+  }
+  // Borrowed reference to the keyword argument, nullptr if it isn't given
+  PyObject* kwarg(PyObject* name) const {
+    if (kwnames_) {
+      return fastcall_kwarg(name);
+    }
+    return kwargs_ ? PyDict_GetItem(kwargs_, name) : nullptr;
+  }
+
+  // Borrowed references to the arguments as a tuple and to the keyword
+  // arguments as a dict (nullptr if there are none)
+  PyObject* args_tuple();
+  PyObject* kwargs_dict();
+
+private:
+  PyObject* fastcall_kwarg(PyObject* name) const;
+
+  PyObject* const* args_;
+  Py_ssize_t nargs_;
+  PyObject* kwnames_ = nullptr;
+  PyObject* args_tuple_ = nullptr;
+  PyObject* kwargs_ = nullptr;
+  // Built from a fastcall
+  THPObjectPtr owned_args_tuple_;
+  THPObjectPtr owned_kwargs_;
+};
+
 struct PythonArgParser {
   explicit PythonArgParser(std::vector<std::string> fmts, bool traceable=false);
 
@@ -99,25 +168,67 @@ struct PythonArgParser {
   template<int N>
   inline PythonArgs parse(PyObject* args, PyObject* kwargs, ParsedArgs<N>& dst);
 
+  // See Note [Fastcall methods]
+  template<int N>
+  inline PythonArgs parse(PythonCallArgs& call_args, ParsedArgs<N>& dst);
+
   // Formatted strings of non-hidden signatures
   std::vector<std::string> get_signatures() const;
 
 private:
   [[noreturn]]
-  void print_error(PyObject* args, PyObject* kwargs, PyObject* parsed_args[]);
+  void print_error(PythonCallArgs& call_args, PyObject* parsed_args[]);
   void check_deprecated(const FunctionSignature & signature);
-  PythonArgs raw_parse(PyObject* args, PyObject* kwargs, PyObject* parsed_args[]);
+  PythonArgs raw_parse(PythonCallArgs& call_args, PyObject* parsed_args[]);
+
+  // Note [Signature match cache]
+  // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+  // Overloads are tried in order, so a call matching the last of them pays
+  // for checking its arguments against all the others first. Whether a
+  // signature matches a call with only positional arguments mostly depends
+  // on the types of the arguments, so the parser remembers which signature
+  // matched for a few tuples of argument types and tries it first.
+  //
+  // Some checks also depend on the values of the arguments (e.g. a 0-dim
+  // integral tensor binds to int64_t, but not other tensors), so a match is
+  // only cached if all the signatures before it were rejected for reasons
+  // that only depend on the types. A cached signature that doesn't match
+  // falls back to trying all the signatures in order, so the result is always
+  // the same as without the cache.
+  //
+  // The cache is only used with the GIL held.
+  static constexpr Py_ssize_t kMaxCachedArgs = 4;
+  static constexpr size_t kSignatureCacheSize = 8;
+
+  struct SignatureCacheEntry {
+    // Holds references to the types so that they can't be freed and their
+    // address reused by another type
+    std::array<PyTypeObject*, kMaxCachedArgs> types {};
+    Py_ssize_t nargs = -1;
+    size_t signature = 0;
+
+    bool matches(const PythonCallArgs& call_args) const;
+    void assign(const PythonCallArgs& call_args, size_t idx);
+  };
+
+  SignatureCacheEntry& signature_cache_entry(const PythonCallArgs& call_args);
 
   std::vector<FunctionSignature> signatures_;
   std::string function_name;
   ssize_t max_args;
   bool traceable;
+  std::array<SignatureCacheEntry, kSignatureCacheSize> signature_cache_;
 };
 
 struct PYBIND11_EXPORT FunctionSignature {
   explicit FunctionSignature(const std::string& fmt, int index);
 
   bool parse(PyObject* args, PyObject* kwargs, PyObject* dst[], bool raise_exception);
+  // When the arguments don't match, sets *depends_on_value if they might
+  // match with other arguments of the same types, see
+  // Note [Signature match cache]
+  bool parse(PythonCallArgs& call_args, PyObject* dst[], bool raise_exception,
+             bool* depends_on_value = nullptr);
 
   std::string toString() const;
 
@@ -229,7 +340,17 @@ inline PythonArgs PythonArgParser::parse(PyObject* args, PyObject* kwargs, Parse
     throw ValueError("PythonArgParser: dst ParsedArgs buffer does not have enough capacity, expected %d (got %d)",
         (int)max_args, N);
   }
-  return raw_parse(args, kwargs, dst.args);
+  PythonCallArgs call_args(args, kwargs);
+  return raw_parse(call_args, dst.args);
+}
+
+template<int N>
+inline PythonArgs PythonArgParser::parse(PythonCallArgs& call_args, ParsedArgs<N>& dst) {
+  if (N < max_args) {
+    throw ValueError("PythonArgParser: dst ParsedArgs buffer does not have enough capacity, expected %d (got %d)",
+        (int)max_args, N);
+  }
+  return raw_parse(call_args, dst.args);
 }
 
 inline bool PythonArgs::has_torch_function(){
@@ -300,6 +300,22 @@ def rebuild_storage_filename(cls, manager, handle, size):
     return storage._shared_decref()
 
 
+def rebuild_storage_pooled(cls, name, df, segment_size, size):
+    # The file descriptor is only sent the first time a segment is sent, see
+    # Note [Shared memory pool]
+    fd = -1 if df is None else df.detach()
+    try:
+        storage = storage_from_cache(cls, name)
+        if storage is not None:
+            return storage._shared_decref()
+        storage = cls._new_shared_pooled(name, fd, segment_size, size)
+        shared_cache[name] = StorageWeakRef(storage)
+        return storage
+    finally:
+        if fd >= 0:
+            os.close(fd)
+
+
 def rebuild_storage_empty(cls):
     return cls()
 
@@ -308,6 +324,13 @@ def reduce_storage(storage):
     from . import get_sharing_strategy
     if storage.is_cuda:
         raise RuntimeError("Cannot pickle CUDA storage; try pickling a CUDA tensor instead")
+    pooled = storage._share_pooled_()
+    if pooled is not None:
+        name, fd, segment_size, size = pooled
+        df = multiprocessing.reduction.DupFd(fd) if fd >= 0 else None
+        cache_key = name
+        metadata = (name, df, segment_size, size)
+        rebuild = rebuild_storage_pooled
     elif get_sharing_strategy() == 'file_system':
         metadata = storage._share_filename_()
         cache_key = metadata[1]
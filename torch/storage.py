@@ -129,11 +129,13 @@ class _StorageBase(object):
     @classmethod
     def _new_shared(cls, size):
         """Creates a new storage in shared memory with the same data type"""
-        from torch.multiprocessing import get_sharing_strategy
+        from torch.multiprocessing import get_sharing_strategy, _shared_memory_pool_enabled
         if cls.is_cuda:
             return cls(size)
         elif get_sharing_strategy() == 'file_system':
             return cls._new_using_filename(size)
+        elif size > 0 and _shared_memory_pool_enabled():
+            return cls._new_pooled(size)
         else:
             return cls._new_using_fd(size)
 
@@ -24,6 +24,14 @@ r"""Interval (in seconds) to check status of processes to avoid hanging in
     sender is alive to prevent hanging."""
 
 
+SHARED_MEMORY_POOL_MAX_CACHED_BYTES = 256 * 1024 * 1024
+r"""Maximum size (in bytes) of the idle shared memory segments each worker
+    keeps to allocate its next batches from, instead of creating a new shared
+    memory file for every batch. Only used with the ``file_descriptor`` sharing
+    strategy, 0 disables the pool. See Note [Shared memory pool] in
+    torch/csrc/multiprocessing/shared_memory_pool.h"""
+
+
 python_exit_status = False
 r"""Whether Python is shutting down. This flag is guaranteed to be set before
 the Python core library resources are freed, but Python may already be exiting
@@ -113,7 +113,7 @@ _IterableDatasetStopIteration = namedtuple('_IterableDatasetStopIteration', ['wo
 
 def _worker_loop(dataset_kind, dataset, index_queue, data_queue, done_event,
                  auto_collation, collate_fn, drop_last, seed, init_fn, worker_id,
-                 num_workers):
+                 num_workers, shared_memory_pool_size=0):
     # See NOTE [ Data Loader Multiprocessing Shutdown Logic ] for details on the
     # logic of this function.
 
@@ -126,6 +126,11 @@ def _worker_loop(dataset_kind, dataset, index_queue, data_queue, done_event,
         signal_handling._set_worker_signal_handlers()
 
         torch.set_num_threads(1)
+        # Allocate the batches from recycled shared memory segments, see
+        # `_utils.SHARED_MEMORY_POOL_MAX_CACHED_BYTES`
+        if shared_memory_pool_size > 0 and \
+                torch.multiprocessing.get_sharing_strategy() == 'file_descriptor':
+            torch.multiprocessing._set_shared_memory_pool(True, shared_memory_pool_size)
         random.seed(seed)
         torch.manual_seed(seed)
 
@@ -201,6 +206,8 @@ def _worker_loop(dataset_kind, dataset, index_queue, data_queue, done_event,
     except KeyboardInterrupt:
         # Main process will raise KeyboardInterrupt anyways.
         pass
+    # Lets the main process unmap the segments once it frees the batches
+    torch.multiprocessing._set_shared_memory_pool(False, 0)
     if done_event.is_set():
         data_queue.cancel_join_thread()
         data_queue.close()
@@ -717,7 +717,8 @@ class _MultiProcessingDataLoaderIter(_BaseDataLoaderIter):
                 args=(self._dataset_kind, self._dataset, index_queue,
                       self._worker_result_queue, self._workers_done_event,
                       self._auto_collation, self._collate_fn, self._drop_last,
-                      self._base_seed + i, self._worker_init_fn, i, self._num_workers))
+                      self._base_seed + i, self._worker_init_fn, i, self._num_workers,
+                      _utils.SHARED_MEMORY_POOL_MAX_CACHED_BYTES))
             w.daemon = True
             # NB: Process.start() actually take some time as it needs to
             #     start a process and pass the arguments over via a pipe.
@@ -778,6 +779,9 @@ class _MultiProcessingDataLoaderIter(_BaseDataLoaderIter):
                 if self._workers_status[worker_id] and not w.is_alive():
                     failed_workers.append(w)
                     self._shutdown_worker(worker_id)
+                    # A killed worker can't drop its shared memory pool
+                    # segments itself
+                    torch.multiprocessing._release_shared_memory_pool_segments(w.pid)
             if len(failed_workers) > 0:
                 pids_str = ', '.join(str(w.pid) for w in failed_workers)
                 raise RuntimeError('DataLoader worker (pid(s) {}) exited unexpectedly'.format(pids_str))
@@ -1070,6 +1074,9 @@ class _MultiProcessingDataLoaderIter(_BaseDataLoaderIter):
                         # here, which we shouldn't, (e.g., pytorch/pytorch#39570),
                         # we kill the worker.
                         w.terminate()
+                    # Unmaps the shared memory pool segments of the worker
+                    # rather than at the next epoch, also if it was killed
+                    torch.multiprocessing._release_shared_memory_pool_segments(w.pid)
                 for q in self._index_queues:
                     q.cancel_join_thread()
                     q.close()
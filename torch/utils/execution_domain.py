@@ -0,0 +1,62 @@
+from __future__ import absolute_import, division, print_function, unicode_literals
+
+import contextlib
+
+import torch._C
+
+
+def register_execution_domain(name, num_intraop_threads=0, num_interop_threads=0,
+                              cpus=None, priority='normal'):
+    r"""Registers a named execution domain: a set of threads with their own
+    intra-op and inter-op thread counts, used to isolate models served from
+    the same process (e.g. a latency critical model from a batch one).
+
+    Arguments:
+        name (str): name of the domain, must not be registered yet
+        num_intraop_threads (int, optional): number of threads of the parallel
+            regions (e.g. ``torch.set_num_threads``) run in the domain; if 0,
+            the number of ``cpus`` if given, or else the default
+        num_interop_threads (int, optional): number of threads running the
+            tasks launched in the domain (e.g. ``torch.jit._fork``); if 0,
+            the number of ``cpus`` if given, or else the default
+        cpus (list of int, optional): CPUs the threads of the domain run on,
+            only supported on Linux
+        priority (str, optional): scheduling priority of the threads of the
+            domain: ``'low'``, ``'normal'`` or ``'high'``
+
+    .. note::
+        With the OpenMP parallel backend, the domain only sets the number of
+        threads of the parallel regions started in it; the OpenMP threads
+        themselves are shared by all the domains. The CPU affinity and the
+        priority only apply to the threads created by the domain.
+    """
+    torch._C._register_execution_domain(
+        name, num_intraop_threads, num_interop_threads,
+        list(cpus) if cpus is not None else [], priority)
+
+
+@contextlib.contextmanager
+def execution_domain(name):
+    r"""Context manager running the ops of the current thread in the execution
+    domain ``name`` (``None`` for the default thread pools). Tasks launched
+    from within the context, e.g. with ``torch.jit._fork``, also run in the
+    domain.
+
+    Example::
+
+        >>> register_execution_domain('serving', num_intraop_threads=2, cpus=[0, 1])
+        >>> with execution_domain('serving'):
+        ...     y = model(x)
+    """
+    prev = torch._C._get_execution_domain()
+    torch._C._set_execution_domain(name)
+    try:
+        yield
+    finally:
+        torch._C._set_execution_domain(prev)
+
+
+def current_execution_domain():
+    r"""Returns the name of the execution domain of the current thread, or
+    ``None`` outside of any domain."""
+    return torch._C._get_execution_domain()